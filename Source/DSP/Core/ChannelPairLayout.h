@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/** Which part of a multichannel bus the analyzer sinks receive. */
+enum class AnalyzerSource { FoldDown, Front, Surround, Rear, TopFront, TopRear, CentreLfe };
+
+inline AnalyzerSource analyzerSourceFromInt(const int index) {
+    return index >= 0 && index <= static_cast<int>(AnalyzerSource::CentreLfe)
+               ? static_cast<AnalyzerSource>(index)
+               : AnalyzerSource::FoldDown;
+}
+
+inline int analyzerSourceToInt(const AnalyzerSource source) { return static_cast<int>(source); }
+
+/**
+ * ChannelPairLayout
+ *
+ * A bus split into the units the channel-mode stage works on: symmetric left/right pairs
+ * (L/R, Ls/Rs, Lrs/Rrs, Ltf/Rtf, ...) and the channels that have no partner (C, LFE, ...).
+ * Every channel belongs to exactly one unit; the front pair, when present, is unit 0.
+ *
+ * A single runs through the stereo kernels as the pair (x, x) and keeps the left output:
+ * it is pure mid in M/S and follows the primary channel in L/R.
+ *
+ * Layouts without channel types (discrete channels) are paired by index.
+ */
+struct ChannelPairLayout {
+    struct Unit {
+        int left = -1;
+        int right = -1; // -1 for a single
+
+        bool isPair() const noexcept { return right >= 0; }
+    };
+
+    std::vector<Unit> units;
+
+    /** Stereo-style pairing by index: (0, 1), (2, 3), ... and a trailing single. */
+    static ChannelPairLayout fromChannelCount(const int numChannels) {
+        ChannelPairLayout layout;
+        for (int ch = 0; ch < numChannels; ch += 2)
+            layout.units.push_back({ch, ch + 1 < numChannels ? ch + 1 : -1});
+        return layout;
+    }
+
+    static ChannelPairLayout fromChannelSet(const juce::AudioChannelSet &set) {
+        using Type = juce::AudioChannelSet::ChannelType;
+
+        static constexpr std::array<std::pair<Type, Type>, 8> kPairTypes{{
+            {juce::AudioChannelSet::left, juce::AudioChannelSet::right},
+            {juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround},
+            {juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide},
+            {juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear},
+            {juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::topFrontRight},
+            {juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::topRearRight},
+            {juce::AudioChannelSet::topSideLeft, juce::AudioChannelSet::topSideRight},
+            {juce::AudioChannelSet::wideLeft, juce::AudioChannelSet::wideRight},
+        }};
+
+        const int numChannels = set.size();
+        std::vector<bool> used(static_cast<size_t>(numChannels), false);
+        ChannelPairLayout layout;
+
+        for (const auto &[leftType, rightType]: kPairTypes) {
+            const int l = set.getChannelIndexForType(leftType);
+            const int r = set.getChannelIndexForType(rightType);
+            if (l >= 0 && r >= 0) {
+                layout.units.push_back({l, r});
+                used[static_cast<size_t>(l)] = used[static_cast<size_t>(r)] = true;
+            }
+        }
+
+        // Nothing recognisable (discrete channels): pair by index
+        if (layout.units.empty())
+            return fromChannelCount(numChannels);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            if (!used[static_cast<size_t>(ch)])
+                layout.units.push_back({ch, -1});
+
+        return layout;
+    }
+
+    int getNumChannels() const noexcept {
+        int count = 0;
+        for (const auto &unit: units)
+            count += unit.isPair() ? 2 : 1;
+        return count;
+    }
+
+    /**
+     * Left/right channel indices the analyzer reads for a source (-1 where the bus has no
+     * such channel). CentreLfe puts the centre on the left and the LFE on the right.
+     * FoldDown has no single pair; use getFoldDownWeights().
+     */
+    static std::array<int, 2> findSource(const juce::AudioChannelSet &set, const AnalyzerSource source) {
+        using Set = juce::AudioChannelSet;
+        const auto pair = [&set](const Set::ChannelType l, const Set::ChannelType r) {
+            return std::array<int, 2>{set.getChannelIndexForType(l), set.getChannelIndexForType(r)};
+        };
+
+        switch (source) {
+            case AnalyzerSource::Front: return pair(Set::left, Set::right);
+            case AnalyzerSource::Surround: {
+                const auto surround = pair(Set::leftSurround, Set::rightSurround);
+                return surround[0] >= 0 ? surround : pair(Set::leftSurroundSide, Set::rightSurroundSide);
+            }
+            case AnalyzerSource::Rear: return pair(Set::leftSurroundRear, Set::rightSurroundRear);
+            case AnalyzerSource::TopFront: return pair(Set::topFrontLeft, Set::topFrontRight);
+            case AnalyzerSource::TopRear: return pair(Set::topRearLeft, Set::topRearRight);
+            case AnalyzerSource::CentreLfe: return pair(Set::centre, Set::LFE);
+            case AnalyzerSource::FoldDown: break;
+        }
+
+        return {-1, -1};
+    }
+
+    /**
+     * Per-channel (left, right) gains of a stereo fold-down in the spirit of ITU-R BS.775:
+     * the front pair at unity, every other pair at -3 dB on its side, other singles at -3 dB
+     * into both sides, LFE dropped.
+     */
+    static std::vector<std::array<float, 2>> getFoldDownWeights(const juce::AudioChannelSet &set) {
+        const float minus3dB = 1.0f / std::sqrt(2.0f);
+        const auto layout = fromChannelSet(set);
+        std::vector<std::array<float, 2>> weights(static_cast<size_t>(set.size()), {0.0f, 0.0f});
+
+        for (size_t u = 0; u < layout.units.size(); ++u) {
+            const auto &unit = layout.units[u];
+
+            if (unit.isPair()) {
+                const float gain = u == 0 ? 1.0f : minus3dB;
+                weights[static_cast<size_t>(unit.left)] = {gain, 0.0f};
+                weights[static_cast<size_t>(unit.right)] = {0.0f, gain};
+            } else {
+                const auto type = set.getTypeOfChannel(unit.left);
+                const bool isLfe = type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2;
+                weights[static_cast<size_t>(unit.left)] = isLfe
+                                                              ? std::array<float, 2>{0.0f, 0.0f}
+                                                              : std::array<float, 2>{minus3dB, minus3dB};
+            }
+        }
+
+        return weights;
+    }
+};
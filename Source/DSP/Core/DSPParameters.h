@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * Plain copy of every host-automatable parameter gFractorDSP consumes, in DSP units.
+ *
+ * Built on the audio thread from the APVTS raw atomics (see ParameterSnapshot) and handed
+ * to gFractorDSP::setParameters(), so parameter state never crosses threads except through
+ * those atomics.
+ */
+struct DSPParameters {
+    float gainDb = 0.0f;
+    float dryWet = 1.0f; // 0.0 = dry, 1.0 = wet
+    bool bypassed = false;
+    bool primaryEnabled = true;
+    bool secondaryEnabled = true;
+    float transientLengthMs = 1.0f;
+
+    bool operator==(const DSPParameters &other) const noexcept {
+        return gainDb == other.gainDb
+               && dryWet == other.dryWet
+               && bypassed == other.bypassed
+               && primaryEnabled == other.primaryEnabled
+               && secondaryEnabled == other.secondaryEnabled
+               && transientLengthMs == other.transientLengthMs;
+    }
+
+    bool operator!=(const DSPParameters &other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * Parameter values that take effect at given sample offsets within one block.
+ *
+ * gFractorDSP::process(buffer, timeline) splits the block at each point and applies the
+ * new values between the pieces, so automation lands on the exact sample. Fixed capacity,
+ * no allocation: the audio thread clears and refills it every block.
+ */
+class ParameterTimeline {
+public:
+    static constexpr size_t kMaxPoints = 32;
+
+    struct Point {
+        int sampleOffset = 0;
+        DSPParameters parameters;
+    };
+
+    void clear() noexcept { numPoints = 0; }
+
+    /**
+     * Append a change. Offsets must not decrease; a point at the same offset as the last one
+     * replaces it, and once the timeline is full later points overwrite the last one (the
+     * block still ends on the newest values, only the split position is coarsened).
+     */
+    void add(const int sampleOffset, const DSPParameters &parameters) noexcept {
+        if (numPoints > 0 && (points[numPoints - 1].sampleOffset >= sampleOffset || numPoints == kMaxPoints)) {
+            points[numPoints - 1].parameters = parameters;
+            return;
+        }
+        points[numPoints++] = {sampleOffset, parameters};
+    }
+
+    size_t size() const noexcept { return numPoints; }
+    bool isEmpty() const noexcept { return numPoints == 0; }
+
+    const Point *begin() const noexcept { return points.data(); }
+    const Point *end() const noexcept { return points.data() + numPoints; }
+
+private:
+    std::array<Point, kMaxPoints> points{};
+    size_t numPoints = 0;
+};
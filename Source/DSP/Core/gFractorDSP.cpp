@@ -1,42 +1,74 @@
 #include "gFractorDSP.h"
 
-gFractorDSP::~gFractorDSP()
-{
-    // Drain any unprocessed handoff pointers — audio thread is guaranteed stopped by now.
-    delete pendingStrategy.load(std::memory_order_acquire);
-    delete strategyPendingDeletion.load(std::memory_order_acquire);
-}
+#include <algorithm>
+#include <utility>
 
-void gFractorDSP::prepare(const juce::dsp::ProcessSpec &spec) {
+template<typename SampleType>
+void gFractorDSP<SampleType>::prepare(const juce::dsp::ProcessSpec &spec) {
     currentSpec = spec;
 
-    gainProcessor.prepare(spec);
-    dryWetMixer.prepare(spec);
-
-    primaryGain.reset(spec.sampleRate, 0.010);
-    primaryGain.setCurrentAndTargetValue(primaryEnabled.load(std::memory_order_relaxed) ? 1.0f : 0.0f);
-    secondaryGain.reset(spec.sampleRate, 0.010);
-    secondaryGain.setCurrentAndTargetValue(secondaryEnabled.load(std::memory_order_relaxed) ? 1.0f : 0.0f);
-
-    gainSmoothed.reset(spec.sampleRate, 0.05);
-    gainSmoothed.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(0.0f));
+    // One channel-mode unit per pair / single of the main bus; channels past it (sidechain) are
+    // left to the pipeline alone
+    const auto numChannels = static_cast<int>(spec.numChannels);
+    const bool layoutFits = !requestedLayout.units.empty() && requestedLayout.getNumChannels() <= numChannels;
+    const auto layout = layoutFits ? requestedLayout : ChannelPairLayout::fromChannelCount(juce::jmin(numChannels, 2));
+
+    channelUnits.clear();
+    for (const auto &channels: layout.units) {
+        auto unit = std::make_unique<ChannelUnit>();
+        unit->channels = channels;
+
+        auto &primaryGain = unit->state.primaryGain;
+        auto &secondaryGain = unit->state.secondaryGain;
+        primaryGain.reset(spec.sampleRate, 0.010);
+        primaryGain.setCurrentAndTargetValue(primaryEnabled.load(std::memory_order_relaxed) ? 1.0f : 0.0f);
+        secondaryGain.reset(spec.sampleRate, 0.010);
+        secondaryGain.setCurrentAndTargetValue(secondaryEnabled.load(std::memory_order_relaxed) ? 1.0f : 0.0f);
+
+        unit->separator.setFftOrder(separatorFftOrder.load(std::memory_order_relaxed));
+        unit->separator.prepare(spec);
+        unit->state.separator = &unit->separator;
+        unit->crossfade.prepare(spec);
+
+        channelUnits.push_back(std::move(unit));
+    }
 
-    dryWetMixer.setWetMixProportion(dryWetMix);
+    singleScratch.assign(juce::jmax<size_t>(1, spec.maximumBlockSize), 0.0f);
 
-    auditFilter.prepare(spec);
-    bandFilter.prepare(spec);
+    crossover.prepare(spec, channelUnits.size());
+    crossoverLefts.assign(channelUnits.size(), nullptr);
+    crossoverRights.assign(channelUnits.size(), nullptr);
+    crossoverRunning = false;
 
-    // Drain any pending handoff pointers — prepare() is always called before the audio thread starts.
-    delete pendingStrategy.exchange(nullptr, std::memory_order_acq_rel);
-    delete strategyPendingDeletion.exchange(nullptr, std::memory_order_acq_rel);
+    matchEq.prepare(spec, static_cast<size_t>(layout.getNumChannels()));
+    matchEqChannels.assign(static_cast<size_t>(layout.getNumChannels()), nullptr);
+    matchEqRunning = false;
+    appliedSeparatorFftOrder = separatorFftOrder.load(std::memory_order_relaxed);
 
-    channelModeStrategy = ChannelModeStrategyFactory::create(outputMode);
-    channelModeStrategy->prepare(spec);
+    gainSmoothed.reset(spec.sampleRate, 0.05);
+    gainSmoothed.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(0.0f));
 
+    // Same 50 ms linear ramps and linear mixing rule as juce::dsp::DryWetMixer
+    dryVolume.reset(spec.sampleRate, 0.05);
+    dryVolume.setCurrentAndTargetValue(1.0f - dryWetMix);
+    wetVolume.reset(spec.sampleRate, 0.05);
+    wetVolume.setCurrentAndTargetValue(dryWetMix);
+    inputGains.assign(juce::jmax<size_t>(1, spec.maximumBlockSize), SampleType(1));
+
+    filterBank.prepare(spec);
+    spectralAudition.prepare(spec);
+    spectralAuditionRunning = false;
+    hasRenderedMode = false;
+    primingSeparators = false;
+    truePeakMeter.prepare(static_cast<int>(spec.maximumBlockSize));
+
+    hasAppliedParameters = false;
+    restartPending = false;
     isPrepared = true;
 }
 
-void gFractorDSP::process(juce::AudioBuffer<float> &buffer) {
+template<typename SampleType>
+void gFractorDSP<SampleType>::process(juce::AudioBuffer<SampleType> &buffer) {
     // Guard against calling process before prepare (handles both Debug jassert and Release)
     if (!isPrepared)
         return;
@@ -45,169 +77,673 @@ void gFractorDSP::process(juce::AudioBuffer<float> &buffer) {
     if (bypassed.load(std::memory_order_acquire))
         return;
 
-    // Pick up any pending strategy swap posted by the message thread (lock-free handoff).
-    if (auto* next = pendingStrategy.exchange(nullptr, std::memory_order_acq_rel))
-    {
-        // Signal the replaced strategy for deferred deletion on the message thread.
-        strategyPendingDeletion.store(channelModeStrategy.release(), std::memory_order_release);
-        channelModeStrategy.reset(next);
+    if (std::exchange(restartPending, false))
+        reset();
+
+    Block block(buffer);
+    updatePeaks(block);
+    processUnbypassed(block);
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::process(juce::AudioBuffer<SampleType> &buffer, const ParameterTimeline &timeline) {
+    if (!isPrepared)
+        return;
+
+    if (std::exchange(restartPending, false))
+        reset();
+
+    Block block(buffer);
+    const auto numSamples = block.getNumSamples();
+    size_t segmentStart = 0;
+    bool peaksUpdated = false;
+
+    // Process [segmentStart, segmentEnd) with the parameters currently applied
+    const auto processSegment = [&](const size_t segmentEnd) {
+        if (segmentEnd <= segmentStart)
+            return;
+
+        if (!bypassed.load(std::memory_order_acquire)) {
+            // Meter the untouched input from the first processed sample to the end of the block
+            if (!peaksUpdated) {
+                updatePeaks(block.getSubBlock(segmentStart));
+                peaksUpdated = true;
+            }
+
+            auto segment = block.getSubBlock(segmentStart, segmentEnd - segmentStart);
+            processUnbypassed(segment);
+        }
+
+        segmentStart = segmentEnd;
+    };
+
+    for (const auto &point: timeline) {
+        processSegment(static_cast<size_t>(juce::jlimit(0, static_cast<int>(numSamples), point.sampleOffset)));
+        setParameters(point.parameters);
     }
 
-    // Create DSP context from buffer
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing context(block);
+    processSegment(numSamples);
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::processSilence(juce::AudioBuffer<SampleType> &buffer, const DSPParameters &parameters) {
+    if (!isPrepared)
+        return;
+
+    // The block is already the silence the flushed chain would output, bypassed or not
+    juce::ignoreUnused(buffer);
+    setParameters(parameters);
+    if (!bypassed.load(std::memory_order_acquire))
+        restartPending = true;
+}
 
-    // Compute peak mid/side levels before any processing
+template<typename SampleType>
+void gFractorDSP<SampleType>::setParameters(const DSPParameters &parameters) {
+    if (hasAppliedParameters && parameters == appliedParameters)
+        return;
+
+    const bool applyAll = !hasAppliedParameters;
+
+    if (applyAll || parameters.gainDb != appliedParameters.gainDb)
+        setGain(parameters.gainDb);
+    if (applyAll || parameters.dryWet != appliedParameters.dryWet)
+        setDryWet(parameters.dryWet);
+    if (applyAll || parameters.bypassed != appliedParameters.bypassed)
+        setBypassed(parameters.bypassed);
+    if (applyAll || parameters.primaryEnabled != appliedParameters.primaryEnabled)
+        setPrimaryEnabled(parameters.primaryEnabled);
+    if (applyAll || parameters.secondaryEnabled != appliedParameters.secondaryEnabled)
+        setSecondaryEnabled(parameters.secondaryEnabled);
+    if (applyAll || parameters.transientLengthMs != appliedParameters.transientLengthMs)
+        setTransientLength(parameters.transientLengthMs);
+
+    // setTransientLength() needs the sample rate, so nothing counts as applied before prepare().
+    appliedParameters = parameters;
+    hasAppliedParameters = isPrepared;
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::updatePeaks(const Block &block) {
+    // Compute peak mid/side levels before any processing (vectorized, ISA picked at startup)
     if (block.getNumChannels() >= 2) {
-        const auto *leftData = block.getChannelPointer(0);
-        const auto *rightData = block.getChannelPointer(1);
-        const auto numSamples = block.getNumSamples();
+        const auto peaks = MidSidePeakKernel::process(block.getChannelPointer(0),
+                                                      block.getChannelPointer(1),
+                                                      block.getNumSamples());
 
-        float peakPrimary = 0.0f;
-        float peakSecondary = 0.0f;
+        peakPrimaryDb.store(juce::Decibels::gainToDecibels(peaks.mid, -100.0f), std::memory_order_relaxed);
+        peakSecondaryDb.store(juce::Decibels::gainToDecibels(peaks.side, -100.0f), std::memory_order_relaxed);
 
-        // SIMD-friendly chunked processing
-        constexpr size_t chunkSize = 8;
-        size_t i = 0;
+        updateTruePeaks(block, peaks);
+    } else {
+        updateTruePeaks(block, {});
+    }
+}
 
-        for (; i + chunkSize <= numSamples; i += chunkSize) {
-            // Compute mid = |L + R| * 0.5 for chunk
-            for (size_t j = 0; j < chunkSize; ++j) {
-                simdWorkBuffer[j] = std::abs(leftData[i + j] + rightData[i + j]) * 0.5f;
-            }
-            // Find max using SIMD
-            for (size_t j = 0; j < chunkSize; ++j) {
-                peakPrimary = juce::jmax(peakPrimary, simdWorkBuffer[j]);
-            }
+template<typename SampleType>
+void gFractorDSP<SampleType>::updateTruePeaks(const Block &block,
+                                              const MidSidePeakKernel::Peaks &midSidePeaks) {
+    const bool enabled = truePeakEnabled.load(std::memory_order_relaxed) && block.getNumChannels() >= 2;
 
-            // Compute side = |L - R| * 0.5 for chunk
-            for (size_t j = 0; j < chunkSize; ++j) {
-                simdWorkBuffer[j] = std::abs(leftData[i + j] - rightData[i + j]) * 0.5f;
-            }
-            for (size_t j = 0; j < chunkSize; ++j) {
-                peakSecondary = juce::jmax(peakSecondary, simdWorkBuffer[j]);
+    if (!enabled) {
+        if (truePeakMetering) {
+            truePeakMetering = false;
+            truePeakPrimaryDb.store(-100.0f, std::memory_order_relaxed);
+            truePeakSecondaryDb.store(-100.0f, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    // Turning the mode on starts from clean filter history
+    if (!truePeakMetering) {
+        truePeakMeter.reset();
+        truePeakMetering = true;
+    }
+
+    if (truePeakResetPending.exchange(false, std::memory_order_relaxed))
+        truePeakMeter.resetHold();
+
+    const auto decode = outputMode.load(std::memory_order_relaxed) == ChannelMode::LR
+                            ? TruePeakMeter::Decode::LeftRight
+                            : TruePeakMeter::Decode::MidSide;
+
+    // In M/S the sample peaks just measured are the meter's gate input; L/R measures its own.
+    const auto *left = block.getChannelPointer(0);
+    const auto *right = block.getChannelPointer(1);
+    const auto numSamples = block.getNumSamples();
+
+    if (decode == TruePeakMeter::Decode::MidSide)
+        truePeakMeter.process(left, right, numSamples, decode, {midSidePeaks.mid, midSidePeaks.side});
+    else
+        truePeakMeter.process(left, right, numSamples, decode);
+
+    truePeakPrimaryDb.store(juce::Decibels::gainToDecibels(truePeakMeter.getHeldPeak(0), -100.0f),
+                            std::memory_order_relaxed);
+    truePeakSecondaryDb.store(juce::Decibels::gainToDecibels(truePeakMeter.getHeldPeak(1), -100.0f),
+                              std::memory_order_relaxed);
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::processUnbypassed(Block &block) {
+    const bool isStereo = block.getNumChannels() >= 2;
+
+    // FFT size changes restart the separators on their next block
+    if (const int order = separatorFftOrder.load(std::memory_order_relaxed); order != appliedSeparatorFftOrder) {
+        appliedSeparatorFftOrder = order;
+        for (auto &unit: channelUnits)
+            unit->separator.setFftOrder(order);
+    }
+
+    // Pick up a mode switch once any previous crossfade has finished
+    if (!isCrossfading()) {
+        const auto requestedMode = outputMode.load(std::memory_order_relaxed);
+        bool modeChanged = !hasRenderedMode || requestedMode != renderedMode;
+        const bool fading = hasRenderedMode && modeChanged && isStereo;
+
+        // Fading into Tonal/Transient, the separators first run on the stage input behind the old
+        // mode until their frames and medians are full, so the fade goes into separated output
+        // rather than into the silence a reset separator starts with
+        const bool wasPriming = std::exchange(primingSeparators, false);
+        if (fading && requestedMode == ChannelMode::TonalTransient) {
+            if (!wasPriming)
+                for (auto &unit: channelUnits)
+                    unit->separator.reset();
+
+            primingSeparators = std::any_of(channelUnits.begin(), channelUnits.end(),
+                                            [](const auto &unit) { return !unit->separator.isPrimed(); });
+            modeChanged = !primingSeparators;
+        }
+
+        if (modeChanged) {
+            for (auto &unit: channelUnits) {
+                if (fading)
+                    unit->crossfade.start(renderedKernel);
+
+                // Switching at once starts the separator from silence rather than stale frames
+                if (requestedMode == ChannelMode::TonalTransient && !fading)
+                    unit->separator.reset();
             }
+
+            renderedMode = requestedMode;
+            hasRenderedMode = true;
+        }
+    }
+
+    // Channel-mode kernel for this block: one specialisation per (mode, primary on, secondary on).
+    // Every unit retargets its own smoothers; they move in step, so unit 0 picks the kernel.
+    const bool primOn = primaryEnabled.load(std::memory_order_relaxed);
+    const bool secOn = secondaryEnabled.load(std::memory_order_relaxed);
+    unsigned channelKernel = ChannelModeKernels::kIdentity;
+
+    for (size_t u = channelUnits.size(); u-- > 0;)
+        channelKernel = ChannelModeKernels::select(renderedMode, primOn, secOn, channelUnits[u]->state);
+
+    renderedKernel = channelKernel;
+
+    // The pipelines only run the channel-mode kernel themselves for a plain stereo pair.
+    // While crossfading, the crossfade runs the old and new kernels on their output; while
+    // priming, the separators take a copy of it;
+    // Tonal/Transient works on whole blocks; buses with more than one unit run every unit.
+    // All three happen after the pipeline, which then uses the identity kernel.
+    // Both pipelines treat the identity kernel (M/S or L/R with both channels on) as no stage.
+    const bool crossfading = isCrossfading() && isStereo;
+    const bool separatePass = isStereo && (crossfading || primingSeparators
+                                           || ChannelModeKernels::isSpectral(channelKernel)
+                                           || (channelUnits.size() > 1
+                                               && !ChannelModeKernels::isIdentity(channelKernel)));
+    const unsigned pipelineKernel = separatePass || ChannelModeKernels::isIdentity(channelKernel)
+                                        ? ChannelModeKernels::kIdentity
+                                        : channelKernel;
+
+    // The spectral audition replaces the filter bank after the pipeline; each engine starts
+    // clean when it takes over, rather than from whatever it held when it was last used
+    const bool spectral = auditionEngine.load(std::memory_order_relaxed) == AuditionEngine::Spectral;
+    if (spectral != spectralAuditionRunning) {
+        if (spectral)
+            spectralAudition.reset();
+        else
+            filterBank.reset();
+        spectralAuditionRunning = spectral;
+    }
+
+    // The fused kernels are stereo-only; anything else (mono, sidechain-wide buffers) runs staged.
+    const bool canFuse = block.getNumChannels() == 2 && currentSpec.numChannels >= 2;
+
+    if (canFuse && executionMode.load(std::memory_order_relaxed) == ExecutionMode::Fused)
+        processFused(block, pipelineKernel);
+    else
+        processStaged(block, pipelineKernel);
+
+    if (spectral)
+        spectralAudition.process(block);
+
+    if (separatePass)
+        processChannelUnits(block, channelKernel, crossfading, primingSeparators);
+
+    // Coming on, the crossover starts from silence rather than whatever it held when it went off
+    if (crossoverEnabled.load(std::memory_order_relaxed)) {
+        if (!crossoverRunning) {
+            crossover.reset();
+            crossoverRunning = true;
         }
 
-        // Tail processing
-        for (; i < numSamples; ++i) {
-            const float mid = std::abs(leftData[i] + rightData[i]) * 0.5f;
-            const float side = std::abs(leftData[i] - rightData[i]) * 0.5f;
-            peakPrimary = juce::jmax(peakPrimary, mid);
-            peakSecondary = juce::jmax(peakSecondary, side);
+        processCrossover(block);
+    } else {
+        crossoverRunning = false;
+    }
+
+    if (matchEqEnabled.load(std::memory_order_relaxed)) {
+        if (!matchEqRunning) {
+            matchEq.reset();
+            matchEqRunning = true;
         }
 
-        peakPrimaryDb.store(juce::Decibels::gainToDecibels(peakPrimary, -100.0f), std::memory_order_relaxed);
-        peakSecondaryDb.store(juce::Decibels::gainToDecibels(peakSecondary, -100.0f), std::memory_order_relaxed);
+        processMatchEq(block);
+    } else {
+        matchEqRunning = false;
     }
+}
 
-    // Push dry signal for wet/dry mixing
-    dryWetMixer.pushDrySamples(block);
+template<typename SampleType>
+void gFractorDSP<SampleType>::processCrossover(Block &block) {
+    const auto numChannels = static_cast<int>(block.getNumChannels());
+
+    // Units run together and in layout order; stop at the first one the block does not cover
+    size_t numUnits = 0;
+    for (; numUnits < channelUnits.size(); ++numUnits) {
+        const auto [leftIndex, rightIndex] = channelUnits[numUnits]->channels;
+        if (leftIndex >= numChannels || rightIndex >= numChannels)
+            break;
+
+        crossoverLefts[numUnits] = block.getChannelPointer(static_cast<size_t>(leftIndex));
+        crossoverRights[numUnits] = channelUnits[numUnits]->channels.isPair()
+                                        ? block.getChannelPointer(static_cast<size_t>(rightIndex))
+                                        : nullptr;
+    }
 
-    // Apply gain with per-sample smoothing if needed
-    if (gainSmoothed.isSmoothing()) {
-        // Per-sample smoothing to prevent zipper noise during gain changes
-        for (size_t sample = 0; sample < block.getNumSamples(); ++sample) {
-            const float currentGain = gainSmoothed.getNextValue();
+    crossover.process(crossoverLefts.data(), crossoverRights.data(), numUnits, block.getNumSamples());
+}
 
-            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
-                auto *channelData = block.getChannelPointer(channel);
-                channelData[sample] *= currentGain;
-            }
+template<typename SampleType>
+void gFractorDSP<SampleType>::processMatchEq(Block &block) {
+    const auto numChannels = static_cast<int>(block.getNumChannels());
+
+    // Same coverage as the crossover: whole units in layout order, the first pair feeding the analysis
+    size_t count = 0;
+    for (const auto &unit: channelUnits) {
+        const auto [leftIndex, rightIndex] = unit->channels;
+        if (leftIndex >= numChannels || rightIndex >= numChannels)
+            break;
+
+        matchEqChannels[count++] = block.getChannelPointer(static_cast<size_t>(leftIndex));
+        if (unit->channels.isPair())
+            matchEqChannels[count++] = block.getChannelPointer(static_cast<size_t>(rightIndex));
+    }
+
+    matchEq.process(matchEqChannels.data(), count, block.getNumSamples());
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::processChannelUnits(Block &block, const unsigned channelKernel,
+                                      const bool crossfading, const bool priming) {
+    const auto numChannels = static_cast<int>(block.getNumChannels());
+    const auto numSamples = block.getNumSamples();
+
+    const auto run = [&](ChannelUnit &unit, SampleType *left, SampleType *right, const size_t len) {
+        if (priming)
+            unit.separator.prime(left, right, len);
+
+        if (crossfading)
+            unit.crossfade.process(channelKernel, left, right, len, unit.state);
+        else
+            ChannelModeKernels::process(channelKernel, left, right, len, unit.state);
+    };
+
+    for (auto &unitPointer: channelUnits) {
+        auto &unit = *unitPointer;
+        const auto [leftIndex, rightIndex] = unit.channels;
+
+        // Channels past the block (e.g. a narrower buffer than prepared) are left alone
+        if (leftIndex >= numChannels || rightIndex >= numChannels)
+            continue;
+
+        SampleType *left = block.getChannelPointer(static_cast<size_t>(leftIndex));
+
+        if (unit.channels.isPair()) {
+            run(unit, left, block.getChannelPointer(static_cast<size_t>(rightIndex)), numSamples);
+            continue;
+        }
+
+        // A single runs as (x, x) and keeps the left output
+        for (size_t start = 0; start < numSamples; start += singleScratch.size()) {
+            const auto len = juce::jmin(singleScratch.size(), numSamples - start);
+            std::copy(left + start, left + start + len, singleScratch.data());
+            run(unit, left + start, singleScratch.data(), len);
+        }
+    }
+}
+
+template<typename SampleType>
+typename gFractorDSP<SampleType>::InputGain gFractorDSP<SampleType>::prepareInputGain(const size_t numSamples) {
+    // The dry volume ramps in step with the wet one
+    const bool mixRamp = wetVolume.isSmoothing();
+
+    if (!mixRamp) {
+        const auto wet = static_cast<SampleType>(wetVolume.getTargetValue());
+        const auto dry = static_cast<SampleType>(dryVolume.getTargetValue());
+
+        if (!gainSmoothed.isSmoothing()) {
+            constantInputGain = static_cast<SampleType>(gainSmoothed.getTargetValue()) * wet + dry;
+            return constantInputGain == SampleType(1) ? InputGain::Identity : InputGain::Constant;
+        }
+
+        // Fully dry: a gain ramp has nothing to act on
+        if (wet == SampleType(0)) {
+            gainSmoothed.skip(static_cast<int>(numSamples));
+            return InputGain::Identity;
+        }
+    }
+
+    jassert(numSamples <= inputGains.size());
+
+    for (size_t i = 0; i < numSamples; ++i) {
+        const auto gain = static_cast<SampleType>(gainSmoothed.getNextValue());
+        const auto wet = static_cast<SampleType>(wetVolume.getNextValue());
+        const auto dry = static_cast<SampleType>(dryVolume.getNextValue());
+        inputGains[i] = gain * wet + dry;
+    }
+
+    return InputGain::Ramp;
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::applyInputGain(Block &block) {
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+
+    for (size_t start = 0; start < numSamples; start += inputGains.size()) {
+        const auto len = juce::jmin(inputGains.size(), numSamples - start);
+        const auto inputGain = prepareInputGain(len);
+
+        if (inputGain == InputGain::Identity)
+            continue;
+
+        for (size_t channel = 0; channel < numChannels; ++channel) {
+            auto *channelData = block.getChannelPointer(channel) + start;
+
+            if (inputGain == InputGain::Constant)
+                juce::FloatVectorOperations::multiply(channelData, constantInputGain, static_cast<int>(len));
+            else
+                juce::FloatVectorOperations::multiply(channelData, inputGains.data(), static_cast<int>(len));
+        }
+    }
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::processStaged(Block &block, const unsigned channelKernel) {
+    juce::dsp::ProcessContextReplacing context(block);
+
+    // Gain and dry/wet in place (skipped when they are identity)
+    applyInputGain(block);
+
+    // Audition bell, band selection and band solo/mute filters (each skips itself when off)
+    if (!spectralAuditionRunning)
+        filterBank.process(context);
+
+    // Channel mode processing (needs a stereo pair)
+    if (channelKernel != ChannelModeKernels::kIdentity && block.getNumChannels() >= 2 && !channelUnits.empty())
+        ChannelModeKernels::process(channelKernel,
+                                    block.getChannelPointer(0),
+                                    block.getChannelPointer(1),
+                                    block.getNumSamples(),
+                                    channelUnits.front()->state);
+}
+
+//==============================================================================
+// Fused pipeline
+//
+// Each variant is one specialisation of the per-frame loop with only the stages that are
+// active for the block compiled in. The variant index is a bitmask of FusedStage flags plus
+// the ChannelModeKernels index in the upper bits, resolved once per block through a dispatch table.
+
+namespace FusedStage {
+    constexpr unsigned inputRamp = 1u << 0; // per-sample gain and dry/wet from inputGains
+    constexpr unsigned inputGain = 1u << 1; // settled, non-unity constantInputGain
+    constexpr unsigned filterBank = 1u << 2;
+    constexpr unsigned kernelShift = 3; // ChannelModeKernels index in bits 3..6
+
+    /**
+     * Maps variants that share a channel-mode kernel onto one instantiation. Tonal/Transient
+     * kernels never reach the fused loop (processUnbypassed() runs them per block), so their
+     * slots map to the identity kernel. inputRamp and inputGain are never both set.
+     */
+    constexpr size_t canonicalise(const size_t variant) {
+        const auto v = static_cast<unsigned>(variant);
+        const unsigned kernel = ChannelModeKernels::isSpectral(v >> kernelShift)
+                                    ? ChannelModeKernels::kIdentity
+                                    : ChannelModeKernels::canonicalise(v >> kernelShift);
+        const unsigned stages = (v & inputRamp) != 0 ? v & ~inputGain & 0x7u : v & 0x7u;
+        return stages | (kernel << kernelShift);
+    }
+}
+
+template<typename SampleType>
+template<size_t Variant>
+void gFractorDSP<SampleType>::processFusedVariant(SampleType *left, SampleType *right, const size_t numSamples) {
+    constexpr auto variant = static_cast<unsigned>(Variant);
+    constexpr bool hasFilterBank = (variant & FusedStage::filterBank) != 0;
+    using ChannelKernel = ChannelModeKernels::Kernel<(variant >> FusedStage::kernelShift)>;
+
+    const SampleType constantGain = constantInputGain;
+    const SampleType *rampGains = inputGains.data();
+
+    // Gain and dry/wet for frame i (see prepareInputGain())
+    const auto inputStages = [&](SampleType &l, SampleType &r, const size_t i) {
+        if constexpr ((variant & FusedStage::inputRamp) != 0) {
+            l *= rampGains[i];
+            r *= rampGains[i];
+        } else if constexpr ((variant & FusedStage::inputGain) != 0) {
+            l *= constantGain;
+            r *= constantGain;
+        } else {
+            juce::ignoreUnused(l, r, i, constantGain, rampGains);
+        }
+    };
+
+    if constexpr (hasFilterBank) {
+        // The filter bank runs its SIMD cascades over whole spans, so the frame loop is
+        // split around them in L1-sized chunks rather than calling the filters per frame.
+        for (size_t start = 0; start < numSamples; start += kFusedChunkSize) {
+            const size_t len = juce::jmin(kFusedChunkSize, numSamples - start);
+            SampleType *l = left + start;
+            SampleType *r = right + start;
+
+            for (size_t i = 0; i < len; ++i)
+                inputStages(l[i], r[i], start + i);
+
+            filterBank.processStereo(l, r, len);
+
+            if constexpr (!ChannelKernel::isIdentity)
+                for (size_t i = 0; i < len; ++i)
+                    ChannelKernel::processFrame(l[i], r[i]);
         }
     } else {
-        // Gain is stable, use optimized JUCE DSP processor
-        gainProcessor.process(context);
+        for (size_t i = 0; i < numSamples; ++i) {
+            SampleType l = left[i];
+            SampleType r = right[i];
+
+            inputStages(l, r, i);
+            ChannelKernel::processFrame(l, r);
+
+            left[i] = l;
+            right[i] = r;
+        }
     }
 
-    // Mix wet/dry signals
-    dryWetMixer.mixWetSamples(block);
+    if constexpr (hasFilterBank)
+        filterBank.endBlock();
+}
 
-    // Transient audition bell filter — 4th order (two cascaded 2nd-order BPFs)
-    auditFilter.process(context);
+template<typename SampleType>
+template<size_t... Variants>
+constexpr std::array<typename gFractorDSP<SampleType>::FusedKernel, sizeof...(Variants)>
+gFractorDSP<SampleType>::makeFusedKernelTable(std::index_sequence<Variants...>) {
+    return {{&gFractorDSP::template processFusedVariant<FusedStage::canonicalise(Variants)>...}};
+}
 
-    // Band selection filter — 4th order (two cascaded 2nd-order BPFs)
-    bandFilter.process(context);
+template<typename SampleType>
+void gFractorDSP<SampleType>::processFused(Block &block, const unsigned channelKernel) {
+    static constexpr auto kernels = makeFusedKernelTable(std::make_index_sequence<kNumFusedVariants>());
+    constexpr auto identityVariant = ChannelModeKernels::kIdentity << FusedStage::kernelShift;
 
-    // Channel mode processing via strategy
-    channelModeStrategy->process(context,
-                                 primaryEnabled,
-                                 secondaryEnabled,
-                                 primaryGain,
-                                 secondaryGain,
-                                 fastEnvAlpha,
-                                 slowEnvAlpha,
-                                 fastEnvState,
-                                 slowEnvState);
+    SampleType *left = block.getChannelPointer(0);
+    SampleType *right = block.getChannelPointer(1);
+    const auto numSamples = block.getNumSamples();
+
+    // One pass for any block up to the prepared size; longer ones go in slices the gain ramp fits
+    for (size_t start = 0; start < numSamples; start += inputGains.size()) {
+        const auto len = juce::jmin(inputGains.size(), numSamples - start);
+        auto variant = channelKernel << FusedStage::kernelShift;
+
+        switch (prepareInputGain(len)) {
+            case InputGain::Ramp: variant |= FusedStage::inputRamp; break;
+            case InputGain::Constant: variant |= FusedStage::inputGain; break;
+            case InputGain::Identity: break;
+        }
+
+        if (!spectralAuditionRunning && filterBank.beginBlock())
+            variant |= FusedStage::filterBank;
+
+        // Every stage is identity: leave the block alone
+        if (variant == identityVariant)
+            continue;
+
+        (this->*kernels[variant])(left + start, right + start, len);
+    }
 }
 
-void gFractorDSP::reset() {
+template<typename SampleType>
+void gFractorDSP<SampleType>::reset() {
     if (!isPrepared)
         return;
 
-    fastEnvState = 0.0f;
-    slowEnvState = 0.0f;
+    for (auto &unit: channelUnits) {
+        unit->separator.reset();
+        unit->crossfade.reset();
+        unit->state.primaryGain.setCurrentAndTargetValue(unit->state.primaryGain.getTargetValue());
+        unit->state.secondaryGain.setCurrentAndTargetValue(unit->state.secondaryGain.getTargetValue());
+    }
 
-    gainProcessor.reset();
-    dryWetMixer.reset();
-    auditFilter.reset();
-    bandFilter.reset();
-    if (channelModeStrategy)
-        channelModeStrategy->reset();
+    gainSmoothed.setCurrentAndTargetValue(gainSmoothed.getTargetValue());
+    dryVolume.setCurrentAndTargetValue(dryVolume.getTargetValue());
+    wetVolume.setCurrentAndTargetValue(wetVolume.getTargetValue());
+    filterBank.reset();
+    spectralAudition.reset();
+    crossover.reset();
+    matchEq.reset();
+
+    // Jump straight to the current output mode on the next block
+    hasRenderedMode = false;
+    primingSeparators = false;
 }
 
-void gFractorDSP::setGain(const float gainDB) {
+template<typename SampleType>
+void gFractorDSP<SampleType>::setGain(const float gainDB) {
     // Convert dB to linear gain
     const float linearGain = juce::Decibels::decibelsToGain(gainDB);
 
     // Set smoothed value (thread-safe: message thread writes, audio thread reads)
     gainSmoothed.setTargetValue(linearGain);
+}
 
-    // Also set the gain processor directly (it will be used when not smoothing)
-    gainProcessor.setGainDecibels(gainDB);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setTransientLength(const float ms) {
+    for (auto &unit: channelUnits)
+        unit->separator.setTransientLength(ms);
 }
 
-void gFractorDSP::setTransientLength(const float ms) {
-    if (isPrepared)
-        fastEnvAlpha = 1.0f - std::exp(-1.0f / (static_cast<float>(currentSpec.sampleRate) * ms * 0.001f));
+template<typename SampleType>
+void gFractorDSP<SampleType>::setSeparatorFftOrder(const int order) {
+    separatorFftOrder.store(juce::jlimit(SpectralSeparator::kMinFftOrder, SpectralSeparator::kMaxFftOrder, order),
+                            std::memory_order_relaxed);
 }
 
-void gFractorDSP::setBypassed(const bool shouldBeBypassed) {
+template<typename SampleType>
+int gFractorDSP<SampleType>::getLatencySamples() const {
+    const int separatorLatency = outputMode.load(std::memory_order_relaxed) == ChannelMode::TonalTransient
+                                     ? 1 << separatorFftOrder.load(std::memory_order_relaxed)
+                                     : 0;
+    const int crossoverLatency = crossoverEnabled.load(std::memory_order_relaxed) ? crossover.getLatencySamples() : 0;
+    const int matchEqLatency = matchEqEnabled.load(std::memory_order_relaxed) ? MatchEqualizer::getLatencySamples() : 0;
+    const int auditionLatency = auditionEngine.load(std::memory_order_relaxed) == AuditionEngine::Spectral
+                                    ? SpectralAudition::getLatencySamples()
+                                    : 0;
+    return separatorLatency + crossoverLatency + matchEqLatency + auditionLatency;
+}
+
+template<typename SampleType>
+int gFractorDSP<SampleType>::getTailSamples() const {
+    // The match EQ filter is minimum phase: its whole length follows the convolver latency.
+    // Every other stage is linear phase or STFT and rings out for as long again as its latency.
+    const bool matchEqOn = matchEqEnabled.load(std::memory_order_relaxed);
+    const int matchEqLatency = matchEqOn ? MatchEqualizer::getLatencySamples() : 0;
+    const int matchEqRingOut = matchEqOn ? static_cast<int>(MatchEqDesigner::kFilterLength) : 0;
+    return 2 * (getLatencySamples() - matchEqLatency) + matchEqLatency + matchEqRingOut;
+}
+
+template<typename SampleType>
+void gFractorDSP<SampleType>::setBypassed(const bool shouldBeBypassed) {
     bypassed.store(shouldBeBypassed, std::memory_order_release);
     // Note: do NOT call reset() here — it would race with an in-flight process() call.
     // Filter state is preserved across bypass; the audio thread stops writing it when bypassed.
 }
 
-void gFractorDSP::setPrimaryEnabled(const bool enabled) {
+template<typename SampleType>
+void gFractorDSP<SampleType>::setPrimaryEnabled(const bool enabled) {
     primaryEnabled.store(enabled, std::memory_order_relaxed);
 }
 
-void gFractorDSP::setSecondaryEnabled(const bool enabled) {
+template<typename SampleType>
+void gFractorDSP<SampleType>::setSecondaryEnabled(const bool enabled) {
     secondaryEnabled.store(enabled, std::memory_order_relaxed);
 }
 
-void gFractorDSP::setOutputMode(const ChannelMode mode) {
-    // Delete any strategy the audio thread signalled for deferred deletion.
-    delete strategyPendingDeletion.exchange(nullptr, std::memory_order_acq_rel);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setOutputMode(const ChannelMode mode) {
+    // Kernels are stateless apart from the units' ChannelModeState, so switching is a single atomic store;
+    // the audio thread starts the crossfade into the new kernel at the start of its next block.
+    outputMode.store(mode, std::memory_order_relaxed);
+}
 
-    outputMode = mode;
-    auto next = ChannelModeStrategyFactory::create(mode);
-    if (isPrepared)
-        next->prepare(currentSpec);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setDryWet(const float proportion) {
+    dryWetMix = juce::jlimit(0.0f, 1.0f, proportion);
+    dryVolume.setTargetValue(1.0f - dryWetMix);
+    wetVolume.setTargetValue(dryWetMix);
+}
 
-    // Post to the audio thread. If a previous pending swap was never picked up, delete it now.
-    delete pendingStrategy.exchange(next.release(), std::memory_order_acq_rel);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setAuditFilter(const bool active, const float frequencyHz, const float q) {
+    filterBank.setAuditFilter(active, frequencyHz, q);
+    spectralAudition.setAuditFilter(active, frequencyHz, q);
 }
 
-void gFractorDSP::setDryWet(const float proportion) {
-    dryWetMix = juce::jlimit(0.0f, 1.0f, proportion);
-    dryWetMixer.setWetMixProportion(dryWetMix);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setBandFilter(const bool active, const float frequencyHz, const float q) {
+    filterBank.setBandFilter(active, frequencyHz, q);
+    spectralAudition.setBandFilter(active, frequencyHz, q);
 }
 
-void gFractorDSP::setAuditFilter(const bool active, const float frequencyHz, const float q) {
-    auditFilter.setParams(active, frequencyHz, q);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setBandSolo(const juce::uint32 bandMask) {
+    filterBank.setBandSolo(bandMask);
+    spectralAudition.setBandSolo(bandMask);
 }
 
-void gFractorDSP::setBandFilter(const bool active, const float frequencyHz, const float q) {
-    bandFilter.setParams(active, frequencyHz, q);
+template<typename SampleType>
+void gFractorDSP<SampleType>::setBandMute(const juce::uint32 bandMask) {
+    filterBank.setBandMute(bandMask);
+    spectralAudition.setBandMute(bandMask);
 }
+
+template class gFractorDSP<float>;
+template class gFractorDSP<double>;
@@ -1,13 +1,25 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
+#include <utility>
+#include <vector>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "../../Utility/ChannelMode.h"
+#include "ChannelPairLayout.h"
+#include "DSPParameters.h"
 #include "../Interfaces/IDSPProcessor.h"
-#include "../Processing/ChannelModeStrategies.h"
-#include "../Processing/BandpassFilter.h"
+#include "../Processing/ChannelModeCrossfade.h"
+#include "../Processing/ChannelModeKernels.h"
+#include "../Processing/FilterBank.h"
+#include "../Processing/MatchEqualizer.h"
+#include "../Processing/MidSidePeakKernel.h"
+#include "../Processing/MultibandCrossover.h"
+#include "../Processing/SpectralAudition.h"
+#include "../Processing/SpectralSeparator.h"
+#include "../Processing/TruePeakMeter.h"
 
 /**
  * Main DSP processor for the gFractor plugin.
@@ -16,31 +28,87 @@
  * This class is called from PluginProcessor::processBlock() on the audio thread.
  * All memory allocations happen in prepare(), not in process().
  *
+ * SampleType is the host's processing precision. gFractorDSP<float> is the 32-bit engine;
+ * gFractorDSP<double> processes 64-bit buffers in place, with the gain, dry/wet, bandpass
+ * and channel-mode stages in double. The spectral separator, the band solo bank and the
+ * meters keep float internals and read double blocks one sample at a time.
+ * Both are instantiated in gFractorDSP.cpp.
+ *
  * Implements IDSPProcessor interface for dependency inversion and testability.
  */
-class gFractorDSP : public IDSPProcessor {
+template<typename SampleType>
+class gFractorDSP : public IDSPProcessor<SampleType> {
 public:
+    /**
+     * How process() walks the buffer.
+     *  - Staged: one full pass per stage (input gain with dry/wet, filter bank, channel mode).
+     *  - Fused:  every active stage runs per sample frame in a single pass. Stereo blocks only;
+     *            other channel layouts always fall back to Staged.
+     */
+    enum class ExecutionMode { Staged, Fused };
+
     gFractorDSP() = default;
-    ~gFractorDSP() override;
+    ~gFractorDSP() override = default;
 
     //==============================================================================
     // IDSPProcessor implementation
     void prepare(const juce::dsp::ProcessSpec &spec) override;
 
-    void process(juce::AudioBuffer<float> &buffer) override;
+    void process(juce::AudioBuffer<SampleType> &buffer) override;
 
     void reset() override;
 
+    /**
+     * Process one block with sample-accurate parameter changes (audio thread).
+     * The block is split at every timeline point and the point's values are applied
+     * through setParameters() before the samples that follow it.
+     */
+    void process(juce::AudioBuffer<SampleType> &buffer, const ParameterTimeline &timeline);
+
+    /**
+     * Stand-in for process() while the input is asleep (audio thread): digital silence for at
+     * least getTailSamples(), so the chain has flushed and would output the same zeros. Applies
+     * parameters and leaves the block as it is. The next process() resets the chain, so nothing
+     * from before the sleep comes out after it, and starts with the smoothers settled as
+     * running would have left them. Tonal/Transient fades back in over its first frame, as
+     * after any reset.
+     */
+    void processSilence(juce::AudioBuffer<SampleType> &buffer, const DSPParameters &parameters);
+
+    /**
+     * Apply a parameter snapshot (audio thread). Only the fields that differ from the last
+     * applied snapshot are forwarded to the setters below, so an unchanged snapshot costs
+     * one comparison.
+     */
+    void setParameters(const DSPParameters &parameters);
+
+    /**
+     * Call before prepare(). How the main bus splits into channel pairs and singles for the
+     * channel-mode stage (see ChannelPairLayout); each unit gets its own mode state,
+     * separator and crossfade. Channels after the layout (a sidechain) skip that stage.
+     * Without a layout, or one wider than spec.numChannels, only channels 0 and 1 are used.
+     */
+    void setChannelLayout(const ChannelPairLayout &layout) { requestedLayout = layout; }
+
+    /** Channel-mode units built by the last prepare(). */
+    size_t getNumChannelUnits() const { return channelUnits.size(); }
+
+    /** Any thread. The audio thread crossfades into the new mode over
+     *  ChannelModeCrossfade::kCrossfadeSeconds; after prepare() or reset() it switches at once.
+     *  Into Tonal/Transient, the fade waits until the separators have been primed on the input. */
     void setOutputMode(ChannelMode mode) override;
 
     //==============================================================================
     // IPeakLevelSource implementation
     float getPeakPrimaryDb() const override { return peakPrimaryDb.load(std::memory_order_relaxed); }
     float getPeakSecondaryDb() const override { return peakSecondaryDb.load(std::memory_order_relaxed); }
+    float getTruePeakPrimaryDb() const override { return truePeakPrimaryDb.load(std::memory_order_relaxed); }
+    float getTruePeakSecondaryDb() const override { return truePeakSecondaryDb.load(std::memory_order_relaxed); }
 
     //==============================================================================
-    /** Parameter updates (called from PluginProcessor on message thread)
-     *  These use SmoothedValue internally, so they're thread-safe.
+    /** Individual parameter updates. PluginProcessor drives them from the audio thread
+     *  through setParameters(); calling them from another thread while process() runs races
+     *  with the smoother and mixer state they retarget.
      */
     void setGain(float gainDB) override;
 
@@ -50,9 +118,30 @@ public:
 
     void setSecondaryEnabled(bool enabled) override;
 
-    /** Set transient length (fast envelope time constant in ms). Recomputes fastEnvAlpha. */
+    /** Set transient length in ms: the Tonal/Transient separator's frequency median span. */
     void setTransientLength(float ms) override;
 
+    /**
+     * Any thread. FFT size (2^order) of the Tonal/Transient separator, clamped to
+     * [SpectralSeparator::kMinFftOrder, kMaxFftOrder]; larger orders resolve low tones better
+     * at the cost of latency. Applied on the next block, which restarts the separator.
+     */
+    void setSeparatorFftOrder(int order);
+    int getSeparatorFftOrder() const { return separatorFftOrder.load(std::memory_order_relaxed); }
+
+    /**
+     * Any thread. Processing latency: the separator's in Tonal/Transient plus the crossover's and
+     * the match EQ's when they are on, and the spectral audition's while it is the audition engine.
+     */
+    int getLatencySamples() const;
+
+    /**
+     * Any thread. How long silent input takes to leave silent output: each block-based stage's
+     * latency plus its ring-out (the other half of a linear-phase FIR, the last STFT frame, the
+     * match EQ's minimum-phase filter).
+     */
+    int getTailSamples() const;
+
     /** Set dry/wet mix proportion (0.0 = fully dry, 1.0 = fully wet). */
     void setDryWet(float proportion) override;
 
@@ -62,60 +151,225 @@ public:
     /** Band selection filter for isolating frequency bands (UI thread sets, audio thread reads) */
     void setBandFilter(bool active, float frequencyHz, float q);
 
+    /** Solo any subset of the analyzer bands (bit i = kBands[i]; 0 = no solo) */
+    void setBandSolo(juce::uint32 bandMask);
+
+    /** Mute any subset of the analyzer bands (bit i = kBands[i]; 0 = no mute) */
+    void setBandMute(juce::uint32 bandMask);
+
+    /**
+     * Any thread. Engine for the three controls above: the IIR FilterBank (default, no latency)
+     * or the STFT band mask of SpectralAudition (brickwall regions, adds its latency). Both
+     * receive every setting, so switching keeps the current selection.
+     */
+    void setAuditionEngine(const AuditionEngine engine) { auditionEngine.store(engine, std::memory_order_relaxed); }
+    AuditionEngine getAuditionEngine() const { return auditionEngine.load(std::memory_order_relaxed); }
+
+    /** Message thread. Raised-cosine edge width of the spectral audition regions (0 = brickwall). */
+    void setSpectralAuditionEdge(const float octaves) { spectralAudition.setEdgeOctaves(octaves); }
+    float getSpectralAuditionEdge() const { return spectralAudition.getEdgeOctaves(); }
+
+    /**
+     * Linear-phase M/S crossover after the channel-mode stage, on every pair of the layout
+     * (see MultibandCrossover). Off by default; turning it on adds its latency and restarts it
+     * from silence. Frequencies and bands: message thread only.
+     */
+    void setCrossoverEnabled(const bool enabled) { crossoverEnabled.store(enabled, std::memory_order_relaxed); }
+    bool isCrossoverEnabled() const { return crossoverEnabled.load(std::memory_order_relaxed); }
+
+    void setCrossoverFrequencies(const std::vector<float> &frequencies) { crossover.setFrequencies(frequencies); }
+    const std::vector<float> &getCrossoverFrequencies() const { return crossover.getFrequencies(); }
+
+    void setCrossoverBand(const int band, const MultibandCrossover::BandSettings &settings) {
+        crossover.setBand(band, settings);
+    }
+
+    MultibandCrossover::BandSettings getCrossoverBand(const int band) const { return crossover.getBand(band); }
+
+    /**
+     * Match EQ towards a target curve after the crossover, on every channel of the layout (see
+     * MatchEqualizer). Off by default; turning it on adds its latency, restarts its convolution
+     * from silence and runs its designer thread. Message thread only.
+     */
+    void setMatchEqEnabled(const bool enabled) {
+        matchEqEnabled.store(enabled, std::memory_order_relaxed);
+        matchEq.setActive(enabled);
+    }
+
+    bool isMatchEqEnabled() const { return matchEqEnabled.load(std::memory_order_relaxed); }
+
+    void setMatchEqTarget(const MatchEqualizer::Target &target) { matchEq.setTarget(target); }
+    void clearMatchEqTarget() { matchEq.clearTarget(); }
+    bool hasMatchEqTarget() const { return matchEq.hasTarget(); }
+
+    void setMatchEqAmount(const float amount) { matchEq.setAmount(amount); }
+    float getMatchEqAmount() const { return matchEq.getAmount(); }
+
+    /** Select the staged or fused pipeline (default Fused). Both share the gain and dry/wet ramps. */
+    void setExecutionMode(const ExecutionMode mode) { executionMode.store(mode, std::memory_order_relaxed); }
+    ExecutionMode getExecutionMode() const { return executionMode.load(std::memory_order_relaxed); }
+
     /** Peak level metering (realtime-safe, atomic reads) */
     void resetPeaks() {
         peakPrimaryDb.store(-100.0f, std::memory_order_relaxed);
         peakSecondaryDb.store(-100.0f, std::memory_order_relaxed);
     }
 
+    /**
+     * True-peak mode: meter the input with the BS.1770 4x oversampled meter as well, on the
+     * pair the output mode decodes (L/R in L/R mode, mid/side otherwise). Off by default.
+     * Held values are exposed through getTruePeakPrimaryDb() / getTruePeakSecondaryDb().
+     */
+    void setTruePeakEnabled(const bool enabled) { truePeakEnabled.store(enabled, std::memory_order_relaxed); }
+    bool isTruePeakEnabled() const { return truePeakEnabled.load(std::memory_order_relaxed); }
+
+    /** Clear the held true peaks (any thread; the audio thread restarts the hold on its next block). */
+    void resetTruePeaks() {
+        truePeakResetPending.store(true, std::memory_order_relaxed);
+        truePeakPrimaryDb.store(-100.0f, std::memory_order_relaxed);
+        truePeakSecondaryDb.store(-100.0f, std::memory_order_relaxed);
+    }
+
 private:
+    //==============================================================================
+    // Pipelines (audio thread only)
+    using Block = juce::dsp::AudioBlock<SampleType>;
+
+    void updatePeaks(const Block &block);
+
+    void updateTruePeaks(const Block &block, const MidSidePeakKernel::Peaks &midSidePeaks);
+
+    void processUnbypassed(Block &block);
+
+    void processStaged(Block &block, unsigned channelKernel);
+
+    void processFused(Block &block, unsigned channelKernel);
+
+    /** Channel-mode stage per unit, after the pipeline (crossfades, Tonal/Transient, multichannel). */
+    void processChannelUnits(Block &block, unsigned channelKernel, bool crossfading, bool priming);
+
+    /** Crossover stage over every unit that fits the block. */
+    void processCrossover(Block &block);
+
+    /** Match EQ stage over every layout channel the block covers. */
+    void processMatchEq(Block &block);
+
+    bool isCrossfading() const { return !channelUnits.empty() && channelUnits.front()->crossfade.isActive(); }
+
+    /**
+     * Gain and dry/wet act on the same input, so they reduce to one gain per sample:
+     * gain * wet + dry. How the next numSamples apply it:
+     *  - Identity: 1 throughout (0 dB and settled, or fully dry); nothing to do.
+     *  - Constant: settled at constantInputGain.
+     *  - Ramp:     per-sample values in inputGains (numSamples must fit it).
+     * Advances the smoothers by numSamples.
+     */
+    enum class InputGain { Identity, Constant, Ramp };
+
+    InputGain prepareInputGain(size_t numSamples);
+
+    /** Staged input stage: one multiply per channel, by constantInputGain or the inputGains ramp. */
+    void applyInputGain(Block &block);
+
+    using FusedKernel = void (gFractorDSP::*)(SampleType *, SampleType *, size_t);
+    static constexpr size_t kNumFusedVariants = 128; // 3 stage flags x 4-bit channel-mode kernel index
+    static constexpr size_t kFusedChunkSize = 64;     // frames per chunk when the filter bank is active
+
+    template<size_t Variant>
+    void processFusedVariant(SampleType *left, SampleType *right, size_t numSamples);
+
+    template<size_t... Variants>
+    static constexpr std::array<FusedKernel, sizeof...(Variants)> makeFusedKernelTable(std::index_sequence<Variants...>);
+
     //==============================================================================
     // Processing state
     juce::dsp::ProcessSpec currentSpec{};
     bool isPrepared = false;
+    bool restartPending = false; // processSilence() cleared a block; reset() before the next one
     std::atomic<bool> bypassed{false};
     std::atomic<bool> primaryEnabled{true};
     std::atomic<bool> secondaryEnabled{true};
-    ChannelMode outputMode = ChannelMode::MidSide;
-    std::unique_ptr<IChannelModeStrategy> channelModeStrategy; // audio thread only
-    // Lock-free handoff: message thread posts new strategy; audio thread picks it up.
-    std::atomic<IChannelModeStrategy*> pendingStrategy{nullptr};
-    // Deferred deletion: audio thread posts the replaced strategy; message thread deletes it.
-    std::atomic<IChannelModeStrategy*> strategyPendingDeletion{nullptr};
-
-    // Smoothed gains for click-free enable/disable transitions (audio thread only)
-    juce::SmoothedValue<float> primaryGain;
-    juce::SmoothedValue<float> secondaryGain;
-
-    // Tonal/Transient audio separation state (moved to strategy)
-    float fastEnvState = 0.0f;
-    float slowEnvState = 0.0f;
-    float fastEnvAlpha = 0.02f;
-    float slowEnvAlpha = 3e-4f;
+    std::atomic<ExecutionMode> executionMode{ExecutionMode::Fused};
+    // Message thread writes, audio thread reads once per block to pick the channel-mode kernel.
+    std::atomic<ChannelMode> outputMode{ChannelMode::MidSide};
 
-    //==============================================================================
-    // DSP components (pre-allocated in prepare(), reused in process())
-    juce::dsp::Gain<float> gainProcessor;
-    juce::dsp::DryWetMixer<float> dryWetMixer;
+    // Last snapshot forwarded by setParameters(); cleared by prepare() so the first block after
+    // it re-applies everything (the separator's transient span depends on the sample rate).
+    DSPParameters appliedParameters;
+    bool hasAppliedParameters = false;
+
+    // One channel-mode unit per pair or single of the layout (audio thread only). A unit owns
+    // its Tonal/Transient gain smoothers and separator and its output-mode crossfade; all
+    // units follow the same kernel, so unit 0 stands for the others when asking about a fade.
+    struct ChannelUnit {
+        ChannelPairLayout::Unit channels;
+        ChannelModeState state;
+        SpectralSeparator separator;
+        ChannelModeCrossfade<SampleType> crossfade;
+    };
 
+    ChannelPairLayout requestedLayout;
+    std::vector<std::unique_ptr<ChannelUnit>> channelUnits;
+    std::vector<SampleType> singleScratch; // partner channel for singles, maximumBlockSize frames
+
+    // Message thread writes, audio thread forwards it to the separators when it changes
+    std::atomic<int> separatorFftOrder{SpectralSeparator::kDefaultFftOrder};
+    int appliedSeparatorFftOrder = 0;
+
+    // Output mode the audio thread is rendering and the kernel its last block used. A new
+    // outputMode is adopted only between crossfades, so a switch during a fade waits for it.
+    ChannelMode renderedMode = ChannelMode::MidSide;
+    unsigned renderedKernel = ChannelModeKernels::kIdentity;
+    bool hasRenderedMode = false;
+    bool primingSeparators = false; // entering Tonal/Transient: separators fed in the background
+
+    // Linear-phase crossover over the same units; the audio thread restarts it when it comes on
+    MultibandCrossover crossover;
+    std::atomic<bool> crossoverEnabled{false};
+    bool crossoverRunning = false;
+    std::vector<SampleType *> crossoverLefts, crossoverRights; // one per unit, filled per block
+
+    // Match EQ over the layout's channels, restarted like the crossover when it comes on
+    MatchEqualizer matchEq;
+    std::atomic<bool> matchEqEnabled{false};
+    bool matchEqRunning = false;
+    std::vector<SampleType *> matchEqChannels; // layout channel order, filled per block
+
+    //==============================================================================
     // Smoothed parameter values (prevents zipper noise)
     juce::SmoothedValue<float> gainSmoothed;
     float dryWetMix = 1.0f; // 0.0 = dry, 1.0 = wet
 
-    // SIMD work buffer for peak metering (8 floats = 2 SIMD vectors)
-    std::array<float, 8> simdWorkBuffer{};
+    // Dry/wet volumes: linear mixing rule with 50 ms linear ramps
+    juce::SmoothedValue<float> dryVolume;
+    juce::SmoothedValue<float> wetVolume;
+
+    // Effective input gain for the current block (see prepareInputGain(); audio thread only)
+    std::vector<SampleType> inputGains; // maximumBlockSize frames
+    SampleType constantInputGain = SampleType(1);
 
     //==============================================================================
-    // Transient audition bell filter — 4th order (two cascaded 2nd-order BPFs)
-    BandpassFilter auditFilter;
+    // Audition, band selection and band solo/mute filters
+    FilterBank<SampleType> filterBank;
 
-    // Band selection filter — 4th order (two cascaded 2nd-order BPFs)
-    BandpassFilter bandFilter;
+    // The same controls as an STFT mask; replaces the filter bank after the pipeline when selected
+    SpectralAudition spectralAudition;
+    std::atomic<AuditionEngine> auditionEngine{AuditionEngine::Filter};
+    bool spectralAuditionRunning = false;
 
     // Peak level metering (written on audio thread, read on UI thread)
     std::atomic<float> peakPrimaryDb{-100.0f};
     std::atomic<float> peakSecondaryDb{-100.0f};
 
+    // True-peak metering: the meter itself is audio-thread only, the held values are published
+    // through the atomics. truePeakMetering tracks the mode the audio thread last ran in.
+    TruePeakMeter truePeakMeter;
+    std::atomic<bool> truePeakEnabled{false};
+    std::atomic<bool> truePeakResetPending{false};
+    bool truePeakMetering = false;
+    std::atomic<float> truePeakPrimaryDb{-100.0f};
+    std::atomic<float> truePeakSecondaryDb{-100.0f};
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(gFractorDSP)
 };
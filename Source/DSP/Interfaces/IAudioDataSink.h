@@ -1,11 +1,27 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../Processing/CaptureBus.h"
+
+/** Channel representation a sink's capture bus carries (left/right sides of the bus). */
+enum class SinkFormat {
+    LeftRight, // L, R
+    MidSide, // (L + R) / 2, (L - R) / 2
+    Mono // (L + R) / 2 on both sides
+};
+
+inline constexpr int kNumSinkFormats = 3;
 
 struct IAudioDataSink {
     virtual ~IAudioDataSink() = default;
 
-    virtual void pushStereoData(const juce::AudioBuffer<float> &buffer) = 0;
+    /** Message thread, once at registration. The registry produces each format once per block
+     *  for all the sinks that subscribe to it. */
+    virtual SinkFormat getSinkFormat() const { return SinkFormat::LeftRight; }
+
+    /** Message thread. The bus the analysed input is written to, in getSinkFormat() (nullptr once
+     *  unregistered); read it through a CaptureBus::Reader. It stays valid until the next call. */
+    virtual void setCaptureBus(const CaptureBus *bus) = 0;
 
     virtual void setSampleRate(double sr) = 0;
 };
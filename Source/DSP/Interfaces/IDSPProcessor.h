@@ -4,13 +4,14 @@
 #include "IPeakLevelSource.h"
 #include "../../Utility/ChannelMode.h"
 
+template<typename SampleType>
 class IDSPProcessor : public IPeakLevelSource {
 public:
     ~IDSPProcessor() override = default;
 
     virtual void prepare(const juce::dsp::ProcessSpec &spec) = 0;
 
-    virtual void process(juce::AudioBuffer<float> &buffer) = 0;
+    virtual void process(juce::AudioBuffer<SampleType> &buffer) = 0;
 
     virtual void reset() = 0;
 
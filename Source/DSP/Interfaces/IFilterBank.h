@@ -2,17 +2,24 @@
 #include <juce_audio_basics/buffers/juce_AudioSampleBuffer.h>
 #include <juce_dsp/processors/juce_ProcessContext.h>
 
+template<typename SampleType>
 class IFilterBank {
 public:
     virtual ~IFilterBank() = default;
 
     virtual void prepare(const juce::dsp::ProcessSpec &spec) = 0;
 
-    virtual void process(juce::AudioBuffer<float> &buffer) = 0;
+    virtual void process(juce::AudioBuffer<SampleType> &buffer) = 0;
 
     virtual void reset() = 0;
 
     virtual void setAuditFilter(bool active, float frequencyHz, float q) = 0;
 
     virtual void setBandFilter(bool active, float frequencyHz, float q) = 0;
+
+    /** Bit i solos kBands[i] (see BandConstants.h); 0 clears the solo. */
+    virtual void setBandSolo(juce::uint32 bandMask) = 0;
+
+    /** Bit i mutes kBands[i]; a muted band also drops out of an active solo. */
+    virtual void setBandMute(juce::uint32 bandMask) = 0;
 };
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../Processing/CaptureBus.h"
 
 struct IGhostDataSink {
     virtual ~IGhostDataSink() = default;
 
-    virtual void pushGhostData(const juce::AudioBuffer<float> &buffer) = 0;
+    /** Message thread. The bus the ghost (comparison) signal is written to, nullptr when detached. */
+    virtual void setGhostCaptureBus(const CaptureBus *bus) = 0;
 };
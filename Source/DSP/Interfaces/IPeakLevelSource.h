@@ -6,4 +6,10 @@ struct IPeakLevelSource {
     [[nodiscard]] virtual float getPeakPrimaryDb() const = 0;
 
     [[nodiscard]] virtual float getPeakSecondaryDb() const = 0;
+
+    /** Held BS.1770 true peak (dBTP) of the primary channel; -100 while true-peak metering is off. */
+    [[nodiscard]] virtual float getTruePeakPrimaryDb() const = 0;
+
+    /** Held BS.1770 true peak (dBTP) of the secondary channel; -100 while true-peak metering is off. */
+    [[nodiscard]] virtual float getTruePeakSecondaryDb() const = 0;
 };
@@ -14,3 +14,17 @@ void PerformanceMonitor::recordBlock(double elapsedMs, double sampleRate, int bl
 
     ++metrics.sampleCount;
 }
+
+//==============================================================================
+void PerformanceMonitor::FifoMetrics::recordRead(const int numWaiting, const std::uint64_t numOverwritten) noexcept {
+    // Readers may run on several threads; only a larger value replaces the mark
+    int mark = highWaterMark.load(std::memory_order_relaxed);
+    while (numWaiting > mark
+           && !highWaterMark.compare_exchange_weak(mark, numWaiting, std::memory_order_relaxed)) {
+    }
+
+    if (numOverwritten > 0) {
+        droppedSamples.fetch_add(numOverwritten, std::memory_order_relaxed);
+        overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
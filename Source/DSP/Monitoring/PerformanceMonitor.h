@@ -1,26 +1,64 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 class PerformanceMonitor {
 public:
+    /** One main capture bus per SinkFormat (left/right, mid/side, mono). */
+    static constexpr int kNumMainFifos = 3;
+
+    /**
+     * Telemetry for one audio-to-UI FIFO (a CaptureBus and its readers). Relaxed counters:
+     * readers record what they find, the display only reads. Only frames the writer overwrote
+     * before a reader got to them count as lost; frames a reader chose to skip (its newest-window
+     * limit, say) do not.
+     */
+    struct FifoMetrics {
+        std::atomic<std::uint64_t> droppedSamples{0}; // frames overwritten before they were read, summed over readers
+        std::atomic<int> overruns{0}; // reads that lost frames to the writer
+        std::atomic<int> highWaterMark{0}; // most frames one read found waiting
+        std::atomic<int> capacity{0};
+
+        /** A read found numWaiting frames, numOverwritten of which the writer had overwritten. */
+        void recordRead(int numWaiting, std::uint64_t numOverwritten) noexcept;
+
+        void reset() {
+            droppedSamples.store(0, std::memory_order_relaxed);
+            overruns.store(0, std::memory_order_relaxed);
+            highWaterMark.store(0, std::memory_order_relaxed);
+        }
+    };
+
     struct Metrics {
         std::atomic<double> averageProcessTimeMs{0.0};
         std::atomic<double> maxProcessTimeMs{0.0};
         std::atomic<double> averageCpuLoad{0.0};
         std::atomic<int> sampleCount{0};
 
+        std::array<FifoMetrics, kNumMainFifos> mainFifos;
+        FifoMetrics ghostFifo;
+
         void reset() {
             averageProcessTimeMs = 0.0;
             maxProcessTimeMs = 0.0;
             averageCpuLoad = 0.0;
             sampleCount = 0;
+            for (auto &fifo: mainFifos)
+                fifo.reset();
+            ghostFifo.reset();
         }
     };
 
     const Metrics &getMetrics() const { return metrics; }
     void reset() { metrics.reset(); }
 
+    /** Where the capture buses report (see CaptureBus::setMetrics). */
+    FifoMetrics &getMainFifoMetrics(const int bus) { return metrics.mainFifos[static_cast<std::size_t>(bus)]; }
+    FifoMetrics &getGhostFifoMetrics() { return metrics.ghostFifo; }
+
     void recordBlock(double elapsedMs, double sampleRate, int blockSize);
 
 private:
@@ -1,58 +1,181 @@
 #include "SinkRegistry.h"
 
-SinkRegistry::SinkRegistry() {
-    audioDataSinks.reserve(8);
+#include <algorithm>
+
+//==============================================================================
+SinkRegistry::SinkRegistry()
+    : formatBuffer(2, 512) { // resized to the host block in prepareAnalyzerSource()
+}
+
+SinkRegistry::~SinkRegistry() = default;
+
+void SinkRegistry::updateSubscribedFormats() noexcept {
+    unsigned formats = 0;
+    for (const auto &subscription: audioDataSinks)
+        formats |= formatBit(subscription.format);
+
+    subscribedFormats.store(formats, std::memory_order_relaxed);
 }
 
 void SinkRegistry::registerAudioDataSink(IAudioDataSink *sink) {
-    if (sink != nullptr) {
-        const juce::SpinLock::ScopedLockType lock(sinkLock);
-        audioDataSinks.push_back(sink);
-    }
+    if (sink == nullptr)
+        return;
+
+    const juce::ScopedLock lock(sinkLock);
+    const auto format = sink->getSinkFormat();
+    audioDataSinks.push_back({sink, format});
+
+    // The format is produced from the next block on; the sink reads from there
+    updateSubscribedFormats();
+    sink->setCaptureBus(&mainBuses[static_cast<size_t>(format)]);
 }
 
 void SinkRegistry::unregisterAudioDataSink(IAudioDataSink *sink) {
-    const juce::SpinLock::ScopedLockType lock(sinkLock);
-    audioDataSinks.erase(
-        std::remove(audioDataSinks.begin(), audioDataSinks.end(), sink),
-        audioDataSinks.end());
+    const juce::ScopedLock lock(sinkLock);
+    const auto isSink = [sink](const Subscription &subscription) { return subscription.sink == sink; };
+    const bool wasRegistered = std::any_of(audioDataSinks.begin(), audioDataSinks.end(), isSink);
+    audioDataSinks.erase(std::remove_if(audioDataSinks.begin(), audioDataSinks.end(), isSink),
+                         audioDataSinks.end());
+    updateSubscribedFormats();
+
+    if (wasRegistered)
+        sink->setCaptureBus(nullptr);
 }
 
 void SinkRegistry::setGhostDataSink(IGhostDataSink *sink) {
-    const juce::SpinLock::ScopedLockType lock(sinkLock);
-    ghostDataSink.store(sink);
+    const juce::ScopedLock lock(sinkLock);
+    auto *previous = ghostDataSink;
+    if (previous == sink)
+        return;
+
+    ghostDataSink = sink;
+
+    if (previous != nullptr)
+        previous->setGhostCaptureBus(nullptr);
+    if (sink != nullptr)
+        sink->setGhostCaptureBus(&ghostBus);
 }
 
 IGhostDataSink *SinkRegistry::getGhostDataSink() const {
-    return ghostDataSink.load();
+    const juce::ScopedLock lock(sinkLock);
+    return ghostDataSink;
 }
 
 void SinkRegistry::prepareSinks(double sampleRate) const {
-    const juce::SpinLock::ScopedLockType lock(sinkLock);
-    for (auto *sink: audioDataSinks)
-        sink->setSampleRate(sampleRate);
+    const juce::ScopedLock lock(sinkLock);
+    for (const auto &subscription: audioDataSinks)
+        subscription.sink->setSampleRate(sampleRate);
+}
+
+void SinkRegistry::prepareAnalyzerSource(const juce::AudioChannelSet &mainBus, const int maximumBlockSize) {
+    foldDownWeights.clear();
+    formatBuffer.setSize(2, juce::jmax(1, maximumBlockSize));
+
+    if (mainBus.size() <= 2)
+        return;
+
+    for (size_t i = 0; i < kNumAnalyzerSources; ++i)
+        sourceChannels[i] = ChannelPairLayout::findSource(mainBus, static_cast<AnalyzerSource>(i));
+
+    foldDownWeights = ChannelPairLayout::getFoldDownWeights(mainBus);
+    foldDownBuffer.setSize(2, juce::jmax(1, maximumBlockSize));
+}
+
+const juce::AudioBuffer<float> &SinkRegistry::selectAnalyzerChannels(const juce::AudioBuffer<float> &buffer) noexcept {
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    // Stereo buses, and blocks that do not match the prepared bus, go through as they are
+    if (numChannels <= 2 || static_cast<size_t>(numChannels) != foldDownWeights.size()
+        || numSamples > foldDownBuffer.getNumSamples())
+        return buffer;
+
+    const auto source = analyzerSource.load(std::memory_order_relaxed);
+
+    if (source != AnalyzerSource::FoldDown) {
+        const auto [left, right] = sourceChannels[static_cast<size_t>(analyzerSourceToInt(source))];
+
+        if (left >= 0 && right >= 0) {
+            // The sinks only read; referring to the pair avoids a copy
+            float *const pair[] = {const_cast<float *>(buffer.getReadPointer(left)),
+                                   const_cast<float *>(buffer.getReadPointer(right))};
+            analyzerView.setDataToReferTo(pair, 2, numSamples);
+            return analyzerView;
+        }
+    }
+
+    float *foldLeft = foldDownBuffer.getWritePointer(0);
+    float *foldRight = foldDownBuffer.getWritePointer(1);
+    juce::FloatVectorOperations::clear(foldLeft, numSamples);
+    juce::FloatVectorOperations::clear(foldRight, numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const auto [toLeft, toRight] = foldDownWeights[static_cast<size_t>(ch)];
+        const float *input = buffer.getReadPointer(ch);
+
+        if (toLeft != 0.0f)
+            juce::FloatVectorOperations::addWithMultiply(foldLeft, input, toLeft, numSamples);
+        if (toRight != 0.0f)
+            juce::FloatVectorOperations::addWithMultiply(foldRight, input, toRight, numSamples);
+    }
+
+    analyzerView.setDataToReferTo(foldDownBuffer.getArrayOfWritePointers(), 2, numSamples);
+    return analyzerView;
 }
 
 void SinkRegistry::pushAudioData(const juce::AudioBuffer<float> &buffer,
                                  bool hasSidechain,
-                                 bool isReferenceMode) const {
+                                 bool isReferenceMode) {
     juce::ignoreUnused(hasSidechain, isReferenceMode);
 
-    const juce::SpinLock::ScopedLockType lock(sinkLock);
-    for (auto *sink: audioDataSinks)
-        sink->pushStereoData(buffer);
+    // Once per subscribed format, whatever the number of sinks: each reads its bus through its own cursor
+    const unsigned formats = subscribedFormats.load(std::memory_order_relaxed);
+    const auto &pair = selectAnalyzerChannels(buffer);
+
+    if ((formats & formatBit(SinkFormat::LeftRight)) != 0)
+        mainBuses[static_cast<size_t>(SinkFormat::LeftRight)].write(pair);
+
+    if ((formats & (formatBit(SinkFormat::MidSide) | formatBit(SinkFormat::Mono))) != 0)
+        writeDerivedFormats(pair, formats);
+}
+
+void SinkRegistry::writeDerivedFormats(const juce::AudioBuffer<float> &pair, const unsigned formats) noexcept {
+    using FVO = juce::FloatVectorOperations;
+    if (pair.getNumChannels() == 0)
+        return;
+
+    const float *left = pair.getReadPointer(0);
+    const float *right = pair.getNumChannels() >= 2 ? pair.getReadPointer(1) : left;
+    float *mid = formatBuffer.getWritePointer(0);
+    float *side = formatBuffer.getWritePointer(1);
+    const int chunk = formatBuffer.getNumSamples();
+    const bool midSide = (formats & formatBit(SinkFormat::MidSide)) != 0;
+    const bool mono = (formats & formatBit(SinkFormat::Mono)) != 0;
+
+    for (int done = 0; done < pair.getNumSamples(); done += chunk) {
+        const int len = juce::jmin(chunk, pair.getNumSamples() - done);
+        FVO::add(mid, left + done, right + done, len);
+        FVO::multiply(mid, 0.5f, len);
+
+        if (midSide) {
+            FVO::subtract(side, left + done, right + done, len);
+            FVO::multiply(side, 0.5f, len);
+            mainBuses[static_cast<size_t>(SinkFormat::MidSide)].write(mid, side, len);
+        }
+        if (mono)
+            mainBuses[static_cast<size_t>(SinkFormat::Mono)].write(mid, mid, len);
+    }
+}
+
+void SinkRegistry::pushSilence() noexcept {
+    for (auto &bus: mainBuses)
+        bus.markSilent();
 }
 
 void SinkRegistry::pushGhostData(const juce::AudioBuffer<float> &mainInput,
                                  const juce::AudioBuffer<float> &sidechain,
                                  bool hasSidechain,
-                                 bool isReferenceMode) const {
-    const juce::SpinLock::ScopedLockType lock(sinkLock);
-
-    if (auto *ghost = ghostDataSink.load(); ghost != nullptr && hasSidechain) {
-        if (isReferenceMode)
-            ghost->pushGhostData(mainInput);
-        else
-            ghost->pushGhostData(sidechain);
-    }
+                                 bool isReferenceMode) noexcept {
+    if (hasSidechain)
+        ghostBus.write(isReferenceMode ? mainInput : sidechain);
 }
@@ -2,13 +2,40 @@
 
 #include "../Interfaces/IAudioDataSink.h"
 #include "../Interfaces/IGhostDataSink.h"
+#include "../Core/ChannelPairLayout.h"
+#include "../Processing/CaptureBus.h"
+#include "PerformanceMonitor.h"
 #include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
 #include <vector>
 
+/**
+ * SinkRegistry
+ *
+ * Hands the analysed audio to the registered sinks. The audio thread writes each block once,
+ * to one CaptureBus for the main feed and one for the ghost feed; every sink reads its bus
+ * through its own cursor, so the audio thread's cost does not grow with the number of sinks.
+ * Registering attaches a sink to the bus, unregistering detaches it.
+ *
+ * The main feed has one bus per SinkFormat. Each sink subscribes to one at registration, and
+ * only the formats someone subscribes to are produced: once per block, with vector kernels,
+ * shared by all their subscribers (no per-sink, per-sample mid/side decode on the UI side).
+ *
+ * The audio thread never touches the sink list, only the atomic set of subscribed formats, so
+ * the list is plain data under sinkLock: register/unregister/setGhostDataSink on the message
+ * thread and prepareSinks() (which a host may call off the message thread) take it. When an
+ * unregister returns, nothing in the registry can still reach the removed sink, so its owner
+ * may destroy it.
+ */
 class SinkRegistry {
 public:
+    static constexpr int kCaptureBusCapacity = 1 << 16; // frames per bus (~0.34 s at 192 kHz)
+
     SinkRegistry();
 
+    ~SinkRegistry();
+
     void registerAudioDataSink(IAudioDataSink *sink);
 
     void unregisterAudioDataSink(IAudioDataSink *sink);
@@ -19,17 +46,81 @@ public:
 
     void prepareSinks(double sampleRate) const;
 
+    /**
+     * Called from prepareToPlay. Sinks take a stereo pair; on a wider main bus this works out
+     * which channels each AnalyzerSource reads and sizes the fold-down buffer, so pushAudioData()
+     * never allocates.
+     */
+    void prepareAnalyzerSource(const juce::AudioChannelSet &mainBus, int maximumBlockSize);
+
+    /** Any thread. Ignored on stereo buses; falls back to the fold-down where the bus lacks the pair. */
+    void setAnalyzerSource(AnalyzerSource source) { analyzerSource.store(source, std::memory_order_relaxed); }
+    AnalyzerSource getAnalyzerSource() const { return analyzerSource.load(std::memory_order_relaxed); }
+
+    /** Audio thread. Write the block (its analyzer pair) to the main capture bus of each subscribed format. */
     void pushAudioData(const juce::AudioBuffer<float> &buffer,
                        bool hasSidechain,
-                       bool isReferenceMode) const;
+                       bool isReferenceMode);
+
+    /** Audio thread. Mark the main buses silent (once per silent stretch, instead of sample data). */
+    void pushSilence() noexcept;
 
+    /** Audio thread. Write the comparison signal to the ghost bus (only while a sidechain is present). */
     void pushGhostData(const juce::AudioBuffer<float> &mainInput,
                        const juce::AudioBuffer<float> &sidechain,
                        bool hasSidechain,
-                       bool isReferenceMode) const;
+                       bool isReferenceMode) noexcept;
+
+    const CaptureBus &getCaptureBus(const SinkFormat format = SinkFormat::LeftRight) const noexcept {
+        return mainBuses[static_cast<size_t>(format)];
+    }
+
+    const CaptureBus &getGhostCaptureBus() const noexcept { return ghostBus; }
+
+    /** Before any sink registers. Each bus reports overruns and fill levels to its own block of monitor. */
+    void setFifoMetrics(PerformanceMonitor &monitor) noexcept {
+        for (int format = 0; format < kNumSinkFormats; ++format)
+            mainBuses[static_cast<size_t>(format)].setMetrics(&monitor.getMainFifoMetrics(format));
+        ghostBus.setMetrics(&monitor.getGhostFifoMetrics());
+    }
 
 private:
-    juce::SpinLock sinkLock;
-    std::vector<IAudioDataSink *> audioDataSinks;
-    std::atomic<IGhostDataSink *> ghostDataSink{nullptr};
+    struct Subscription {
+        IAudioDataSink *sink;
+        SinkFormat format;
+    };
+
+    /** Under sinkLock: hand the formats the sinks subscribe to to the audio thread. */
+    void updateSubscribedFormats() noexcept;
+
+    /** The stereo pair the sinks see for a main-bus block (the block itself when it is stereo). */
+    const juce::AudioBuffer<float> &selectAnalyzerChannels(const juce::AudioBuffer<float> &buffer) noexcept;
+
+    /** Mid/side and mono from the analyzer pair, in formatBuffer-sized chunks. */
+    void writeDerivedFormats(const juce::AudioBuffer<float> &pair, unsigned formats) noexcept;
+
+    static constexpr unsigned formatBit(SinkFormat format) { return 1u << static_cast<unsigned>(format); }
+
+    static_assert(kNumSinkFormats == PerformanceMonitor::kNumMainFifos, "one FIFO metrics block per main bus");
+
+    std::array<CaptureBus, kNumSinkFormats> mainBuses{
+        CaptureBus(kCaptureBusCapacity), CaptureBus(kCaptureBusCapacity), CaptureBus(kCaptureBusCapacity)
+    };
+    CaptureBus ghostBus{kCaptureBusCapacity};
+    std::atomic<unsigned> subscribedFormats{0}; // formatBit()s, read by the audio thread
+    juce::AudioBuffer<float> formatBuffer; // mid, side scratch (audio thread)
+
+    // Never taken on the audio thread
+    juce::CriticalSection sinkLock;
+    std::vector<Subscription> audioDataSinks;
+    IGhostDataSink *ghostDataSink = nullptr;
+
+    std::atomic<AnalyzerSource> analyzerSource{AnalyzerSource::FoldDown};
+
+    // Multichannel bus analysis (written in prepareAnalyzerSource, read on the audio thread)
+    static constexpr size_t kNumAnalyzerSources = static_cast<size_t>(AnalyzerSource::CentreLfe) + 1;
+    std::array<std::array<int, 2>, kNumAnalyzerSources> sourceChannels{};
+    std::vector<std::array<float, 2>> foldDownWeights; // empty on a stereo bus
+    juce::AudioBuffer<float> foldDownBuffer;
+    juce::AudioBuffer<float> analyzerView; // refers to the selected pair or foldDownBuffer
 };
@@ -1,113 +1,95 @@
 #include "AudioRingBuffer.h"
 
 AudioRingBuffer::AudioRingBuffer(const int fifoCapacity, const int rollingBufferSize)
-    : fifo(fifoCapacity),
-      fifoL(static_cast<size_t>(fifoCapacity), 0.0f),
-      fifoR(static_cast<size_t>(fifoCapacity), 0.0f),
-      rollingL(static_cast<size_t>(rollingBufferSize), 0.0f),
-      rollingR(static_cast<size_t>(rollingBufferSize), 0.0f),
+    : ownBus(fifoCapacity),
+      reader(&ownBus),
+      activeCapacity(fifoCapacity),
+      decimatedL(static_cast<size_t>(kDecimationChunk / 2 + 1), 0.0f),
+      decimatedR(static_cast<size_t>(kDecimationChunk / 2 + 1), 0.0f),
+      rollingL(rollingBufferSize),
+      rollingR(rollingBufferSize),
       rollingSize(rollingBufferSize) {
 }
 
 void AudioRingBuffer::push(const juce::AudioBuffer<float> &buffer) {
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-
-    if (numSamples == 0 || numChannels == 0)
-        return;
-
-    const float *left = buffer.getReadPointer(0);
-    const float *right = numChannels >= 2 ? buffer.getReadPointer(1) : left;
-
-    push(left, right, numSamples);
+    ownBus.write(buffer);
 }
 
 void AudioRingBuffer::push(const float *left, const float *right, const int numSamples) {
-    if (!accepting.load(std::memory_order_relaxed))
-        return;
-
-    if (left == nullptr || right == nullptr || numSamples <= 0)
-        return;
-
-    const auto fifoSize = static_cast<int>(fifoL.size());
-    int start1, size1, start2, size2;
-    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
-
-    if (size1 > 0 && start1 >= 0 && start1 + size1 <= fifoSize) {
-        for (int i = 0; i < size1; ++i) {
-            fifoL[static_cast<size_t>(start1 + i)] = left[i];
-            fifoR[static_cast<size_t>(start1 + i)] = right[i];
-        }
-    }
-    if (size2 > 0 && start2 >= 0 && start2 + size2 <= fifoSize) {
-        for (int i = 0; i < size2; ++i) {
-            fifoL[static_cast<size_t>(start2 + i)] = left[size1 + i];
-            fifoR[static_cast<size_t>(start2 + i)] = right[size1 + i];
-        }
-    }
+    ownBus.write(left, right, numSamples);
+}
 
-    fifo.finishedWrite(size1 + size2);
+void AudioRingBuffer::attach(const CaptureBus *bus) {
+    reader.attach(bus != nullptr ? bus : &ownBus);
+    decimator.reset();
 }
 
 int AudioRingBuffer::drain() {
-    const int available = fifo.getNumReady();
-    if (available <= 0)
-        return 0;
-
     // Guard against corrupt state — rollingSize could be stale after a resize race
     if (rollingSize <= 0 || writePos < 0 || writePos >= rollingSize) {
-        int s1, z1, s2, z2;
-        fifo.prepareToRead(available, s1, z1, s2, z2);
-        fifo.finishedRead(z1 + z2);
+        reader.skipToEnd();
         return 0;
     }
 
-    const auto fifoSize = static_cast<int>(fifoL.size());
-    int start1, size1, start2, size2;
-    fifo.prepareToRead(available, start1, size1, start2, size2);
+    const int stages = decimator.getNumStages();
+    int numWritten = 0;
 
-    auto copyToRolling = [&](const int srcStart, const int count) {
-        // Bounds-check FIFO source region
-        if (srcStart < 0 || srcStart + count > fifoSize || count <= 0)
+    reader.read(activeCapacity << stages, [&](const float *left, const float *right, const int numSamples) {
+        if (stages == 0) {
+            writeToRolling(left, right, numSamples);
+            numWritten += numSamples;
             return;
+        }
 
-        for (int i = 0; i < count; ++i) {
-            const int src = srcStart + i;
-            const int dst = (writePos + i) % rollingSize;
-            rollingL[static_cast<size_t>(dst)] = fifoL[static_cast<size_t>(src)];
-            rollingR[static_cast<size_t>(dst)] = fifoR[static_cast<size_t>(src)];
+        // Fixed chunks keep the decimated scratch preallocated whatever the span
+        for (int done = 0; done < numSamples; done += kDecimationChunk) {
+            const int len = juce::jmin(kDecimationChunk, numSamples - done);
+            const int count = decimator.process(left + done, right + done, len,
+                                                decimatedL.data(), decimatedR.data());
+            writeToRolling(decimatedL.data(), decimatedR.data(), count);
+            numWritten += count;
         }
-        writePos = (writePos + count) % rollingSize;
-    };
-    if (size1 > 0) copyToRolling(start1, size1);
-    if (size2 > 0) copyToRolling(start2, size2);
+    });
 
-    fifo.finishedRead(size1 + size2);
-    return size1 + size2;
+    return numWritten;
 }
 
-void AudioRingBuffer::drainSilently() {
-    const int available = fifo.getNumReady();
-    if (available <= 0)
-        return;
+void AudioRingBuffer::writeToRolling(const float *left, const float *right, int numSamples) {
+    // Only the newest rollingSize samples survive a longer span
+    if (numSamples > rollingSize) {
+        const int skip = numSamples - rollingSize;
+        left += skip;
+        right += skip;
+        writePos = (writePos + skip) % rollingSize;
+        numSamples = rollingSize;
+    }
 
-    int start1, size1, start2, size2;
-    fifo.prepareToRead(available, start1, size1, start2, size2);
-    fifo.finishedRead(size1 + size2);
+    rollingL.write(writePos, left, numSamples);
+    rollingR.write(writePos, right, numSamples);
+    writePos = (writePos + numSamples) % rollingSize;
+}
+
+void AudioRingBuffer::drainSilently() {
+    reader.skipToEnd();
 }
 
 void AudioRingBuffer::resizeRolling(const int newSize) {
     rollingSize = newSize;
-    rollingL.assign(static_cast<size_t>(newSize), 0.0f);
-    rollingR.assign(static_cast<size_t>(newSize), 0.0f);
+    rollingL.setSize(newSize);
+    rollingR.setSize(newSize);
     writePos = 0;
 }
 
 void AudioRingBuffer::resetFifo(const int newActiveCapacity) {
-    // Pause push() on the audio thread to avoid a data race on AbstractFifo internals
-    // (setTotalSize/reset are not thread-safe with concurrent prepareToWrite).
-    accepting.store(false, std::memory_order_seq_cst);
-    fifo.setTotalSize(newActiveCapacity);
-    fifo.reset();
-    accepting.store(true, std::memory_order_release);
+    // Reader state only: the writer never waits on, or is paused for, a reader
+    activeCapacity = juce::jmax(1, newActiveCapacity);
+    reader.skipToEnd();
+}
+
+void AudioRingBuffer::setDecimationStages(const int stages) {
+    decimator.setNumStages(stages);
+
+    // Whatever is pending or rolling is at the old rate
+    reader.skipToEnd();
+    resizeRolling(rollingSize);
 }
@@ -1,53 +1,87 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
-#include <atomic>
 #include <vector>
 
+#include "CaptureBus.h"
+#include "HalfbandDecimator.h"
+#include "MirroredRing.h"
+
 /**
  * AudioRingBuffer
  *
- * Lock-free stereo FIFO + circular rolling buffer for audio-to-UI data transfer.
+ * CaptureBus reader + circular rolling buffer for audio-to-UI data transfer.
  * Extracted from the pattern duplicated in AudioVisualizerBase and GhostSpectrum.
  *
- * The audio thread pushes samples via push() (lock-free, no allocation).
- * The UI thread drains the FIFO into the rolling buffer via drain().
+ * The consumer thread (a visualizer's UI timer, or the SpectrumAnalysisWorker) drains the
+ * frames written since the last drain() into the rolling buffer, as the bus reader copies them
+ * out. The source is the processor's shared bus once attach()ed; until then it is a bus of its
+ * own, fed through push() (lock-free, no allocation).
+ *
+ * Optionally the drained audio runs through a HalfbandDecimator on its way in, so the rolling
+ * buffer holds it at 1 / 2^stages of the bus rate (setDecimationStages()).
+ *
+ * The rolling buffer is a MirroredRing: drained spans go in as bulk copies, and the whole
+ * buffer in time order is the single pointer getL() + getWritePos().
  */
 class AudioRingBuffer {
 public:
     AudioRingBuffer(int fifoCapacity, int rollingBufferSize);
 
-    /** Push stereo data from the audio thread (lock-free). */
+    /** Push stereo data into the own bus (lock-free; one producer). */
     void push(const juce::AudioBuffer<float> &buffer);
 
-    /** Push raw L/R pointer pairs from the audio thread (lock-free). */
+    /** Push raw L/R pointer pairs into the own bus (lock-free; one producer). */
     void push(const float *left, const float *right, int numSamples);
 
-    /** Drain FIFO into rolling buffer. Returns number of new samples written. */
+    /** Read from bus instead (nullptr: back to the own bus), starting at its current end. */
+    void attach(const CaptureBus *bus);
+
+    /** The source has been marked silent and nothing was written since. */
+    bool isSourceSilent() const { return reader.getBus() != nullptr && reader.getBus()->isSilent(); }
+
+    /** Sleep until minFrames (at the bus rate) are ready to drain; see CaptureBus::Reader::waitForData(). */
+    bool waitForData(int minFrames, int timeoutMs) const { return reader.waitForData(minFrames, timeoutMs); }
+
+    /** Drain new frames into rolling buffer. Returns number of new samples written. */
     int drain();
 
-    /** Drain FIFO without writing to rolling buffer (used when frozen). */
+    /** Skip new frames without writing to rolling buffer (used when frozen). */
     void drainSilently();
 
     /** Resize the rolling buffer (clears data, resets write position). */
     void resizeRolling(int newSize);
 
-    /** Reset FIFO to a new active capacity (underlying buffers stay at max size). */
+    /** Skip pending frames; later drains take at most the newest newActiveCapacity (rolling-rate) samples. */
     void resetFifo(int newActiveCapacity);
 
-    // Accessors
-    const std::vector<float> &getL() const { return rollingL; }
-    const std::vector<float> &getR() const { return rollingR; }
+    /** Decimate by 2^stages from the next drain on; clears the pending frames and rolling buffer. */
+    void setDecimationStages(int stages);
+    int getDecimationStages() const { return decimator.getNumStages(); }
+
+    /** Frames skipped because a drain came too late (beyond the active capacity or the bus). */
+    std::uint64_t getNumDropped() const { return reader.getNumDropped(); }
+
+    // Accessors. 2 x getRollingSize() samples each, the second half mirroring the first, so
+    // getL() + getWritePos() is the whole rolling buffer oldest first
+    const float *getL() const { return rollingL.getData(); }
+    const float *getR() const { return rollingR.getData(); }
     int getWritePos() const { return writePos; }
     int getRollingSize() const { return rollingSize; }
 
 private:
-    std::atomic<bool> accepting { true };
+    static constexpr int kDecimationChunk = 512;
+
+    void writeToRolling(const float *left, const float *right, int numSamples);
+
+    CaptureBus ownBus;
+    CaptureBus::Reader reader;
+    int activeCapacity;
 
-    juce::AbstractFifo fifo;
-    std::vector<float> fifoL, fifoR;
+    HalfbandDecimator decimator;
+    std::vector<float> decimatedL, decimatedR;
 
-    std::vector<float> rollingL, rollingR;
+    MirroredRing rollingL, rollingR;
     int writePos = 0;
     int rollingSize;
 };
@@ -0,0 +1,296 @@
+#include "BandSoloBank.h"
+
+#include <algorithm>
+#include <functional>
+#include "Biquad.h"
+#include "SimdLanes.h"
+
+namespace {
+#if GFRACTOR_SIMD
+    using namespace SimdLanes;
+
+    /** Eight lanes as a pair of 4-wide registers. */
+    struct Octet {
+        Vec lo, hi;
+
+        static Octet load(const float *p) noexcept { return {SimdLanes::load(p), SimdLanes::load(p + 4)}; }
+
+        static Octet splat(const float v) noexcept {
+            const Vec s = SimdLanes::splat(v);
+            return {s, s};
+        }
+
+        void store(float *p) const noexcept {
+            SimdLanes::store(p, lo);
+            SimdLanes::store(p + 4, hi);
+        }
+
+        float sum() const noexcept { return SimdLanes::sum(add(lo, hi)); }
+    };
+
+    inline Octet operator+(const Octet a, const Octet b) noexcept { return {add(a.lo, b.lo), add(a.hi, b.hi)}; }
+    inline Octet operator-(const Octet a, const Octet b) noexcept { return {sub(a.lo, b.lo), sub(a.hi, b.hi)}; }
+    inline Octet operator*(const Octet a, const Octet b) noexcept { return {mul(a.lo, b.lo), mul(a.hi, b.hi)}; }
+#else
+    struct Octet {
+        float v[BandSoloBank::kNumLanes];
+
+        static Octet load(const float *p) noexcept {
+            Octet o;
+            std::copy(p, p + BandSoloBank::kNumLanes, o.v);
+            return o;
+        }
+
+        static Octet splat(const float x) noexcept {
+            Octet o;
+            std::fill(o.v, o.v + BandSoloBank::kNumLanes, x);
+            return o;
+        }
+
+        void store(float *p) const noexcept { std::copy(v, v + BandSoloBank::kNumLanes, p); }
+
+        float sum() const noexcept {
+            float total = 0.0f;
+            for (const float x: v)
+                total += x;
+            return total;
+        }
+    };
+
+    template<typename Op>
+    inline Octet lanewise(const Octet a, const Octet b, Op op) noexcept {
+        Octet o;
+        for (int lane = 0; lane < BandSoloBank::kNumLanes; ++lane)
+            o.v[lane] = op(a.v[lane], b.v[lane]);
+        return o;
+    }
+
+    inline Octet operator+(const Octet a, const Octet b) noexcept { return lanewise(a, b, std::plus<float>()); }
+    inline Octet operator-(const Octet a, const Octet b) noexcept { return lanewise(a, b, std::minus<float>()); }
+    inline Octet operator*(const Octet a, const Octet b) noexcept { return lanewise(a, b, std::multiplies<float>()); }
+#endif
+
+    struct BankLanes {
+        Octet b0, b2, a1, a2;
+    };
+
+    /** TDF-II step on all lanes; same operation order as BiquadState::process() with b1 = 0. */
+    inline Octet tick(const Octet x, const BankLanes &c, Octet &s1, Octet &s2) noexcept {
+        const Octet y = c.b0 * x + s1;
+        s1 = s2 - c.a1 * y;
+        s2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+}
+
+void BandSoloBank::prepare(const juce::dsp::ProcessSpec &spec) {
+    for (size_t band = 0; band < static_cast<size_t>(kNumBands); ++band) {
+        const auto info = getBandInfo(band);
+        const auto c = BiquadCoefficients::bandPass(spec.sampleRate, info.centerFreq, info.q);
+
+        coefficients.b0[band] = c.b0;
+        coefficients.b2[band] = c.b2;
+        coefficients.a1[band] = c.a1;
+        coefficients.a2[band] = c.a2;
+    }
+
+    // Dry lane: a passthrough biquad, so it rides through the same cascade untouched.
+    for (int lane = kNumBands; lane < kNumLanes; ++lane) {
+        coefficients.b0[lane] = 1.0f;
+        coefficients.b2[lane] = 0.0f;
+        coefficients.a1[lane] = 0.0f;
+        coefficients.a2[lane] = 0.0f;
+    }
+
+    channelStates.assign(static_cast<size_t>(spec.numChannels), ChannelState{});
+    crossfadeLength = juce::jmax(1, juce::roundToInt(spec.sampleRate * kCrossfadeSeconds));
+
+    reset();
+}
+
+bool BandSoloBank::beginBlock() noexcept {
+    const auto solo = soloBands.load(std::memory_order_relaxed);
+    const auto mute = mutedBands.load(std::memory_order_relaxed);
+
+    if (solo != appliedSolo || mute != appliedMute) {
+        appliedSolo = solo;
+        appliedMute = mute;
+
+        if (!running) {
+            // Waking up from bypass: weights are sitting on the dry lane, filters start clean.
+            clearState();
+            running = true;
+        }
+
+        const auto target = computeWeights(solo, mute);
+        const float scale = 1.0f / static_cast<float>(crossfadeLength);
+
+        for (int lane = 0; lane < kNumLanes; ++lane) {
+            targetWeights[lane] = target[static_cast<size_t>(lane)];
+            weightStep[lane] = (targetWeights[lane] - weights[lane]) * scale;
+        }
+        samplesLeftInCrossfade = crossfadeLength;
+    } else if (running && samplesLeftInCrossfade == 0 && solo == 0 && mute == 0) {
+        // Faded back to the dry lane alone: nothing to do until the masks change again.
+        running = false;
+    }
+
+    return running;
+}
+
+template<typename SampleType>
+void BandSoloBank::process(juce::dsp::ProcessContextReplacing<SampleType> &context) noexcept {
+    if (!beginBlock())
+        return;
+
+    auto &block = context.getOutputBlock();
+    const auto numChannels = juce::jmin(block.getNumChannels(), channelStates.size());
+    const auto numSamples = block.getNumSamples();
+
+    size_t ch = 0;
+    for (; ch + 1 < numChannels; ch += 2) {
+        SampleType *const pair[] = {block.getChannelPointer(ch), block.getChannelPointer(ch + 1)};
+        processChannels<2>(&channelStates[ch], pair, numSamples);
+    }
+
+    if (ch < numChannels) {
+        SampleType *const single[] = {block.getChannelPointer(ch)};
+        processChannels<1>(&channelStates[ch], single, numSamples);
+    }
+
+    advanceWeights(numSamples);
+    endBlock();
+}
+
+template<typename SampleType>
+void BandSoloBank::processStereo(SampleType *left, SampleType *right, const size_t numSamples) noexcept {
+    SampleType *const pair[] = {left, right};
+    processChannels<2>(channelStates.data(), pair, numSamples);
+    advanceWeights(numSamples);
+}
+
+template<size_t NumChannels, typename SampleType>
+void BandSoloBank::processChannels(ChannelState *states, SampleType *const *channels,
+                                   const size_t numSamples) noexcept {
+    const BankLanes c{
+        Octet::load(coefficients.b0), Octet::load(coefficients.b2),
+        Octet::load(coefficients.a1), Octet::load(coefficients.a2)
+    };
+
+    Octet s1[NumChannels], s2[NumChannels], s3[NumChannels], s4[NumChannels];
+    for (size_t ch = 0; ch < NumChannels; ++ch) {
+        s1[ch] = Octet::load(states[ch].stage1s1);
+        s2[ch] = Octet::load(states[ch].stage1s2);
+        s3[ch] = Octet::load(states[ch].stage2s1);
+        s4[ch] = Octet::load(states[ch].stage2s2);
+    }
+
+    // Both stages on all eight lanes, then one weighted lane sum per channel.
+    const auto processFrame = [&](const size_t i, const Octet &weight) {
+        for (size_t ch = 0; ch < NumChannels; ++ch) {
+            const Octet x = Octet::splat(static_cast<float>(channels[ch][i]));
+            const Octet y = tick(tick(x, c, s1[ch], s2[ch]), c, s3[ch], s4[ch]);
+            channels[ch][i] = static_cast<SampleType>((y * weight).sum());
+        }
+    };
+
+    const auto crossfadeFrames = juce::jmin(numSamples, static_cast<size_t>(samplesLeftInCrossfade));
+    size_t i = 0;
+
+    if (crossfadeFrames > 0) {
+        Octet weight = Octet::load(weights);
+        const Octet step = Octet::load(weightStep);
+
+        for (; i < crossfadeFrames; ++i) {
+            weight = weight + step;
+            processFrame(i, weight);
+        }
+    }
+
+    if (i < numSamples) {
+        const Octet weight = Octet::load(targetWeights);
+
+        for (; i < numSamples; ++i)
+            processFrame(i, weight);
+    }
+
+    for (size_t ch = 0; ch < NumChannels; ++ch) {
+        s1[ch].store(states[ch].stage1s1);
+        s2[ch].store(states[ch].stage1s2);
+        s3[ch].store(states[ch].stage2s1);
+        s4[ch].store(states[ch].stage2s2);
+    }
+}
+
+void BandSoloBank::advanceWeights(const size_t numSamples) noexcept {
+    if (samplesLeftInCrossfade == 0)
+        return;
+
+    const auto len = juce::jmin(numSamples, static_cast<size_t>(samplesLeftInCrossfade));
+
+    // Same accumulation as the channel loops, so every channel saw identical weights.
+    for (size_t i = 0; i < len; ++i)
+        for (int lane = 0; lane < kNumLanes; ++lane)
+            weights[lane] += weightStep[lane];
+
+    samplesLeftInCrossfade -= static_cast<int>(len);
+
+    if (samplesLeftInCrossfade == 0)
+        std::copy(std::begin(targetWeights), std::end(targetWeights), weights);
+}
+
+void BandSoloBank::endBlock() noexcept {
+    for (auto &state: channelStates) {
+        for (int lane = 0; lane < kNumLanes; ++lane) {
+            JUCE_SNAP_TO_ZERO(state.stage1s1[lane]);
+            JUCE_SNAP_TO_ZERO(state.stage1s2[lane]);
+            JUCE_SNAP_TO_ZERO(state.stage2s1[lane]);
+            JUCE_SNAP_TO_ZERO(state.stage2s2[lane]);
+        }
+    }
+}
+
+void BandSoloBank::reset() noexcept {
+    appliedSolo = soloBands.load(std::memory_order_relaxed);
+    appliedMute = mutedBands.load(std::memory_order_relaxed);
+
+    const auto target = computeWeights(appliedSolo, appliedMute);
+    std::copy(target.begin(), target.end(), targetWeights);
+    std::copy(target.begin(), target.end(), weights);
+    std::fill(std::begin(weightStep), std::end(weightStep), 0.0f);
+
+    samplesLeftInCrossfade = 0;
+    running = appliedSolo != 0 || appliedMute != 0;
+    clearState();
+}
+
+void BandSoloBank::clearState() noexcept {
+    std::fill(channelStates.begin(), channelStates.end(), ChannelState{});
+}
+
+BandSoloBank::LaneWeights BandSoloBank::computeWeights(juce::uint32 soloMask, juce::uint32 muteMask) noexcept {
+    soloMask &= kAllBands;
+    muteMask &= kAllBands;
+
+    LaneWeights result{};
+
+    if (soloMask != 0) {
+        // Soloed bands only; a band that is both soloed and muted stays silent.
+        const auto audible = soloMask & ~muteMask;
+        for (int band = 0; band < kNumBands; ++band)
+            result[static_cast<size_t>(band)] = ((audible >> band) & 1u) != 0 ? 1.0f : 0.0f;
+    } else {
+        // Everything except the muted bands: dry minus their bandpass outputs.
+        result[kDryLane] = 1.0f;
+        for (int band = 0; band < kNumBands; ++band)
+            if (((muteMask >> band) & 1u) != 0)
+                result[static_cast<size_t>(band)] = -1.0f;
+    }
+
+    return result;
+}
+
+template void BandSoloBank::process<float>(juce::dsp::ProcessContextReplacing<float> &) noexcept;
+template void BandSoloBank::process<double>(juce::dsp::ProcessContextReplacing<double> &) noexcept;
+template void BandSoloBank::processStereo<float>(float *, float *, size_t) noexcept;
+template void BandSoloBank::processStereo<double>(double *, double *, size_t) noexcept;
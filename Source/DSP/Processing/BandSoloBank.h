@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+#include "../../Utility/BandConstants.h"
+
+/**
+ * BandSoloBank
+ *
+ * Solo / mute for any subset of the analyzer bands (kBands), evaluated as one filter bank.
+ *
+ * Every band is the same 4th-order bandpass the band selection filter uses (two cascaded
+ * 2nd-order BPFs at getBandInfo() centre and Q). All seven bands plus one passthrough lane
+ * sit in the eight lanes of a single filter state, so each frame runs one 8-lane cascade and
+ * a weighted lane sum, whatever the number of selected bands:
+ *
+ *   - solo:  out = sum of the soloed bands (muted bands are left out)
+ *   - mute:  out = dry - sum of the muted bands (used when nothing is soloed)
+ *   - none:  the bank is bypassed and costs nothing
+ *
+ * Mask changes crossfade the lane weights over kCrossfadeSeconds, so switching bands (and
+ * switching the bank on or off) is click-free. Filter state restarts from zero each time the
+ * bank wakes up; the fade in from the dry lane covers the filters' settling.
+ *
+ * The lanes are float; float and double blocks are read and written in place, one sample at a time.
+ *
+ * Thread-safe: setSoloMask() / setMuteMask() are called from the message thread;
+ * everything else runs on the audio thread. Realtime-safe (allocation only in prepare()).
+ */
+class BandSoloBank {
+public:
+    /** kNumBands band lanes plus the dry lane. */
+    static constexpr int kNumLanes = 8;
+    static constexpr int kDryLane = kNumBands;
+    static_assert(kNumBands < kNumLanes, "one lane is reserved for the dry signal");
+
+    /** Bits 0..kNumBands-1, one per entry of kBands. */
+    static constexpr juce::uint32 kAllBands = (1u << kNumBands) - 1u;
+
+    /** Lane-weight crossfade time for solo/mute changes. */
+    static constexpr double kCrossfadeSeconds = 0.01;
+
+    using LaneWeights = std::array<float, kNumLanes>;
+
+    /** Called from the message thread. Bit i solos kBands[i]; 0 clears the solo. */
+    void setSoloMask(const juce::uint32 bandMask) noexcept {
+        soloBands.store(bandMask & kAllBands, std::memory_order_relaxed);
+    }
+
+    /** Called from the message thread. Bit i mutes kBands[i]; 0 clears the mute. */
+    void setMuteMask(const juce::uint32 bandMask) noexcept {
+        mutedBands.store(bandMask & kAllBands, std::memory_order_relaxed);
+    }
+
+    /** Called from the audio thread (prepareToPlay). Designs the band lanes for the sample rate. */
+    void prepare(const juce::dsp::ProcessSpec &spec);
+
+    /**
+     * Called from the audio thread at the start of every block.
+     * Picks up mask changes and starts the weight crossfade.
+     * @return true if the bank has to run for this block
+     */
+    bool beginBlock() noexcept;
+
+    /** Called from the audio thread (processBlock). */
+    template<typename SampleType>
+    void process(juce::dsp::ProcessContextReplacing<SampleType> &context) noexcept;
+
+    /** Stereo path for the fused pipeline. Only valid after beginBlock() returned true;
+     *  chunks must be contiguous and followed by endBlock() once the block is done. */
+    template<typename SampleType>
+    void processStereo(SampleType *left, SampleType *right, size_t numSamples) noexcept;
+
+    /** Call after a block of processStereo() calls (mirrors the denormal flush done by process()). */
+    void endBlock() noexcept;
+
+    /** Called from the audio thread (reset). Jumps to the current masks without a crossfade. */
+    void reset() noexcept;
+
+    /** Lane weights the bank settles on for a solo/mute pair (also used by the tests). */
+    static LaneWeights computeWeights(juce::uint32 soloMask, juce::uint32 muteMask) noexcept;
+
+private:
+    /** b1 is zero for every lane (bandpass and passthrough alike), so it is not stored. */
+    struct LaneCoefficients {
+        alignas(16) float b0[kNumLanes];
+        alignas(16) float b2[kNumLanes];
+        alignas(16) float a1[kNumLanes];
+        alignas(16) float a2[kNumLanes];
+    };
+
+    /** TDF-II states of both cascaded stages, one lane per band. */
+    struct ChannelState {
+        alignas(16) float stage1s1[kNumLanes];
+        alignas(16) float stage1s2[kNumLanes];
+        alignas(16) float stage2s1[kNumLanes];
+        alignas(16) float stage2s2[kNumLanes];
+    };
+
+    /** Runs NumChannels channels side by side so their recursions overlap. */
+    template<size_t NumChannels, typename SampleType>
+    void processChannels(ChannelState *states, SampleType *const *channels, size_t numSamples) noexcept;
+
+    /** Walks the weight crossfade by the numSamples steps the channels just took. */
+    void advanceWeights(size_t numSamples) noexcept;
+
+    void clearState() noexcept;
+
+    std::atomic<juce::uint32> soloBands{0};
+    std::atomic<juce::uint32> mutedBands{0};
+
+    LaneCoefficients coefficients{};
+    std::vector<ChannelState> channelStates;
+
+    // Weight crossfade (audio thread only)
+    alignas(16) float weights[kNumLanes] = {};
+    alignas(16) float targetWeights[kNumLanes] = {};
+    alignas(16) float weightStep[kNumLanes] = {};
+    juce::uint32 appliedSolo = 0;
+    juce::uint32 appliedMute = 0;
+    int crossfadeLength = 1;
+    int samplesLeftInCrossfade = 0;
+    bool running = false;
+};
@@ -2,7 +2,10 @@
 
 #include <atomic>
 #include <cmath>
+#include <vector>
 #include <juce_dsp/juce_dsp.h>
+#include "Biquad.h"
+#include "StereoBiquadCascade.h"
 
 /**
  * 4th-order bandpass filter built from two cascaded 2nd-order IIR BPFs.
@@ -12,12 +15,26 @@
  *
  * Used for both the transient audition bell filter and the band selection filter
  * in gFractorDSP, replacing two identical blocks of inline member code.
+ *
+ * Realtime-safe retuning: coefficients are designed in place (no allocation) and
+ * frequency/Q glide to new targets. While gliding, coefficients are redesigned every
+ * kSegmentLength samples and linearly interpolated per sample in between, so sweeps
+ * from the UI are free of zipper noise.
+ *
+ * Channels are filtered in pairs by StereoBiquadCascade (L/R and both stages in SIMD lanes).
+ * Runs block-wise via process(), or on stereo chunks via beginBlock() / processStereo() /
+ * endBlock() from gFractorDSP's fused path. Both walk the coefficient ramp identically.
+ *
+ * SampleType is the processing precision; coefficients are designed the same way for both.
  */
+template<typename SampleType>
 class BandpassFilter {
 public:
-    using IIRDuplicator = juce::dsp::ProcessorDuplicator<
-        juce::dsp::IIR::Filter<float>,
-        juce::dsp::IIR::Coefficients<float>>;
+    /** Samples between coefficient redesigns while frequency or Q is gliding. */
+    static constexpr int kSegmentLength = 16;
+
+    /** Glide time for frequency (multiplicative) and Q (linear) changes. */
+    static constexpr double kGlideSeconds = 0.02;
 
     /** Called from the message thread to update filter parameters. */
     void setParams(const bool isActive, const float frequencyHz, const float qValue) {
@@ -29,54 +46,144 @@ public:
     /** Called from the audio thread (prepareToPlay). */
     void prepare(const juce::dsp::ProcessSpec &spec) {
         sampleRate = spec.sampleRate;
-        filter1.prepare(spec);
-        filter2.prepare(spec);
-        filter1.reset();
-        filter2.reset();
-        lastFreq = -1.0f;
-        lastQ    = -1.0f;
+        numChannelsPrepared = static_cast<size_t>(spec.numChannels);
+        cascades.assign((numChannelsPrepared + 1) / 2, StereoBiquadCascade<SampleType>{});
+
+        freqSmoothed.reset(sampleRate, kGlideSeconds);
+        qSmoothed.reset(sampleRate, kGlideSeconds);
+
+        reset();
     }
 
-    /** Called from the audio thread (processBlock). */
-    void process(juce::dsp::ProcessContextReplacing<float> &context) {
+    /**
+     * Called from the audio thread at the start of every block.
+     * Picks up parameter changes and flushes state when the filter was just switched off.
+     * @return true if the filter is active for this block
+     */
+    bool beginBlock() noexcept {
         if (active.load(std::memory_order_relaxed)) {
-            const float f  = freq.load(std::memory_order_relaxed);
+            const float f  = juce::jmax(1.0f, freq.load(std::memory_order_relaxed));
             const float qv = q.load(std::memory_order_relaxed);
-            if (std::abs(f - lastFreq) > 0.01f || std::abs(qv - lastQ) > 0.01f) {
-                const auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, f, qv);
-                *filter1.state = *coeffs;
-                *filter2.state = *coeffs;
-                lastFreq = f;
-                lastQ    = qv;
+
+            if (!wasActive) {
+                // Fresh start: jump straight to the requested response, nothing to glide from.
+                freqSmoothed.setCurrentAndTargetValue(f);
+                qSmoothed.setCurrentAndTargetValue(qv);
+                current = target = BiquadCoefficients::bandPass(sampleRate, f, qv);
+                ramping = false;
+                samplesLeftInSegment = 0;
+                wasActive = true;
+            } else if (std::abs(f - freqSmoothed.getTargetValue()) > 0.01f
+                       || std::abs(qv - qSmoothed.getTargetValue()) > 0.01f) {
+                freqSmoothed.setTargetValue(f);
+                qSmoothed.setTargetValue(qv);
             }
-            filter1.process(context);
-            filter2.process(context);
-        } else if (lastFreq > 0.0f) {
+            return true;
+        }
+
+        if (wasActive) {
             // Filter just became inactive — flush state so it doesn't bleed on re-enable.
-            filter1.reset();
-            filter2.reset();
-            lastFreq = -1.0f;
-            lastQ    = -1.0f;
+            reset();
         }
+        return false;
+    }
+
+    /** Called from the audio thread (processBlock). */
+    void process(juce::dsp::ProcessContextReplacing<SampleType> &context) {
+        if (!beginBlock())
+            return;
+
+        auto &block = context.getOutputBlock();
+        const auto numChannels = juce::jmin(block.getNumChannels(), numChannelsPrepared);
+
+        processChannels([&block](const size_t ch) { return block.getChannelPointer(ch); },
+                        numChannels, block.getNumSamples());
+        endBlock();
+    }
+
+    /** Stereo path for the fused pipeline. Only valid after beginBlock() returned true. */
+    void processStereo(SampleType *left, SampleType *right, const size_t numSamples) noexcept {
+        SampleType *const channels[] = {left, right};
+        processChannels([&channels](const size_t ch) { return channels[ch]; }, 2, numSamples);
     }
 
+    /** Call after a block of processStereo() calls (mirrors the denormal flush done by process()). */
+    void endBlock() noexcept {
+        for (auto &cascade: cascades)
+            cascade.snapToZero();
+    }
+
+    size_t getNumChannels() const noexcept { return numChannelsPrepared; }
+
+    /** Coefficients currently applied (for tests and diagnostics). */
+    const BiquadCoefficients &getCurrentCoefficients() const noexcept { return current; }
+
     /** Called from the audio thread (reset). */
     void reset() {
-        filter1.reset();
-        filter2.reset();
-        lastFreq = -1.0f;
-        lastQ    = -1.0f;
+        for (auto &cascade: cascades)
+            cascade.reset();
+        wasActive = false;
+        ramping = false;
+        samplesLeftInSegment = 0;
     }
 
 private:
+    /** Runs the coefficient segments over numChannels channels, two channels per cascade. */
+    template<typename ChannelPointer>
+    void processChannels(ChannelPointer &&channelPointer, const size_t numChannels, const size_t numSamples) noexcept {
+        for (size_t pos = 0; pos < numSamples;) {
+            if (samplesLeftInSegment == 0)
+                startSegment();
+
+            const auto len = juce::jmin(numSamples - pos, static_cast<size_t>(samplesLeftInSegment));
+
+            for (size_t ch = 0; ch < numChannels; ch += 2) {
+                auto c = current;
+                cascades[ch / 2].process(channelPointer(ch) + pos,
+                                         ch + 1 < numChannels ? channelPointer(ch + 1) + pos : nullptr,
+                                         len, c, ramping ? &step : nullptr);
+            }
+
+            // Walk the shared ramp by the same steps each cascade just took.
+            if (ramping)
+                for (size_t i = 0; i < len; ++i)
+                    current += step;
+
+            samplesLeftInSegment -= static_cast<int>(len);
+            pos += len;
+        }
+    }
+
+    /** Land exactly on the previous target, then aim at the glide position kSegmentLength samples ahead. */
+    void startSegment() noexcept {
+        current = target;
+        samplesLeftInSegment = kSegmentLength;
+        ramping = freqSmoothed.isSmoothing() || qSmoothed.isSmoothing();
+
+        if (ramping) {
+            target = BiquadCoefficients::bandPass(sampleRate,
+                                                  freqSmoothed.skip(kSegmentLength),
+                                                  qSmoothed.skip(kSegmentLength));
+            step = BiquadCoefficients::rampStep(current, target, kSegmentLength);
+        }
+    }
+
     std::atomic<bool>  active{false};
     std::atomic<float> freq{1000.0f};
     std::atomic<float> q{1.0f};
 
-    IIRDuplicator filter1;
-    IIRDuplicator filter2;
+    std::vector<StereoBiquadCascade<SampleType>> cascades; // one per channel pair
+    size_t numChannelsPrepared = 0;
+
+    // Coefficient ramp (audio thread only)
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> freqSmoothed{1000.0f};
+    juce::SmoothedValue<float> qSmoothed{1.0f};
+    BiquadCoefficients current;
+    BiquadCoefficients target;
+    BiquadCoefficients step;
+    int  samplesLeftInSegment = 0;
+    bool ramping   = false;
+    bool wasActive = false;
 
     double sampleRate = 44100.0;
-    float  lastFreq   = -1.0f;
-    float  lastQ      = -1.0f;
 };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cmath>
+#include <juce_core/juce_core.h>
+
+/**
+ * Biquad coefficients normalised to a0 = 1.
+ *
+ * Designed in place as plain values, so the audio thread can retune a filter without
+ * going through juce::dsp::IIR::Coefficients (which heap-allocates a ref-counted object).
+ * Linear interpolation between two stable sets stays stable (the a1/a2 stability triangle
+ * is convex), which is what BandpassFilter relies on for its per-sample ramps.
+ */
+struct BiquadCoefficients {
+    float b0 = 1.0f;
+    float b1 = 0.0f;
+    float b2 = 0.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+
+    /** Same bilinear design as juce::dsp::IIR::Coefficients<float>::makeBandPass(), evaluated in double. */
+    static BiquadCoefficients bandPass(const double sampleRate, const float frequencyHz, const float q) noexcept {
+        if (sampleRate <= 0.0)
+            return {};
+
+        const double frequency = juce::jlimit(1.0, sampleRate * 0.499, static_cast<double>(frequencyHz));
+        const double n = 1.0 / std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        const double nSquared = n * n;
+        const double invQ = 1.0 / juce::jmax(0.01, static_cast<double>(q));
+        const double c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+        return {
+            static_cast<float>(c1 * n * invQ),
+            0.0f,
+            static_cast<float>(-c1 * n * invQ),
+            static_cast<float>(c1 * 2.0 * (1.0 - nSquared)),
+            static_cast<float>(c1 * (1.0 - invQ * n + nSquared))
+        };
+    }
+
+    /** Per-sample increment that walks from `from` to `to` in numSteps steps. */
+    static BiquadCoefficients rampStep(const BiquadCoefficients &from, const BiquadCoefficients &to,
+                                       const int numSteps) noexcept {
+        const float scale = 1.0f / static_cast<float>(numSteps);
+        return {
+            (to.b0 - from.b0) * scale,
+            (to.b1 - from.b1) * scale,
+            (to.b2 - from.b2) * scale,
+            (to.a1 - from.a1) * scale,
+            (to.a2 - from.a2) * scale
+        };
+    }
+
+    BiquadCoefficients &operator+=(const BiquadCoefficients &step) noexcept {
+        b0 += step.b0;
+        b1 += step.b1;
+        b2 += step.b2;
+        a1 += step.a1;
+        a2 += step.a2;
+        return *this;
+    }
+};
+
+/** Transposed direct form II state for one channel (same structure as juce::dsp::IIR::Filter). */
+struct BiquadState {
+    float s1 = 0.0f;
+    float s2 = 0.0f;
+
+    float process(const float x, const BiquadCoefficients &c) noexcept {
+        const float y = c.b0 * x + s1;
+        s1 = c.b1 * x - c.a1 * y + s2;
+        s2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+
+    void snapToZero() noexcept {
+        JUCE_SNAP_TO_ZERO(s1);
+        JUCE_SNAP_TO_ZERO(s2);
+    }
+
+    void reset() noexcept {
+        s1 = 0.0f;
+        s2 = 0.0f;
+    }
+};
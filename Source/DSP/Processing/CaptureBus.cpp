@@ -0,0 +1,127 @@
+#include "CaptureBus.h"
+
+#include <algorithm>
+
+CaptureBus::CaptureBus(const int minimumCapacity)
+    : capacity(juce::nextPowerOfTwo(juce::jmax(2, minimumCapacity))),
+      mask(capacity - 1),
+      readableFrames(juce::jmax(1, static_cast<int>(capacity * kReadableFraction))),
+      left(static_cast<size_t>(capacity), 0.0f),
+      right(static_cast<size_t>(capacity), 0.0f) {
+}
+
+void CaptureBus::write(const juce::AudioBuffer<float> &buffer) noexcept {
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    const float *l = buffer.getReadPointer(0);
+    write(l, numChannels >= 2 ? buffer.getReadPointer(1) : l, buffer.getNumSamples());
+}
+
+void CaptureBus::write(const float *l, const float *r, const int numSamples) noexcept {
+    if (l == nullptr || r == nullptr || numSamples <= 0)
+        return;
+
+    // Only one writer, so the position it last published is its own
+    const std::uint64_t position = written.load(std::memory_order_relaxed);
+    const std::uint64_t end = position + static_cast<std::uint64_t>(numSamples);
+
+    // Claim the frames about to be overwritten before touching them (the seqlock's odd count)
+    claimed.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const int skip = juce::jmax(0, numSamples - capacity);
+    const int count = numSamples - skip;
+
+    const int index = static_cast<int>((position + static_cast<std::uint64_t>(skip)) & static_cast<std::uint64_t>(mask));
+    const int first = juce::jmin(count, capacity - index);
+    std::copy_n(l + skip, first, left.data() + index);
+    std::copy_n(r + skip, first, right.data() + index);
+    std::copy_n(l + skip + first, count - first, left.data());
+    std::copy_n(r + skip + first, count - first, right.data());
+
+    written.store(end, std::memory_order_release);
+    silent.store(false, std::memory_order_release);
+    wakeIfArmed(end);
+}
+
+void CaptureBus::markSilent() noexcept {
+    silent.store(true, std::memory_order_release);
+    wakeIfArmed(kNotArmed);
+}
+
+void CaptureBus::wakeReader() const noexcept {
+    wakeRequested.store(true, std::memory_order_release);
+    readerWake.post();
+}
+
+void CaptureBus::wakeIfArmed(const std::uint64_t position) const noexcept {
+    // Pairs with the reader's fence between arming and checking: either it sees this write
+    // (or silence mark), or this sees its threshold
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Disarm before posting, so the reader is posted once however many writes follow
+    const auto threshold = wakeAt.load(std::memory_order_relaxed);
+    if (threshold != kNotArmed && position >= threshold
+        && wakeAt.exchange(kNotArmed, std::memory_order_relaxed) != kNotArmed)
+        readerWake.post();
+}
+
+void CaptureBus::setMetrics(PerformanceMonitor::FifoMetrics *newMetrics) noexcept {
+    metrics = newMetrics;
+    if (metrics != nullptr)
+        metrics->capacity.store(capacity, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void CaptureBus::Reader::attach(const CaptureBus *newBus) noexcept {
+    bus = newBus;
+    position = bus != nullptr ? bus->written.load(std::memory_order_acquire) : 0;
+}
+
+int CaptureBus::Reader::getNumReady() const noexcept {
+    if (bus == nullptr)
+        return 0;
+    const auto ready = bus->written.load(std::memory_order_acquire) - position;
+    return static_cast<int>(juce::jmin<std::uint64_t>(ready, static_cast<std::uint64_t>(bus->capacity)));
+}
+
+void CaptureBus::Reader::skipToEnd() noexcept {
+    if (bus != nullptr)
+        position = bus->written.load(std::memory_order_acquire);
+}
+
+bool CaptureBus::Reader::waitForData(const int minFrames, const int timeoutMs) const {
+    if (bus == nullptr)
+        return false;
+
+    const std::uint64_t target = position + static_cast<std::uint64_t>(juce::jmax(1, minFrames));
+    const std::uint64_t startPosition = bus->written.load(std::memory_order_acquire);
+    const bool wasSilent = bus->isSilent();
+    const auto start = juce::Time::getMillisecondCounter();
+
+    for (;;) {
+        // Arm, then check: a write or silence mark after the check finds the threshold and posts
+        const auto token = bus->readerWake.prepare();
+        bus->wakeAt.store(target, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // write() clears the silence flag, so silence after a write is a new mark
+        const std::uint64_t end = bus->written.load(std::memory_order_acquire);
+        const bool ready = end >= target;
+        const bool newlySilent = bus->isSilent() && (!wasSilent || end != startPosition);
+
+        int remainingMs = -1;
+        if (timeoutMs >= 0)
+            remainingMs = juce::jmax(0, timeoutMs - static_cast<int>(juce::Time::getMillisecondCounter() - start));
+
+        if (ready || newlySilent || remainingMs == 0
+            || bus->wakeRequested.exchange(false, std::memory_order_acquire)) {
+            bus->wakeAt.store(kNotArmed, std::memory_order_relaxed);
+            return ready;
+        }
+
+        bus->readerWake.wait(token, remainingMs);
+    }
+}
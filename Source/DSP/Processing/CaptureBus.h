@@ -0,0 +1,205 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../Monitoring/PerformanceMonitor.h"
+#include "WakeSignal.h"
+
+/**
+ * CaptureBus
+ *
+ * Single-writer, multi-reader stereo capture ring for audio-to-UI transfer. The audio thread
+ * writes each block once; every consumer keeps its own Reader cursor and copies the new frames
+ * out, so the audio thread's cost does not depend on how many consumers are attached.
+ *
+ * The writer never waits for readers: a reader that falls more than kReadableFraction of the
+ * capacity behind skips the oldest frames (counted in getNumDropped()). The remaining quarter
+ * is headroom for the writer while a reader copies. Should a stalled reader be lapped anyway,
+ * the frames are not trusted: like a seqlock, the writer claims the positions it is about to
+ * overwrite before it touches them, and the reader copies kReadChunk frames at a time into its
+ * own scratch, checks the claim afterwards and drops every frame it may have copied torn.
+ * Consumers only ever see whole frames, in order.
+ *
+ * With setMetrics(), every read reports how full it found the bus and how many frames the
+ * writer overwrote before it got to them (frames an oversized write could not keep included),
+ * so gapped analyzer data shows up in the PerformanceMonitor. Frames a reader skips of its own
+ * accord (beyond its maxFrames) are not reported.
+ *
+ * A reader thread can sleep until enough frames have arrived (Reader::waitForData()). It arms
+ * a wake threshold, the write position it waits for; the write() that reaches it, or a
+ * markSilent(), disarms it and posts the reader's WakeSignal, which never blocks the writer.
+ * Writes below the threshold cost the writer one fence and one load. One reader waits at a
+ * time.
+ *
+ * Threading: write() and markSilent() on one thread (the audio thread), atomics and at most
+ * one non-blocking post per wait, no allocation, no locks. Each Reader belongs to one thread;
+ * any number of readers may run concurrently.
+ */
+class CaptureBus {
+public:
+    static constexpr double kReadableFraction = 0.75;
+    static constexpr int kReadChunk = 512;
+
+    /** Capacity rounded up to a power of two; allocates. */
+    explicit CaptureBus(int minimumCapacity);
+
+    int getCapacity() const noexcept { return capacity; }
+
+    /** Writer: append a block (mono feeds both sides); only the last capacity frames of an oversized block are kept. */
+    void write(const juce::AudioBuffer<float> &buffer) noexcept;
+
+    void write(const float *left, const float *right, int numSamples) noexcept;
+
+    /** Writer: the input went silent; the next write() clears it. Wakes a waiting reader. */
+    void markSilent() noexcept;
+
+    bool isSilent() const noexcept { return silent.load(std::memory_order_acquire); }
+
+    /** Frames written since construction. */
+    std::uint64_t getWritePosition() const noexcept { return written.load(std::memory_order_acquire); }
+
+    /** Report fill levels and overwritten frames to newMetrics (nullptr: stop). Set it before readers attach. */
+    void setMetrics(PerformanceMonitor::FifoMetrics *newMetrics) noexcept;
+
+    /** Any thread. End the reader's current or next waitForData() now, e.g. to hand it new
+     *  settings, or stop it. */
+    void wakeReader() const noexcept;
+
+    /** One consumer's cursor into a bus. */
+    class Reader {
+    public:
+        Reader() = default;
+
+        explicit Reader(const CaptureBus *source) noexcept { attach(source); }
+
+        /** Follow bus (nullptr: detach) from its current end. */
+        void attach(const CaptureBus *newBus) noexcept;
+
+        const CaptureBus *getBus() const noexcept { return bus; }
+
+        /** Frames written since the last read (before any skip). */
+        int getNumReady() const noexcept;
+
+        /**
+         * Hand the unread frames, at most the newest maxFrames of them, to
+         * consume(const float *left, const float *right, int numSamples) in order, copied out in
+         * chunks of at most kReadChunk frames. Older frames are skipped, and so are frames the
+         * writer overwrote before they were copied. Returns the number of frames consumed.
+         */
+        template<typename Consumer>
+        int read(int maxFrames, Consumer &&consume) noexcept;
+
+        /** Skip everything written so far. */
+        void skipToEnd() noexcept;
+
+        /**
+         * Block until minFrames are ready, the bus is marked silent, wakeReader() is called or
+         * timeoutMs passes (negative: no timeout). Returns true if minFrames are ready. The
+         * writer wakes it; a silence mark from before the wait does not count.
+         */
+        bool waitForData(int minFrames, int timeoutMs) const;
+
+        /** Frames this reader skipped because it fell behind (or its maxFrames was smaller). */
+        std::uint64_t getNumDropped() const noexcept { return dropped; }
+
+    private:
+        const CaptureBus *bus = nullptr;
+        std::uint64_t position = 0;
+        std::uint64_t dropped = 0;
+        std::array<float, kReadChunk> scratchLeft{}, scratchRight{};
+    };
+
+private:
+    /** The oldest frame position the writer has not claimed to overwrite. */
+    std::uint64_t getOldestIntact() const noexcept {
+        const auto end = claimed.load(std::memory_order_relaxed);
+        return end > static_cast<std::uint64_t>(capacity) ? end - static_cast<std::uint64_t>(capacity) : 0;
+    }
+
+    int capacity;
+    int mask;
+    int readableFrames;
+    std::vector<float> left, right;
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> claimed{0}; // the end of the write in progress (seqlock claim)
+    std::atomic<bool> silent{false};
+    PerformanceMonitor::FifoMetrics *metrics = nullptr;
+
+    /** Writer: post readerWake if a reader is waiting for position or earlier. */
+    void wakeIfArmed(std::uint64_t position) const noexcept;
+
+    // The waiting reader's threshold (kNotArmed: nobody waits), its wakeReader() request, and
+    // the signal it sleeps on
+    static constexpr std::uint64_t kNotArmed = std::numeric_limits<std::uint64_t>::max();
+    mutable std::atomic<std::uint64_t> wakeAt{kNotArmed};
+    mutable std::atomic<bool> wakeRequested{false};
+    mutable WakeSignal readerWake;
+};
+
+//==============================================================================
+template<typename Consumer>
+int CaptureBus::Reader::read(const int maxFrames, Consumer &&consume) noexcept {
+    if (bus == nullptr || maxFrames <= 0)
+        return 0;
+
+    const std::uint64_t end = bus->written.load(std::memory_order_acquire);
+    const auto limit = static_cast<std::uint64_t>(juce::jmin(maxFrames, bus->readableFrames));
+    const std::uint64_t waiting = end - position;
+    std::uint64_t start = position;
+
+    if (waiting > limit) {
+        dropped += waiting - limit;
+        start = end - limit;
+    }
+
+    // Of the frames skipped here, only those the writer has already overwritten are an overrun
+    std::uint64_t overwritten = juce::jlimit(position, start, bus->getOldestIntact()) - position;
+    position = end;
+
+    // Copy a chunk out, then check the claim: a frame the writer may have reclaimed during the
+    // copy is dropped (like a seqlock retry, except the frames are gone, so there is no retry)
+    int numFrames = 0;
+    while (start < end) {
+        const std::uint64_t intact = bus->getOldestIntact();
+        if (start < intact) {
+            const auto lapped = juce::jmin(intact, end) - start;
+            overwritten += lapped;
+            dropped += lapped;
+            start += lapped;
+            continue;
+        }
+
+        const int count = static_cast<int>(juce::jmin(end - start, static_cast<std::uint64_t>(kReadChunk)));
+        const int index = static_cast<int>(start & static_cast<std::uint64_t>(bus->mask));
+        const int first = juce::jmin(count, bus->capacity - index);
+        std::copy_n(bus->left.data() + index, first, scratchLeft.data());
+        std::copy_n(bus->right.data() + index, first, scratchRight.data());
+        std::copy_n(bus->left.data(), count - first, scratchLeft.data() + first);
+        std::copy_n(bus->right.data(), count - first, scratchRight.data() + first);
+
+        // Pairs with the writer's release fence: a copied sample from a write means its claim is seen
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto chunkEnd = start + static_cast<std::uint64_t>(count);
+        const int torn = static_cast<int>(juce::jlimit(start, chunkEnd, bus->getOldestIntact()) - start);
+        overwritten += static_cast<std::uint64_t>(torn);
+        dropped += static_cast<std::uint64_t>(torn);
+
+        if (torn < count)
+            consume(scratchLeft.data() + torn, scratchRight.data() + torn, count - torn);
+
+        numFrames += count - torn;
+        start = chunkEnd;
+    }
+
+    if (bus->metrics != nullptr)
+        bus->metrics->recordRead(static_cast<int>(juce::jmin(waiting, static_cast<std::uint64_t>(bus->capacity))),
+                                 overwritten);
+
+    return numFrames;
+}
@@ -0,0 +1,64 @@
+#include "ChannelModeCrossfade.h"
+
+#include <algorithm>
+#include <cmath>
+
+template<typename SampleType>
+void ChannelModeCrossfade<SampleType>::prepare(const juce::dsp::ProcessSpec &spec) {
+    const auto length = static_cast<size_t>(juce::jmax(1, juce::roundToInt(spec.sampleRate * kCrossfadeSeconds)));
+
+    // Frame i of the fade sits at (i + 1) / length, so the last frame is exactly on the new
+    // kernel. Both curves come from sin() so their end points are exactly 0 and 1.
+    const auto gainAt = [length](const size_t step) {
+        return static_cast<SampleType>(std::sin(juce::MathConstants<double>::halfPi * static_cast<double>(step)
+                                           / static_cast<double>(length)));
+    };
+
+    fadeIn.resize(length);
+    fadeOut.resize(length);
+    for (size_t i = 0; i < length; ++i) {
+        fadeIn[i] = gainAt(i + 1);
+        fadeOut[i] = gainAt(length - 1 - i);
+    }
+
+    const auto scratchSize = static_cast<size_t>(juce::jmax(1u, spec.maximumBlockSize));
+    scratchLeft.assign(scratchSize, SampleType(0));
+    scratchRight.assign(scratchSize, SampleType(0));
+
+    reset();
+}
+
+template<typename SampleType>
+void ChannelModeCrossfade<SampleType>::process(const unsigned toKernel, SampleType *left, SampleType *right,
+                                               const size_t numSamples, ChannelModeState &state) noexcept {
+    size_t done = 0;
+
+    // The fading part goes through the scratch in pieces of at most its size.
+    while (done < numSamples && isActive() && !scratchLeft.empty()) {
+        const auto len = juce::jmin(numSamples - done, fadeIn.size() - position, scratchLeft.size());
+        SampleType *l = left + done;
+        SampleType *r = right + done;
+
+        std::copy(l, l + len, scratchLeft.data());
+        std::copy(r, r + len, scratchRight.data());
+
+        ChannelModeKernels::process(sourceKernel, scratchLeft.data(), scratchRight.data(), len, state);
+        ChannelModeKernels::process(toKernel, l, r, len, state);
+
+        const SampleType *in = fadeIn.data() + position;
+        const SampleType *out = fadeOut.data() + position;
+        for (size_t i = 0; i < len; ++i) {
+            l[i] = l[i] * in[i] + scratchLeft[i] * out[i];
+            r[i] = r[i] * in[i] + scratchRight[i] * out[i];
+        }
+
+        position += len;
+        done += len;
+    }
+
+    if (done < numSamples)
+        ChannelModeKernels::process(toKernel, left + done, right + done, numSamples - done, state);
+}
+
+template class ChannelModeCrossfade<float>;
+template class ChannelModeCrossfade<double>;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+#include "ChannelModeKernels.h"
+
+/**
+ * ChannelModeCrossfade
+ *
+ * Click-free output mode switches. Every channel-mode kernel is a compile-time
+ * specialisation in the ChannelModeKernels table, so a switch is only a change of kernel
+ * index; this class covers the audible side of it. For kCrossfadeSeconds after a switch,
+ * the old and the new kernel both run on the signal entering the channel-mode stage and
+ * their outputs are blended with equal-power (sine / cosine) gains.
+ *
+ * Switches into or out of Tonal/Transient also change the stage's latency, and the host's:
+ * the separator output is SpectralSeparator::getLatencySamples() behind the other kernels.
+ * The fade is where the output moves from one timeline to the other. Both sides carry the
+ * full signal: leaving, the separator keeps running through the fade; entering, gFractorDSP
+ * primes the separators in the background (SpectralSeparator::prime()) and only starts the
+ * fade once they are producing separated output.
+ *
+ * The old kernel runs on a copy in preallocated scratch buffers; the fade gains are tabled
+ * in prepare(). Nothing allocates on the audio thread.
+ *
+ * SampleType is the processing precision (float or double) of the owning gFractorDSP.
+ *
+ * Audio thread only; realtime-safe (allocation only in prepare()).
+ */
+template<typename SampleType>
+class ChannelModeCrossfade {
+public:
+    static constexpr double kCrossfadeSeconds = 0.01;
+
+    /** Sizes the scratch for spec.maximumBlockSize frames and tables the fade gains. */
+    void prepare(const juce::dsp::ProcessSpec &spec);
+
+    /** Begin fading out of fromKernel (the kernel index the last block used). */
+    void start(const unsigned fromKernel) noexcept {
+        sourceKernel = fromKernel;
+        position = 0;
+    }
+
+    /** True until the fade started by start() has been fully rendered. */
+    bool isActive() const noexcept { return position < fadeIn.size(); }
+
+    /** Drop any fade in progress. */
+    void reset() noexcept { position = fadeIn.size(); }
+
+    /**
+     * Run the channel-mode stage for one stereo block while fading into toKernel.
+     * left/right hold the signal entering the stage and are overwritten with its output.
+     * Frames after the end of the fade get toKernel alone.
+     */
+    void process(unsigned toKernel, SampleType *left, SampleType *right, size_t numSamples,
+                 ChannelModeState &state) noexcept;
+
+private:
+    std::vector<SampleType> scratchLeft, scratchRight;
+    std::vector<SampleType> fadeIn, fadeOut;
+
+    unsigned sourceKernel = 0;
+    size_t position = 0;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "SpectralSeparator.h"
+#include "../../Utility/ChannelMode.h"
+
+/** State carried between blocks by the channel-mode stage (audio thread only). */
+struct ChannelModeState {
+    // Smoothed gains for click-free enable/disable transitions (Tonal/Transient only)
+    juce::SmoothedValue<float> primaryGain;
+    juce::SmoothedValue<float> secondaryGain;
+
+    // Tonal/Transient separation, owned by gFractorDSP; without one those kernels pass through
+    SpectralSeparator *separator = nullptr;
+};
+
+/**
+ * Channel-mode output stage, specialised at compile time.
+ *
+ * Every (mode, primary enabled, secondary enabled) combination is its own kernel, so the
+ * per-sample loops never test the enable flags. gFractorDSP resolves the kernel once per
+ * block with select() and runs it through a dispatch table. Kernels are templated on the
+ * sample type, with one dispatch table per type.
+ *
+ * Kernel index layout: bits 2..3 = mode slot, bit 1 = primary on, bit 0 = secondary on.
+ * Mode slots 0..2 follow channelModeToInt(); slot 3 is Tonal/Transient while its gains are
+ * still ramping, which needs the smoothers and therefore ignores the enable bits.
+ *
+ * The Tonal/Transient kernels are "spectral": they hand the whole block to the state's
+ * SpectralSeparator (transient = primary, tonal = secondary) instead of working per frame,
+ * so the fused per-frame path in gFractorDSP runs them as a separate pass.
+ */
+namespace ChannelModeKernels {
+    constexpr unsigned kMidSide = 0;
+    constexpr unsigned kLR = 1;
+    constexpr unsigned kTonalTransient = 2;
+    constexpr unsigned kTonalTransientRamp = 3;
+
+    constexpr size_t kNumKernels = 16;
+
+    constexpr unsigned makeIndex(const unsigned modeSlot, const bool primOn, const bool secOn) noexcept {
+        return (modeSlot << 2) | (primOn ? 2u : 0u) | (secOn ? 1u : 0u);
+    }
+
+    /** A kernel that leaves the signal untouched (M/S with both channels on). */
+    constexpr unsigned kIdentity = makeIndex(kMidSide, true, true);
+
+    /** Folds indices that share a kernel (the ramping slot ignores the enable bits). */
+    constexpr unsigned canonicalise(const unsigned index) noexcept {
+        return (index >> 2) == kTonalTransientRamp ? makeIndex(kTonalTransientRamp, false, false) : index;
+    }
+
+    template<unsigned Index>
+    struct Kernel {
+        static constexpr unsigned modeSlot = Index >> 2;
+        static constexpr bool primOn = (Index & 2u) != 0;
+        static constexpr bool secOn = (Index & 1u) != 0;
+
+        /** Tonal/Transient: block-based STFT separation, no per-frame form. */
+        static constexpr bool isSpectral = modeSlot == kTonalTransient || modeSlot == kTonalTransientRamp;
+
+        /** M/S and L/R with both channels on leave the signal untouched. */
+        static constexpr bool isIdentity = !isSpectral && primOn && secOn;
+
+        /** One stereo frame of an M/S or L/R kernel. Shared by process() and the fused path in gFractorDSP. */
+        template<typename SampleType>
+        static void processFrame(SampleType &left, SampleType &right) noexcept {
+            static_assert(!isSpectral, "Tonal/Transient kernels only run per block");
+
+            if constexpr (isIdentity) {
+                juce::ignoreUnused(left, right);
+            } else if constexpr (modeSlot == kMidSide) {
+                if constexpr (primOn) {
+                    const SampleType mid = (left + right) * SampleType(0.5);
+                    left = mid;
+                    right = mid;
+                } else if constexpr (secOn) {
+                    const SampleType side = (left - right) * SampleType(0.5);
+                    left = side;
+                    right = -side;
+                } else {
+                    left = SampleType(0);
+                    right = SampleType(0);
+                }
+            } else {
+                if constexpr (!primOn) left = SampleType(0);
+                if constexpr (!secOn) right = SampleType(0);
+            }
+        }
+
+        template<typename SampleType>
+        static void process(SampleType *left, SampleType *right, const size_t numSamples,
+                            ChannelModeState &state) noexcept {
+            if constexpr (isIdentity) {
+                juce::ignoreUnused(left, right, numSamples, state);
+            } else if constexpr (isSpectral) {
+                // Settled and ramping gains take the same path; the separator applies them per sample.
+                if (state.separator != nullptr)
+                    state.separator->process(left, right, numSamples, state.primaryGain, state.secondaryGain);
+            } else {
+                juce::ignoreUnused(state);
+                for (size_t i = 0; i < numSamples; ++i)
+                    processFrame(left[i], right[i]);
+            }
+        }
+    };
+
+    template<typename SampleType>
+    using KernelFn = void (*)(SampleType *, SampleType *, size_t, ChannelModeState &) noexcept;
+
+    template<typename SampleType, size_t... Indices>
+    constexpr std::array<KernelFn<SampleType>, sizeof...(Indices)> makeTable(std::index_sequence<Indices...>) {
+        return {{&Kernel<canonicalise(static_cast<unsigned>(Indices))>::template process<SampleType>...}};
+    }
+
+    /**
+     * Resolve the kernel for this block. Tonal/Transient retargets its gain smoothers here
+     * and uses the ramping kernel until both have settled.
+     */
+    inline unsigned select(const ChannelMode mode, const bool primOn, const bool secOn,
+                           ChannelModeState &state) noexcept {
+        const auto modeSlot = static_cast<unsigned>(channelModeToInt(mode));
+
+        if (modeSlot == kTonalTransient) {
+            state.primaryGain.setTargetValue(primOn ? 1.0f : 0.0f);
+            state.secondaryGain.setTargetValue(secOn ? 1.0f : 0.0f);
+
+            if (state.primaryGain.isSmoothing() || state.secondaryGain.isSmoothing())
+                return makeIndex(kTonalTransientRamp, false, false);
+        }
+
+        return makeIndex(modeSlot, primOn, secOn);
+    }
+
+    /** Whether a kernel index is one of the Tonal/Transient (per-block) kernels. */
+    constexpr bool isSpectral(const unsigned index) noexcept {
+        const unsigned modeSlot = index >> 2;
+        return modeSlot == kTonalTransient || modeSlot == kTonalTransientRamp;
+    }
+
+    /** Whether a kernel index leaves the signal untouched (M/S or L/R with both channels on). */
+    constexpr bool isIdentity(const unsigned index) noexcept {
+        return !isSpectral(index) && (index & 3u) == 3u;
+    }
+
+    /** Run the kernel returned by select() over one stereo block. */
+    template<typename SampleType>
+    void process(const unsigned index, SampleType *left, SampleType *right, const size_t numSamples,
+                 ChannelModeState &state) noexcept {
+        static constexpr auto kernels = makeTable<SampleType>(std::make_index_sequence<kNumKernels>());
+        kernels[index](left, right, numSamples, state);
+    }
+}
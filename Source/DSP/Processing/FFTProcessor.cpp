@@ -68,20 +68,28 @@ void FFTProcessor::setSmoothing(const SmoothingMode mode) {
     smoothingStrategy->computeRanges(numBins, sampleRate, fftSize, smoothingRanges);
 }
 
-void FFTProcessor::processBlock(const std::vector<float> &srcL, const std::vector<float> &srcR,
-                                const int srcWritePos,
+void FFTProcessor::processBlock(const float *windowL, const float *windowR,
                                 std::vector<float> &outPrimaryDb, std::vector<float> &outSecondaryDb) {
-    // Unwrap circular buffer into FFT input, applying channel decode + window
-    for (int j = 0; j < fftSize; ++j) {
-        const int idx = (srcWritePos + j) % fftSize;
-        const float l = srcL[static_cast<size_t>(idx)];
-        const float r = srcR[static_cast<size_t>(idx)];
-        const float w = hannWindow[static_cast<size_t>(j)];
-
-        float ch1, ch2;
-        ChannelDecoder::decode(channelMode, l, r, ch1, ch2);
-        fftDataPrimary[static_cast<size_t>(j)] = ch1 * w;
-        fftDataSecondary[static_cast<size_t>(j)] = ch2 * w;
+    // Channel decode (as ChannelDecoder::decode) + window, vectorised over the contiguous input
+    using FVO = juce::FloatVectorOperations;
+    float *primary = fftDataPrimary.data();
+    float *secondary = fftDataSecondary.data();
+
+    if (channelMode == ChannelMode::LR) {
+        FVO::multiply(primary, windowL, hannWindow.data(), fftSize);
+        FVO::multiply(secondary, windowR, hannWindow.data(), fftSize);
+    } else {
+        FVO::add(primary, windowL, windowR, fftSize);
+        if (channelMode == ChannelMode::TonalTransient)
+            FVO::copy(secondary, primary, fftSize);
+        else
+            FVO::subtract(secondary, windowL, windowR, fftSize);
+
+        // Halving is exact, so the order of the two scalings does not matter
+        FVO::multiply(primary, hannWindow.data(), fftSize);
+        FVO::multiply(secondary, hannWindow.data(), fftSize);
+        FVO::multiply(primary, 0.5f, fftSize);
+        FVO::multiply(secondary, 0.5f, fftSize);
     }
 
     // Zero imaginary parts
@@ -135,6 +143,31 @@ void FFTProcessor::processBlock(const std::vector<float> &srcL, const std::vecto
     }
 }
 
+bool FFTProcessor::processSilentBlock(std::vector<float> &outPrimaryDb, std::vector<float> &outSecondaryDb) {
+    if (channelMode == ChannelMode::TonalTransient)
+        for (auto &tonal: tonalAccum)
+            tonal *= kTonalDecay;
+
+    constexpr float kFloorToleranceDb = 0.01f;
+    bool aboveFloor = false;
+
+    for (int bin = 0; bin < numBins; ++bin) {
+        auto &smPrimary = outPrimaryDb[static_cast<size_t>(bin)];
+        auto &smSecondary = outSecondaryDb[static_cast<size_t>(bin)];
+
+        smPrimary = juce::jmax(minDb, smPrimary * temporalDecay + minDb * (1.0f - temporalDecay));
+        smSecondary = juce::jmax(minDb, smSecondary * temporalDecay + minDb * (1.0f - temporalDecay));
+        aboveFloor = aboveFloor || smPrimary > minDb + kFloorToleranceDb || smSecondary > minDb + kFloorToleranceDb;
+    }
+
+    if (smoothingMode != SmoothingMode::None) {
+        applyOctaveSmoothing(outPrimaryDb);
+        applyOctaveSmoothing(outSecondaryDb);
+    }
+
+    return aboveFloor;
+}
+
 void FFTProcessor::applyOctaveSmoothing(std::vector<float> &dbData) const {
     // Build prefix sum so each bin's range average is O(1) instead of O(range_width)
     smoothingPrefix[0] = 0.0f;
@@ -20,7 +20,7 @@
  *  - Optional 1/3-octave smoothing
  *
  * Extracted from SpectrumAnalyzer to separate DSP concerns from rendering.
- * Both SpectrumAnalyzer and GhostSpectrum can compose an FFTProcessor.
+ * SpectrumAnalysisWorker runs one for both the main and the ghost curves.
  */
 class FFTProcessor {
 public:
@@ -51,18 +51,23 @@ public:
     void setTemporalDecay(const float decay) { temporalDecay = juce::jlimit(0.0f, 1.0f, decay); }
 
     /**
-     * Process one FFT block from circular buffer data.
+     * Process one FFT block from a contiguous input window.
      *
-     * @param srcL         Left channel rolling buffer
-     * @param srcR         Right channel rolling buffer
-     * @param srcWritePos  Current write position in the rolling buffer
+     * @param windowL      Left channel, getFftSize() samples oldest first (e.g. a MirroredRing window)
+     * @param windowR      Right channel, likewise
      * @param outPrimaryDb     Output: temporally smoothed primary dB values
      * @param outSecondaryDb    Output: temporally smoothed secondary dB values
      */
-    void processBlock(const std::vector<float> &srcL, const std::vector<float> &srcR,
-                      int srcWritePos,
+    void processBlock(const float *windowL, const float *windowR,
                       std::vector<float> &outPrimaryDb, std::vector<float> &outSecondaryDb);
 
+    /**
+     * Same smoothing as processBlock() for an all-zero window, without the FFT: every bin
+     * decays towards the floor at the temporal decay rate.
+     * @return true while any bin is still above the floor (0.01 dB)
+     */
+    bool processSilentBlock(std::vector<float> &outPrimaryDb, std::vector<float> &outSecondaryDb);
+
     // Accessors
     int getFftOrder() const { return fftOrder; }
     int getFftSize() const { return fftSize; }
@@ -86,7 +91,7 @@ private:
     // Windowing
     std::vector<float> hannWindow;
 
-    // Work buffers (UI thread only)
+    // Work buffers (one thread: the analysis worker)
     std::vector<float> fftDataPrimary;
     std::vector<float> fftDataSecondary;
 
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "../Interfaces/IFilterBank.h"
+#include "BandpassFilter.h"
+#include "BandSoloBank.h"
+
+/**
+ * The monitoring filters driven from the spectrum analyzer, in processing order:
+ *   1. transient audition bell filter (right-click)
+ *   2. band selection filter (band hint click)
+ *   3. band solo / mute bank (any subset of kBands)
+ *
+ * Thread-safe in the same way as its members: setters on the message thread,
+ * everything else on the audio thread.
+ *
+ * gFractorDSP runs it through process(ProcessContextReplacing) in the staged pipeline and
+ * through beginBlock() / processStereo() / endBlock() on chunks in the fused one.
+ * SampleType follows gFractorDSP's; the solo bank keeps float lanes for either type.
+ */
+template<typename SampleType>
+class FilterBank : public IFilterBank<SampleType> {
+public:
+    //==============================================================================
+    // IFilterBank implementation
+    void prepare(const juce::dsp::ProcessSpec &spec) override {
+        auditFilter.prepare(spec);
+        bandFilter.prepare(spec);
+        bandSolo.prepare(spec);
+    }
+
+    void process(juce::AudioBuffer<SampleType> &buffer) override {
+        juce::dsp::AudioBlock<SampleType> block(buffer);
+        juce::dsp::ProcessContextReplacing context(block);
+        process(context);
+    }
+
+    void reset() override {
+        auditFilter.reset();
+        bandFilter.reset();
+        bandSolo.reset();
+    }
+
+    void setAuditFilter(const bool active, const float frequencyHz, const float q) override {
+        auditFilter.setParams(active, frequencyHz, q);
+    }
+
+    void setBandFilter(const bool active, const float frequencyHz, const float q) override {
+        bandFilter.setParams(active, frequencyHz, q);
+    }
+
+    void setBandSolo(const juce::uint32 bandMask) override { bandSolo.setSoloMask(bandMask); }
+
+    void setBandMute(const juce::uint32 bandMask) override { bandSolo.setMuteMask(bandMask); }
+
+    //==============================================================================
+    /** Called from the audio thread (processBlock). */
+    void process(juce::dsp::ProcessContextReplacing<SampleType> &context) {
+        auditFilter.process(context);
+        bandFilter.process(context);
+        bandSolo.process(context);
+    }
+
+    /**
+     * Fused path: picks up parameter changes for every filter.
+     * @return true if at least one filter is active for this block
+     */
+    bool beginBlock() noexcept {
+        auditActive = auditFilter.beginBlock();
+        bandActive = bandFilter.beginBlock();
+        soloActive = bandSolo.beginBlock();
+        return auditActive || bandActive || soloActive;
+    }
+
+    /** Stereo chunk for the fused pipeline. Only valid after beginBlock() returned true. */
+    void processStereo(SampleType *left, SampleType *right, const size_t numSamples) noexcept {
+        if (auditActive)
+            auditFilter.processStereo(left, right, numSamples);
+        if (bandActive)
+            bandFilter.processStereo(left, right, numSamples);
+        if (soloActive)
+            bandSolo.processStereo(left, right, numSamples);
+    }
+
+    /** Call after a block of processStereo() calls. */
+    void endBlock() noexcept {
+        if (auditActive)
+            auditFilter.endBlock();
+        if (bandActive)
+            bandFilter.endBlock();
+        if (soloActive)
+            bandSolo.endBlock();
+    }
+
+private:
+    // Transient audition bell filter — 4th order (two cascaded 2nd-order BPFs)
+    BandpassFilter<SampleType> auditFilter;
+
+    // Band selection filter — 4th order (two cascaded 2nd-order BPFs)
+    BandpassFilter<SampleType> bandFilter;
+
+    // Solo / mute over all analyzer bands at once
+    BandSoloBank bandSolo;
+
+    // Which filters beginBlock() found active (audio thread only)
+    bool auditActive = false;
+    bool bandActive = false;
+    bool soloActive = false;
+};
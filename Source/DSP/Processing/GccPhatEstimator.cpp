@@ -0,0 +1,159 @@
+#include "GccPhatEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr size_t kFrameSize = GccPhatEstimator::getFrameSize();
+    constexpr size_t kHopSize = kFrameSize / 2;
+
+    double meanSquareDb(const std::vector<float> &samples) noexcept {
+        double energy = 0.0;
+        for (const float s: samples)
+            energy += static_cast<double>(s) * static_cast<double>(s);
+        return 10.0 * std::log10(energy / static_cast<double>(samples.size()) + 1.0e-30);
+    }
+}
+
+GccPhatEstimator::GccPhatEstimator()
+    : fft(std::make_unique<juce::dsp::FFT>(kFrameOrder)) {
+    window.resize(kFrameSize);
+    for (size_t i = 0; i < kFrameSize; ++i)
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi
+                                                            * static_cast<double>(i)
+                                                            / static_cast<double>(kFrameSize)));
+
+    firstInput.assign(kFrameSize, 0.0f);
+    secondInput.assign(kFrameSize, 0.0f);
+    firstFrame.assign(2 * kFrameSize, 0.0f);
+    secondFrame.assign(2 * kFrameSize, 0.0f);
+    correlation.assign(2 * kFrameSize, 0.0f);
+}
+
+void GccPhatEstimator::prepare(const double newSampleRate, const int newFactor, const int newMaxLag) {
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 11025.0;
+    factor = juce::jmax(1, newFactor);
+    maxLag = juce::jlimit(0, static_cast<int>(kFrameSize / 4), newMaxLag);
+
+    numBins = juce::jlimit<size_t>(2, kFrameSize / 2,
+                                   static_cast<size_t>(kPassbandFraction * static_cast<double>(kFrameSize / 2)));
+    crossPower.assign(numBins, {});
+    phase.assign(numBins, {});
+    reset();
+}
+
+void GccPhatEstimator::reset() {
+    std::fill(firstInput.begin(), firstInput.end(), 0.0f);
+    std::fill(secondInput.begin(), secondInput.end(), 0.0f);
+    std::fill(crossPower.begin(), crossPower.end(), std::complex<double>());
+    fill = 0;
+    numFrames = 0;
+}
+
+void GccPhatEstimator::pushSamples(const float *first, const float *second, const size_t numSamples) {
+    size_t done = 0;
+    while (done < numSamples) {
+        const size_t len = juce::jmin(numSamples - done, kFrameSize - fill);
+        std::copy(first + done, first + done + len, firstInput.begin() + static_cast<std::ptrdiff_t>(fill));
+        std::copy(second + done, second + done + len, secondInput.begin() + static_cast<std::ptrdiff_t>(fill));
+        done += len;
+        fill += len;
+
+        if (fill < kFrameSize)
+            continue;
+
+        analyseFrame();
+
+        // 50% overlap: the second half starts the next frame
+        std::copy(firstInput.begin() + static_cast<std::ptrdiff_t>(kHopSize), firstInput.end(), firstInput.begin());
+        std::copy(secondInput.begin() + static_cast<std::ptrdiff_t>(kHopSize), secondInput.end(), secondInput.begin());
+        fill = kHopSize;
+    }
+}
+
+double GccPhatEstimator::getAnalysedSeconds() const noexcept {
+    return static_cast<double>(numFrames * kHopSize) / sampleRate;
+}
+
+void GccPhatEstimator::analyseFrame() {
+    if (crossPower.empty() || meanSquareDb(firstInput) < kSilenceDb || meanSquareDb(secondInput) < kSilenceDb)
+        return;
+
+    for (size_t i = 0; i < kFrameSize; ++i) {
+        firstFrame[i] = firstInput[i] * window[i];
+        secondFrame[i] = secondInput[i] * window[i];
+    }
+    std::fill(firstFrame.begin() + static_cast<std::ptrdiff_t>(kFrameSize), firstFrame.end(), 0.0f);
+    std::fill(secondFrame.begin() + static_cast<std::ptrdiff_t>(kFrameSize), secondFrame.end(), 0.0f);
+    fft->performRealOnlyForwardTransform(firstFrame.data(), true);
+    fft->performRealOnlyForwardTransform(secondFrame.data(), true);
+
+    // A plain mean until the exponential window is full, so early frames are not under-weighted
+    ++numFrames;
+    const double decay = std::exp(-static_cast<double>(kHopSize) / (kAveragingSeconds * sampleRate));
+    const double weight = juce::jmax(1.0 / static_cast<double>(numFrames), 1.0 - decay);
+
+    // second * conj(first): a delay d of second turns into a phase of -2 pi k d / N
+    for (size_t k = 0; k < numBins; ++k) {
+        const std::complex<double> x(firstFrame[2 * k], firstFrame[2 * k + 1]);
+        const std::complex<double> y(secondFrame[2 * k], secondFrame[2 * k + 1]);
+        crossPower[k] += weight * (y * std::conj(x) - crossPower[k]);
+    }
+}
+
+double GccPhatEstimator::correlationAt(const double lag) const noexcept {
+    // Sum of the phase-transformed bins turned back by the lag, through a rotating phasor
+    const std::complex<double> step = std::polar(1.0, 2.0 * juce::MathConstants<double>::pi * lag
+                                                      / static_cast<double>(kFrameSize));
+    std::complex<double> rotation = step;
+    double sum = 0.0;
+
+    for (size_t k = 1; k < numBins; ++k) {
+        sum += (phase[k] * rotation).real();
+        rotation *= step;
+    }
+    return sum / static_cast<double>(numBins - 1);
+}
+
+bool GccPhatEstimator::estimate(Estimate &result) {
+    if (numFrames == 0 || crossPower.empty() || getAnalysedSeconds() < kMinAnalysisSeconds)
+        return false;
+
+    // PHAT weighting: keep the phase, drop the magnitude; DC and the band above the passband are out
+    std::fill(correlation.begin(), correlation.end(), 0.0f);
+    for (size_t k = 1; k < numBins; ++k) {
+        const double magnitude = std::abs(crossPower[k]);
+        phase[k] = magnitude > 1.0e-30 ? crossPower[k] / magnitude : std::complex<double>();
+        correlation[2 * k] = static_cast<float>(phase[k].real());
+        correlation[2 * k + 1] = static_cast<float>(phase[k].imag());
+    }
+    fft->performRealOnlyInverseTransform(correlation.data());
+
+    // Coarse peak on the frame's sample grid, negative lags wrapped to the end
+    int coarse = 0;
+    float peak = correlation[0];
+    for (int lag = -maxLag; lag <= maxLag; ++lag) {
+        const float value = correlation[static_cast<size_t>((lag + static_cast<int>(kFrameSize))
+                                                            % static_cast<int>(kFrameSize))];
+        if (value > peak) {
+            peak = value;
+            coarse = lag;
+        }
+    }
+
+    // Fine peak on the undecimated grid, from the band-limited correlation between samples
+    int best = 0;
+    double bestValue = -1.0;
+    for (int j = -factor; j <= factor; ++j) {
+        const double value = correlationAt(static_cast<double>(coarse)
+                                           + static_cast<double>(j) / static_cast<double>(factor));
+        if (value > bestValue) {
+            bestValue = value;
+            best = j;
+        }
+    }
+
+    result.lagSamples = coarse * factor + best;
+    result.confidence = static_cast<float>(juce::jmax(0.0, bestValue));
+    return true;
+}
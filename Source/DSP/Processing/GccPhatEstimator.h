@@ -0,0 +1,87 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * GccPhatEstimator
+ *
+ * The non-realtime half of the sidechain alignment: measures how far one signal lags another
+ * with the generalised cross-correlation under the phase transform (GCC-PHAT).
+ *
+ * Measurement: kFrameOrder-point Hann frames of both signals at 50% overlap. The cross-power
+ * spectrum is averaged with an exponential window of kAveragingSeconds (a plain mean until that
+ * much has been heard); frames where either side is quieter than kSilenceDb are skipped.
+ *
+ * Estimate: each averaged bin is reduced to its phase and the inverse FFT gives a correlation
+ * whose peak is the lag, independent of either signal's spectrum, so a filtered or compressed
+ * parallel return still correlates sharply. The search covers +/- the prepared maximum lag.
+ *
+ * The input is usually decimated: prepare() takes the decimation factor, the estimate refines the
+ * peak to 1 / factor of an input sample by evaluating the band-limited correlation between the
+ * frame's samples, and reports the lag in samples of the undecimated signal. Only bins below
+ * kPassbandFraction of Nyquist (the decimation filter's passband) take part.
+ *
+ * Not thread-safe: one thread at a time, never the audio thread (prepare() allocates).
+ */
+class GccPhatEstimator {
+public:
+    static constexpr int kFrameOrder = 13; // 8192-point frames
+    static constexpr double kAveragingSeconds = 2.0;
+    static constexpr double kMinAnalysisSeconds = 1.0;
+    static constexpr float kSilenceDb = -70.0f;
+    static constexpr double kPassbandFraction = 0.8;
+
+    /** One estimate: the lag of the second signal behind the first, in undecimated samples. */
+    struct Estimate {
+        int lagSamples = 0;
+        float confidence = 0.0f; // peak of the phase correlation, 1 for a pure delay
+    };
+
+    GccPhatEstimator();
+
+    /**
+     * sampleRate is the rate of the pushed (decimated) samples; factor the decimation behind it.
+     * maxLag (pushed samples) is limited to a quarter frame.
+     */
+    void prepare(double sampleRate, int factor, int maxLag);
+
+    /** Forget the measured cross-spectrum. */
+    void reset();
+
+    /** Feed both signals, sample-aligned with each other; complete frames are analysed as they fill. */
+    void pushSamples(const float *first, const float *second, size_t numSamples);
+
+    /** Seconds of (non-silent) input in the average. */
+    double getAnalysedSeconds() const noexcept;
+
+    static constexpr size_t getFrameSize() noexcept { return size_t{1} << kFrameOrder; }
+
+    /** Lag of second behind first. False until kMinAnalysisSeconds have been measured. */
+    bool estimate(Estimate &result);
+
+private:
+    void analyseFrame();
+
+    /** Phase correlation at a fractional lag (pushed samples), 1 for a perfect match. */
+    double correlationAt(double lag) const noexcept;
+
+    double sampleRate = 11025.0;
+    int factor = 1;
+    int maxLag = 0;
+    size_t numBins = 0; // 1 .. numBins - 1 take part
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    std::vector<float> firstInput, secondInput; // one frame collecting, as MatchEqDesigner
+    std::vector<float> firstFrame, secondFrame; // FFT scratch
+    size_t fill = 0;
+
+    std::vector<std::complex<double>> crossPower;
+    std::vector<std::complex<double>> phase; // unit phasors of crossPower for the refinement
+    std::vector<float> correlation;
+    size_t numFrames = 0;
+};
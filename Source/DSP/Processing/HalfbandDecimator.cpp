@@ -0,0 +1,123 @@
+#include "HalfbandDecimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <juce_core/juce_core.h>
+
+namespace {
+    // Kaiser beta for kStopbandDb of attenuation
+    constexpr double kKaiserBeta = 0.1102 * (HalfbandDecimator::kStopbandDb - 8.7);
+
+    // Zeroth-order modified Bessel function of the first kind, by its power series
+    double besselI0(const double x) noexcept {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50 && term > 1.0e-12 * sum; ++k) {
+            const double t = x / (2.0 * static_cast<double>(k));
+            term *= t * t;
+            sum += term;
+        }
+        return sum;
+    }
+}
+
+HalfbandDecimator::HalfbandDecimator() {
+    // h(d) = sin(pi d / 2) / (pi d) under a Kaiser window; only odd offsets d are non-zero
+    constexpr double halfSpan = 0.5 * static_cast<double>(kNumTaps - 1);
+    double sum = 0.0;
+    for (int j = 0; j < kHalfLength; ++j) {
+        const double d = static_cast<double>(2 * (kHalfLength - j) - 1);
+        const double ratio = d / halfSpan;
+        const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) / besselI0(kKaiserBeta);
+        const double tap = std::sin(0.5 * juce::MathConstants<double>::pi * d)
+                           / (juce::MathConstants<double>::pi * d) * window;
+        coefficients[static_cast<size_t>(j)] = static_cast<float>(tap);
+        sum += tap;
+    }
+
+    // Unity at DC: the centre tap is 1/2, the pairs on either side share the other half
+    for (auto &c: coefficients)
+        c = static_cast<float>(c * 0.25 / sum);
+}
+
+int HalfbandDecimator::stagesFor(const double sampleRate, const double maxVisibleHz) noexcept {
+    int stageCount = 0;
+    double outputRate = sampleRate * 0.5;
+    while (stageCount < kMaxStages && outputRate >= kMinOutputRate
+           && outputRate * kPassbandFraction >= maxVisibleHz) {
+        ++stageCount;
+        outputRate *= 0.5;
+    }
+    return stageCount;
+}
+
+void HalfbandDecimator::setNumStages(const int newNumStages) noexcept {
+    const int clamped = juce::jlimit(0, kMaxStages, newNumStages);
+    if (clamped == numStages)
+        return;
+
+    numStages = clamped;
+    reset();
+}
+
+void HalfbandDecimator::reset() noexcept {
+    for (auto &stage: stages)
+        stage = Stage{};
+}
+
+//==============================================================================
+void HalfbandDecimator::Channel::pushOdd(const float sample) noexcept {
+    odd[static_cast<size_t>(oddPosition)] = sample;
+    odd[static_cast<size_t>(oddPosition + kHalfLength)] = sample;
+    oddPosition = oddPosition + 1 == kHalfLength ? 0 : oddPosition + 1;
+}
+
+float HalfbandDecimator::Channel::pushEven(const float sample,
+                                           const std::array<float, kHalfLength> &taps) noexcept {
+    constexpr int evenLength = 2 * kHalfLength;
+    even[static_cast<size_t>(evenPosition)] = sample;
+    even[static_cast<size_t>(evenPosition + evenLength)] = sample;
+    evenPosition = evenPosition + 1 == evenLength ? 0 : evenPosition + 1;
+
+    // Oldest first from the write position; the j-th oldest pairs with the j-th newest
+    const float *span = even.data() + evenPosition;
+    float sum = 0.0f;
+    for (int j = 0; j < kHalfLength; ++j)
+        sum += taps[static_cast<size_t>(j)] * (span[j] + span[evenLength - 1 - j]);
+
+    // The centre tap lands on the oldest of the last kHalfLength odd-phase samples
+    return sum + 0.5f * odd[static_cast<size_t>(oddPosition)];
+}
+
+int HalfbandDecimator::processStage(Stage &stage, const std::array<float, kHalfLength> &taps,
+                                    const float *left, const float *right, const int numSamples,
+                                    float *outLeft, float *outRight) noexcept {
+    // Writes trail the reads (count <= i / 2), so a later stage may run in place
+    int count = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        const float l = left[i];
+        const float r = right[i];
+
+        if (stage.oddPending) {
+            stage.left.pushOdd(l);
+            stage.right.pushOdd(r);
+        } else {
+            outLeft[count] = stage.left.pushEven(l, taps);
+            outRight[count] = stage.right.pushEven(r, taps);
+            ++count;
+        }
+        stage.oddPending = !stage.oddPending;
+    }
+    return count;
+}
+
+int HalfbandDecimator::process(const float *left, const float *right, const int numSamples,
+                               float *outLeft, float *outRight) noexcept {
+    if (numStages == 0 || numSamples <= 0)
+        return 0;
+
+    int count = processStage(stages[0], coefficients, left, right, numSamples, outLeft, outRight);
+    for (int s = 1; s < numStages; ++s)
+        count = processStage(stages[static_cast<size_t>(s)], coefficients, outLeft, outRight, count,
+                             outLeft, outRight);
+    return count;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+
+/**
+ * HalfbandDecimator
+ *
+ * Stereo cascade of up to kMaxStages 2:1 decimators, each a kNumTaps-tap Kaiser-windowed
+ * halfband low-pass in polyphase form. Every other tap of a halfband filter is zero, so each
+ * output costs kHalfLength multiplies on the paired even-phase samples plus the centre tap of
+ * the odd phase, and the filter only ever runs at the output rate.
+ *
+ * The passband is flat (within 0.001 dB) up to kPassbandFraction of each stage's output rate;
+ * everything that would fold back below that edge is at least kStopbandDb down. It feeds the
+ * analyzer's FFT at a lower rate when the host runs at 88.2 kHz and above, so the same FFT
+ * order spends its bins on the visible range.
+ *
+ * Realtime-safe: fixed-size state, no allocation. setNumStages() and process() belong to one
+ * thread (the UI thread, for AudioRingBuffer).
+ */
+class HalfbandDecimator {
+public:
+    static constexpr int kMaxStages = 3;
+    static constexpr int kHalfLength = 16;                  // coefficient pairs per stage
+    static constexpr int kNumTaps = 4 * kHalfLength - 1;    // 63, including the zeros
+    static constexpr double kPassbandFraction = 0.419;      // of the stage's output rate
+    static constexpr double kStopbandDb = 80.0;
+    static constexpr double kMinOutputRate = 44100.0;       // stagesFor() never goes below it
+
+    HalfbandDecimator();
+
+    /**
+     * Most stages that keep maxVisibleHz inside the passband at sampleRate / 2^stages, without
+     * dropping below kMinOutputRate (a standard-rate host stays undecimated).
+     */
+    static int stagesFor(double sampleRate, double maxVisibleHz) noexcept;
+
+    /** 0 passes nothing through process(); changing the count clears the filter state. */
+    void setNumStages(int numStages) noexcept;
+    int getNumStages() const noexcept { return numStages; }
+
+    /** Clear every stage's history. */
+    void reset() noexcept;
+
+    /**
+     * Decimate numSamples of left/right into outLeft/outRight (room for numSamples / 2^stages + 1
+     * each); returns the number of samples written. The outputs must not alias the inputs.
+     */
+    int process(const float *left, const float *right, int numSamples, float *outLeft, float *outRight) noexcept;
+
+private:
+    // One channel of one stage; histories are written twice, so each read is one linear span
+    struct Channel {
+        std::array<float, 4 * kHalfLength> even{};
+        std::array<float, 2 * kHalfLength> odd{};
+        int evenPosition = 0;
+        int oddPosition = 0;
+
+        void pushOdd(float sample) noexcept;
+        float pushEven(float sample, const std::array<float, kHalfLength> &taps) noexcept;
+    };
+
+    struct Stage {
+        Channel left, right;
+        bool oddPending = true; // the next input is the odd-phase sample of a pair
+    };
+
+    static int processStage(Stage &stage, const std::array<float, kHalfLength> &taps,
+                            const float *left, const float *right, int numSamples,
+                            float *outLeft, float *outRight) noexcept;
+
+    std::array<float, kHalfLength> coefficients{}; // outermost pair first
+    std::array<Stage, kMaxStages> stages{};
+    int numStages = 0;
+};
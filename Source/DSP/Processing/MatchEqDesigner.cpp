@@ -0,0 +1,201 @@
+#include "MatchEqDesigner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr size_t kAnalysisSize = size_t{1} << MatchEqDesigner::kAnalysisOrder;
+    constexpr size_t kHopSize = kAnalysisSize / 2;
+    constexpr size_t kDesignSize = size_t{1} << MatchEqDesigner::kDesignOrder;
+
+    // Linear interpolation of a per-bin curve at a fractional bin, clamped to its ends
+    float interpolate(const std::vector<float> &curve, const double bin) noexcept {
+        const double last = static_cast<double>(curve.size() - 1);
+        const double pos = juce::jlimit(0.0, last, bin);
+        const auto index = static_cast<size_t>(pos);
+        if (index + 1 >= curve.size())
+            return curve.back();
+
+        const auto frac = static_cast<float>(pos - static_cast<double>(index));
+        return curve[index] + frac * (curve[index + 1] - curve[index]);
+    }
+
+    // 0 at or below from, 1 at or above to, linear in log frequency between
+    float logRamp(const double frequency, const double from, const double to) noexcept {
+        if (frequency <= from)
+            return 0.0f;
+        if (frequency >= to)
+            return 1.0f;
+        return static_cast<float>(std::log(frequency / from) / std::log(to / from));
+    }
+}
+
+MatchEqDesigner::MatchEqDesigner()
+    : analysisFft(std::make_unique<juce::dsp::FFT>(kAnalysisOrder)),
+      designFft(std::make_unique<juce::dsp::FFT>(kDesignOrder)) {
+    window.resize(kAnalysisSize);
+    for (size_t i = 0; i < kAnalysisSize; ++i)
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi
+                                                            * static_cast<double>(i)
+                                                            / static_cast<double>(kAnalysisSize)));
+
+    input.assign(kAnalysisSize, 0.0f);
+    frame.assign(2 * kAnalysisSize, 0.0f);
+    averagePower.assign(getNumBins(), 0.0);
+}
+
+void MatchEqDesigner::prepare(const double newSampleRate) {
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    reset();
+}
+
+void MatchEqDesigner::reset() {
+    std::fill(input.begin(), input.end(), 0.0f);
+    std::fill(averagePower.begin(), averagePower.end(), 0.0);
+    measuredDb.clear();
+    fill = 0;
+    numFrames = 0;
+}
+
+void MatchEqDesigner::pushSamples(const float *samples, const size_t numSamples) {
+    size_t done = 0;
+    while (done < numSamples) {
+        const size_t len = juce::jmin(numSamples - done, kAnalysisSize - fill);
+        std::copy(samples + done, samples + done + len, input.begin() + static_cast<std::ptrdiff_t>(fill));
+        done += len;
+        fill += len;
+
+        if (fill < kAnalysisSize)
+            continue;
+
+        analyseFrame();
+
+        // 50% overlap: the second half starts the next frame
+        std::copy(input.begin() + static_cast<std::ptrdiff_t>(kHopSize), input.end(), input.begin());
+        fill = kHopSize;
+    }
+}
+
+double MatchEqDesigner::getAnalysedSeconds() const noexcept {
+    return static_cast<double>(numFrames * kHopSize) / sampleRate;
+}
+
+void MatchEqDesigner::analyseFrame() {
+    double energy = 0.0;
+    for (const float s: input)
+        energy += static_cast<double>(s) * static_cast<double>(s);
+
+    const auto levelDb = static_cast<float>(10.0 * std::log10(energy / static_cast<double>(kAnalysisSize) + 1.0e-30));
+    if (levelDb < kSilenceDb)
+        return;
+
+    for (size_t i = 0; i < kAnalysisSize; ++i)
+        frame[i] = input[i] * window[i];
+    std::fill(frame.begin() + static_cast<std::ptrdiff_t>(kAnalysisSize), frame.end(), 0.0f);
+    analysisFft->performRealOnlyForwardTransform(frame.data(), true);
+
+    // A plain mean until the exponential window is full, so early frames are not under-weighted
+    ++numFrames;
+    const double decay = std::exp(-static_cast<double>(kHopSize) / (kAveragingSeconds * sampleRate));
+    const double weight = juce::jmax(1.0 / static_cast<double>(numFrames), 1.0 - decay);
+
+    measuredDb.resize(getNumBins());
+    for (size_t k = 0; k < getNumBins(); ++k) {
+        const double re = frame[2 * k];
+        const double im = frame[2 * k + 1];
+        averagePower[k] += weight * (re * re + im * im - averagePower[k]);
+        measuredDb[k] = static_cast<float>(10.0 * std::log10(averagePower[k] + 1.0e-30));
+    }
+}
+
+bool MatchEqDesigner::designCorrection(const Target &target, const float amount,
+                                       std::vector<float> &correctionDb) const {
+    if (!target.isValid() || measuredDb.empty() || getAnalysedSeconds() < kMinAnalysisSeconds)
+        return false;
+
+    const size_t numBins = getNumBins();
+    const double binHz = sampleRate / static_cast<double>(kAnalysisSize);
+    const double targetBinsPerHz = static_cast<double>(target.fftSize) / target.sampleRate;
+    const double lowHz = kMinMatchHz;
+    const double highHz = juce::jmin(static_cast<double>(kMaxMatchHz), 0.4 * sampleRate);
+
+    // Target minus measured, held constant outside the matched range (the taper below removes it)
+    std::vector<float> difference(numBins);
+    for (size_t k = 0; k < numBins; ++k) {
+        const double frequency = juce::jlimit(lowHz, highHz, static_cast<double>(k) * binHz);
+        difference[k] = interpolate(target.db, frequency * targetBinsPerHz)
+                        - interpolate(measuredDb, frequency / binHz);
+    }
+
+    // Fractional-octave smoothing: mean over [k / r, k * r] through a prefix sum
+    std::vector<double> prefix(numBins + 1, 0.0);
+    for (size_t k = 0; k < numBins; ++k)
+        prefix[k + 1] = prefix[k] + static_cast<double>(difference[k]);
+
+    const double ratio = std::pow(2.0, 0.5 * static_cast<double>(kSmoothingOctaves));
+    correctionDb.resize(numBins);
+    for (size_t k = 0; k < numBins; ++k) {
+        const auto lo = static_cast<size_t>(std::floor(static_cast<double>(k) / ratio));
+        const auto hi = juce::jmin(numBins - 1, static_cast<size_t>(std::ceil(static_cast<double>(k) * ratio)));
+        correctionDb[k] = static_cast<float>((prefix[hi + 1] - prefix[lo]) / static_cast<double>(hi + 1 - lo));
+    }
+
+    // Match the shape, not the level: remove the mean per octave across the matched range
+    double sum = 0.0, weights = 0.0;
+    for (size_t k = 1; k < numBins; ++k) {
+        const double frequency = static_cast<double>(k) * binHz;
+        if (frequency < lowHz || frequency > highHz)
+            continue;
+        sum += static_cast<double>(correctionDb[k]) / frequency;
+        weights += 1.0 / frequency;
+    }
+    const auto offset = weights > 0.0 ? static_cast<float>(sum / weights) : 0.0f;
+
+    const float scale = juce::jlimit(0.0f, 1.0f, amount);
+    const double fadeOutHz = juce::jmin(20000.0, 0.5 * sampleRate);
+    for (size_t k = 0; k < numBins; ++k) {
+        const double frequency = static_cast<double>(k) * binHz;
+        const float taper = logRamp(frequency, 0.5 * lowHz, lowHz) * (1.0f - logRamp(frequency, highHz, fadeOutHz));
+        correctionDb[k] = juce::jlimit(-kMaxCorrectionDb, kMaxCorrectionDb, correctionDb[k] - offset)
+                          * scale * taper;
+    }
+
+    return true;
+}
+
+void MatchEqDesigner::designFilter(const std::vector<float> &correctionDb, std::vector<float> &impulse) {
+    constexpr size_t half = kDesignSize / 2;
+    const double analysisBinsPerDesignBin = static_cast<double>(kAnalysisSize) / static_cast<double>(kDesignSize);
+
+    // Log magnitude (natural log, zero phase) on the design grid
+    cepstrum.assign(2 * kDesignSize, 0.0f);
+    for (size_t j = 0; j <= half; ++j) {
+        const float db = correctionDb.empty()
+                             ? 0.0f
+                             : interpolate(correctionDb, static_cast<double>(j) * analysisBinsPerDesignBin);
+        cepstrum[2 * j] = db * static_cast<float>(std::log(10.0) / 20.0);
+    }
+    designFft->performRealOnlyInverseTransform(cepstrum.data());
+
+    // Fold the real cepstrum onto positive quefrencies: the minimum-phase log spectrum
+    for (size_t i = 1; i < half; ++i)
+        cepstrum[i] *= 2.0f;
+    std::fill(cepstrum.begin() + static_cast<std::ptrdiff_t>(half + 1), cepstrum.end(), 0.0f);
+    designFft->performRealOnlyForwardTransform(cepstrum.data(), true);
+
+    for (size_t j = 0; j <= half; ++j) {
+        const float magnitude = std::exp(cepstrum[2 * j]);
+        const float phase = cepstrum[2 * j + 1];
+        cepstrum[2 * j] = magnitude * std::cos(phase);
+        cepstrum[2 * j + 1] = magnitude * std::sin(phase);
+    }
+    designFft->performRealOnlyInverseTransform(cepstrum.data());
+
+    // Truncate with a half-Hann fade over the last quarter (the response has decayed by then)
+    impulse.assign(cepstrum.begin(), cepstrum.begin() + static_cast<std::ptrdiff_t>(kFilterLength));
+    const size_t fadeLength = kFilterLength / 4;
+    for (size_t i = 0; i < fadeLength; ++i)
+        impulse[kFilterLength - fadeLength + i] *= static_cast<float>(
+            0.5 + 0.5 * std::cos(juce::MathConstants<double>::pi * static_cast<double>(i + 1)
+                                 / static_cast<double>(fadeLength)));
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * MatchEqDesigner
+ *
+ * The non-realtime half of the match EQ: measures the long-term spectrum of the input and
+ * designs the minimum-phase FIR that bends it towards a target curve.
+ *
+ * Measurement: kAnalysisOrder-point Hann frames at 50% overlap, power-averaged with an
+ * exponential window of kAveragingSeconds (a plain mean until that much has been heard).
+ * Frames quieter than kSilenceDb are skipped so pauses do not dilute the average.
+ *
+ * Design (designCorrection()): target minus measured per bin, smoothed to kSmoothingOctaves,
+ * level-aligned (mean over kMinMatchHz..kMaxMatchHz removed, so only the shape is matched),
+ * limited to +/-kMaxCorrectionDb, scaled by the amount and faded to 0 dB outside the matched
+ * range. designFilter() turns that magnitude into a minimum-phase FIR of kFilterLength taps
+ * through the real cepstrum, so the correction adds no latency beyond the convolver's.
+ *
+ * The target is any dB-per-bin curve with its own FFT size and sample rate (the analyzer's
+ * saved curves); it is resampled by frequency.
+ *
+ * Not thread-safe: one thread at a time, never the audio thread (everything allocates).
+ */
+class MatchEqDesigner {
+public:
+    static constexpr int kAnalysisOrder = 13; // 8192-point frames
+    static constexpr int kDesignOrder = 14; // cepstrum FFT, twice the analysis resolution
+    static constexpr size_t kFilterLength = 4096;
+    static constexpr double kAveragingSeconds = 10.0;
+    static constexpr double kMinAnalysisSeconds = 2.0;
+    static constexpr float kSilenceDb = -80.0f;
+    static constexpr float kSmoothingOctaves = 1.0f / 3.0f;
+    static constexpr float kMaxCorrectionDb = 12.0f;
+    static constexpr float kMinMatchHz = 30.0f;
+    static constexpr float kMaxMatchHz = 16000.0f;
+
+    /** A target spectrum: dB per bin of an fftSize-point analysis at sampleRate. */
+    struct Target {
+        std::vector<float> db;
+        int fftSize = 0;
+        double sampleRate = 0.0;
+
+        bool isValid() const noexcept { return fftSize > 0 && sampleRate > 0.0 && db.size() >= 2; }
+    };
+
+    MatchEqDesigner();
+
+    void prepare(double sampleRate);
+
+    /** Forget the measured spectrum. */
+    void reset();
+
+    /** Feed input; complete frames are analysed as they fill. */
+    void pushSamples(const float *samples, size_t numSamples);
+
+    /** Seconds of (non-silent) input in the long-term average. */
+    double getAnalysedSeconds() const noexcept;
+
+    /** Analysis bins (kAnalysisOrder-point FFT, DC..Nyquist). */
+    static constexpr size_t getNumBins() noexcept { return (size_t{1} << kAnalysisOrder) / 2 + 1; }
+
+    /** The measured long-term spectrum in dB per analysis bin (empty before the first frame). */
+    const std::vector<float> &getMeasuredDb() const noexcept { return measuredDb; }
+
+    /**
+     * Correction in dB per analysis bin towards target at amount (0..1). False, leaving
+     * correctionDb untouched, until kMinAnalysisSeconds have been measured or for an invalid target.
+     */
+    bool designCorrection(const Target &target, float amount, std::vector<float> &correctionDb) const;
+
+    /** Minimum-phase FIR (kFilterLength taps) with the magnitude of correctionDb. */
+    void designFilter(const std::vector<float> &correctionDb, std::vector<float> &impulse);
+
+private:
+    void analyseFrame();
+
+    double sampleRate = 44100.0;
+    std::unique_ptr<juce::dsp::FFT> analysisFft, designFft;
+    std::vector<float> window;
+    std::vector<float> input; // one frame collecting; the second half is kept as the next frame's first
+    std::vector<float> frame; // FFT scratch
+    size_t fill = 0;
+
+    std::vector<double> averagePower;
+    std::vector<float> measuredDb;
+    size_t numFrames = 0;
+
+    std::vector<float> cepstrum;
+};
@@ -0,0 +1,258 @@
+#include "MatchEqualizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr size_t kDrainBlock = 4096;
+}
+
+MatchEqualizer::MatchEqualizer()
+    : juce::Thread("Match EQ designer") {
+}
+
+MatchEqualizer::~MatchEqualizer() {
+    stopThread(kStopTimeoutMs);
+}
+
+void MatchEqualizer::prepare(const juce::dsp::ProcessSpec &spec, const size_t numChannels) {
+    stopThread(kStopTimeoutMs);
+
+    sampleRate = spec.sampleRate > 0.0 ? spec.sampleRate : 44100.0;
+
+    if (ffts == nullptr)
+        ffts = std::make_unique<NonUniformConvolver::Ffts>();
+
+    constexpr size_t length = MatchEqDesigner::kFilterLength;
+    for (auto &design: designs)
+        NonUniformConvolver::prepareKernel(*ffts, length, design);
+    for (auto &kernel: kernels)
+        NonUniformConvolver::prepareKernel(*ffts, length, kernel);
+
+    // Start from a unit impulse: the delayed input
+    impulse.assign(length, 0.0f);
+    impulse[0] = 1.0f;
+    NonUniformConvolver::transformKernel(*ffts, impulse.data(), 1, kernels[0], scratch);
+    activeKernel = 0;
+
+    convolvers.clear();
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        auto convolver = std::make_unique<NonUniformConvolver>();
+        convolver->prepare(*ffts, length);
+        convolver->setKernel(&kernels[0]);
+        convolvers.push_back(std::move(convolver));
+    }
+
+    backDesign = 0;
+    pendingDesign.store(1, std::memory_order_relaxed);
+    frontDesign = 2;
+    numDesigns.store(0, std::memory_order_relaxed);
+
+    const int fifoSize = juce::roundToInt(sampleRate * kFifoSeconds);
+    fifo.setTotalSize(fifoSize);
+    fifoBuffer.assign(static_cast<size_t>(fifoSize), 0.0f);
+    drainBuffer.assign(kDrainBlock, 0.0f);
+
+    // The measurement starts over; a target already set is designed once enough is heard
+    designer.prepare(sampleRate);
+    lastCorrection.clear();
+    designedTargetGeneration = targetGeneration.load(std::memory_order_acquire) - 1;
+    designedAmount = -1.0f;
+
+    isPrepared = true;
+    reset();
+
+    if (active.load(std::memory_order_relaxed))
+        startThread();
+}
+
+void MatchEqualizer::reset() noexcept {
+    for (auto &convolver: convolvers)
+        convolver->reset();
+}
+
+void MatchEqualizer::setActive(const bool shouldBeActive) {
+    active.store(shouldBeActive, std::memory_order_relaxed);
+
+    if (!isPrepared)
+        return;
+
+    if (shouldBeActive && !isThreadRunning())
+        startThread();
+    else if (!shouldBeActive)
+        stopThread(kStopTimeoutMs);
+}
+
+void MatchEqualizer::setTarget(const Target &newTarget) {
+    if (!newTarget.isValid()) {
+        clearTarget();
+        return;
+    }
+
+    {
+        const juce::ScopedLock lock(targetLock);
+        target = newTarget;
+    }
+
+    targetLoaded.store(true, std::memory_order_relaxed);
+    targetGeneration.fetch_add(1, std::memory_order_release);
+    notify();
+}
+
+void MatchEqualizer::clearTarget() {
+    {
+        const juce::ScopedLock lock(targetLock);
+        target = {};
+    }
+
+    targetLoaded.store(false, std::memory_order_relaxed);
+    targetGeneration.fetch_add(1, std::memory_order_release);
+    notify();
+}
+
+void MatchEqualizer::setAmount(const float newAmount) noexcept {
+    amount.store(juce::jlimit(0.0f, 1.0f, newAmount), std::memory_order_relaxed);
+    notify();
+}
+
+//==============================================================================
+void MatchEqualizer::run() {
+    while (!threadShouldExit()) {
+        drainFifo();
+
+        const auto generation = targetGeneration.load(std::memory_order_acquire);
+        const float strength = amount.load(std::memory_order_relaxed);
+        const bool settingsChanged = generation != designedTargetGeneration || strength != designedAmount;
+
+        bool loaded;
+        {
+            const juce::ScopedLock lock(targetLock);
+            loaded = target.isValid();
+            if (settingsChanged)
+                designedTarget = target;
+        }
+
+        bool handled = true;
+        if (!loaded) {
+            // Back to the unit impulse once per clear
+            if (settingsChanged && !lastCorrection.empty()) {
+                std::fill(impulse.begin(), impulse.end(), 0.0f);
+                impulse[0] = 1.0f;
+                publish(impulse);
+            }
+            lastCorrection.clear();
+        } else if (designer.designCorrection(designedTarget, strength, correction)) {
+            bool moved = settingsChanged || lastCorrection.size() != correction.size();
+            for (size_t k = 0; !moved && k < correction.size(); ++k)
+                moved = std::abs(correction[k] - lastCorrection[k]) > kRedesignThresholdDb;
+
+            if (moved) {
+                designer.designFilter(correction, impulse);
+                publish(impulse);
+                lastCorrection = correction;
+            }
+        } else {
+            handled = false; // not enough measured yet: try again next time
+        }
+
+        if (handled) {
+            designedTargetGeneration = generation;
+            designedAmount = strength;
+        }
+
+        wait(kDesignIntervalMs);
+    }
+}
+
+void MatchEqualizer::drainFifo() {
+    int ready = fifo.getNumReady();
+
+    while (ready > 0) {
+        const int chunk = juce::jmin(ready, static_cast<int>(drainBuffer.size()));
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(chunk, start1, size1, start2, size2);
+
+        std::copy_n(fifoBuffer.data() + start1, size1, drainBuffer.data());
+        std::copy_n(fifoBuffer.data() + start2, size2, drainBuffer.data() + size1);
+        fifo.finishedRead(size1 + size2);
+
+        designer.pushSamples(drainBuffer.data(), static_cast<size_t>(size1 + size2));
+        ready -= size1 + size2;
+    }
+}
+
+void MatchEqualizer::publish(const std::vector<float> &newImpulse) {
+    NonUniformConvolver::transformKernel(*ffts, newImpulse.data(), newImpulse.size(),
+                                         designs[static_cast<size_t>(backDesign)], scratch);
+    backDesign = pendingDesign.exchange(backDesign | kFreshDesign, std::memory_order_acq_rel) & ~kFreshDesign;
+    numDesigns.fetch_add(1, std::memory_order_release);
+}
+
+//==============================================================================
+void MatchEqualizer::adoptKernel() noexcept {
+    if ((pendingDesign.load(std::memory_order_acquire) & kFreshDesign) == 0)
+        return;
+
+    // The kernel being left must stay intact until every convolver has faded away from it
+    for (const auto &convolver: convolvers)
+        if (convolver->isSwitching())
+            return;
+
+    frontDesign = pendingDesign.exchange(frontDesign, std::memory_order_acq_rel) & ~kFreshDesign;
+
+    const int next = 1 - activeKernel;
+    NonUniformConvolver::copyKernel(kernels[static_cast<size_t>(next)], designs[static_cast<size_t>(frontDesign)]);
+    activeKernel = next;
+
+    for (auto &convolver: convolvers)
+        convolver->setKernel(&kernels[static_cast<size_t>(next)]);
+}
+
+template<typename SampleType>
+void MatchEqualizer::capture(SampleType *const *channels, const size_t numChannels,
+                             const size_t numSamples) noexcept {
+    // Whole blocks or nothing: a partial block would splice a discontinuity into the analysis
+    const auto count = static_cast<int>(numSamples);
+    if (numChannels == 0 || fifo.getFreeSpace() < count)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(count, start1, size1, start2, size2);
+
+    const SampleType *left = channels[0];
+    const SampleType *right = numChannels > 1 ? channels[1] : nullptr;
+
+    auto write = [&](const int start, const int size, const int offset) {
+        float *dest = fifoBuffer.data() + start;
+        for (int i = 0; i < size; ++i) {
+            const auto n = static_cast<size_t>(offset + i);
+            dest[i] = right != nullptr
+                          ? 0.5f * static_cast<float>(left[n] + right[n])
+                          : static_cast<float>(left[n]);
+        }
+    };
+
+    write(start1, size1, 0);
+    write(start2, size2, size1);
+    fifo.finishedWrite(size1 + size2);
+}
+
+template<typename SampleType>
+void MatchEqualizer::process(SampleType *const *channels, const size_t numChannels,
+                             const size_t numSamples) noexcept {
+    if (!isPrepared)
+        return;
+
+    adoptKernel();
+
+    // The analysis hears the input, not the corrected output
+    if (active.load(std::memory_order_relaxed))
+        capture(channels, numChannels, numSamples);
+
+    const size_t count = juce::jmin(numChannels, convolvers.size());
+    for (size_t ch = 0; ch < count; ++ch)
+        convolvers[ch]->process(channels[ch], numSamples);
+}
+
+template void MatchEqualizer::process<float>(float *const *, size_t, size_t) noexcept;
+template void MatchEqualizer::process<double>(double *const *, size_t, size_t) noexcept;
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+#include "MatchEqDesigner.h"
+#include "NonUniformConvolver.h"
+
+/**
+ * MatchEqualizer
+ *
+ * Bends the long-term spectrum of a bus towards a loaded target curve. The audio thread feeds
+ * the mono sum of the first pair (before correction) into a lock-free FIFO and convolves every
+ * channel with the current correction through a NonUniformConvolver (getLatencySamples()).
+ *
+ * A worker thread, running while the EQ is active, drains the FIFO into a MatchEqDesigner
+ * and every kDesignIntervalMs redesigns the correction; redesigns whose correction moved by
+ * less than kRedesignThresholdDb anywhere are dropped. A new filter is transformed on the
+ * worker and handed over through a triple buffer; the audio thread adopts it once every channel
+ * has finished its previous switch, copying it into the idle one of its two kernels so each
+ * convolver can crossfade from the kernel it is leaving.
+ *
+ * Until a target is loaded and enough input has been measured the kernel is a unit impulse:
+ * the input, delayed. Clearing the target publishes the unit impulse again.
+ *
+ * Threading: prepare(), setActive(), setTarget(), clearTarget() and setAmount() on the message
+ * thread (never concurrently with prepare()); reset() and process() on the audio thread,
+ * realtime-safe (a full FIFO drops the analysis input, never blocks).
+ */
+class MatchEqualizer : private juce::Thread {
+public:
+    using Target = MatchEqDesigner::Target;
+
+    static constexpr int kDesignIntervalMs = 500;
+    static constexpr float kRedesignThresholdDb = 0.1f;
+    static constexpr double kFifoSeconds = 2.0;
+    static constexpr int kStopTimeoutMs = 2000;
+
+    MatchEqualizer();
+    ~MatchEqualizer() override;
+
+    /** Allocate for numChannels at spec's sample rate; restarts the worker when active. */
+    void prepare(const juce::dsp::ProcessSpec &spec, size_t numChannels);
+
+    /** Clear the convolution history; the measurement carries on. */
+    void reset() noexcept;
+
+    static constexpr int getLatencySamples() noexcept { return NonUniformConvolver::getLatencySamples(); }
+
+    /** Start or stop the worker; inactive, nothing is measured or designed. */
+    void setActive(bool shouldBeActive);
+    bool isActive() const noexcept { return active.load(std::memory_order_relaxed); }
+
+    /** Message thread. Match towards target (dB per bin, see MatchEqDesigner::Target). */
+    void setTarget(const Target &target);
+    void clearTarget();
+    bool hasTarget() const noexcept { return targetLoaded.load(std::memory_order_relaxed); }
+
+    /** Strength of the correction, 0 (none) to 1 (full). */
+    void setAmount(float newAmount) noexcept;
+    float getAmount() const noexcept { return amount.load(std::memory_order_relaxed); }
+
+    /** Filters published by the worker since prepare(), identity resets included. */
+    juce::uint32 getNumDesigns() const noexcept { return numDesigns.load(std::memory_order_acquire); }
+
+    /** Convolve numChannels channels in place; the first two also feed the analysis. */
+    template<typename SampleType>
+    void process(SampleType *const *channels, size_t numChannels, size_t numSamples) noexcept;
+
+private:
+    void run() override;
+
+    /** Worker: move the analysis FIFO into the designer. */
+    void drainFifo();
+
+    /** Worker: transform impulse into the back kernel and publish it. */
+    void publish(const std::vector<float> &impulse);
+
+    /** Audio thread, between blocks: adopt a published kernel when no switch is in flight. */
+    void adoptKernel() noexcept;
+
+    template<typename SampleType>
+    void capture(SampleType *const *channels, size_t numChannels, size_t numSamples) noexcept;
+
+    std::unique_ptr<NonUniformConvolver::Ffts> ffts;
+    std::vector<std::unique_ptr<NonUniformConvolver>> convolvers;
+    double sampleRate = 44100.0;
+    bool isPrepared = false;
+    std::atomic<bool> active{false};
+
+    // Analysis input: audio thread writes, worker reads
+    juce::AbstractFifo fifo{1};
+    std::vector<float> fifoBuffer;
+
+    // Worker state
+    MatchEqDesigner designer;
+    std::vector<float> drainBuffer, impulse, correction, lastCorrection, scratch;
+    Target designedTarget;
+    juce::uint32 designedTargetGeneration = 0;
+    float designedAmount = -1.0f;
+
+    // Target and amount from the message thread; the generation tells the worker to redesign
+    juce::CriticalSection targetLock;
+    Target target;
+    std::atomic<bool> targetLoaded{false};
+    std::atomic<juce::uint32> targetGeneration{0};
+    std::atomic<float> amount{1.0f};
+
+    // Triple buffer: the worker fills designs[backDesign] and swaps it into pendingDesign with
+    // kFreshDesign set; the audio thread swaps designs[frontDesign] out when it sees the flag.
+    static constexpr int kFreshDesign = 4;
+    std::array<NonUniformConvolver::Kernel, 3> designs;
+    int backDesign = 0;
+    std::atomic<int> pendingDesign{1};
+    int frontDesign = 2;
+    std::atomic<juce::uint32> numDesigns{0};
+
+    // Audio thread: the kernel in use and the one it last replaced
+    std::array<NonUniformConvolver::Kernel, 2> kernels;
+    int activeKernel = 0;
+};
@@ -0,0 +1,218 @@
+#include "MidSidePeakKernel.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include <juce_core/juce_core.h>
+
+#if JUCE_INTEL
+ #define GFRACTOR_PEAK_X86 1
+ #include <immintrin.h>
+ #if JUCE_MSVC
+  #define GFRACTOR_TARGET_AVX2
+ #else
+  #define GFRACTOR_TARGET_AVX2 __attribute__((target("avx2")))
+ #endif
+#elif JUCE_ARM && (defined(__aarch64__) || defined(_M_ARM64))
+ #define GFRACTOR_PEAK_NEON 1
+ #include <arm_neon.h>
+#endif
+
+namespace {
+    using Peaks = MidSidePeakKernel::Peaks;
+    using KernelFn = Peaks (*)(const float *, const float *, size_t) noexcept;
+
+    // Peaks are accumulated as max|L +/- R| and halved once at the end — scaling by 0.5
+    // is exact, so this matches max(|L +/- R| * 0.5) bit-for-bit without a multiply per sample.
+    // Data is always the first operand of the max so NaN samples never replace the accumulator.
+
+    Peaks processScalarTail(const float *left, const float *right, size_t start, const size_t numSamples,
+                            float peakMid, float peakSide) noexcept {
+        for (; start < numSamples; ++start) {
+            peakMid = juce::jmax(peakMid, std::abs(left[start] + right[start]));
+            peakSide = juce::jmax(peakSide, std::abs(left[start] - right[start]));
+        }
+        return {peakMid * 0.5f, peakSide * 0.5f};
+    }
+
+    Peaks processScalar(const float *left, const float *right, const size_t numSamples) noexcept {
+        return processScalarTail(left, right, 0, numSamples, 0.0f, 0.0f);
+    }
+
+#if GFRACTOR_PEAK_X86
+    float horizontalMax(const __m128 v) noexcept {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, v);
+        return juce::jmax(juce::jmax(lanes[0], lanes[1]), juce::jmax(lanes[2], lanes[3]));
+    }
+
+    Peaks processSSE2(const float *left, const float *right, const size_t numSamples) noexcept {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        __m128 mid0 = _mm_setzero_ps(), mid1 = _mm_setzero_ps();
+        __m128 side0 = _mm_setzero_ps(), side1 = _mm_setzero_ps();
+
+        size_t i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            const __m128 l0 = _mm_loadu_ps(left + i), r0 = _mm_loadu_ps(right + i);
+            const __m128 l1 = _mm_loadu_ps(left + i + 4), r1 = _mm_loadu_ps(right + i + 4);
+            mid0 = _mm_max_ps(_mm_and_ps(_mm_add_ps(l0, r0), absMask), mid0);
+            mid1 = _mm_max_ps(_mm_and_ps(_mm_add_ps(l1, r1), absMask), mid1);
+            side0 = _mm_max_ps(_mm_and_ps(_mm_sub_ps(l0, r0), absMask), side0);
+            side1 = _mm_max_ps(_mm_and_ps(_mm_sub_ps(l1, r1), absMask), side1);
+        }
+        for (; i + 4 <= numSamples; i += 4) {
+            const __m128 l0 = _mm_loadu_ps(left + i), r0 = _mm_loadu_ps(right + i);
+            mid0 = _mm_max_ps(_mm_and_ps(_mm_add_ps(l0, r0), absMask), mid0);
+            side0 = _mm_max_ps(_mm_and_ps(_mm_sub_ps(l0, r0), absMask), side0);
+        }
+
+        return processScalarTail(left, right, i, numSamples,
+                                 horizontalMax(_mm_max_ps(mid0, mid1)),
+                                 horizontalMax(_mm_max_ps(side0, side1)));
+    }
+
+    GFRACTOR_TARGET_AVX2
+    Peaks processAVX2(const float *left, const float *right, const size_t numSamples) noexcept {
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        __m256 mid0 = _mm256_setzero_ps(), mid1 = _mm256_setzero_ps();
+        __m256 side0 = _mm256_setzero_ps(), side1 = _mm256_setzero_ps();
+
+        size_t i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            const __m256 l0 = _mm256_loadu_ps(left + i), r0 = _mm256_loadu_ps(right + i);
+            const __m256 l1 = _mm256_loadu_ps(left + i + 8), r1 = _mm256_loadu_ps(right + i + 8);
+            mid0 = _mm256_max_ps(_mm256_and_ps(_mm256_add_ps(l0, r0), absMask), mid0);
+            mid1 = _mm256_max_ps(_mm256_and_ps(_mm256_add_ps(l1, r1), absMask), mid1);
+            side0 = _mm256_max_ps(_mm256_and_ps(_mm256_sub_ps(l0, r0), absMask), side0);
+            side1 = _mm256_max_ps(_mm256_and_ps(_mm256_sub_ps(l1, r1), absMask), side1);
+        }
+        for (; i + 8 <= numSamples; i += 8) {
+            const __m256 l0 = _mm256_loadu_ps(left + i), r0 = _mm256_loadu_ps(right + i);
+            mid0 = _mm256_max_ps(_mm256_and_ps(_mm256_add_ps(l0, r0), absMask), mid0);
+            side0 = _mm256_max_ps(_mm256_and_ps(_mm256_sub_ps(l0, r0), absMask), side0);
+        }
+
+        mid0 = _mm256_max_ps(mid0, mid1);
+        side0 = _mm256_max_ps(side0, side1);
+        const __m128 mid = _mm_max_ps(_mm256_castps256_ps128(mid0), _mm256_extractf128_ps(mid0, 1));
+        const __m128 side = _mm_max_ps(_mm256_castps256_ps128(side0), _mm256_extractf128_ps(side0, 1));
+
+        return processScalarTail(left, right, i, numSamples, horizontalMax(mid), horizontalMax(side));
+    }
+#endif
+
+#if GFRACTOR_PEAK_NEON
+    Peaks processNEON(const float *left, const float *right, const size_t numSamples) noexcept {
+        // vmaxnm returns the numeric operand when the other is NaN.
+        float32x4_t mid0 = vdupq_n_f32(0.0f), mid1 = vdupq_n_f32(0.0f);
+        float32x4_t side0 = vdupq_n_f32(0.0f), side1 = vdupq_n_f32(0.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            const float32x4_t l0 = vld1q_f32(left + i), r0 = vld1q_f32(right + i);
+            const float32x4_t l1 = vld1q_f32(left + i + 4), r1 = vld1q_f32(right + i + 4);
+            mid0 = vmaxnmq_f32(mid0, vabsq_f32(vaddq_f32(l0, r0)));
+            mid1 = vmaxnmq_f32(mid1, vabsq_f32(vaddq_f32(l1, r1)));
+            side0 = vmaxnmq_f32(side0, vabsq_f32(vsubq_f32(l0, r0)));
+            side1 = vmaxnmq_f32(side1, vabsq_f32(vsubq_f32(l1, r1)));
+        }
+        for (; i + 4 <= numSamples; i += 4) {
+            const float32x4_t l0 = vld1q_f32(left + i), r0 = vld1q_f32(right + i);
+            mid0 = vmaxnmq_f32(mid0, vabsq_f32(vaddq_f32(l0, r0)));
+            side0 = vmaxnmq_f32(side0, vabsq_f32(vsubq_f32(l0, r0)));
+        }
+
+        return processScalarTail(left, right, i, numSamples,
+                                 vmaxnmvq_f32(vmaxnmq_f32(mid0, mid1)),
+                                 vmaxnmvq_f32(vmaxnmq_f32(side0, side1)));
+    }
+#endif
+
+    KernelFn kernelFor(const MidSidePeakKernel::Isa isa) noexcept {
+        switch (isa) {
+            case MidSidePeakKernel::Isa::Scalar: return processScalar;
+#if GFRACTOR_PEAK_X86
+            case MidSidePeakKernel::Isa::AVX2: return processAVX2;
+            case MidSidePeakKernel::Isa::SSE2: return processSSE2;
+            case MidSidePeakKernel::Isa::NEON: return processScalar;
+#elif GFRACTOR_PEAK_NEON
+            case MidSidePeakKernel::Isa::AVX2: return processScalar;
+            case MidSidePeakKernel::Isa::SSE2: return processScalar;
+            case MidSidePeakKernel::Isa::NEON: return processNEON;
+#else
+            case MidSidePeakKernel::Isa::AVX2:
+            case MidSidePeakKernel::Isa::SSE2:
+            case MidSidePeakKernel::Isa::NEON: return processScalar;
+#endif
+        }
+        return processScalar;
+    }
+
+    MidSidePeakKernel::Isa detectIsa() noexcept {
+#if GFRACTOR_PEAK_X86
+        return juce::SystemStats::hasAVX2() ? MidSidePeakKernel::Isa::AVX2 : MidSidePeakKernel::Isa::SSE2;
+#elif GFRACTOR_PEAK_NEON
+        return MidSidePeakKernel::Isa::NEON;
+#else
+        return MidSidePeakKernel::Isa::Scalar;
+#endif
+    }
+
+    // Resolved during static initialisation so the audio thread never runs CPU detection.
+    const MidSidePeakKernel::Isa activeIsa = detectIsa();
+    const KernelFn activeKernel = kernelFor(activeIsa);
+}
+
+MidSidePeakKernel::Peaks MidSidePeakKernel::process(const float *left, const float *right,
+                                                    const size_t numSamples) noexcept {
+    return activeKernel(left, right, numSamples);
+}
+
+MidSidePeakKernel::Peaks MidSidePeakKernel::process(const Isa isa, const float *left, const float *right,
+                                                    const size_t numSamples) noexcept {
+    return kernelFor(isSupported(isa) ? isa : Isa::Scalar)(left, right, numSamples);
+}
+
+MidSidePeakKernel::Peaks MidSidePeakKernel::process(const double *left, const double *right,
+                                                    const size_t numSamples) noexcept {
+    double peakMid = 0.0, peakSide = 0.0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        peakMid = juce::jmax(peakMid, std::abs(left[i] + right[i]));
+        peakSide = juce::jmax(peakSide, std::abs(left[i] - right[i]));
+    }
+    return {static_cast<float>(peakMid * 0.5), static_cast<float>(peakSide * 0.5)};
+}
+
+MidSidePeakKernel::Isa MidSidePeakKernel::getActiveIsa() noexcept {
+    return activeIsa;
+}
+
+bool MidSidePeakKernel::isSupported(const Isa isa) noexcept {
+    switch (isa) {
+        case Isa::Scalar: return true;
+#if GFRACTOR_PEAK_X86
+        case Isa::SSE2: return true;
+        case Isa::AVX2: return juce::SystemStats::hasAVX2();
+        case Isa::NEON: return false;
+#elif GFRACTOR_PEAK_NEON
+        case Isa::SSE2: return false;
+        case Isa::AVX2: return false;
+        case Isa::NEON: return true;
+#else
+        case Isa::SSE2:
+        case Isa::AVX2:
+        case Isa::NEON: return false;
+#endif
+    }
+    return false;
+}
+
+const char *MidSidePeakKernel::getIsaName(const Isa isa) noexcept {
+    switch (isa) {
+        case Isa::SSE2: return "SSE2";
+        case Isa::AVX2: return "AVX2";
+        case Isa::NEON: return "NEON";
+        case Isa::Scalar: break;
+    }
+    return "Scalar";
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * MidSidePeakKernel
+ *
+ * Vectorized abs-max kernel for the mid/side peak meter in gFractorDSP.
+ * Computes max|(L + R) / 2| and max|(L - R) / 2| in a single pass over L/R.
+ *
+ * The implementation is selected once at startup through runtime ISA dispatch:
+ *  - AVX2 (x86/x64, when the CPU reports support)
+ *  - SSE2 (x86/x64 baseline)
+ *  - NEON (ARM64)
+ *  - Scalar fallback (any other target)
+ *
+ * All variants are realtime-safe (no allocation, no locks) and ignore NaN
+ * input the same way the original scalar juce::jmax loop did.
+ */
+struct MidSidePeakKernel {
+    struct Peaks {
+        float mid = 0.0f;
+        float side = 0.0f;
+    };
+
+    enum class Isa { Scalar, SSE2, AVX2, NEON };
+
+    /** Compute linear mid/side sample peaks using the best kernel for this CPU. */
+    static Peaks process(const float *left, const float *right, size_t numSamples) noexcept;
+
+    /** Double-precision input (64-bit processing path): scalar, peaks reported as float. */
+    static Peaks process(const double *left, const double *right, size_t numSamples) noexcept;
+
+    /** Compute linear mid/side sample peaks with the given kernel.
+     *  Falls back to the scalar kernel if the ISA is not available on this build/CPU. */
+    static Peaks process(Isa isa, const float *left, const float *right, size_t numSamples) noexcept;
+
+    /** The kernel chosen by runtime dispatch. */
+    static Isa getActiveIsa() noexcept;
+
+    /** True if the given kernel was compiled in and is supported by this CPU. */
+    static bool isSupported(Isa isa) noexcept;
+
+    static const char *getIsaName(Isa isa) noexcept;
+};
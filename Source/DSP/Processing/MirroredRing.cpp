@@ -0,0 +1,105 @@
+#include "MirroredRing.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#if JUCE_LINUX
+ #define GFRACTOR_MIRROR_MMAP 1
+ #include <sys/mman.h>
+ #include <unistd.h>
+#endif
+
+namespace {
+#if GFRACTOR_MIRROR_MMAP
+    /** Maps one bytes-long memfd twice, back to back. nullptr if the OS refuses. */
+    void *mapMirrored(const size_t bytes) {
+        const int fd = memfd_create("gfractor-ring", MFD_CLOEXEC);
+        if (fd < 0)
+            return nullptr;
+
+        void *result = nullptr;
+        if (ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+            // Reserve both halves first, so nothing else can be mapped in between
+            void *base = mmap(nullptr, bytes * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base != MAP_FAILED) {
+                auto *lower = static_cast<char *>(base);
+                constexpr int prot = PROT_READ | PROT_WRITE;
+                if (mmap(lower, bytes, prot, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+                    && mmap(lower + bytes, bytes, prot, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED)
+                    result = base;
+                else
+                    munmap(base, bytes * 2);
+            }
+        }
+
+        close(fd); // the mappings keep the memory alive
+        return result;
+    }
+#endif
+}
+
+MirroredRing::~MirroredRing() {
+    release();
+}
+
+void MirroredRing::setSize(const int numSamples) {
+    if (numSamples == size) {
+        clear();
+        return;
+    }
+
+    release();
+    if (numSamples <= 0)
+        return;
+
+    size = numSamples;
+
+#if GFRACTOR_MIRROR_MMAP
+    const auto bytes = static_cast<size_t>(numSamples) * sizeof(float);
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    // memfd pages start zeroed
+    if (pageSize > 0 && bytes % pageSize == 0) {
+        if (void *mapped = mapMirrored(bytes)) {
+            data = static_cast<float *>(mapped);
+            mirrored = true;
+            return;
+        }
+    }
+#endif
+
+    fallback.assign(static_cast<size_t>(numSamples) * 2, 0.0f);
+    data = fallback.data();
+}
+
+void MirroredRing::write(const int index, const float *source, const int numSamples) noexcept {
+    jassert(index >= 0 && index < size && numSamples <= size);
+
+    if (mirrored) {
+        juce::FloatVectorOperations::copy(data + index, source, numSamples);
+        return;
+    }
+
+    const int first = juce::jmin(numSamples, size - index);
+    const int rest = numSamples - first;
+    juce::FloatVectorOperations::copy(data + index, source, first);
+    juce::FloatVectorOperations::copy(data + index + size, source, first);
+    juce::FloatVectorOperations::copy(data, source + first, rest);
+    juce::FloatVectorOperations::copy(data + size, source + first, rest);
+}
+
+void MirroredRing::clear() noexcept {
+    if (data != nullptr)
+        juce::FloatVectorOperations::clear(data, mirrored ? size : size * 2);
+}
+
+void MirroredRing::release() noexcept {
+#if GFRACTOR_MIRROR_MMAP
+    if (mirrored)
+        munmap(data, static_cast<size_t>(size) * sizeof(float) * 2);
+#endif
+
+    fallback = {};
+    data = nullptr;
+    size = 0;
+    mirrored = false;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+/**
+ * MirroredRing
+ *
+ * Float ring whose storage is followed by a mirror of itself: getData()[i + getSize()] is
+ * getData()[i], so any getSize() consecutive samples starting anywhere in the ring are one
+ * contiguous pointer, and a wrapping write is a single copy.
+ *
+ * On Linux the mirror is the same memory mapped twice, back to back (memfd + two adjacent
+ * mmaps), when the ring is a whole number of pages. Elsewhere, or if the mapping fails, the
+ * storage is a plain 2 x size array and write() copies into both halves.
+ *
+ * Not thread-safe: one thread writes and reads (the one draining the AudioRingBuffer).
+ */
+class MirroredRing {
+public:
+    MirroredRing() = default;
+
+    explicit MirroredRing(int numSamples) { setSize(numSamples); }
+
+    ~MirroredRing();
+
+    /** Allocates (or maps) numSamples, zeroed; keeps the storage if the size is unchanged. */
+    void setSize(int numSamples);
+
+    int getSize() const noexcept { return size; }
+
+    /** True when the OS does the mirroring (no copy into the second half). */
+    bool isMirrored() const noexcept { return mirrored; }
+
+    /** 2 x getSize() readable samples; the second half mirrors the first. */
+    const float *getData() const noexcept { return data; }
+
+    /** Copy numSamples (at most getSize()) to index (below getSize()) onwards, wrapping. */
+    void write(int index, const float *source, int numSamples) noexcept;
+
+    void clear() noexcept;
+
+private:
+    void release() noexcept;
+
+    float *data = nullptr;
+    int size = 0;
+    bool mirrored = false;
+    std::vector<float> fallback;
+
+    JUCE_DECLARE_NON_COPYABLE(MirroredRing)
+};
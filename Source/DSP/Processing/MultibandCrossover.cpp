@@ -0,0 +1,292 @@
+#include "MultibandCrossover.h"
+#include "../../Utility/BandConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr size_t kPartitionSize = size_t{1} << MultibandCrossover::kPartitionOrder;
+
+    // Odd, so the FIR has a whole-sample centre: a power of two minus one
+    size_t kernelLengthFor(const double sampleRate) noexcept {
+        const auto target = juce::jmax(2, juce::roundToInt(sampleRate * MultibandCrossover::kKernelSeconds));
+        return static_cast<size_t>(juce::nextPowerOfTwo(target)) - 1;
+    }
+}
+
+MultibandCrossover::MultibandCrossover()
+    : frequencies(getDefaultFrequencies()) {
+    for (int band = 0; band < kMaxBands; ++band) {
+        midGains[static_cast<size_t>(band)].store(1.0f, std::memory_order_relaxed);
+        sideGains[static_cast<size_t>(band)].store(1.0f, std::memory_order_relaxed);
+    }
+}
+
+std::vector<float> MultibandCrossover::getDefaultFrequencies() {
+    std::vector<float> edges;
+    for (size_t i = 0; i + 1 < kBands.size(); ++i)
+        edges.push_back(kBands[i].hi);
+    return edges;
+}
+
+int MultibandCrossover::getLatencySamples(const double sampleRate) noexcept {
+    return static_cast<int>(kPartitionSize + (kernelLengthFor(sampleRate) - 1) / 2);
+}
+
+void MultibandCrossover::prepare(const juce::dsp::ProcessSpec &spec, const size_t numUnits) {
+    sampleRate = spec.sampleRate > 0.0 ? spec.sampleRate : 44100.0;
+    kernelLength = kernelLengthFor(sampleRate);
+    numPartitions = (kernelLength + kPartitionSize - 1) / kPartitionSize;
+
+    if (fft == nullptr)
+        fft = std::make_unique<juce::dsp::FFT>(kPartitionOrder + 1);
+
+    for (auto &design: designs)
+        for (auto &row: design.rows)
+            PartitionedConvolver::prepareKernel(*fft, numPartitions, row);
+
+    for (size_t i = 0; i < 2; ++i) {
+        PartitionedConvolver::prepareKernel(*fft, numPartitions, midKernels[i]);
+        PartitionedConvolver::prepareKernel(*fft, numPartitions, sideKernels[i]);
+    }
+
+    units.clear();
+    for (size_t u = 0; u < numUnits; ++u) {
+        auto unit = std::make_unique<Unit>();
+        unit->mid.prepare(*fft, numPartitions);
+        unit->side.prepare(*fft, numPartitions);
+        unit->midInput.assign(kPartitionSize, 0.0f);
+        unit->sideInput.assign(kPartitionSize, 0.0f);
+        unit->midOutput.assign(kPartitionSize, 0.0f);
+        unit->sideOutput.assign(kPartitionSize, 0.0f);
+        units.push_back(std::move(unit));
+    }
+
+    designImpulse.assign(kernelLength, 0.0f);
+
+    // The audio thread is stopped: design straight into the front buffer
+    backDesign = 0;
+    pendingDesign.store(1, std::memory_order_relaxed);
+    frontDesign = 2;
+    designInto(designs[static_cast<size_t>(frontDesign)]);
+    hasKernels = false;
+
+    latencySamples.store(getLatencySamples(sampleRate), std::memory_order_relaxed);
+    isPrepared = true;
+    reset();
+}
+
+void MultibandCrossover::reset() noexcept {
+    for (auto &unit: units) {
+        unit->mid.reset();
+        unit->side.reset();
+        std::fill(unit->midInput.begin(), unit->midInput.end(), 0.0f);
+        std::fill(unit->sideInput.begin(), unit->sideInput.end(), 0.0f);
+        std::fill(unit->midOutput.begin(), unit->midOutput.end(), 0.0f);
+        std::fill(unit->sideOutput.begin(), unit->sideOutput.end(), 0.0f);
+    }
+
+    position = 0;
+}
+
+void MultibandCrossover::setFrequencies(const std::vector<float> &newFrequencies) {
+    std::vector<float> edges;
+    for (const float f: newFrequencies)
+        if (std::isfinite(f))
+            edges.push_back(juce::jlimit(kMinFrequency, kMaxFrequency, f));
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    if (edges.size() > static_cast<size_t>(kMaxBands - 1))
+        edges.resize(static_cast<size_t>(kMaxBands - 1));
+
+    if (edges.empty())
+        return;
+
+    frequencies = std::move(edges);
+
+    if (isPrepared)
+        publishDesign();
+}
+
+void MultibandCrossover::setBand(const int band, const BandSettings &settings) {
+    if (band < 0 || band >= kMaxBands)
+        return;
+
+    auto clamped = settings;
+    clamped.midGainDb = juce::jlimit(kMinGainDb, kMaxGainDb, settings.midGainDb);
+    clamped.sideGainDb = juce::jlimit(kMinGainDb, kMaxGainDb, settings.sideGainDb);
+    bands[static_cast<size_t>(band)] = clamped;
+
+    const auto index = static_cast<size_t>(band);
+    midGains[index].store(clamped.midEnabled ? juce::Decibels::decibelsToGain(clamped.midGainDb) : 0.0f,
+                          std::memory_order_relaxed);
+    sideGains[index].store(clamped.sideEnabled ? juce::Decibels::decibelsToGain(clamped.sideGainDb) : 0.0f,
+                           std::memory_order_relaxed);
+    gainGeneration.fetch_add(1, std::memory_order_release);
+}
+
+MultibandCrossover::BandSettings MultibandCrossover::getBand(const int band) const {
+    if (band < 0 || band >= kMaxBands)
+        return {};
+    return bands[static_cast<size_t>(band)];
+}
+
+void MultibandCrossover::designInto(Design &design) {
+    const auto length = kernelLength;
+    const double centre = static_cast<double>(length - 1) / 2.0;
+    const double nyquistLimit = 0.45 * sampleRate;
+
+    // Row 0: the pure delay every band set sums to
+    std::fill(designImpulse.begin(), designImpulse.end(), 0.0f);
+    designImpulse[(length - 1) / 2] = 1.0f;
+    PartitionedConvolver::transformKernel(*fft, designImpulse.data(), length, design.rows[0], designScratch);
+
+    design.numEdges = frequencies.size();
+
+    // Blackman-windowed sinc lowpasses, normalised to unity at DC
+    for (size_t e = 0; e < design.numEdges; ++e) {
+        const double cutoff = juce::jmin(static_cast<double>(frequencies[e]), nyquistLimit) / sampleRate;
+        double sum = 0.0;
+
+        for (size_t n = 0; n < length; ++n) {
+            const double x = static_cast<double>(n) - centre;
+            const double sinc = x == 0.0
+                                    ? 2.0 * cutoff
+                                    : std::sin(2.0 * juce::MathConstants<double>::pi * cutoff * x)
+                                      / (juce::MathConstants<double>::pi * x);
+            const double phase = 2.0 * juce::MathConstants<double>::pi * static_cast<double>(n)
+                                 / static_cast<double>(length - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            const double tap = sinc * window;
+
+            designImpulse[n] = static_cast<float>(tap);
+            sum += tap;
+        }
+
+        const auto scale = static_cast<float>(1.0 / sum);
+        for (auto &tap: designImpulse)
+            tap *= scale;
+
+        PartitionedConvolver::transformKernel(*fft, designImpulse.data(), length, design.rows[e + 1], designScratch);
+    }
+}
+
+void MultibandCrossover::publishDesign() {
+    auto &design = designs[static_cast<size_t>(backDesign)];
+    designInto(design);
+    backDesign = pendingDesign.exchange(backDesign | kFreshDesign, std::memory_order_acq_rel) & ~kFreshDesign;
+}
+
+bool MultibandCrossover::updateKernels() noexcept {
+    bool designChanged = false;
+    if ((pendingDesign.load(std::memory_order_acquire) & kFreshDesign) != 0) {
+        frontDesign = pendingDesign.exchange(frontDesign, std::memory_order_acq_rel) & ~kFreshDesign;
+        designChanged = true;
+    }
+
+    const auto generation = gainGeneration.load(std::memory_order_acquire);
+    if (hasKernels && !designChanged && generation == appliedGeneration)
+        return false;
+
+    appliedGeneration = generation;
+
+    std::array<float, kMaxBands> mid{}, side{};
+    for (size_t band = 0; band < static_cast<size_t>(kMaxBands); ++band) {
+        mid[band] = midGains[band].load(std::memory_order_relaxed);
+        side[band] = sideGains[band].load(std::memory_order_relaxed);
+    }
+
+    // The first kernels after prepare() have nothing to fade from
+    const bool fade = hasKernels;
+    const int next = hasKernels ? 1 - activeKernel : activeKernel;
+    const auto &design = designs[static_cast<size_t>(frontDesign)];
+
+    combine(design, mid, midKernels[static_cast<size_t>(next)]);
+    combine(design, side, sideKernels[static_cast<size_t>(next)]);
+
+    activeKernel = next;
+    hasKernels = true;
+    return fade;
+}
+
+void MultibandCrossover::combine(const Design &design, const std::array<float, kMaxBands> &gains,
+                                 PartitionedConvolver::Kernel &kernel) const noexcept {
+    const size_t numEdges = design.numEdges;
+
+    // H = g[last] * delay + sum (g[e] - g[e + 1]) * lowpass(e); equal neighbours cost nothing
+    PartitionedConvolver::clearKernel(kernel);
+    PartitionedConvolver::addKernel(kernel, design.rows[0], gains[numEdges]);
+
+    for (size_t e = 0; e < numEdges; ++e)
+        PartitionedConvolver::addKernel(kernel, design.rows[e + 1], gains[e] - gains[e + 1]);
+}
+
+template<typename SampleType>
+void MultibandCrossover::process(SampleType *const *lefts, SampleType *const *rights, const size_t numUnits,
+                                 const size_t numSamples) noexcept {
+    if (!isPrepared)
+        return;
+
+    const size_t count = juce::jmin(numUnits, units.size());
+
+    size_t done = 0;
+    while (done < numSamples) {
+        const size_t len = juce::jmin(numSamples - done, kPartitionSize - position);
+
+        for (size_t u = 0; u < count; ++u) {
+            auto &unit = *units[u];
+            SampleType *left = lefts[u] + done;
+            float *midIn = unit.midInput.data() + position;
+            const float *midOut = unit.midOutput.data() + position;
+
+            if (rights[u] == nullptr) {
+                for (size_t i = 0; i < len; ++i) {
+                    midIn[i] = static_cast<float>(left[i]);
+                    left[i] = static_cast<SampleType>(midOut[i]);
+                }
+                continue;
+            }
+
+            SampleType *right = rights[u] + done;
+            float *sideIn = unit.sideInput.data() + position;
+            const float *sideOut = unit.sideOutput.data() + position;
+
+            for (size_t i = 0; i < len; ++i) {
+                const auto l = static_cast<float>(left[i]);
+                const auto r = static_cast<float>(right[i]);
+                midIn[i] = 0.5f * (l + r);
+                sideIn[i] = 0.5f * (l - r);
+
+                left[i] = static_cast<SampleType>(midOut[i] + sideOut[i]);
+                right[i] = static_cast<SampleType>(midOut[i] - sideOut[i]);
+            }
+        }
+
+        done += len;
+        position += len;
+
+        if (position < kPartitionSize)
+            continue;
+
+        // Every unit reaches the boundary together, so they all switch kernels on this partition
+        const bool fade = updateKernels();
+        const auto active = static_cast<size_t>(activeKernel);
+        const auto *midFrom = fade ? &midKernels[1 - active] : nullptr;
+        const auto *sideFrom = fade ? &sideKernels[1 - active] : nullptr;
+
+        for (size_t u = 0; u < count; ++u) {
+            auto &unit = *units[u];
+            unit.mid.process(unit.midInput.data(), unit.midOutput.data(), midKernels[active], midFrom);
+
+            if (rights[u] != nullptr)
+                unit.side.process(unit.sideInput.data(), unit.sideOutput.data(), sideKernels[active], sideFrom);
+        }
+
+        position = 0;
+    }
+}
+
+template void MultibandCrossover::process<float>(float *const *, float *const *, size_t, size_t) noexcept;
+template void MultibandCrossover::process<double>(double *const *, double *const *, size_t, size_t) noexcept;
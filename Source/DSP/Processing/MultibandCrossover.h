@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+#include "PartitionedConvolver.h"
+
+/**
+ * MultibandCrossover
+ *
+ * Linear-phase mid/side crossover with per-band mid and side gain and enable. The bands are
+ * split at 1..kMaxBands-1 user frequencies (by default the analyzer's kBands edges) with
+ * windowed-sinc lowpass FIRs of one length and centre: band b is lowpass(edge b) minus
+ * lowpass(edge b-1), the lowest band the first lowpass and the highest the delayed input minus
+ * the last. The bands therefore sum to a pure delay whatever the edges, and at unity gain the
+ * crossover is transparent.
+ *
+ * The gains are folded into one kernel per channel rather than filtering every band:
+ *     H = g[N-1] * delay + sum over edges e of (g[e] - g[e+1]) * lowpass(e)
+ * so mid and side each run one PartitionedConvolver and the cost does not grow with the number
+ * of bands. Lowpasses whose weight is zero (equal gains either side) drop out, and with every
+ * band at unity only the delay's single partition is convolved.
+ *
+ * Kernel length is kKernelSeconds rounded up to a power of two (4095 taps at 44.1/48 kHz),
+ * which resolves the lowest default edge (80 Hz) to a transition of roughly 60 Hz. Latency is
+ * the partition size plus half the kernel; see getLatencySamples().
+ *
+ * One crossover serves every channel pair of a bus (pairs and singles share the band kernels,
+ * each has its own delay lines), processed together so kernel changes land on the same
+ * partition everywhere. Gain changes rebuild the kernels at the next partition and crossfade
+ * to them over it; frequency changes redesign the lowpasses on the calling thread and hand them
+ * to the audio thread through a triple buffer.
+ *
+ * Threading: prepare(), setFrequencies() and setBand() on the message thread (never concurrently
+ * with prepare()); reset() and process() on the audio thread, realtime-safe.
+ */
+class MultibandCrossover {
+public:
+    static constexpr int kMaxBands = 8;
+    static constexpr int kPartitionOrder = 8; // 256-sample partitions
+    static constexpr double kKernelSeconds = 0.085;
+    static constexpr float kMinFrequency = 20.0f;
+    static constexpr float kMaxFrequency = 20000.0f;
+    static constexpr float kMinGainDb = -24.0f;
+    static constexpr float kMaxGainDb = 24.0f;
+
+    struct BandSettings {
+        float midGainDb = 0.0f;
+        float sideGainDb = 0.0f;
+        bool midEnabled = true;
+        bool sideEnabled = true;
+
+        bool operator==(const BandSettings &other) const {
+            return midGainDb == other.midGainDb && sideGainDb == other.sideGainDb
+                   && midEnabled == other.midEnabled && sideEnabled == other.sideEnabled;
+        }
+    };
+
+    MultibandCrossover();
+
+    /** The kBands edges: Sub | Low | Low-Mid | Mid | Hi-Mid | High | Air. */
+    static std::vector<float> getDefaultFrequencies();
+
+    /** Allocate for numUnits channel pairs / singles and design the current frequencies. */
+    void prepare(const juce::dsp::ProcessSpec &spec, size_t numUnits);
+
+    /** Clear every delay line; output is silent for the latency, then follows the input. */
+    void reset() noexcept;
+
+    /** Partition size plus the FIR's group delay, at the prepared sample rate. */
+    int getLatencySamples() const noexcept { return latencySamples.load(std::memory_order_relaxed); }
+
+    /** Latency at sampleRate (for reporting before prepare()). */
+    static int getLatencySamples(double sampleRate) noexcept;
+
+    /**
+     * Message thread. Crossover frequencies in Hz: sorted, clamped to [kMinFrequency, kMaxFrequency]
+     * (and below Nyquist when designed), at most kMaxBands - 1 and at least one. Bands number one
+     * more than the frequencies. Designs the new lowpasses here when prepared.
+     */
+    void setFrequencies(const std::vector<float> &frequencies);
+    const std::vector<float> &getFrequencies() const { return frequencies; }
+    int getNumBands() const { return static_cast<int>(frequencies.size()) + 1; }
+
+    /** Message thread. Gains are clamped to [kMinGainDb, kMaxGainDb]; out-of-range bands are ignored. */
+    void setBand(int band, const BandSettings &settings);
+    BandSettings getBand(int band) const;
+
+    /**
+     * Process every unit of one block in place. rights[u] == nullptr marks a single (mid only);
+     * pairs are split into mid/side, filtered and decoded back to left/right, all delayed by
+     * getLatencySamples(). Double blocks are converted sample by sample; the convolution runs in float.
+     */
+    template<typename SampleType>
+    void process(SampleType *const *lefts, SampleType *const *rights, size_t numUnits, size_t numSamples) noexcept;
+
+private:
+    // Lowpass spectra for one set of frequencies: row 0 the delay, row e + 1 the lowpass at edge e
+    struct Design {
+        std::array<PartitionedConvolver::Kernel, kMaxBands> rows;
+        size_t numEdges = 0;
+    };
+
+    // Delay lines and partition FIFOs of one pair (side unused for singles)
+    struct Unit {
+        PartitionedConvolver mid, side;
+        std::vector<float> midInput, sideInput, midOutput, sideOutput;
+    };
+
+    void designInto(Design &design);
+    void publishDesign();
+
+    /** At a partition boundary: adopt a new design or gains and pick the kernels to fade from. */
+    bool updateKernels() noexcept;
+    void combine(const Design &design, const std::array<float, kMaxBands> &gains,
+                 PartitionedConvolver::Kernel &kernel) const noexcept;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    double sampleRate = 0.0;
+    size_t kernelLength = 0;
+    size_t numPartitions = 0;
+    std::atomic<int> latencySamples{0};
+    bool isPrepared = false;
+
+    // Message thread
+    std::vector<float> frequencies;
+    std::array<BandSettings, kMaxBands> bands{};
+    std::vector<float> designImpulse, designScratch;
+
+    // Triple buffer: the message thread fills designs[backDesign] and swaps it into pendingDesign
+    // with kFreshDesign set; the audio thread swaps designs[frontDesign] out when it sees the flag.
+    static constexpr int kFreshDesign = 4;
+    std::array<Design, 3> designs;
+    int backDesign = 0;
+    std::atomic<int> pendingDesign{1};
+    int frontDesign = 2;
+
+    // Band gains as linear factors (0 when disabled), bumped generation on every change
+    std::array<std::atomic<float>, kMaxBands> midGains, sideGains;
+    std::atomic<juce::uint32> gainGeneration{0};
+    juce::uint32 appliedGeneration = 0;
+
+    // Audio thread: combined kernels, two per channel so the previous one can fade out
+    std::array<PartitionedConvolver::Kernel, 2> midKernels, sideKernels;
+    int activeKernel = 0;
+    bool hasKernels = false;
+
+    std::vector<std::unique_ptr<Unit>> units;
+    size_t position = 0; // within the current partition, shared by all units
+};
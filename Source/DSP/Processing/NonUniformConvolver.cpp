@@ -0,0 +1,138 @@
+#include "NonUniformConvolver.h"
+
+#include <algorithm>
+
+namespace {
+    // Partitions stage needs for kernels of up to maxLength taps (at least one)
+    size_t partitionsFor(const size_t stage, const size_t maxLength) noexcept {
+        const size_t offset = NonUniformConvolver::getTailOffset();
+
+        if (stage == 0) {
+            const size_t taps = juce::jmin(maxLength, offset);
+            return juce::jmax<size_t>(1, (taps + NonUniformConvolver::getHeadSize() - 1)
+                                         / NonUniformConvolver::getHeadSize());
+        }
+
+        const size_t taps = maxLength > offset ? maxLength - offset : 0;
+        return juce::jmax<size_t>(1, (taps + NonUniformConvolver::getTailSize() - 1)
+                                     / NonUniformConvolver::getTailSize());
+    }
+
+    const juce::dsp::FFT &fftFor(const NonUniformConvolver::Ffts &ffts, const size_t stage) noexcept {
+        return stage == 0 ? ffts.head : ffts.tail;
+    }
+}
+
+void NonUniformConvolver::prepare(const Ffts &ffts, const size_t maxLength) {
+    for (size_t s = 0; s < kNumStages; ++s) {
+        auto &stage = stages[s];
+        stage.size = s == 0 ? getHeadSize() : getTailSize();
+        stage.convolver.prepare(fftFor(ffts, s), partitionsFor(s, maxLength));
+        stage.input.assign(stage.size, 0.0f);
+        stage.output.assign(stage.size, 0.0f);
+        stage.kernel = nullptr;
+    }
+
+    prepareKernel(ffts, maxLength, silence);
+    currentKernel = &silence;
+    reset();
+}
+
+void NonUniformConvolver::reset() noexcept {
+    for (auto &stage: stages) {
+        stage.convolver.reset();
+        std::fill(stage.input.begin(), stage.input.end(), 0.0f);
+        std::fill(stage.output.begin(), stage.output.end(), 0.0f);
+        stage.position = 0;
+    }
+}
+
+void NonUniformConvolver::prepareKernel(const Ffts &ffts, const size_t maxLength, Kernel &kernel) {
+    for (size_t s = 0; s < kNumStages; ++s)
+        PartitionedConvolver::prepareKernel(fftFor(ffts, s), partitionsFor(s, maxLength), kernel.stages[s]);
+}
+
+void NonUniformConvolver::transformKernel(const Ffts &ffts, const float *impulse, const size_t length,
+                                          Kernel &kernel, std::vector<float> &scratch) {
+    const size_t offset = getTailOffset();
+    const size_t headLength = juce::jmin(length, offset);
+
+    PartitionedConvolver::transformKernel(ffts.head, impulse, headLength, kernel.stages[0], scratch);
+
+    if (length > offset)
+        PartitionedConvolver::transformKernel(ffts.tail, impulse + offset, length - offset, kernel.stages[1], scratch);
+    else
+        PartitionedConvolver::clearKernel(kernel.stages[1]);
+}
+
+void NonUniformConvolver::copyKernel(Kernel &destination, const Kernel &source) noexcept {
+    for (size_t s = 0; s < kNumStages; ++s) {
+        PartitionedConvolver::clearKernel(destination.stages[s]);
+        PartitionedConvolver::addKernel(destination.stages[s], source.stages[s], 1.0f);
+    }
+}
+
+void NonUniformConvolver::setKernel(const Kernel *kernel) noexcept {
+    currentKernel = kernel != nullptr ? kernel : &silence;
+
+    // A stage that has never convolved has nothing to fade from
+    for (auto &stage: stages)
+        if (stage.kernel == nullptr)
+            stage.kernel = currentKernel;
+}
+
+bool NonUniformConvolver::isSwitching() const noexcept {
+    return std::any_of(stages.begin(), stages.end(),
+                       [this](const Stage &stage) { return stage.kernel != currentKernel; });
+}
+
+void NonUniformConvolver::processStage(const size_t index) noexcept {
+    auto &stage = stages[index];
+    const auto *from = stage.kernel != nullptr && stage.kernel != currentKernel
+                           ? &stage.kernel->stages[index]
+                           : nullptr;
+
+    stage.convolver.process(stage.input.data(), stage.output.data(), currentKernel->stages[index], from);
+    stage.kernel = currentKernel;
+    stage.position = 0;
+}
+
+template<typename SampleType>
+void NonUniformConvolver::process(SampleType *data, const size_t numSamples) noexcept {
+    if (currentKernel == nullptr)
+        return;
+
+    auto &head = stages[0];
+    auto &tail = stages[1];
+
+    size_t done = 0;
+    while (done < numSamples) {
+        // The tail partition is a whole number of head partitions, so the head boundary comes first
+        const size_t len = juce::jmin(numSamples - done, head.size - head.position, tail.size - tail.position);
+
+        SampleType *io = data + done;
+        float *headIn = head.input.data() + head.position;
+        float *tailIn = tail.input.data() + tail.position;
+        const float *headOut = head.output.data() + head.position;
+        const float *tailOut = tail.output.data() + tail.position;
+
+        for (size_t i = 0; i < len; ++i) {
+            const auto x = static_cast<float>(io[i]);
+            headIn[i] = x;
+            tailIn[i] = x;
+            io[i] = static_cast<SampleType>(headOut[i] + tailOut[i]);
+        }
+
+        done += len;
+        head.position += len;
+        tail.position += len;
+
+        if (head.position == head.size)
+            processStage(0);
+        if (tail.position == tail.size)
+            processStage(1);
+    }
+}
+
+template void NonUniformConvolver::process<float>(float *, size_t) noexcept;
+template void NonUniformConvolver::process<double>(double *, size_t) noexcept;
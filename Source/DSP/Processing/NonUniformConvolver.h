@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+#include "PartitionedConvolver.h"
+
+/**
+ * NonUniformConvolver
+ *
+ * Low-latency convolution of one channel with a long kernel: two PartitionedConvolver stages,
+ * a short head (kHeadOrder, 64-sample partitions) for the start of the kernel and a long tail
+ * (kTailOrder, 1024-sample partitions) for the rest. The head alone sets the latency (one head
+ * partition), the tail carries most of the taps at a fraction of the head's per-sample cost.
+ *
+ * The tail stage delivers its output one tail partition after the input, so it can only take
+ * taps from getTailOffset() = tail partition - head partition onwards; the head covers the taps
+ * before that. Each stage buffers its own input and output partitions and the two outputs are
+ * summed sample by sample, so host block sizes are free.
+ *
+ * Kernels are caller-owned (see Kernel) and switched with setKernel(): each stage adopts the new
+ * kernel at its next partition and crossfades from the one it last used across it, so a switch
+ * completes within one tail partition (isSwitching()).
+ *
+ * The FFTs are shared through Ffts and must outlive the convolver; transforms keep no state, so
+ * kernels may be built on another thread while the audio thread convolves.
+ *
+ * Threading: prepare() and the kernel builders off the audio thread; reset(), setKernel() and
+ * process() on the audio thread, realtime-safe.
+ */
+class NonUniformConvolver {
+public:
+    static constexpr int kHeadOrder = 6; // 64-sample head partitions: the latency
+    static constexpr int kTailOrder = 10; // 1024-sample tail partitions
+    static constexpr size_t kNumStages = 2;
+
+    /** The head and tail FFTs (twice the partition sizes). */
+    struct Ffts {
+        juce::dsp::FFT head{kHeadOrder + 1};
+        juce::dsp::FFT tail{kTailOrder + 1};
+    };
+
+    /** A kernel's head and tail partition spectra. */
+    struct Kernel {
+        std::array<PartitionedConvolver::Kernel, kNumStages> stages;
+    };
+
+    static constexpr size_t getHeadSize() noexcept { return size_t{1} << kHeadOrder; }
+    static constexpr size_t getTailSize() noexcept { return size_t{1} << kTailOrder; }
+
+    /** First tap handled by the tail stage; earlier taps belong to the head. */
+    static constexpr size_t getTailOffset() noexcept { return getTailSize() - getHeadSize(); }
+
+    static constexpr int getLatencySamples() noexcept { return static_cast<int>(getHeadSize()); }
+
+    /** Size both stages for kernels of up to maxLength taps. */
+    void prepare(const Ffts &ffts, size_t maxLength);
+
+    /** Clear the input history and partition buffers; the kernel is kept. */
+    void reset() noexcept;
+
+    //==============================================================================
+    // Kernel building (not the audio thread, except copyKernel())
+
+    /** Allocate kernel for up to maxLength taps and silence it. */
+    static void prepareKernel(const Ffts &ffts, size_t maxLength, Kernel &kernel);
+
+    /** Split a time-domain impulse between the stages and transform it into kernel. */
+    static void transformKernel(const Ffts &ffts, const float *impulse, size_t length, Kernel &kernel,
+                                std::vector<float> &scratch);
+
+    /** destination = source for kernels prepared alike; realtime-safe. */
+    static void copyKernel(Kernel &destination, const Kernel &source) noexcept;
+
+    //==============================================================================
+    /**
+     * Use kernel from each stage's next partition, crossfading from the previous one. The kernel
+     * must stay untouched until the switch completes (see isSwitching()). nullptr silences.
+     */
+    void setKernel(const Kernel *kernel) noexcept;
+
+    /** True while a stage has not yet adopted the kernel last set. */
+    bool isSwitching() const noexcept;
+
+    /** Convolve numSamples in place, delayed by getLatencySamples(). Doubles run in float. */
+    template<typename SampleType>
+    void process(SampleType *data, size_t numSamples) noexcept;
+
+private:
+    struct Stage {
+        PartitionedConvolver convolver;
+        std::vector<float> input, output;
+        size_t size = 0;
+        size_t position = 0;
+        const Kernel *kernel = nullptr; // the kernel this stage last convolved with
+    };
+
+    void processStage(size_t index) noexcept;
+
+    std::array<Stage, kNumStages> stages;
+    const Kernel *currentKernel = nullptr;
+    Kernel silence; // stands in for a nullptr kernel
+};
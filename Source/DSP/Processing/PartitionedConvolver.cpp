@@ -0,0 +1,162 @@
+#include "PartitionedConvolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+void PartitionedConvolver::prepare(const juce::dsp::FFT &fftToUse, const size_t numPartitions) {
+    fft = &fftToUse;
+
+    const auto fftSize = static_cast<size_t>(fftToUse.getSize());
+    partitionSize = fftSize / 2;
+    spectrumSize = getSpectrumSize(fftSize);
+    maxPartitions = juce::jmax<size_t>(1, numPartitions);
+
+    delayLine.assign(maxPartitions * spectrumSize, 0.0f);
+    previousInput.assign(partitionSize, 0.0f);
+    frame.assign(2 * fftSize, 0.0f);
+    fadeFrame.assign(2 * fftSize, 0.0f);
+
+    fadeIn.resize(partitionSize);
+    for (size_t i = 0; i < partitionSize; ++i)
+        fadeIn[i] = static_cast<float>(0.5 - 0.5 * std::cos(juce::MathConstants<double>::pi
+                                                            * static_cast<double>(i + 1)
+                                                            / static_cast<double>(partitionSize)));
+
+    head = 0;
+}
+
+void PartitionedConvolver::reset() noexcept {
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    std::fill(previousInput.begin(), previousInput.end(), 0.0f);
+    head = 0;
+}
+
+void PartitionedConvolver::prepareKernel(const juce::dsp::FFT &fftToUse, const size_t numPartitions,
+                                         Kernel &kernel) {
+    kernel.spectrumSize = getSpectrumSize(static_cast<size_t>(fftToUse.getSize()));
+    kernel.spectra.assign(juce::jmax<size_t>(1, numPartitions) * kernel.spectrumSize, 0.0f);
+    kernel.firstPartition = 0;
+    kernel.endPartition = 0;
+}
+
+void PartitionedConvolver::transformKernel(const juce::dsp::FFT &fftToUse, const float *impulse,
+                                           const size_t length, Kernel &kernel, std::vector<float> &scratch) {
+    const auto fftSize = static_cast<size_t>(fftToUse.getSize());
+    const size_t blockSize = fftSize / 2;
+    const size_t capacity = kernel.spectra.size() / kernel.spectrumSize;
+
+    jassert(kernel.spectrumSize == getSpectrumSize(fftSize));
+    jassert(length <= capacity * blockSize);
+    scratch.resize(2 * fftSize);
+
+    clearKernel(kernel);
+    const size_t numPartitions = juce::jmin(capacity, (length + blockSize - 1) / blockSize);
+
+    for (size_t p = 0; p < numPartitions; ++p) {
+        const size_t start = p * blockSize;
+        const size_t len = juce::jmin(blockSize, length - start);
+
+        // All-zero stretches (e.g. either side of a centred impulse) stay silent partitions
+        if (std::all_of(impulse + start, impulse + start + len, [](const float s) { return s == 0.0f; }))
+            continue;
+
+        std::fill(scratch.begin(), scratch.end(), 0.0f);
+        std::copy(impulse + start, impulse + start + len, scratch.begin());
+        fftToUse.performRealOnlyForwardTransform(scratch.data(), true);
+
+        std::copy(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(kernel.spectrumSize),
+                  kernel.spectra.begin() + static_cast<std::ptrdiff_t>(p * kernel.spectrumSize));
+
+        if (kernel.isSilent())
+            kernel.firstPartition = p;
+        kernel.endPartition = p + 1;
+    }
+}
+
+void PartitionedConvolver::clearKernel(Kernel &kernel) noexcept {
+    if (!kernel.isSilent()) {
+        const auto begin = kernel.spectra.begin();
+        std::fill(begin + static_cast<std::ptrdiff_t>(kernel.firstPartition * kernel.spectrumSize),
+                  begin + static_cast<std::ptrdiff_t>(kernel.endPartition * kernel.spectrumSize), 0.0f);
+    }
+
+    kernel.firstPartition = 0;
+    kernel.endPartition = 0;
+}
+
+void PartitionedConvolver::addKernel(Kernel &kernel, const Kernel &source, const float weight) noexcept {
+    jassert(kernel.spectra.size() == source.spectra.size() && kernel.spectrumSize == source.spectrumSize);
+
+    if (source.isSilent() || weight == 0.0f)
+        return;
+
+    const size_t offset = source.firstPartition * source.spectrumSize;
+    const auto count = static_cast<int>((source.endPartition - source.firstPartition) * source.spectrumSize);
+    juce::FloatVectorOperations::addWithMultiply(kernel.spectra.data() + offset, source.spectra.data() + offset,
+                                                 weight, count);
+
+    if (kernel.isSilent()) {
+        kernel.firstPartition = source.firstPartition;
+        kernel.endPartition = source.endPartition;
+    } else {
+        kernel.firstPartition = juce::jmin(kernel.firstPartition, source.firstPartition);
+        kernel.endPartition = juce::jmax(kernel.endPartition, source.endPartition);
+    }
+}
+
+void PartitionedConvolver::process(const float *input, float *output, const Kernel &kernel,
+                                   const Kernel *fadeFrom) noexcept {
+    if (fft == nullptr)
+        return;
+
+    jassert(kernel.spectrumSize == spectrumSize);
+
+    // Overlap-save frame: the previous partition followed by this one
+    std::copy(previousInput.begin(), previousInput.end(), frame.begin());
+    std::copy(input, input + partitionSize, frame.begin() + static_cast<std::ptrdiff_t>(partitionSize));
+    std::copy(input, input + partitionSize, previousInput.begin());
+    std::fill(frame.begin() + static_cast<std::ptrdiff_t>(2 * partitionSize), frame.end(), 0.0f);
+
+    fft->performRealOnlyForwardTransform(frame.data(), true);
+
+    head = (head + 1) % maxPartitions;
+    std::copy(frame.begin(), frame.begin() + static_cast<std::ptrdiff_t>(spectrumSize),
+              delayLine.begin() + static_cast<std::ptrdiff_t>(head * spectrumSize));
+
+    // The second half of each inverse transform is free of circular wrap-around
+    const float *wet = frame.data() + partitionSize;
+    convolve(kernel, frame.data());
+
+    if (fadeFrom == nullptr) {
+        std::copy(wet, wet + partitionSize, output);
+        return;
+    }
+
+    const float *previous = fadeFrame.data() + partitionSize;
+    convolve(*fadeFrom, fadeFrame.data());
+
+    for (size_t i = 0; i < partitionSize; ++i)
+        output[i] = previous[i] + (wet[i] - previous[i]) * fadeIn[i];
+}
+
+void PartitionedConvolver::convolve(const Kernel &kernel, float *buffer) const noexcept {
+    std::fill(buffer, buffer + 2 * 2 * partitionSize, 0.0f);
+
+    if (kernel.isSilent())
+        return;
+
+    const size_t end = juce::jmin(kernel.endPartition, maxPartitions);
+
+    for (size_t p = kernel.firstPartition; p < end; ++p) {
+        // Partition p of the kernel meets the input from p partitions ago
+        const float *x = delayLine.data() + ((head + maxPartitions - p) % maxPartitions) * spectrumSize;
+        const float *h = kernel.spectra.data() + p * spectrumSize;
+
+        for (size_t k = 0; k < spectrumSize; k += 2) {
+            buffer[k] += x[k] * h[k] - x[k + 1] * h[k + 1];
+            buffer[k + 1] += x[k] * h[k + 1] + x[k + 1] * h[k];
+        }
+    }
+
+    fft->performRealOnlyInverseTransform(buffer);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * PartitionedConvolver
+ *
+ * Uniformly partitioned FFT convolution (overlap-save) for one channel. A kernel is cut into
+ * partitions of B samples, each transformed once at 2B points (see transformKernel()). Every
+ * B-sample input partition is transformed once into a frequency-domain delay line; one output
+ * partition is the inverse transform of the delay-line spectra times the kernel spectra, summed
+ * over the kernel's partitions. Per sample that is one forward and one inverse 2B-point FFT per
+ * B samples plus numPartitions complex multiply-adds per bin.
+ *
+ * Kernels are caller-owned spectra, so several convolvers can share one, and a convolver can
+ * change kernel between any two partitions: the delay line holds only input, so the new kernel
+ * applies to the full history at once. process() can crossfade from the old kernel's output to
+ * the new one's over that partition to keep the switch click-free.
+ *
+ * Works on whole partitions; buffering host blocks into them, and the B samples of latency that
+ * costs, is the caller's. The FFT (size 2B) is shared and must outlive the convolver.
+ *
+ * Audio thread only; realtime-safe (allocation only in prepare()).
+ */
+class PartitionedConvolver {
+public:
+    /**
+     * Partition spectra of one kernel: partition p occupies spectrumSize floats from
+     * p * spectrumSize, bins 0..B as interleaved re/im. Partitions outside
+     * [firstPartition, endPartition) are silent and skipped.
+     */
+    struct Kernel {
+        std::vector<float> spectra;
+        size_t spectrumSize = 0; // floats per partition
+        size_t firstPartition = 0;
+        size_t endPartition = 0;
+
+        bool isSilent() const noexcept { return firstPartition >= endPartition; }
+    };
+
+    /** Size the delay line for kernels of up to maxPartitions partitions of fft.getSize() / 2. */
+    void prepare(const juce::dsp::FFT &fft, size_t maxPartitions);
+
+    /** Clear the input history. */
+    void reset() noexcept;
+
+    size_t getPartitionSize() const noexcept { return partitionSize; }
+
+    //==============================================================================
+    // Kernel building (any one thread at a time; not the audio thread, the sizing allocates)
+
+    /** Floats per partition spectrum for an FFT of fftSize points. */
+    static size_t getSpectrumSize(const size_t fftSize) noexcept { return fftSize + 2; }
+
+    /** Allocate kernel for maxPartitions partitions of the fft's size and silence it. */
+    static void prepareKernel(const juce::dsp::FFT &fft, size_t maxPartitions, Kernel &kernel);
+
+    /**
+     * Transform a time-domain impulse of length samples (at most maxPartitions * B) into kernel.
+     * scratch is the caller's FFT buffer (resized to 2 * fft.getSize() on first use).
+     */
+    static void transformKernel(const juce::dsp::FFT &fft, const float *impulse, size_t length, Kernel &kernel,
+                                std::vector<float> &scratch);
+
+    /** Silence kernel (only its active partitions are touched). */
+    static void clearKernel(Kernel &kernel) noexcept;
+
+    /** kernel += source * weight, partition by partition; the active range grows to cover source's. */
+    static void addKernel(Kernel &kernel, const Kernel &source, float weight) noexcept;
+
+    //==============================================================================
+    /**
+     * Convolve one partition: input and output hold getPartitionSize() samples (they may alias).
+     * With fadeFrom, output fades from fadeFrom's result to kernel's across the partition
+     * (raised cosine); the second kernel costs its multiply-adds and one more inverse FFT.
+     */
+    void process(const float *input, float *output, const Kernel &kernel, const Kernel *fadeFrom = nullptr) noexcept;
+
+private:
+    /** Sum the delay line against kernel into buffer (2 * fftSize floats) and inverse transform it. */
+    void convolve(const Kernel &kernel, float *buffer) const noexcept;
+
+    const juce::dsp::FFT *fft = nullptr;
+    size_t partitionSize = 0;
+    size_t spectrumSize = 0;
+    size_t maxPartitions = 0;
+
+    std::vector<float> delayLine; // maxPartitions input spectra, newest at head
+    size_t head = 0;
+
+    std::vector<float> previousInput; // last input partition (first half of the overlap-save frame)
+    std::vector<float> frame, fadeFrame; // 2 * fftSize, FFT scratch
+    std::vector<float> fadeIn; // partitionSize raised-cosine gains
+};
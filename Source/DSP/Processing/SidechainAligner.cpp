@@ -0,0 +1,278 @@
+#include "SidechainAligner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr size_t kDrainBlock = 4096;
+}
+
+//==============================================================================
+void SidechainAligner::Decimator::prepare(const size_t numTaps) {
+    history.assign(2 * numTaps, 0.0f);
+    position = 0;
+}
+
+void SidechainAligner::Decimator::push(const float sample) noexcept {
+    const size_t numTaps = history.size() / 2;
+    history[position] = sample;
+    history[position + numTaps] = sample;
+    position = position + 1 == numTaps ? 0 : position + 1;
+}
+
+float SidechainAligner::Decimator::output(const std::vector<float> &taps) const noexcept {
+    // Oldest to newest from position; the taps are symmetric, so the order does not matter
+    const float *span = history.data() + position;
+    float sum = 0.0f;
+    for (size_t i = 0; i < taps.size(); ++i)
+        sum += taps[i] * span[i];
+    return sum;
+}
+
+void SidechainAligner::DelayLine::prepare(const int numChannels, const int capacity, const int maximumBlockSize) {
+    ring.setSize(numChannels, capacity);
+    ring.clear();
+    output.setSize(numChannels, maximumBlockSize);
+    writePosition = 0;
+}
+
+void SidechainAligner::DelayLine::refer(const juce::AudioBuffer<float> &input) noexcept {
+    // The sinks only read; referring to the input avoids a copy
+    view.setDataToReferTo(const_cast<float *const *>(input.getArrayOfReadPointers()),
+                          input.getNumChannels(), input.getNumSamples());
+}
+
+void SidechainAligner::DelayLine::process(const juce::AudioBuffer<float> &input, const int delay) noexcept {
+    const int numChannels = input.getNumChannels();
+    const int numSamples = input.getNumSamples();
+    const int capacity = ring.getNumSamples();
+
+    if (numChannels > ring.getNumChannels() || numSamples > output.getNumSamples() || delay + numSamples > capacity) {
+        refer(input);
+        return;
+    }
+
+    const int firstWrite = juce::jmin(numSamples, capacity - writePosition);
+    const int readPosition = (writePosition - delay + capacity) % capacity;
+    const int firstRead = juce::jmin(numSamples, capacity - readPosition);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const float *source = input.getReadPointer(ch);
+        float *line = ring.getWritePointer(ch);
+        std::copy_n(source, firstWrite, line + writePosition);
+        std::copy_n(source + firstWrite, numSamples - firstWrite, line);
+
+        if (delay > 0) {
+            float *dest = output.getWritePointer(ch);
+            std::copy_n(line + readPosition, firstRead, dest);
+            std::copy_n(line, numSamples - firstRead, dest + firstRead);
+        }
+    }
+
+    writePosition = (writePosition + numSamples) % capacity;
+
+    if (delay > 0)
+        view.setDataToReferTo(output.getArrayOfWritePointers(), numChannels, numSamples);
+    else
+        refer(input);
+}
+
+//==============================================================================
+SidechainAligner::SidechainAligner()
+    : juce::Thread("Sidechain aligner") {
+}
+
+SidechainAligner::~SidechainAligner() {
+    stopThread(kStopTimeoutMs);
+}
+
+void SidechainAligner::prepare(const double newSampleRate, const int maximumBlockSize,
+                               const int numMainChannels, const int numSidechainChannels) {
+    stopThread(kStopTimeoutMs);
+
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    factor = juce::jmax(1, juce::roundToInt(sampleRate / kDecimatedRate));
+    const double decimatedRate = sampleRate / static_cast<double>(factor);
+
+    // Blackman-windowed sinc, cut off between the estimator's passband and the decimated Nyquist
+    const size_t numTaps = static_cast<size_t>(kFilterTapsPerPhase * factor + 1);
+    const double cutoff = 0.5 * (1.0 + GccPhatEstimator::kPassbandFraction) * 0.5 / static_cast<double>(factor);
+    const double centre = 0.5 * static_cast<double>(numTaps - 1);
+    filterTaps.resize(numTaps);
+    double sum = 0.0;
+    for (size_t i = 0; i < numTaps; ++i) {
+        const double x = static_cast<double>(i) - centre;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(2.0 * juce::MathConstants<double>::pi * cutoff * x)
+                                             / (2.0 * juce::MathConstants<double>::pi * cutoff * x);
+        const double phase = 2.0 * juce::MathConstants<double>::pi * static_cast<double>(i)
+                             / static_cast<double>(numTaps - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        filterTaps[i] = static_cast<float>(sinc * window);
+        sum += sinc * window;
+    }
+    for (auto &tap: filterTaps)
+        tap = static_cast<float>(tap / sum);
+
+    mainDecimator.prepare(numTaps);
+    sidechainDecimator.prepare(numTaps);
+    decimationPhase = 0;
+
+    const int blockSize = juce::jmax(1, maximumBlockSize);
+    mainStaging.assign(static_cast<size_t>(blockSize / factor + 1), 0.0f);
+    sidechainStaging.assign(mainStaging.size(), 0.0f);
+
+    const int fifoSize = juce::roundToInt(decimatedRate * kFifoSeconds);
+    fifo.setTotalSize(fifoSize);
+    mainFifo.assign(static_cast<size_t>(fifoSize), 0.0f);
+    sidechainFifo.assign(static_cast<size_t>(fifoSize), 0.0f);
+    mainDrain.assign(kDrainBlock, 0.0f);
+    sidechainDrain.assign(kDrainBlock, 0.0f);
+
+    maxDelaySamples = static_cast<int>(std::ceil(static_cast<double>(kMaxDelayMs) * 0.001 * sampleRate));
+    estimator.prepare(decimatedRate, factor, (maxDelaySamples + factor - 1) / factor);
+
+    mainLine.prepare(juce::jmax(1, numMainChannels), maxDelaySamples + blockSize, blockSize);
+    sidechainLine.prepare(juce::jmax(1, numSidechainChannels), maxDelaySamples + blockSize, blockSize);
+
+    // The measurement starts over
+    delaySamples.store(0, std::memory_order_relaxed);
+    confidence.store(0.0f, std::memory_order_relaxed);
+    hasLastEstimate = false;
+
+    isPrepared = true;
+
+    if (active.load(std::memory_order_relaxed))
+        startThread();
+}
+
+void SidechainAligner::setActive(const bool shouldBeActive) {
+    active.store(shouldBeActive, std::memory_order_relaxed);
+
+    if (!shouldBeActive) {
+        delaySamples.store(0, std::memory_order_relaxed);
+        confidence.store(0.0f, std::memory_order_relaxed);
+    }
+
+    if (!isPrepared)
+        return;
+
+    if (shouldBeActive && !isThreadRunning()) {
+        // Start from a clean measurement; whatever was queued before the last stop is stale
+        estimator.reset();
+        fifo.finishedRead(fifo.getNumReady());
+        hasLastEstimate = false;
+        startThread();
+    } else if (!shouldBeActive) {
+        stopThread(kStopTimeoutMs);
+    }
+}
+
+//==============================================================================
+void SidechainAligner::run() {
+    while (!threadShouldExit()) {
+        drainFifo();
+
+        GccPhatEstimator::Estimate estimate;
+        if (estimator.estimate(estimate)) {
+            confidence.store(estimate.confidence, std::memory_order_relaxed);
+
+            // Publish only what two estimates in a row agree on, so one noisy frame cannot move it
+            if (estimate.confidence >= kMinConfidence) {
+                if (hasLastEstimate && std::abs(estimate.lagSamples - lastLag) <= 1)
+                    delaySamples.store(juce::jlimit(-maxDelaySamples, maxDelaySamples, estimate.lagSamples),
+                                       std::memory_order_relaxed);
+
+                lastLag = estimate.lagSamples;
+                hasLastEstimate = true;
+            } else {
+                hasLastEstimate = false;
+            }
+        }
+
+        wait(kEstimateIntervalMs);
+    }
+}
+
+void SidechainAligner::drainFifo() {
+    int ready = fifo.getNumReady();
+
+    while (ready > 0) {
+        const int chunk = juce::jmin(ready, static_cast<int>(kDrainBlock));
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(chunk, start1, size1, start2, size2);
+
+        std::copy_n(mainFifo.data() + start1, size1, mainDrain.data());
+        std::copy_n(mainFifo.data() + start2, size2, mainDrain.data() + size1);
+        std::copy_n(sidechainFifo.data() + start1, size1, sidechainDrain.data());
+        std::copy_n(sidechainFifo.data() + start2, size2, sidechainDrain.data() + size1);
+        fifo.finishedRead(size1 + size2);
+
+        estimator.pushSamples(mainDrain.data(), sidechainDrain.data(), static_cast<size_t>(size1 + size2));
+        ready -= size1 + size2;
+    }
+}
+
+//==============================================================================
+template<typename SampleType>
+float SidechainAligner::monoSample(const juce::AudioBuffer<SampleType> &buffer, const int index) noexcept {
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+        return 0.0f;
+    if (numChannels == 1)
+        return static_cast<float>(buffer.getReadPointer(0)[index]);
+    return 0.5f * static_cast<float>(buffer.getReadPointer(0)[index] + buffer.getReadPointer(1)[index]);
+}
+
+template<typename SampleType>
+void SidechainAligner::capture(const juce::AudioBuffer<SampleType> &main,
+                               const juce::AudioBuffer<SampleType> &sidechain) noexcept {
+    const int numSamples = juce::jmin(main.getNumSamples(), sidechain.getNumSamples());
+    if (!isPrepared || !active.load(std::memory_order_relaxed)
+        || static_cast<size_t>(numSamples / factor + 1) > mainStaging.size())
+        return;
+
+    // Both sides decimate in step, so every kept pair is one instant
+    int count = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        mainDecimator.push(monoSample(main, i));
+        sidechainDecimator.push(monoSample(sidechain, i));
+
+        if (++decimationPhase < factor)
+            continue;
+
+        decimationPhase = 0;
+        mainStaging[static_cast<size_t>(count)] = mainDecimator.output(filterTaps);
+        sidechainStaging[static_cast<size_t>(count)] = sidechainDecimator.output(filterTaps);
+        ++count;
+    }
+
+    // Whole blocks or nothing, for both sides at once: they must stay paired
+    if (count == 0 || fifo.getFreeSpace() < count)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(count, start1, size1, start2, size2);
+    std::copy_n(mainStaging.data(), size1, mainFifo.data() + start1);
+    std::copy_n(mainStaging.data() + size1, size2, mainFifo.data() + start2);
+    std::copy_n(sidechainStaging.data(), size1, sidechainFifo.data() + start1);
+    std::copy_n(sidechainStaging.data() + size1, size2, sidechainFifo.data() + start2);
+    fifo.finishedWrite(size1 + size2);
+}
+
+void SidechainAligner::align(const juce::AudioBuffer<float> &main, const juce::AudioBuffer<float> &sidechain) noexcept {
+    // Inactive, both lines stay idle and refer to the inputs
+    if (!isPrepared || !active.load(std::memory_order_relaxed)) {
+        mainLine.refer(main);
+        sidechainLine.refer(sidechain);
+        return;
+    }
+
+    const int delay = delaySamples.load(std::memory_order_relaxed);
+    mainLine.process(main, juce::jmax(0, delay));
+    sidechainLine.process(sidechain, juce::jmax(0, -delay));
+}
+
+template void SidechainAligner::capture<float>(const juce::AudioBuffer<float> &,
+                                               const juce::AudioBuffer<float> &) noexcept;
+template void SidechainAligner::capture<double>(const juce::AudioBuffer<double> &,
+                                                const juce::AudioBuffer<double> &) noexcept;
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "GccPhatEstimator.h"
+
+/**
+ * SidechainAligner
+ *
+ * Lines the sidechain up with the main input for the analyzer's comparison views. The audio
+ * thread low-passes and decimates the mono sums of both buses to about kDecimatedRate and
+ * hands them to a worker through a lock-free FIFO; the worker runs a GccPhatEstimator on them
+ * every kEstimateIntervalMs and publishes the lag once two estimates in a row agree to within a
+ * sample with at least kMinConfidence.
+ *
+ * align() then delays whichever feed leads through a preallocated delay line of up to
+ * kMaxDelayMs, so a parallel-processed return and its source reach the analyzer sample-aligned.
+ * Only the analyzer feeds are delayed: the audio path, and the reported latency, are untouched.
+ * A new lag switches the delay at the next block (a step in the display, never in the audio).
+ *
+ * Threading: prepare() and setActive() on the message thread (never concurrently with each
+ * other); capture() and align() on the audio thread, realtime-safe (a full FIFO drops the
+ * block, never blocks). Inactive, nothing is measured and align() passes the feeds through.
+ */
+class SidechainAligner : private juce::Thread {
+public:
+    static constexpr double kDecimatedRate = 12000.0;
+    static constexpr int kFilterTapsPerPhase = 16;
+    static constexpr float kMaxDelayMs = 150.0f;
+    static constexpr int kEstimateIntervalMs = 250;
+    static constexpr float kMinConfidence = 0.2f;
+    static constexpr double kFifoSeconds = 4.0;
+    static constexpr int kStopTimeoutMs = 2000;
+
+    SidechainAligner();
+    ~SidechainAligner() override;
+
+    /** Allocate for the two buses at sampleRate; restarts the worker when active. */
+    void prepare(double sampleRate, int maximumBlockSize, int numMainChannels, int numSidechainChannels);
+
+    /** Start or stop the worker; stopping drops the delay back to zero. */
+    void setActive(bool shouldBeActive);
+    bool isActive() const noexcept { return active.load(std::memory_order_relaxed); }
+
+    /** Any thread. Published lag of the sidechain behind the main input (negative: it leads). */
+    int getDelaySamples() const noexcept { return delaySamples.load(std::memory_order_relaxed); }
+
+    /** Any thread. Confidence of the last estimate (0..1). */
+    float getConfidence() const noexcept { return confidence.load(std::memory_order_relaxed); }
+
+    /** Decimation factor for the prepared sample rate. */
+    int getDecimationFactor() const noexcept { return factor; }
+
+    /** Audio thread. Measure a block of both buses (before anything overwrites either). */
+    template<typename SampleType>
+    void capture(const juce::AudioBuffer<SampleType> &main, const juce::AudioBuffer<SampleType> &sidechain) noexcept;
+
+    /**
+     * Audio thread. Delay the leading feed by the published lag; the results stay valid until
+     * the next call. Blocks the delay lines were not prepared for pass through.
+     */
+    void align(const juce::AudioBuffer<float> &main, const juce::AudioBuffer<float> &sidechain) noexcept;
+
+    const juce::AudioBuffer<float> &getAlignedMain() const noexcept { return mainLine.view; }
+    const juce::AudioBuffer<float> &getAlignedSidechain() const noexcept { return sidechainLine.view; }
+
+private:
+    // Windowed-sinc low-pass history; the filter is evaluated only at the kept samples
+    struct Decimator {
+        std::vector<float> history; // taps twice over, so each output reads one linear span
+        size_t position = 0;
+
+        void prepare(size_t numTaps);
+        void push(float sample) noexcept;
+        float output(const std::vector<float> &taps) const noexcept;
+    };
+
+    // Ring of the feed's channels; view refers to the input or to output
+    struct DelayLine {
+        juce::AudioBuffer<float> ring, output, view;
+        int writePosition = 0;
+
+        void prepare(int numChannels, int capacity, int maximumBlockSize);
+        void refer(const juce::AudioBuffer<float> &input) noexcept;
+        void process(const juce::AudioBuffer<float> &input, int delay) noexcept;
+    };
+
+    void run() override;
+
+    /** Worker: move the FIFO into the estimator. */
+    void drainFifo();
+
+    template<typename SampleType>
+    static float monoSample(const juce::AudioBuffer<SampleType> &buffer, int index) noexcept;
+
+    double sampleRate = 44100.0;
+    int factor = 1;
+    int maxDelaySamples = 0;
+    bool isPrepared = false;
+    std::atomic<bool> active{false};
+
+    // Audio thread: decimation into the staging blocks
+    std::vector<float> filterTaps;
+    Decimator mainDecimator, sidechainDecimator;
+    int decimationPhase = 0;
+    std::vector<float> mainStaging, sidechainStaging;
+
+    // Decimated pairs: audio thread writes, worker reads
+    juce::AbstractFifo fifo{1};
+    std::vector<float> mainFifo, sidechainFifo;
+
+    // Worker state
+    GccPhatEstimator estimator;
+    std::vector<float> mainDrain, sidechainDrain;
+    bool hasLastEstimate = false;
+    int lastLag = 0;
+
+    std::atomic<int> delaySamples{0};
+    std::atomic<float> confidence{0.0f};
+
+    // Audio thread
+    DelayLine mainLine, sidechainLine;
+};
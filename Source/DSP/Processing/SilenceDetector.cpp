@@ -0,0 +1,64 @@
+#include "SilenceDetector.h"
+
+void SilenceDetector::prepare(const double newSampleRate) {
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    reset();
+}
+
+void SilenceDetector::reset() noexcept {
+    silentSamples = 0;
+    zeroSamples = 0;
+    sleeping.store(false, std::memory_order_relaxed);
+}
+
+void SilenceDetector::setThresholdDb(const float newThresholdDb) noexcept {
+    thresholdDb.store(juce::jlimit(kMinThresholdDb, kMaxThresholdDb, newThresholdDb), std::memory_order_relaxed);
+}
+
+void SilenceDetector::setHoldMs(const float newHoldMs) noexcept {
+    holdMs.store(juce::jlimit(kMinHoldMs, kMaxHoldMs, newHoldMs), std::memory_order_relaxed);
+}
+
+template<typename SampleType>
+SilenceDetector::Activity SilenceDetector::process(const juce::AudioBuffer<SampleType> &buffer) noexcept {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        if (sleeping.load(std::memory_order_relaxed))
+            reset();
+        return Activity::Active;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    // decibelsToGain() maps -100 dB and below to 0 unless told otherwise
+    const auto threshold = static_cast<SampleType>(
+        juce::Decibels::decibelsToGain(thresholdDb.load(std::memory_order_relaxed), kMinThresholdDb - 1.0f));
+
+    // Stop at the first channel that reaches the threshold: sound is the common case
+    SampleType peak = 0;
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+        const auto magnitude = buffer.getMagnitude(ch, 0, numSamples);
+        if (magnitude >= threshold) {
+            reset();
+            return Activity::Active;
+        }
+        peak = juce::jmax(peak, magnitude);
+    }
+
+    zeroSamples = peak == SampleType(0) ? zeroSamples + numSamples : 0;
+
+    if (sleeping.load(std::memory_order_relaxed))
+        return Activity::Sleeping;
+
+    const auto holdSamples =
+        static_cast<juce::int64>(static_cast<double>(holdMs.load(std::memory_order_relaxed)) * 0.001 * sampleRate);
+
+    silentSamples += numSamples;
+
+    if (silentSamples < holdSamples)
+        return Activity::Active;
+
+    sleeping.store(true, std::memory_order_relaxed);
+    return Activity::EnteredSleep;
+}
+
+template SilenceDetector::Activity SilenceDetector::process(const juce::AudioBuffer<float> &) noexcept;
+template SilenceDetector::Activity SilenceDetector::process(const juce::AudioBuffer<double> &) noexcept;
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ * SilenceDetector
+ *
+ * Block-level silence gate for the audio thread. A block is silent when no sample on any
+ * channel reaches the threshold. Once silent blocks have covered the hold time the detector
+ * goes to sleep, and the first block that reaches the threshold wakes it again.
+ *
+ * Sleep only says the input is too quiet to be worth analysing. Input under the threshold
+ * is still audio, so processing may only stop once hasFlushed(): asleep, and the input has
+ * been digital silence for setFlushSamples(), which the owner sets to how long its processing
+ * takes to go silent after its input does (latency plus ring-out).
+ *
+ * Threshold and hold may be set from any thread; process() is audio thread only and realtime-safe.
+ */
+class SilenceDetector {
+public:
+    static constexpr float kDefaultThresholdDb = -100.0f;
+    static constexpr float kMinThresholdDb = -140.0f;
+    static constexpr float kMaxThresholdDb = -60.0f;
+
+    static constexpr float kDefaultHoldMs = 500.0f;
+    static constexpr float kMinHoldMs = 50.0f;
+    static constexpr float kMaxHoldMs = 10000.0f;
+
+    /** What process() saw: still running, just fell asleep (this block), or asleep. */
+    enum class Activity { Active, EnteredSleep, Sleeping };
+
+    void prepare(double sampleRate);
+
+    /** Wake up and restart the hold. */
+    void reset() noexcept;
+
+    /** Any thread. Clamped to [kMinThresholdDb, kMaxThresholdDb]. */
+    void setThresholdDb(float thresholdDb) noexcept;
+    float getThresholdDb() const noexcept { return thresholdDb.load(std::memory_order_relaxed); }
+
+    /** Any thread. Clamped to [kMinHoldMs, kMaxHoldMs]. */
+    void setHoldMs(float holdMs) noexcept;
+    float getHoldMs() const noexcept { return holdMs.load(std::memory_order_relaxed); }
+
+    /** Any thread. Digital silence needed before hasFlushed() (e.g. the processing latency and tail). */
+    void setFlushSamples(int numSamples) noexcept {
+        flushSamples.store(juce::jmax(0, numSamples), std::memory_order_relaxed);
+    }
+
+    /** Off means every block is Active. On by default. */
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /** Classify one block (all of its channels). */
+    template<typename SampleType>
+    Activity process(const juce::AudioBuffer<SampleType> &buffer) noexcept;
+
+    /** Any thread. Whether the last block left the detector asleep. */
+    bool isSleeping() const noexcept { return sleeping.load(std::memory_order_relaxed); }
+
+    /** Audio thread. Asleep, and every sample for at least the flush samples has been exactly zero. */
+    bool hasFlushed() const noexcept {
+        return isSleeping() && zeroSamples >= flushSamples.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<float> thresholdDb{kDefaultThresholdDb};
+    std::atomic<float> holdMs{kDefaultHoldMs};
+    std::atomic<int> flushSamples{0};
+    std::atomic<bool> enabled{true};
+    std::atomic<bool> sleeping{false};
+
+    double sampleRate = 44100.0;
+    juce::int64 silentSamples = 0; // audio thread only
+    juce::int64 zeroSamples = 0;   // audio thread only
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#if JUCE_INTEL
+ #define GFRACTOR_SIMD_SSE 1
+ #include <emmintrin.h>
+#elif JUCE_ARM && (defined(__aarch64__) || defined(_M_ARM64))
+ #define GFRACTOR_SIMD_NEON 1
+ #include <arm_neon.h>
+#endif
+
+#define GFRACTOR_SIMD (GFRACTOR_SIMD_SSE || GFRACTOR_SIMD_NEON)
+
+/**
+ * Minimal 4 x float register helpers shared by the SIMD filter engines
+ * (StereoBiquadCascade, BandSoloBank, TruePeakMeter). SSE2 on x86/x64, NEON on ARM64; when neither is
+ * available GFRACTOR_SIMD is 0 and callers compile their scalar paths instead.
+ *
+ * Only include from .cpp files: the intrinsics headers stay out of the public headers.
+ */
+namespace SimdLanes {
+#if GFRACTOR_SIMD_SSE
+    using Vec = __m128;
+
+    inline Vec load(const float *p) noexcept { return _mm_load_ps(p); }
+    inline void store(float *p, const Vec v) noexcept { _mm_store_ps(p, v); }
+    inline Vec loadUnaligned(const float *p) noexcept { return _mm_loadu_ps(p); }
+    inline void storeUnaligned(float *p, const Vec v) noexcept { _mm_storeu_ps(p, v); }
+    inline Vec splat(const float v) noexcept { return _mm_set1_ps(v); }
+    inline Vec add(const Vec a, const Vec b) noexcept { return _mm_add_ps(a, b); }
+    inline Vec sub(const Vec a, const Vec b) noexcept { return _mm_sub_ps(a, b); }
+    inline Vec mul(const Vec a, const Vec b) noexcept { return _mm_mul_ps(a, b); }
+    inline float lane0(const Vec v) noexcept { return _mm_cvtss_f32(v); }
+    inline float lane1(const Vec v) noexcept { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))); }
+    inline float lane2(const Vec v) noexcept { return _mm_cvtss_f32(_mm_movehl_ps(v, v)); }
+    inline float lane3(const Vec v) noexcept { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+
+    /** Sum of all four lanes. */
+    inline float sum(const Vec v) noexcept {
+        const Vec pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    inline Vec abs(const Vec v) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+
+    /** Lane-wise max; SSE returns b when either lane is NaN, so pass the running max as b. */
+    inline Vec max(const Vec a, const Vec b) noexcept { return _mm_max_ps(a, b); }
+
+    /** Largest of the four lanes. */
+    inline float maxAcross(const Vec v) noexcept {
+        const Vec pairs = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_max_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+#elif GFRACTOR_SIMD_NEON
+    using Vec = float32x4_t;
+
+    inline Vec load(const float *p) noexcept { return vld1q_f32(p); }
+    inline void store(float *p, const Vec v) noexcept { vst1q_f32(p, v); }
+    inline Vec loadUnaligned(const float *p) noexcept { return vld1q_f32(p); }
+    inline void storeUnaligned(float *p, const Vec v) noexcept { vst1q_f32(p, v); }
+    inline Vec splat(const float v) noexcept { return vdupq_n_f32(v); }
+    inline Vec add(const Vec a, const Vec b) noexcept { return vaddq_f32(a, b); }
+    inline Vec sub(const Vec a, const Vec b) noexcept { return vsubq_f32(a, b); }
+    inline Vec mul(const Vec a, const Vec b) noexcept { return vmulq_f32(a, b); }
+    inline float lane0(const Vec v) noexcept { return vgetq_lane_f32(v, 0); }
+    inline float lane1(const Vec v) noexcept { return vgetq_lane_f32(v, 1); }
+    inline float lane2(const Vec v) noexcept { return vgetq_lane_f32(v, 2); }
+    inline float lane3(const Vec v) noexcept { return vgetq_lane_f32(v, 3); }
+
+    inline float sum(const Vec v) noexcept { return vaddvq_f32(v); }
+
+    inline Vec abs(const Vec v) noexcept { return vabsq_f32(v); }
+
+    inline Vec max(const Vec a, const Vec b) noexcept { return vmaxnmq_f32(a, b); }
+
+    inline float maxAcross(const Vec v) noexcept { return vmaxnmvq_f32(v); }
+#endif
+}
@@ -0,0 +1,266 @@
+#include "SpectralAudition.h"
+#include "../../Utility/BandConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 0 below edge - width / 2, 1 above edge + width / 2, raised cosine in log frequency between
+    float rise(const double frequency, const double edge, const double widthOctaves) noexcept {
+        if (frequency <= 0.0)
+            return 0.0f;
+        if (widthOctaves <= 0.0)
+            return frequency >= edge ? 1.0f : 0.0f;
+
+        const double x = std::log2(frequency / edge) / widthOctaves + 0.5;
+        if (x <= 0.0)
+            return 0.0f;
+        if (x >= 1.0)
+            return 1.0f;
+        return static_cast<float>(0.5 - 0.5 * std::cos(juce::MathConstants<double>::pi * x));
+    }
+
+    float passBand(const double frequency, const double lo, const double hi, const double widthOctaves) noexcept {
+        return rise(frequency, lo, widthOctaves) * (1.0f - rise(frequency, hi, widthOctaves));
+    }
+
+    // Union of the kBands in bandMask: contiguous runs merge, so shared edges do not dip
+    float bandUnion(const double frequency, const juce::uint32 bandMask, const double widthOctaves) noexcept {
+        float sum = 0.0f;
+        for (int first = 0; first < kNumBands; ++first) {
+            if ((bandMask & (1u << first)) == 0)
+                continue;
+
+            int last = first;
+            while (last + 1 < kNumBands && (bandMask & (1u << (last + 1))) != 0)
+                ++last;
+
+            sum += passBand(frequency, kBands[static_cast<size_t>(first)].lo, kBands[static_cast<size_t>(last)].hi,
+                            widthOctaves);
+            first = last;
+        }
+        return juce::jmin(1.0f, sum);
+    }
+}
+
+SpectralAudition::SpectralAudition() {
+    window.resize(kFftSize);
+    for (size_t i = 0; i < kFftSize; ++i)
+        window[i] = static_cast<float>(std::sin(juce::MathConstants<double>::pi * static_cast<double>(i)
+                                                / static_cast<double>(kFftSize)));
+
+    frame.assign(2 * kFftSize, 0.0f);
+    mask.assign(kNumBins, 1.0f);
+}
+
+void SpectralAudition::prepare(const juce::dsp::ProcessSpec &spec) {
+    sampleRate = spec.sampleRate > 0.0 ? spec.sampleRate : 44100.0;
+    numChannels = spec.numChannels;
+
+    if (fft == nullptr)
+        fft = std::make_unique<juce::dsp::FFT>(kFftOrder);
+
+    inputRing.assign(numChannels, std::vector<float>(kFftSize, 0.0f));
+    outputRing.assign(numChannels, std::vector<float>(kFftSize, 0.0f));
+
+    // The sample rate moves every region's bins
+    appliedGeneration = generation.load(std::memory_order_acquire) - 1;
+    reset();
+}
+
+void SpectralAudition::reset() noexcept {
+    for (auto &ring: inputRing)
+        std::fill(ring.begin(), ring.end(), 0.0f);
+    for (auto &ring: outputRing)
+        std::fill(ring.begin(), ring.end(), 0.0f);
+
+    ringPosition = 0;
+    samplesUntilFrame = kHopSize;
+    running = false;
+    identityFrames = 0;
+}
+
+void SpectralAudition::setAuditFilter(const bool active, const float frequencyHz, const float q) noexcept {
+    audit.frequency.store(frequencyHz, std::memory_order_relaxed);
+    audit.q.store(q, std::memory_order_relaxed);
+    audit.active.store(active, std::memory_order_relaxed);
+    bumpGeneration();
+}
+
+void SpectralAudition::setBandFilter(const bool active, const float frequencyHz, const float q) noexcept {
+    band.frequency.store(frequencyHz, std::memory_order_relaxed);
+    band.q.store(q, std::memory_order_relaxed);
+    band.active.store(active, std::memory_order_relaxed);
+    bumpGeneration();
+}
+
+void SpectralAudition::setBandSolo(const juce::uint32 bandMask) noexcept {
+    soloMask.store(bandMask & ((1u << kNumBands) - 1u), std::memory_order_relaxed);
+    bumpGeneration();
+}
+
+void SpectralAudition::setBandMute(const juce::uint32 bandMask) noexcept {
+    muteMask.store(bandMask & ((1u << kNumBands) - 1u), std::memory_order_relaxed);
+    bumpGeneration();
+}
+
+void SpectralAudition::setEdgeOctaves(const float octaves) noexcept {
+    edgeOctaves.store(juce::jlimit(0.0f, kMaxEdgeOctaves, octaves), std::memory_order_relaxed);
+    bumpGeneration();
+}
+
+void SpectralAudition::updateMask() noexcept {
+    appliedGeneration = generation.load(std::memory_order_acquire);
+
+    const double width = edgeOctaves.load(std::memory_order_relaxed);
+    const double binHz = sampleRate / static_cast<double>(kFftSize);
+    std::fill(mask.begin(), mask.end(), 1.0f);
+
+    // A bell region spans f / Q around its geometric centre, as the bandpass filters' -3 dB points
+    const auto applyRegion = [&](const Region &region) {
+        if (!region.active.load(std::memory_order_relaxed))
+            return;
+
+        const double centre = region.frequency.load(std::memory_order_relaxed);
+        const double q = juce::jmax(0.01, static_cast<double>(region.q.load(std::memory_order_relaxed)));
+        const double half = 1.0 / (2.0 * q);
+        const double lo = centre * (std::sqrt(1.0 + half * half) - half);
+        const double hi = lo + centre / q;
+
+        for (size_t k = 0; k < kNumBins; ++k)
+            mask[k] *= passBand(static_cast<double>(k) * binHz, lo, hi, width);
+    };
+
+    applyRegion(audit);
+    applyRegion(band);
+
+    // Solo passes the soloed bands less the muted ones; mute alone removes the muted bands
+    const auto solo = soloMask.load(std::memory_order_relaxed);
+    const auto mute = muteMask.load(std::memory_order_relaxed);
+    if (solo != 0) {
+        for (size_t k = 0; k < kNumBins; ++k)
+            mask[k] *= bandUnion(static_cast<double>(k) * binHz, solo & ~mute, width);
+    } else if (mute != 0) {
+        for (size_t k = 0; k < kNumBins; ++k)
+            mask[k] *= 1.0f - bandUnion(static_cast<double>(k) * binHz, mute, width);
+    }
+
+    maskIsIdentity = std::all_of(mask.begin(), mask.end(), [](const float gain) { return gain == 1.0f; });
+}
+
+void SpectralAudition::seedOverlapAdd() noexcept {
+    constexpr size_t ringMask = kFftSize - 1;
+    constexpr float olaScale = 2.0f / static_cast<float>(kOverlap);
+
+    // The frame m hops ago still owes the outputs from here on its samples from m * hop, which
+    // an all-pass mask returns as input * window^2
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        const auto &input = inputRing[ch];
+        auto &output = outputRing[ch];
+
+        for (size_t m = 1; m < static_cast<size_t>(kOverlap); ++m) {
+            const size_t start = m * kHopSize;
+            for (size_t i = start; i < kFftSize; ++i) {
+                const size_t j = (ringPosition + i - start) & ringMask;
+                output[j] += input[j] * window[i] * window[i] * olaScale;
+            }
+        }
+    }
+}
+
+void SpectralAudition::processFrame() noexcept {
+    constexpr size_t ringMask = kFftSize - 1;
+    constexpr float olaScale = 2.0f / static_cast<float>(kOverlap);
+    float *data = frame.data();
+
+    for (size_t ch = 0; ch < numChannels; ++ch) {
+        const auto &input = inputRing[ch];
+        auto &output = outputRing[ch];
+
+        // Analysis: the ring holds the last kFftSize inputs, oldest at ringPosition
+        for (size_t i = 0; i < kFftSize; ++i) {
+            const float s = input[(ringPosition + i) & ringMask];
+            data[i] = (std::isfinite(s) ? s : 0.0f) * window[i];
+        }
+        std::fill(data + kFftSize, data + 2 * kFftSize, 0.0f);
+
+        fft->performRealOnlyForwardTransform(data, true);
+
+        for (size_t k = 0; k < kNumBins; ++k) {
+            data[2 * k] *= mask[k];
+            data[2 * k + 1] *= mask[k];
+        }
+
+        fft->performRealOnlyInverseTransform(data);
+
+        for (size_t i = 0; i < kFftSize; ++i)
+            output[(ringPosition + i) & ringMask] += data[i] * window[i] * olaScale;
+    }
+}
+
+template<typename SampleType>
+void SpectralAudition::process(const juce::dsp::AudioBlock<SampleType> &block) noexcept {
+    if (fft == nullptr)
+        return;
+
+    constexpr size_t ringMask = kFftSize - 1;
+    const size_t channels = juce::jmin(block.getNumChannels(), numChannels);
+    const size_t numSamples = block.getNumSamples();
+
+    size_t done = 0;
+    while (done < numSamples) {
+        const size_t len = juce::jmin(numSamples - done, samplesUntilFrame);
+
+        for (size_t ch = 0; ch < channels; ++ch) {
+            SampleType *io = block.getChannelPointer(ch) + done;
+            auto &input = inputRing[ch];
+            auto &output = outputRing[ch];
+            size_t pos = ringPosition;
+
+            for (size_t i = 0; i < len; ++i) {
+                const float delayed = input[pos];
+                input[pos] = static_cast<float>(io[i]);
+
+                if (running) {
+                    io[i] = static_cast<SampleType>(output[pos]);
+                    output[pos] = 0.0f;
+                } else {
+                    io[i] = static_cast<SampleType>(delayed);
+                }
+
+                pos = (pos + 1) & ringMask;
+            }
+        }
+
+        ringPosition = (ringPosition + len) & ringMask;
+        done += len;
+        samplesUntilFrame -= len;
+
+        if (samplesUntilFrame > 0)
+            continue;
+
+        samplesUntilFrame = kHopSize;
+
+        if (generation.load(std::memory_order_acquire) != appliedGeneration)
+            updateMask();
+
+        if (!maskIsIdentity) {
+            if (!running)
+                seedOverlapAdd();
+            running = true;
+            identityFrames = 0;
+            processFrame();
+        } else if (running) {
+            // Let the last masked frames overlap-add out, then idle on the delayed input
+            processFrame();
+            if (++identityFrames >= kOverlap) {
+                running = false;
+                for (auto &ring: outputRing)
+                    std::fill(ring.begin(), ring.end(), 0.0f);
+            }
+        }
+    }
+}
+
+template void SpectralAudition::process<float>(const juce::dsp::AudioBlock<float> &) noexcept;
+template void SpectralAudition::process<double>(const juce::dsp::AudioBlock<double> &) noexcept;
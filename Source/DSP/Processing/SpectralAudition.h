@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+
+/** Which engine runs the analyzer's audition, band selection and band solo/mute. */
+enum class AuditionEngine { Filter, Spectral };
+
+inline AuditionEngine auditionEngineFromInt(const int index) {
+    return index == 1 ? AuditionEngine::Spectral : AuditionEngine::Filter;
+}
+
+inline int auditionEngineToInt(const AuditionEngine engine) {
+    return engine == AuditionEngine::Spectral ? 1 : 0;
+}
+
+/**
+ * SpectralAudition
+ *
+ * The FilterBank's monitoring controls as one STFT band mask: the audition bell region, the
+ * band selection region and the band solo/mute set each become a per-bin gain, multiplied
+ * together in the same series order the filters run. Regions are brickwall, or raised-cosine
+ * edged over setEdgeOctaves(), and leak only through the window's sidelobes rather than an IIR
+ * bandpass's skirts.
+ *
+ * Every channel is transformed once per hop and multiplied by the one mask, so any number of
+ * regions costs the same; the mask is rebuilt only when a control changes. Frames are
+ * sqrt-Hann analysis and synthesis windows at 75% overlap (as SpectralSeparator), so an all-pass
+ * mask reconstructs the input exactly. Latency is the FFT size.
+ *
+ * While every control is off the engine idles: the output is the delayed input and no FFTs run.
+ * Waking up seeds the overlap-add ring with the pass-through share of the frames it skipped, so
+ * the switch is seamless either way.
+ *
+ * Thread-safe: the setters from the message thread; everything else on the audio thread.
+ * Realtime-safe (allocation only in prepare()).
+ */
+class SpectralAudition {
+public:
+    static constexpr int kFftOrder = 12; // 4096 samples: ~12 Hz bins at 48 kHz
+    static constexpr int kOverlap = 4;
+    static constexpr float kDefaultEdgeOctaves = 1.0f / 12.0f;
+    static constexpr float kMaxEdgeOctaves = 1.0f;
+
+    SpectralAudition();
+
+    /** Allocate for spec.numChannels channels. */
+    void prepare(const juce::dsp::ProcessSpec &spec);
+
+    /** Clear the STFT state; output is silent for the latency, then follows the input. */
+    void reset() noexcept;
+
+    static constexpr int getLatencySamples() noexcept { return 1 << kFftOrder; }
+
+    //==============================================================================
+    // Message thread (same meaning as FilterBank's)
+    void setAuditFilter(bool active, float frequencyHz, float q) noexcept;
+    void setBandFilter(bool active, float frequencyHz, float q) noexcept;
+    void setBandSolo(juce::uint32 bandMask) noexcept;
+    void setBandMute(juce::uint32 bandMask) noexcept;
+
+    /** Width of the raised-cosine region edges in octaves; 0 is a brickwall. */
+    void setEdgeOctaves(float octaves) noexcept;
+    float getEdgeOctaves() const noexcept { return edgeOctaves.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Audio thread. Mask every channel of the block in place, delayed by getLatencySamples(). */
+    template<typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType> &block) noexcept;
+
+    /** True while any control is on (tests). */
+    bool isMasking() const noexcept { return !maskIsIdentity; }
+
+    /** Current mask gain at a bin (tests). */
+    float getMaskGain(size_t bin) const noexcept { return bin < mask.size() ? mask[bin] : 0.0f; }
+
+private:
+    // One bandpass region from the FilterBank-style centre frequency and Q
+    struct Region {
+        std::atomic<bool> active{false};
+        std::atomic<float> frequency{1000.0f};
+        std::atomic<float> q{1.0f};
+    };
+
+    void bumpGeneration() noexcept { generation.fetch_add(1, std::memory_order_release); }
+
+    /** Rebuild the mask from the controls (audio thread, at a frame boundary). */
+    void updateMask() noexcept;
+
+    void processFrame() noexcept;
+
+    /** Leaving idle: add the skipped frames' pass-through share to the overlap-add ring. */
+    void seedOverlapAdd() noexcept;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    double sampleRate = 44100.0;
+    size_t numChannels = 0;
+
+    static constexpr size_t kFftSize = size_t{1} << kFftOrder;
+    static constexpr size_t kHopSize = kFftSize / kOverlap;
+    static constexpr size_t kNumBins = kFftSize / 2 + 1;
+
+    // Per channel: input ring (also the delayed dry signal) and overlap-add ring, kFftSize each
+    std::vector<std::vector<float>> inputRing, outputRing;
+    size_t ringPosition = 0;
+    size_t samplesUntilFrame = kHopSize;
+
+    std::vector<float> window; // sqrt-Hann, analysis and synthesis
+    std::vector<float> frame; // 2 * kFftSize, FFT scratch
+
+    // Controls: message thread writes, generation tells the audio thread to rebuild the mask
+    Region audit, band;
+    std::atomic<juce::uint32> soloMask{0}, muteMask{0};
+    std::atomic<float> edgeOctaves{kDefaultEdgeOctaves};
+    std::atomic<juce::uint32> generation{1};
+    juce::uint32 appliedGeneration = 0;
+
+    // Audio thread
+    std::vector<float> mask; // kNumBins gains
+    bool maskIsIdentity = true;
+    bool running = false; // frames are being transformed
+    int identityFrames = 0; // consecutive all-pass frames while running
+};
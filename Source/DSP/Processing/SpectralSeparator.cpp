@@ -0,0 +1,314 @@
+#include "SpectralSeparator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /**
+     * Swap one value of a sorted run for another and keep it sorted: the slot of `outgoing`
+     * is moved towards where `incoming` belongs, shifting the values in between. O(length).
+     */
+    void replaceSorted(float *sorted, const int length, const float outgoing, const float incoming) noexcept {
+        int i = static_cast<int>(std::lower_bound(sorted, sorted + length, outgoing) - sorted);
+        jassert(i < length && sorted[i] == outgoing);
+        i = juce::jmin(i, length - 1);
+
+        if (incoming > outgoing) {
+            for (; i + 1 < length && sorted[i + 1] < incoming; ++i)
+                sorted[i] = sorted[i + 1];
+        } else {
+            for (; i > 0 && sorted[i - 1] > incoming; --i)
+                sorted[i] = sorted[i - 1];
+        }
+
+        sorted[i] = incoming;
+    }
+}
+
+void SpectralSeparator::prepare(const juce::dsp::ProcessSpec &spec) {
+    sampleRate = spec.sampleRate > 0.0 ? spec.sampleRate : 44100.0;
+
+    for (int order = kMinFftOrder; order <= kMaxFftOrder; ++order) {
+        auto &engine = ffts[static_cast<size_t>(order - kMinFftOrder)];
+        if (engine == nullptr)
+            engine = std::make_unique<juce::dsp::FFT>(order);
+    }
+
+    constexpr size_t maxSize = size_t{1} << kMaxFftOrder;
+    constexpr size_t maxBins = maxSize / 2 + 1;
+
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        inputRing[static_cast<size_t>(ch)].assign(maxSize, 0.0f);
+        percussiveRing[static_cast<size_t>(ch)].assign(maxSize, 0.0f);
+        frame[static_cast<size_t>(ch)].assign(2 * maxSize, 0.0f);
+    }
+
+    window.assign(maxSize, 0.0f);
+    magnitude.assign(maxBins, 0.0f);
+    harmonic.assign(maxBins, 0.0f);
+    percussive.assign(maxBins, 0.0f);
+    timeHistory.assign(maxBins * kMaxTimeMedianFrames, 0.0f);
+    timeSorted.assign(maxBins * kMaxTimeMedianFrames, 0.0f);
+
+    configure(requestedOrder.load(std::memory_order_relaxed));
+}
+
+void SpectralSeparator::setFftOrder(const int order) noexcept {
+    requestedOrder.store(juce::jlimit(kMinFftOrder, kMaxFftOrder, order), std::memory_order_relaxed);
+}
+
+void SpectralSeparator::setTransientLength(const float ms) noexcept {
+    transientLengthMs = juce::jmax(0.01f, ms);
+    updateFrequencyMedianBins();
+}
+
+void SpectralSeparator::configure(const int order) noexcept {
+    activeOrder = order;
+    fft = ffts[static_cast<size_t>(order - kMinFftOrder)].get();
+    fftSize = size_t{1} << order;
+    hopSize = fftSize / kOverlap;
+    numBins = fftSize / 2 + 1;
+
+    // sqrt of a periodic Hann window: analysis x synthesis sums to kOverlap / 2 at this hop
+    for (size_t i = 0; i < fftSize; ++i)
+        window[i] = static_cast<float>(std::sin(juce::MathConstants<double>::pi * static_cast<double>(i)
+                                                / static_cast<double>(fftSize)));
+
+    // Odd frame count so the median is a single element
+    const auto frames = juce::roundToInt(kTimeMedianSeconds * sampleRate / static_cast<double>(hopSize));
+    timeMedianFrames = juce::jlimit(kMinTimeMedianFrames, kMaxTimeMedianFrames, frames | 1);
+    warmUpSamples = fftSize + static_cast<size_t>(timeMedianFrames) * hopSize;
+
+    updateFrequencyMedianBins();
+    reset();
+}
+
+void SpectralSeparator::updateFrequencyMedianBins() noexcept {
+    if (fftSize == 0)
+        return;
+
+    const double binHz = sampleRate / static_cast<double>(fftSize);
+    const double spanHz = 1000.0 / static_cast<double>(transientLengthMs);
+    frequencyMedianBins = juce::jlimit(kMinFrequencyMedianBins, kMaxFrequencyMedianBins,
+                                       juce::roundToInt(spanHz / binHz) | 1);
+}
+
+void SpectralSeparator::reset() noexcept {
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        std::fill(inputRing[static_cast<size_t>(ch)].begin(), inputRing[static_cast<size_t>(ch)].end(), 0.0f);
+        std::fill(percussiveRing[static_cast<size_t>(ch)].begin(), percussiveRing[static_cast<size_t>(ch)].end(), 0.0f);
+    }
+
+    std::fill(timeHistory.begin(), timeHistory.end(), 0.0f);
+    std::fill(timeSorted.begin(), timeSorted.end(), 0.0f);
+    timeHistoryHead = 0;
+
+    ringPosition = 0;
+    samplesUntilFrame = hopSize;
+    samplesSinceReset = 0;
+}
+
+template<typename SampleType>
+void SpectralSeparator::process(SampleType *left, SampleType *right, const size_t numSamples,
+                                juce::SmoothedValue<float> &percussiveGain,
+                                juce::SmoothedValue<float> &harmonicGain) noexcept {
+    if (fft == nullptr)
+        return;
+
+    const int order = requestedOrder.load(std::memory_order_relaxed);
+    if (order != activeOrder)
+        configure(order);
+
+    SampleType *const channels[] = {left, right};
+    const size_t ringMask = fftSize - 1;
+
+    // The first fftSize outputs after a reset are silent; fade the signal in over one hop after them
+    const size_t fadeEnd = fftSize + hopSize;
+    const float fadeStep = 1.0f / static_cast<float>(hopSize);
+
+    size_t done = 0;
+    while (done < numSamples) {
+        const size_t len = juce::jmin(numSamples - done, samplesUntilFrame);
+
+        for (size_t i = done; i < done + len; ++i) {
+            const size_t pos = ringPosition;
+            const float pGain = percussiveGain.getNextValue();
+            const float hGain = harmonicGain.getNextValue();
+
+            float fade = 1.0f;
+            if (samplesSinceReset < warmUpSamples) {
+                if (samplesSinceReset < fadeEnd)
+                    fade = samplesSinceReset < fftSize
+                               ? 0.0f
+                               : static_cast<float>(samplesSinceReset - fftSize + 1) * fadeStep;
+                ++samplesSinceReset;
+            }
+
+            for (int ch = 0; ch < kNumChannels; ++ch) {
+                auto &input = inputRing[static_cast<size_t>(ch)];
+                auto &percussiveOut = percussiveRing[static_cast<size_t>(ch)];
+
+                const float delayed = input[pos];
+                const float p = percussiveOut[pos];
+                input[pos] = static_cast<float>(channels[ch][i]);
+                percussiveOut[pos] = 0.0f;
+
+                channels[ch][i] = static_cast<SampleType>((p * pGain + (delayed - p) * hGain) * fade);
+            }
+
+            ringPosition = (pos + 1) & ringMask;
+        }
+
+        done += len;
+        samplesUntilFrame -= len;
+
+        if (samplesUntilFrame == 0) {
+            processFrame();
+            samplesUntilFrame = hopSize;
+        }
+    }
+}
+
+template void SpectralSeparator::process<float>(float *, float *, size_t, juce::SmoothedValue<float> &,
+                                                juce::SmoothedValue<float> &) noexcept;
+template void SpectralSeparator::process<double>(double *, double *, size_t, juce::SmoothedValue<float> &,
+                                                 juce::SmoothedValue<float> &) noexcept;
+
+template<typename SampleType>
+void SpectralSeparator::prime(const SampleType *left, const SampleType *right, const size_t numSamples) noexcept {
+    if (fft == nullptr)
+        return;
+
+    const int order = requestedOrder.load(std::memory_order_relaxed);
+    if (order != activeOrder)
+        configure(order);
+
+    const SampleType *const channels[] = {left, right};
+    const size_t ringMask = fftSize - 1;
+
+    size_t done = 0;
+    while (done < numSamples) {
+        const size_t len = juce::jmin(numSamples - done, samplesUntilFrame);
+
+        // The overlap-add slots that would have been output are dropped, as process() does
+        for (int ch = 0; ch < kNumChannels; ++ch) {
+            auto &input = inputRing[static_cast<size_t>(ch)];
+            auto &percussiveOut = percussiveRing[static_cast<size_t>(ch)];
+
+            for (size_t i = 0; i < len; ++i) {
+                const size_t pos = (ringPosition + i) & ringMask;
+                input[pos] = static_cast<float>(channels[ch][done + i]);
+                percussiveOut[pos] = 0.0f;
+            }
+        }
+
+        ringPosition = (ringPosition + len) & ringMask;
+        samplesSinceReset = juce::jmin(warmUpSamples, samplesSinceReset + len);
+        done += len;
+        samplesUntilFrame -= len;
+
+        if (samplesUntilFrame == 0) {
+            processFrame();
+            samplesUntilFrame = hopSize;
+        }
+    }
+}
+
+template void SpectralSeparator::prime<float>(const float *, const float *, size_t) noexcept;
+template void SpectralSeparator::prime<double>(const double *, const double *, size_t) noexcept;
+
+void SpectralSeparator::processFrame() noexcept {
+    const size_t ringMask = fftSize - 1;
+
+    // Analysis: the ring holds the last fftSize inputs, oldest at ringPosition
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        const auto &input = inputRing[static_cast<size_t>(ch)];
+        float *data = frame[static_cast<size_t>(ch)].data();
+
+        for (size_t i = 0; i < fftSize; ++i) {
+            const float s = input[(ringPosition + i) & ringMask];
+            data[i] = (std::isfinite(s) ? s : 0.0f) * window[i];
+        }
+        std::fill(data + fftSize, data + 2 * fftSize, 0.0f);
+
+        fft->performRealOnlyForwardTransform(data, true);
+    }
+
+    const float *l = frame[0].data();
+    const float *r = frame[1].data();
+    for (size_t k = 0; k < numBins; ++k) {
+        const float m = std::sqrt(l[2 * k] * l[2 * k] + l[2 * k + 1] * l[2 * k + 1]
+                                  + r[2 * k] * r[2 * k] + r[2 * k + 1] * r[2 * k + 1]);
+        magnitude[k] = std::isfinite(m) ? m : 0.0f;
+    }
+
+    updateHarmonicEstimate();
+    updatePercussiveEstimate();
+
+    // Soft mask P^2 / (H^2 + P^2), written as a ratio so large magnitudes cannot overflow
+    for (size_t k = 0; k < numBins; ++k) {
+        float mask = 0.0f;
+        if (percussive[k] > 0.0f) {
+            const float ratio = harmonic[k] / percussive[k];
+            mask = 1.0f / (1.0f + ratio * ratio);
+        }
+
+        for (auto &data: frame) {
+            data[2 * k] *= mask;
+            data[2 * k + 1] *= mask;
+        }
+    }
+
+    // Synthesis: window again and overlap-add into the samples that follow the ring position
+    const float olaScale = 2.0f / static_cast<float>(kOverlap);
+
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        float *data = frame[static_cast<size_t>(ch)].data();
+        auto &percussiveOut = percussiveRing[static_cast<size_t>(ch)];
+
+        fft->performRealOnlyInverseTransform(data);
+
+        for (size_t i = 0; i < fftSize; ++i)
+            percussiveOut[(ringPosition + i) & ringMask] += data[i] * window[i] * olaScale;
+    }
+}
+
+void SpectralSeparator::updateHarmonicEstimate() noexcept {
+    const int length = timeMedianFrames;
+
+    for (size_t k = 0; k < numBins; ++k) {
+        float *history = timeHistory.data() + k * kMaxTimeMedianFrames;
+        float *sorted = timeSorted.data() + k * kMaxTimeMedianFrames;
+
+        const float outgoing = history[timeHistoryHead];
+        history[timeHistoryHead] = magnitude[k];
+        replaceSorted(sorted, length, outgoing, magnitude[k]);
+
+        harmonic[k] = sorted[length / 2];
+    }
+
+    timeHistoryHead = (timeHistoryHead + 1) % static_cast<size_t>(length);
+}
+
+void SpectralSeparator::updatePercussiveEstimate() noexcept {
+    const int length = frequencyMedianBins;
+    const int half = length / 2;
+    const int bins = static_cast<int>(numBins);
+
+    // Bins outside the spectrum count as silence
+    const auto valueAt = [&](const int bin) {
+        return bin >= 0 && bin < bins ? magnitude[static_cast<size_t>(bin)] : 0.0f;
+    };
+
+    float *sorted = frequencyWindow.data();
+    for (int i = 0; i < length; ++i)
+        sorted[i] = valueAt(i - half);
+    std::sort(sorted, sorted + length);
+
+    for (int k = 0; k < bins; ++k) {
+        percussive[static_cast<size_t>(k)] = sorted[half];
+
+        if (k + 1 < bins)
+            replaceSorted(sorted, length, valueAt(k - half), valueAt(k + 1 + half));
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * SpectralSeparator
+ *
+ * STFT harmonic/percussive separation (median filtering, Fitzgerald 2010) for the
+ * Tonal/Transient output mode.
+ *
+ * Per frame, the stereo magnitude spectrum is median-filtered two ways:
+ *   - across time, per bin, over the last ~kTimeMedianSeconds of frames -> harmonic estimate
+ *   - across frequency, within the frame                                -> percussive estimate
+ * A soft mask P^2 / (H^2 + P^2) extracts the percussive part, which is overlap-added back to
+ * the time domain (sqrt-Hann analysis and synthesis windows, 75% overlap). The harmonic part
+ * is the delayed input minus the percussive part, so the two always sum to the input.
+ *
+ * The medians are rolling: each bin keeps its time window sorted and swaps one value per
+ * frame, and the frequency median slides one sorted window along the bins, so every
+ * median costs O(window) instead of a sort.
+ *
+ * Latency is exactly the FFT size. setFftOrder() trades latency for frequency resolution and
+ * CPU; the transient length sets the frequency median span (a transient of length T is
+ * roughly 1 / T wide, so shorter transients are judged over more bins).
+ *
+ * After a reset the output is silent for one FFT size and the time medians need a full window
+ * of frames. prime() feeds input without producing output, so the owner can warm a separator
+ * up in the background (isPrimed()) before switching to it.
+ *
+ * Thread-safe: setFftOrder() from any thread (applied at the start of the next process());
+ * everything else on the audio thread. Realtime-safe (allocation only in prepare()).
+ */
+class SpectralSeparator {
+public:
+    static constexpr int kMinFftOrder = 9;      // 512 samples
+    static constexpr int kMaxFftOrder = 12;     // 4096 samples
+    static constexpr int kDefaultFftOrder = 11; // 2048 samples
+    static constexpr int kOverlap = 4;
+
+    static constexpr double kTimeMedianSeconds = 0.2;
+    static constexpr int kMinTimeMedianFrames = 5;
+    static constexpr int kMaxTimeMedianFrames = 31;
+    static constexpr int kMinFrequencyMedianBins = 3;
+    static constexpr int kMaxFrequencyMedianBins = 63;
+
+    /** Allocates for kMaxFftOrder and builds every FFT engine, so later order changes are free. */
+    void prepare(const juce::dsp::ProcessSpec &spec);
+
+    /** Clears the STFT and median state; output fades back in once new input has filled a frame. */
+    void reset() noexcept;
+
+    /** Any thread. Clamped to [kMinFftOrder, kMaxFftOrder]; restarts the separator when applied. */
+    void setFftOrder(int order) noexcept;
+    int getFftOrder() const noexcept { return requestedOrder.load(std::memory_order_relaxed); }
+
+    /** Latency of the requested FFT order, in samples. */
+    int getLatencySamples() const noexcept { return 1 << getFftOrder(); }
+
+    /** Audio thread. Transient length in ms; sets the frequency median span. */
+    void setTransientLength(float ms) noexcept;
+
+    /**
+     * Separate one stereo block in place: out = percussive * percussiveGain + harmonic * harmonicGain,
+     * delayed by getLatencySamples(). The gain smoothers advance once per sample.
+     * Double blocks are converted sample by sample at the rings; the STFT and its delay line run in float.
+     */
+    template<typename SampleType>
+    void process(SampleType *left, SampleType *right, size_t numSamples,
+                 juce::SmoothedValue<float> &percussiveGain, juce::SmoothedValue<float> &harmonicGain) noexcept;
+
+    /** Feed one stereo block as process() would, without producing output. */
+    template<typename SampleType>
+    void prime(const SampleType *left, const SampleType *right, size_t numSamples) noexcept;
+
+    /** True once the requested order is running and its frames and time medians are full of input. */
+    bool isPrimed() const noexcept {
+        return activeOrder == getFftOrder() && samplesSinceReset >= warmUpSamples;
+    }
+
+    /** Frequency median span in bins for the current order and transient length (tests). */
+    int getFrequencyMedianBins() const noexcept { return frequencyMedianBins; }
+
+private:
+    static constexpr int kNumChannels = 2;
+    static constexpr int kNumOrders = kMaxFftOrder - kMinFftOrder + 1;
+
+    void configure(int order) noexcept;
+    void updateFrequencyMedianBins() noexcept;
+    void processFrame() noexcept;
+    void updateHarmonicEstimate() noexcept;
+    void updatePercussiveEstimate() noexcept;
+
+    std::array<std::unique_ptr<juce::dsp::FFT>, kNumOrders> ffts;
+    juce::dsp::FFT *fft = nullptr;
+
+    double sampleRate = 44100.0;
+    float transientLengthMs = 1.0f;
+    std::atomic<int> requestedOrder{kDefaultFftOrder};
+    int activeOrder = 0;
+
+    // Active frame geometry
+    size_t fftSize = 0;
+    size_t hopSize = 0;
+    size_t numBins = 0;
+    int timeMedianFrames = kMinTimeMedianFrames;
+    int frequencyMedianBins = kMinFrequencyMedianBins;
+
+    // Input ring (also the delayed dry signal) and percussive overlap-add ring, fftSize each
+    std::array<std::vector<float>, kNumChannels> inputRing, percussiveRing;
+    size_t ringPosition = 0;
+    size_t samplesUntilFrame = 0;
+    size_t samplesSinceReset = 0; // counts up to warmUpSamples
+    size_t warmUpSamples = 0;     // fftSize + timeMedianFrames hops
+
+    std::vector<float> window; // sqrt-Hann, used for analysis and synthesis
+    std::array<std::vector<float>, kNumChannels> frame; // 2 * fftSize, FFT scratch
+
+    std::vector<float> magnitude, harmonic, percussive;
+
+    // Per bin: the last timeMedianFrames magnitudes in arrival order and the same values sorted
+    std::vector<float> timeHistory, timeSorted;
+    size_t timeHistoryHead = 0;
+
+    std::array<float, kMaxFrequencyMedianBins> frequencyWindow{};
+};
@@ -0,0 +1,257 @@
+#include "SpectrumAnalysisWorker.h"
+
+#include <algorithm>
+
+SpectrumAnalysisWorker::SpectrumAnalysisWorker(const int maxFifoCapacity)
+    : juce::Thread("Spectrum analysis"),
+      mainRing(maxFifoCapacity, 1),
+      ghostRing(maxFifoCapacity, 1) {
+    // Rolling buffer sizes are set by the first applyChanges()
+    startThread();
+}
+
+SpectrumAnalysisWorker::~SpectrumAnalysisWorker() {
+    signalThreadShouldExit();
+    wake();
+    stopThread(kStopTimeoutMs);
+}
+
+//==============================================================================
+void SpectrumAnalysisWorker::setCaptureBus(const CaptureBus *bus) {
+    const CaptureBus *previous = mainBus;
+    mainBus = bus;
+    requestedMainBus.store(bus, std::memory_order_release);
+
+    // The worker may still be waiting on the bus it is leaving
+    if (previous != nullptr)
+        previous->wakeReader();
+    wake();
+}
+
+void SpectrumAnalysisWorker::setGhostCaptureBus(const CaptureBus *bus) {
+    requestedGhostBus.store(bus, std::memory_order_release);
+    wake();
+}
+
+juce::uint32 SpectrumAnalysisWorker::setSettings(const Settings &newSettings) {
+    {
+        const juce::ScopedLock lock(settingsLock);
+        settings = newSettings;
+    }
+    settingsGeneration.store(++generation, std::memory_order_release);
+    wake();
+    return generation;
+}
+
+juce::uint32 SpectrumAnalysisWorker::clear() {
+    {
+        const juce::ScopedLock lock(settingsLock);
+        ++clearGeneration;
+    }
+    settingsGeneration.store(++generation, std::memory_order_release);
+    wake();
+    return generation;
+}
+
+void SpectrumAnalysisWorker::setFrozen(const bool shouldFreeze) {
+    frozen.store(shouldFreeze, std::memory_order_relaxed);
+    wake();
+}
+
+const SpectrumAnalysisWorker::Frame *SpectrumAnalysisWorker::takeLatestFrame() noexcept {
+    if ((pendingFrame.load(std::memory_order_acquire) & kFreshFrame) == 0)
+        return nullptr;
+
+    frontFrame = pendingFrame.exchange(frontFrame, std::memory_order_acq_rel) & ~kFreshFrame;
+    return &frames[static_cast<size_t>(frontFrame)];
+}
+
+void SpectrumAnalysisWorker::wake() {
+    if (mainBus != nullptr)
+        mainBus->wakeReader();
+    notify();
+}
+
+//==============================================================================
+void SpectrumAnalysisWorker::run() {
+    while (!threadShouldExit()) {
+        applyChanges();
+
+        const bool isFrozen = frozen.load(std::memory_order_relaxed);
+        if (isFrozen) {
+            mainRing.drainSilently();
+            ghostRing.drainSilently();
+            restingAtFloor = false;
+        } else if (analyse()) {
+            restingAtFloor = false;
+            publish(true);
+        } else if (mainRing.isSourceSilent() && !restingAtFloor) {
+            bool aboveFloor = true;
+            if (decayTowardsSilence(aboveFloor)) {
+                restingAtFloor = !aboveFloor;
+                publish(aboveFloor);
+            }
+        }
+
+        // Decaying: step again in a frame's time. Otherwise sleep, with no timeout, until the
+        // audio thread has written the rest of the next main hop (or marks the bus silent)
+        const bool decaying = !isFrozen && mainRing.isSourceSilent() && !restingAtFloor;
+        const int timeoutMs = decaying ? kFrameIntervalMs : -1;
+        if (adoptedMainBus == nullptr)
+            wait(timeoutMs);
+        else
+            mainRing.waitForData((hopSize - mainHopCounter) << applied.decimationStages, timeoutMs);
+    }
+}
+
+void SpectrumAnalysisWorker::applyChanges() {
+    if (const auto *bus = requestedMainBus.load(std::memory_order_acquire); bus != adoptedMainBus) {
+        mainRing.attach(bus);
+        adoptedMainBus = bus;
+        mainHopCounter = 0;
+    }
+    if (const auto *bus = requestedGhostBus.load(std::memory_order_acquire); bus != adoptedGhostBus) {
+        ghostRing.attach(bus);
+        adoptedGhostBus = bus;
+        ghostHopCounter = 0;
+    }
+
+    const auto current = settingsGeneration.load(std::memory_order_acquire);
+    if (configured && current == appliedGeneration)
+        return;
+
+    Settings next;
+    juce::uint32 clears;
+    {
+        const juce::ScopedLock lock(settingsLock);
+        next = settings;
+        clears = clearGeneration;
+    }
+
+    const bool resized = !configured || next.fftOrder != applied.fftOrder;
+    const bool redecimated = !configured || next.decimationStages != applied.decimationStages;
+
+    if (resized) {
+        const int fftSize = 1 << next.fftOrder;
+        fftProcessor.setFftOrder(next.fftOrder, next.minDb);
+        mainRing.resizeRolling(fftSize);
+        ghostRing.resizeRolling(fftSize);
+        mainRing.resetFifo(fftSize * 2);
+        ghostRing.resetFifo(fftSize * 2);
+    }
+
+    // Whatever is pending or rolling was at the old rate
+    if (redecimated) {
+        mainRing.setDecimationStages(next.decimationStages);
+        ghostRing.setDecimationStages(next.decimationStages);
+    }
+
+    if (resized || next.sampleRate != applied.sampleRate)
+        fftProcessor.setSampleRate(next.sampleRate);
+    if (!configured || next.smoothing != applied.smoothing)
+        fftProcessor.setSmoothing(next.smoothing);
+    if (!configured || next.slopeDb != applied.slopeDb)
+        fftProcessor.setSlope(next.slopeDb);
+    fftProcessor.setMinDb(next.minDb);
+    fftProcessor.setTemporalDecay(next.curveDecay);
+    fftProcessor.setChannelMode(next.channelMode);
+
+    if (resized || next.overlapFactor != applied.overlapFactor) {
+        hopSize = juce::jmax(1, fftProcessor.getFftSize() / next.overlapFactor);
+        mainHopCounter = 0;
+        ghostHopCounter = 0;
+    }
+
+    // Every bin maps to a different frequency after a resize or a rate change
+    if (resized || redecimated || clears != appliedClearGeneration)
+        resetCurves(next.minDb);
+
+    applied = next;
+    appliedClearGeneration = clears;
+    appliedGeneration = current;
+    configured = true;
+}
+
+//==============================================================================
+bool SpectrumAnalysisWorker::analyse() {
+    const bool mainReady = runHops(mainRing, mainHopCounter, primaryDb, secondaryDb);
+    const bool ghostReady = runHops(ghostRing, ghostHopCounter, ghostPrimaryDb, ghostSecondaryDb);
+    hasGhost = hasGhost || ghostReady;
+    return mainReady || ghostReady;
+}
+
+bool SpectrumAnalysisWorker::runHops(AudioRingBuffer &ring, int &hopCounter,
+                                     std::vector<float> &outPrimaryDb, std::vector<float> &outSecondaryDb) {
+    const int numNew = ring.drain();
+    if (numNew <= 0)
+        return false;
+
+    const int fftSize = fftProcessor.getFftSize();
+    const float *rollingL = ring.getL();
+    const float *rollingR = ring.getR();
+
+    // Advance a virtual write position through the drained samples to run each hop's FFT at
+    // its own offset. The rolling buffer is mirrored, so the window starting there is
+    // contiguous. Double-modulo keeps the start positive when numNew > fftSize.
+    bool fftReady = false;
+    int virtualWritePos = ((ring.getWritePos() - numNew) % fftSize + fftSize) % fftSize;
+
+    for (int i = 0; i < numNew; ++i) {
+        virtualWritePos = (virtualWritePos + 1) % fftSize;
+        ++hopCounter;
+
+        if (hopCounter >= hopSize) {
+            fftProcessor.processBlock(rollingL + virtualWritePos, rollingR + virtualWritePos,
+                                      outPrimaryDb, outSecondaryDb);
+            fftReady = true;
+            hopCounter = 0;
+        }
+    }
+
+    return fftReady;
+}
+
+bool SpectrumAnalysisWorker::decayTowardsSilence(bool &aboveFloor) {
+    // The hops the FFT would have run on the silent input, as smoothing steps only
+    const int numElapsed = juce::roundToInt(applied.sampleRate * kFrameIntervalMs / 1000.0);
+    bool stepped = false;
+    aboveFloor = false;
+
+    for (mainHopCounter += numElapsed; mainHopCounter >= hopSize; mainHopCounter -= hopSize) {
+        aboveFloor = fftProcessor.processSilentBlock(primaryDb, secondaryDb);
+        aboveFloor = fftProcessor.processSilentBlock(ghostPrimaryDb, ghostSecondaryDb) || aboveFloor;
+        stepped = true;
+    }
+    ghostHopCounter = 0;
+
+    if (stepped && !aboveFloor) {
+        for (auto *curve: {&primaryDb, &secondaryDb, &ghostPrimaryDb, &ghostSecondaryDb})
+            std::fill(curve->begin(), curve->end(), applied.minDb);
+    }
+
+    return stepped;
+}
+
+void SpectrumAnalysisWorker::resetCurves(const float minDb) {
+    const auto numBins = static_cast<size_t>(fftProcessor.getNumBins());
+    for (auto *curve: {&primaryDb, &secondaryDb, &ghostPrimaryDb, &ghostSecondaryDb})
+        curve->assign(numBins, minDb);
+
+    mainHopCounter = 0;
+    ghostHopCounter = 0;
+    hasGhost = false;
+    restingAtFloor = false;
+}
+
+void SpectrumAnalysisWorker::publish(const bool aboveFloor) {
+    auto &frame = frames[static_cast<size_t>(backFrame)];
+    frame.primaryDb = primaryDb; // same size as last time: no allocation
+    frame.secondaryDb = secondaryDb;
+    frame.ghostPrimaryDb = ghostPrimaryDb;
+    frame.ghostSecondaryDb = ghostSecondaryDb;
+    frame.generation = appliedGeneration;
+    frame.hasGhost = hasGhost;
+    frame.aboveFloor = aboveFloor;
+
+    backFrame = pendingFrame.exchange(backFrame | kFreshFrame, std::memory_order_acq_rel) & ~kFreshFrame;
+}
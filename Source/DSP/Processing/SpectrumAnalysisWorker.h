@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <juce_core/juce_core.h>
+
+#include "AudioRingBuffer.h"
+#include "FFTProcessor.h"
+
+/**
+ * SpectrumAnalysisWorker
+ *
+ * The spectrum analyzer's analysis, on a thread of its own. The worker drains the main and
+ * ghost capture buses into their rolling buffers (decimated as configured), runs the hop-by-hop
+ * FFTs with temporal and octave smoothing in one FFTProcessor, and publishes the smoothed curves
+ * as an immutable Frame through a triple buffer. The message thread takes the newest frame once
+ * per display tick (takeLatestFrame()) and only renders it.
+ *
+ * The worker sleeps on the main bus, with no timeout, until the rest of the next hop has been
+ * written: it arms the bus with that position and the audio thread's write() that reaches it
+ * posts the wakeup (see CaptureBus::Reader::waitForData()), one wakeup per hop. The ghost bus
+ * is written in the same blocks, so it is drained on the same wakeups. Once the bus is marked
+ * silent the curves step down to the floor every kFrameIntervalMs, the smoothing the FFT would
+ * have applied to silence; then the worker sleeps until audio returns. Settings changes,
+ * freeze, bus changes and shutdown wake it at once.
+ *
+ * Every frame carries the generation of the settings it was analysed with; setSettings() and
+ * clear() return the generation to wait for, so the display can ignore frames still in flight
+ * from before a change (a different bin count, say).
+ *
+ * Threading: the public interface on the message thread. The rolling buffers, the FFTProcessor
+ * and the curves belong to the worker; published frames are the only shared data.
+ */
+class SpectrumAnalysisWorker : private juce::Thread {
+public:
+    struct Settings {
+        int fftOrder = Defaults::fftOrder;
+        int overlapFactor = Defaults::overlapFactor;
+        int decimationStages = 0;
+        double sampleRate = 44100.0; // the analysis rate (after decimation)
+        float minDb = Defaults::minDb;
+        float curveDecay = Defaults::curveDecay;
+        float slopeDb = 0.0f;
+        SmoothingMode smoothing = Defaults::smoothing;
+        ChannelMode channelMode = ChannelMode::MidSide;
+    };
+
+    /** The curves after one or more hops; never written again while the message thread holds it. */
+    struct Frame {
+        std::vector<float> primaryDb, secondaryDb;
+        std::vector<float> ghostPrimaryDb, ghostSecondaryDb;
+        juce::uint32 generation = 0;
+        bool hasGhost = false;   // a ghost hop has run since the curves were last reset
+        bool aboveFloor = true;  // false once silence has brought every curve to the floor
+    };
+
+    static constexpr int kFrameIntervalMs = 16;
+    static constexpr int kStopTimeoutMs = 2000;
+
+    /** Allocates both rolling buffers' buses (maxFifoCapacity frames) and starts the worker. */
+    explicit SpectrumAnalysisWorker(int maxFifoCapacity);
+    ~SpectrumAnalysisWorker() override;
+
+    /** Analyse bus (nullptr: detach), from its current end. */
+    void setCaptureBus(const CaptureBus *bus);
+    void setGhostCaptureBus(const CaptureBus *bus);
+
+    /** Analyse with newSettings from now on; returns the generation of the frames that use them.
+     *  The curves restart from the floor when the FFT order or the decimation changes. */
+    juce::uint32 setSettings(const Settings &newSettings);
+
+    /** Restart every curve from the floor; returns the generation, as setSettings(). */
+    juce::uint32 clear();
+
+    /** While frozen the input is skipped and nothing is published. */
+    void setFrozen(bool shouldFreeze);
+
+    /** The newest frame published since the last call, or nullptr. Valid until the next call. */
+    const Frame *takeLatestFrame() noexcept;
+
+private:
+    void run() override;
+
+    /** Worker: follow bus and settings changes. */
+    void applyChanges();
+
+    /** Worker: drain both buses and run the hops they complete. True if any FFT ran. */
+    bool analyse();
+
+    /** Worker: kFrameIntervalMs of silence as smoothing steps. False if no hop completed;
+     *  aboveFloor tells whether any curve is still above the floor. */
+    bool decayTowardsSilence(bool &aboveFloor);
+
+    /** Worker: copy the curves into the back frame and hand it over. */
+    void publish(bool aboveFloor);
+
+    /** Worker: drain into ring and run its hops on primary/secondary. True if any FFT ran. */
+    bool runHops(AudioRingBuffer &ring, int &hopCounter,
+                 std::vector<float> &primaryDb, std::vector<float> &secondaryDb);
+
+    void resetCurves(float minDb);
+
+    /** Message thread: interrupt the worker's wait. */
+    void wake();
+
+    // Message thread side
+    const CaptureBus *mainBus = nullptr;
+    juce::uint32 generation = 0;
+
+    // Handed to the worker: buses, settings and clears (under settingsLock), and the generation
+    // that tells the worker to pick them up
+    std::atomic<const CaptureBus *> requestedMainBus{nullptr};
+    std::atomic<const CaptureBus *> requestedGhostBus{nullptr};
+    juce::CriticalSection settingsLock;
+    Settings settings;
+    juce::uint32 clearGeneration = 0;
+    std::atomic<juce::uint32> settingsGeneration{0};
+    std::atomic<bool> frozen{false};
+
+    // Worker state
+    AudioRingBuffer mainRing, ghostRing;
+    const CaptureBus *adoptedMainBus = nullptr;
+    const CaptureBus *adoptedGhostBus = nullptr;
+    FFTProcessor fftProcessor;
+    Settings applied;
+    bool configured = false;
+    juce::uint32 appliedGeneration = 0;
+    juce::uint32 appliedClearGeneration = 0;
+    int hopSize = 1;
+    int mainHopCounter = 0;
+    int ghostHopCounter = 0;
+    std::vector<float> primaryDb, secondaryDb, ghostPrimaryDb, ghostSecondaryDb;
+    bool hasGhost = false;
+    bool restingAtFloor = false;
+
+    // Triple buffer: the worker fills frames[backFrame] and swaps it into pendingFrame with
+    // kFreshFrame set; the message thread swaps frames[frontFrame] out when it sees the flag.
+    static constexpr int kFreshFrame = 4;
+    std::array<Frame, 3> frames;
+    int backFrame = 0;
+    std::atomic<int> pendingFrame{1};
+    int frontFrame = 2;
+
+    JUCE_DECLARE_NON_COPYABLE(SpectrumAnalysisWorker)
+};
@@ -0,0 +1,180 @@
+#include "StereoBiquadCascade.h"
+
+#include <type_traits>
+#include "SimdLanes.h"
+
+namespace {
+    // State lanes: 0 = L stage 1, 1 = R stage 1, 2 = L stage 2, 3 = R stage 2.
+    // Operation order matches BiquadState::process() so every path rounds the same way.
+
+    template<typename SampleType>
+    inline SampleType tick(const SampleType x, const BiquadCoefficients &c, SampleType &s1, SampleType &s2) noexcept {
+        const SampleType y = static_cast<SampleType>(c.b0) * x + s1;
+        s1 = static_cast<SampleType>(c.b1) * x - static_cast<SampleType>(c.a1) * y + s2;
+        s2 = static_cast<SampleType>(c.b2) * x - static_cast<SampleType>(c.a2) * y;
+        return y;
+    }
+
+#if GFRACTOR_SIMD
+    using namespace SimdLanes;
+#endif
+
+#if GFRACTOR_SIMD_SSE
+    /** [left, right, y0, y1]: new frame into the stage-1 lanes, stage-1 output into the stage-2 lanes. */
+    inline Vec makeInput(const float left, const float right, const Vec y) noexcept {
+        return _mm_movelh_ps(_mm_unpacklo_ps(_mm_set_ss(left), _mm_set_ss(right)), y);
+    }
+
+    /** [next0, next0, current0, current0]: stage-2 lanes keep the previous frame's coefficient. */
+    inline Vec skewLanes(const Vec next, const Vec current) noexcept {
+        return _mm_shuffle_ps(next, current, _MM_SHUFFLE(0, 0, 0, 0));
+    }
+#elif GFRACTOR_SIMD_NEON
+    inline Vec makeInput(const float left, const float right, const Vec y) noexcept {
+        return vcombine_f32(vset_lane_f32(right, vdup_n_f32(left), 1), vget_low_f32(y));
+    }
+
+    inline Vec skewLanes(const Vec next, const Vec current) noexcept {
+        return vcombine_f32(vdup_laneq_f32(next, 0), vdup_laneq_f32(current, 0));
+    }
+#endif
+
+#if GFRACTOR_SIMD
+    struct CoefficientLanes {
+        Vec b0, b1, b2, a1, a2;
+
+        explicit CoefficientLanes(const BiquadCoefficients &c) noexcept
+            : b0(splat(c.b0)), b1(splat(c.b1)), b2(splat(c.b2)), a1(splat(c.a1)), a2(splat(c.a2)) {
+        }
+
+        /** Stage-1 lanes step to the next frame's coefficients; stage-2 lanes take the old stage-1 value. */
+        void advance(const CoefficientLanes &step) noexcept {
+            b0 = skewLanes(add(b0, step.b0), b0);
+            b1 = skewLanes(add(b1, step.b1), b1);
+            b2 = skewLanes(add(b2, step.b2), b2);
+            a1 = skewLanes(add(a1, step.a1), a1);
+            a2 = skewLanes(add(a2, step.a2), a2);
+        }
+
+        BiquadCoefficients stageOne() const noexcept {
+            return {lane0(b0), lane0(b1), lane0(b2), lane0(a1), lane0(a2)};
+        }
+    };
+
+    inline Vec tick(const Vec x, const CoefficientLanes &c, Vec &s1, Vec &s2) noexcept {
+        const Vec y = add(mul(c.b0, x), s1);
+        s1 = add(sub(mul(c.b1, x), mul(c.a1, y)), s2);
+        s2 = sub(mul(c.b2, x), mul(c.a2, y));
+        return y;
+    }
+#endif
+}
+
+template<typename SampleType>
+void StereoBiquadCascade<SampleType>::process(SampleType *left, SampleType *right, const size_t numSamples,
+                                              BiquadCoefficients &coefficients,
+                                              const BiquadCoefficients *rampStep) noexcept {
+    if (numSamples == 0 || left == nullptr)
+        return;
+
+    if (right != nullptr) {
+        if (rampStep != nullptr)
+            processStereo<true>(left, right, numSamples, coefficients, *rampStep);
+        else
+            processStereo<false>(left, right, numSamples, coefficients, coefficients);
+    } else {
+        if (rampStep != nullptr)
+            processMono<true>(left, numSamples, coefficients, *rampStep);
+        else
+            processMono<false>(left, numSamples, coefficients, coefficients);
+    }
+}
+
+template<typename SampleType>
+template<bool Ramp>
+void StereoBiquadCascade<SampleType>::processStereo(SampleType *left, SampleType *right, const size_t numSamples,
+                                                    BiquadCoefficients &c,
+                                                    const BiquadCoefficients &rampStep) noexcept {
+#if GFRACTOR_SIMD
+    if constexpr (std::is_same_v<SampleType, float>) {
+        // Prologue: stage 1 alone on frame 0.
+        if constexpr (Ramp)
+            c += rampStep;
+
+        float y1L = tick(left[0], c, s1[0], s2[0]);
+        float y1R = tick(right[0], c, s1[1], s2[1]);
+
+        if (numSamples > 1) {
+            Vec state1 = load(s1);
+            Vec state2 = load(s2);
+            CoefficientLanes lanes(c);
+            const CoefficientLanes step(rampStep);
+            Vec y = makeInput(y1L, y1R, splat(0.0f));
+
+            // Steady state: stage 1 on frame i and stage 2 on frame i - 1 in one update.
+            for (size_t i = 1; i < numSamples; ++i) {
+                if constexpr (Ramp)
+                    lanes.advance(step);
+
+                y = tick(makeInput(left[i], right[i], y), lanes, state1, state2);
+                left[i - 1] = lane2(y);
+                right[i - 1] = lane3(y);
+            }
+
+            store(s1, state1);
+            store(s2, state2);
+            y1L = lane0(y);
+            y1R = lane1(y);
+
+            if constexpr (Ramp)
+                c = lanes.stageOne();
+        }
+
+        // Epilogue: stage 2 alone on the last frame.
+        left[numSamples - 1] = tick(y1L, c, s1[2], s2[2]);
+        right[numSamples - 1] = tick(y1R, c, s1[3], s2[3]);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < numSamples; ++i) {
+        if constexpr (Ramp)
+            c += rampStep;
+
+        left[i] = tick(tick(left[i], c, s1[0], s2[0]), c, s1[2], s2[2]);
+        right[i] = tick(tick(right[i], c, s1[1], s2[1]), c, s1[3], s2[3]);
+    }
+}
+
+template<typename SampleType>
+template<bool Ramp>
+void StereoBiquadCascade<SampleType>::processMono(SampleType *data, const size_t numSamples,
+                                                  BiquadCoefficients &c, const BiquadCoefficients &rampStep) noexcept {
+    juce::ignoreUnused(rampStep);
+
+    for (size_t i = 0; i < numSamples; ++i) {
+        if constexpr (Ramp)
+            c += rampStep;
+
+        data[i] = tick(tick(data[i], c, s1[0], s2[0]), c, s1[2], s2[2]);
+    }
+}
+
+template<typename SampleType>
+void StereoBiquadCascade<SampleType>::snapToZero() noexcept {
+    for (int lane = 0; lane < 4; ++lane) {
+        JUCE_SNAP_TO_ZERO(s1[lane]);
+        JUCE_SNAP_TO_ZERO(s2[lane]);
+    }
+}
+
+template<typename SampleType>
+void StereoBiquadCascade<SampleType>::reset() noexcept {
+    for (int lane = 0; lane < 4; ++lane) {
+        s1[lane] = SampleType(0);
+        s2[lane] = SampleType(0);
+    }
+}
+
+template class StereoBiquadCascade<float>;
+template class StereoBiquadCascade<double>;
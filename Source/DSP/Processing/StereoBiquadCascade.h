@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include "Biquad.h"
+
+/**
+ * StereoBiquadCascade
+ *
+ * Two identical biquad stages in series for a stereo pair, with all four TDF-II states held
+ * in the lanes of one SIMD register: [L stage 1, R stage 1, L stage 2, R stage 2].
+ *
+ * process() walks the block as a wavefront: every step advances stage 1 on frame n and
+ * stage 2 on frame n - 1 in one 4-lane update, so the 4th-order section costs a single
+ * vector biquad per frame instead of four scalar ones. The first and last frames of a block
+ * are finished with scalar stage-only steps, so no latency is introduced and state is
+ * consistent between blocks.
+ *
+ * Coefficients can be ramped per frame: frame i uses coefficients + (i + 1) * step, which is
+ * accumulated exactly as a scalar cascade would, and the final value is written back.
+ *
+ * SSE2 on x86/x64, NEON on ARM64, scalar elsewhere. Realtime-safe (no allocation, no locks).
+ * The double instantiation keeps its state in double and always runs the scalar steps.
+ */
+template<typename SampleType>
+class StereoBiquadCascade {
+public:
+    /**
+     * Filter one block in place.
+     * @param left         first channel
+     * @param right        second channel, or nullptr to run the cascade on `left` alone
+     * @param coefficients coefficients for the block; advanced to the last frame's value when ramping
+     * @param rampStep     per-frame coefficient increment, or nullptr for constant coefficients
+     */
+    void process(SampleType *left, SampleType *right, size_t numSamples,
+                 BiquadCoefficients &coefficients, const BiquadCoefficients *rampStep = nullptr) noexcept;
+
+    /** Flush denormal state (call once per block). */
+    void snapToZero() noexcept;
+
+    void reset() noexcept;
+
+private:
+    template<bool Ramp>
+    void processStereo(SampleType *left, SampleType *right, size_t numSamples,
+                       BiquadCoefficients &coefficients, const BiquadCoefficients &rampStep) noexcept;
+
+    template<bool Ramp>
+    void processMono(SampleType *data, size_t numSamples,
+                     BiquadCoefficients &coefficients, const BiquadCoefficients &rampStep) noexcept;
+
+    alignas(16) SampleType s1[4] = {};
+    alignas(16) SampleType s2[4] = {};
+};
@@ -0,0 +1,289 @@
+#include "TruePeakMeter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include "MidSidePeakKernel.h"
+#include "SimdLanes.h"
+
+namespace {
+    constexpr int kPhases = TruePeakMeter::kOversampling;
+    constexpr int kTaps = TruePeakMeter::kTapsPerPhase;
+
+    /** ITU-R BS.1770-4 Annex 2 interpolation filter, one row per polyphase branch. */
+    constexpr float kBranches[kPhases][kTaps] = {
+        {
+            0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+            -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+            0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f
+        },
+        {
+            -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+            -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+            0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f
+        },
+        {
+            -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f,
+            -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f,
+            0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f
+        },
+        {
+            -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f,
+            -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f,
+            0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f
+        },
+    };
+
+    /** Same taps transposed: row k holds tap k of all four branches, ready for one 4-lane load. */
+    struct alignas(16) TapLanes {
+        float lanes[kTaps][kPhases];
+    };
+
+    constexpr TapLanes makeTapLanes() {
+        TapLanes t{};
+        for (int k = 0; k < kTaps; ++k)
+            for (int p = 0; p < kPhases; ++p)
+                t.lanes[k][p] = kBranches[p][k];
+        return t;
+    }
+
+    constexpr TapLanes kTapLanes = makeTapLanes();
+
+    constexpr float makeMaximumBranchGain() {
+        float gain = 0.0f;
+        for (const auto &branch: kBranches) {
+            float sum = 0.0f;
+            for (const float tap: branch)
+                sum += tap < 0.0f ? -tap : tap;
+            gain = sum > gain ? sum : gain;
+        }
+        return gain;
+    }
+
+    constexpr float kMaximumBranchGain = makeMaximumBranchGain();
+
+    /**
+     * Decode L/R into the two channel buffers (after their history) and return the input peaks.
+     * Double input is decoded in double and rounded once into the float buffers.
+     */
+    template<TruePeakMeter::Decode Mode, typename SampleType>
+    void decode(const SampleType *left, const SampleType *right, float *a, float *b, const size_t numSamples,
+                float &peakA, float &peakB) noexcept {
+        size_t i = 0;
+        peakA = 0.0f;
+        peakB = 0.0f;
+
+#if GFRACTOR_SIMD
+        if constexpr (std::is_same_v<SampleType, float>) {
+            using namespace SimdLanes;
+            const Vec half = splat(0.5f);
+            Vec maxA = splat(0.0f), maxB = splat(0.0f);
+
+            for (; i + 4 <= numSamples; i += 4) {
+                const Vec l = loadUnaligned(left + i);
+                const Vec r = loadUnaligned(right + i);
+                const Vec x = Mode == TruePeakMeter::Decode::MidSide ? mul(add(l, r), half) : l;
+                const Vec y = Mode == TruePeakMeter::Decode::MidSide ? mul(sub(l, r), half) : r;
+                storeUnaligned(a + i, x);
+                storeUnaligned(b + i, y);
+                maxA = max(abs(x), maxA);
+                maxB = max(abs(y), maxB);
+            }
+
+            peakA = maxAcross(maxA);
+            peakB = maxAcross(maxB);
+        }
+#endif
+
+        for (; i < numSamples; ++i) {
+            const SampleType l = left[i], r = right[i];
+            a[i] = static_cast<float>(Mode == TruePeakMeter::Decode::MidSide ? (l + r) * SampleType(0.5) : l);
+            b[i] = static_cast<float>(Mode == TruePeakMeter::Decode::MidSide ? (l - r) * SampleType(0.5) : r);
+            peakA = juce::jmax(peakA, std::abs(a[i]));
+            peakB = juce::jmax(peakB, std::abs(b[i]));
+        }
+    }
+
+    /**
+     * Largest |output| of all four branches for samples [kHistory, kHistory + numSamples)
+     * of a decoded buffer.
+     */
+    float polyphasePeak(const float *buffer, const size_t numSamples) noexcept {
+        constexpr size_t history = kTaps - 1;
+
+#if GFRACTOR_SIMD
+        using namespace SimdLanes;
+        Vec taps[kTaps];
+        for (int k = 0; k < kTaps; ++k)
+            taps[k] = load(kTapLanes.lanes[k]);
+
+        Vec peak = splat(0.0f);
+
+        for (size_t i = 0; i < numSamples; ++i) {
+            const float *x = buffer + history + i;
+
+            // Even and odd taps in two chains so the adds overlap
+            Vec even = mul(taps[0], splat(x[0]));
+            Vec odd = mul(taps[1], splat(x[-1]));
+            for (int k = 2; k < kTaps; k += 2) {
+                even = add(even, mul(taps[k], splat(x[-k])));
+                odd = add(odd, mul(taps[k + 1], splat(x[-(k + 1)])));
+            }
+
+            peak = max(abs(add(even, odd)), peak);
+        }
+
+        return maxAcross(peak);
+#else
+        float peak = 0.0f;
+
+        for (size_t i = 0; i < numSamples; ++i) {
+            const float *x = buffer + history + i;
+
+            for (const auto &branch: kBranches) {
+                float y = 0.0f;
+                for (int k = 0; k < kTaps; ++k)
+                    y += branch[k] * x[-k];
+                peak = juce::jmax(peak, std::abs(y));
+            }
+        }
+
+        return peak;
+#endif
+    }
+}
+
+void TruePeakMeter::prepare(const int maximumBlockSize) {
+    chunkSize = static_cast<size_t>(juce::jmax(1, maximumBlockSize));
+
+    // At least kHistory frames of room so carryHistory() can stage a full history
+    for (auto &buffer: decoded)
+        buffer.assign(kHistory + juce::jmax(chunkSize, kHistory), 0.0f);
+
+    reset();
+}
+
+template<typename SampleType>
+void TruePeakMeter::process(const SampleType *left, const SampleType *right, const size_t numSamples,
+                            const Decode decode) noexcept {
+    process(left, right, numSamples, decode, measureSamplePeaks(left, right, numSamples, decode));
+}
+
+template<typename SampleType>
+void TruePeakMeter::process(const SampleType *left, const SampleType *right, const size_t numSamples,
+                            const Decode decode, const ChannelPeaks &samplePeaks) noexcept {
+    if (chunkSize == 0 || numSamples == 0)
+        return;
+
+    if (decode != currentDecode) {
+        // The history belongs to the other decoding; so does anything held.
+        currentDecode = decode;
+        reset();
+    }
+
+    // No oversampled value of this block can exceed (largest input in the filter window) x
+    // (worst-case branch gain); if that cannot beat the hold, the filter has nothing to add.
+    bool needsFilter = false;
+
+    for (size_t ch = 0; ch < static_cast<size_t>(kNumChannels); ++ch) {
+        heldPeak[ch] = juce::jmax(heldPeak[ch], samplePeaks[ch]);
+
+        if (juce::jmax(samplePeaks[ch], historyPeak(ch)) * kMaximumBranchGain > heldPeak[ch])
+            needsFilter = true;
+    }
+
+    if (!needsFilter) {
+        carryHistory(left, right, numSamples);
+        return;
+    }
+
+    for (size_t start = 0; start < numSamples; start += chunkSize)
+        processChunk(left + start, right + start, juce::jmin(chunkSize, numSamples - start));
+}
+
+template<typename SampleType>
+TruePeakMeter::ChannelPeaks TruePeakMeter::measureSamplePeaks(const SampleType *left, const SampleType *right,
+                                                              const size_t numSamples,
+                                                              const Decode decode) noexcept {
+    if (decode == Decode::MidSide) {
+        const auto peaks = MidSidePeakKernel::process(left, right, numSamples);
+        return {peaks.mid, peaks.side};
+    }
+
+    // (x + x) / 2 == x exactly, so the mid lane of a channel paired with itself is its abs-max
+    return {
+        MidSidePeakKernel::process(left, left, numSamples).mid,
+        MidSidePeakKernel::process(right, right, numSamples).mid
+    };
+}
+
+template<typename SampleType>
+void TruePeakMeter::processChunk(const SampleType *left, const SampleType *right, const size_t numSamples) noexcept {
+    const auto inputPeak = decodeAfterHistory(left, right, numSamples);
+
+    for (size_t ch = 0; ch < static_cast<size_t>(kNumChannels); ++ch) {
+        float *buffer = decoded[ch].data();
+        auto &held = heldPeak[ch];
+
+        // Same bound as process(), per chunk and channel
+        if (juce::jmax(inputPeak[ch], historyPeak(ch)) * kMaximumBranchGain > held)
+            held = juce::jmax(held, polyphasePeak(buffer, numSamples));
+
+        // Keep the last kHistory samples for the next chunk
+        std::copy(buffer + numSamples, buffer + numSamples + kHistory, buffer);
+    }
+}
+
+template<typename SampleType>
+void TruePeakMeter::carryHistory(const SampleType *left, const SampleType *right, const size_t numSamples) noexcept {
+    const auto tail = juce::jmin(numSamples, kHistory);
+    decodeAfterHistory(left + (numSamples - tail), right + (numSamples - tail), tail);
+
+    for (auto &buffer: decoded)
+        std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(tail),
+                  buffer.begin() + static_cast<std::ptrdiff_t>(tail + kHistory), buffer.begin());
+}
+
+template<typename SampleType>
+TruePeakMeter::ChannelPeaks TruePeakMeter::decodeAfterHistory(const SampleType *left, const SampleType *right,
+                                                              const size_t numSamples) noexcept {
+    float *a = decoded[0].data() + kHistory;
+    float *b = decoded[1].data() + kHistory;
+    ChannelPeaks peaks{};
+
+    if (currentDecode == Decode::MidSide)
+        ::decode<Decode::MidSide>(left, right, a, b, numSamples, peaks[0], peaks[1]);
+    else
+        ::decode<Decode::LeftRight>(left, right, a, b, numSamples, peaks[0], peaks[1]);
+
+    return peaks;
+}
+
+float TruePeakMeter::historyPeak(const size_t channel) const noexcept {
+    float peak = 0.0f;
+    for (size_t i = 0; i < kHistory; ++i)
+        peak = juce::jmax(peak, std::abs(decoded[channel][i]));
+    return peak;
+}
+
+void TruePeakMeter::reset() noexcept {
+    for (auto &buffer: decoded)
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+
+    resetHold();
+}
+
+float TruePeakMeter::getMaximumBranchGain() noexcept {
+    return kMaximumBranchGain;
+}
+
+template void TruePeakMeter::process<float>(const float *, const float *, size_t, Decode) noexcept;
+template void TruePeakMeter::process<double>(const double *, const double *, size_t, Decode) noexcept;
+template void TruePeakMeter::process<float>(const float *, const float *, size_t, Decode,
+                                            const ChannelPeaks &) noexcept;
+template void TruePeakMeter::process<double>(const double *, const double *, size_t, Decode,
+                                             const ChannelPeaks &) noexcept;
+template TruePeakMeter::ChannelPeaks TruePeakMeter::measureSamplePeaks<float>(const float *, const float *, size_t,
+                                                                              Decode) noexcept;
+template TruePeakMeter::ChannelPeaks TruePeakMeter::measureSamplePeaks<double>(const double *, const double *, size_t,
+                                                                               Decode) noexcept;
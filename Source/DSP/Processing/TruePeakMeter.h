@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * TruePeakMeter
+ *
+ * ITU-R BS.1770-4 (Annex 2) true-peak meter for a decoded channel pair: each channel is
+ * upsampled 4x with the standard's 48-tap interpolation filter (four 12-tap polyphase
+ * branches) and the largest absolute oversampled value is held until resetHold().
+ *
+ * The four branches of one input sample share their inputs, so they are evaluated together
+ * as one 4-lane multiply-add chain (SSE2 / NEON through SimdLanes, scalar elsewhere).
+ * On top of that, a block whose sample peak times the filter's worst-case gain cannot beat
+ * the held value skips the filter altogether: it costs the sample-peak pass (which
+ * gFractorDSP already runs for its mid/side meter and can hand in) plus carrying over the
+ * 11-sample history. The full polyphase pass only runs while the held value can still rise.
+ *
+ * The held value also includes the sample peaks, so it never reads below them.
+ *
+ * Input may be float or double; it is decoded into the meter's float history either way.
+ *
+ * Audio thread only; realtime-safe (allocation only in prepare()).
+ */
+class TruePeakMeter {
+public:
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+    static constexpr int kNumChannels = 2;
+
+    /** How the incoming L/R pair is decoded before metering. */
+    enum class Decode { MidSide, LeftRight };
+
+    /** Linear sample peaks of the two decoded channels. */
+    using ChannelPeaks = std::array<float, kNumChannels>;
+
+    /** Scratch for blocks of up to maximumBlockSize frames; larger blocks are metered in chunks. */
+    void prepare(int maximumBlockSize);
+
+    /**
+     * Meter one block of L/R input decoded as requested. Switching the decode mode
+     * restarts the filter history and the hold.
+     */
+    template<typename SampleType>
+    void process(const SampleType *left, const SampleType *right, size_t numSamples, Decode decode) noexcept;
+
+    /** Same, with the block's decoded sample peaks already measured (see measureSamplePeaks()). */
+    template<typename SampleType>
+    void process(const SampleType *left, const SampleType *right, size_t numSamples, Decode decode,
+                 const ChannelPeaks &samplePeaks) noexcept;
+
+    /** Decoded sample peaks of a block, through the vectorized MidSidePeakKernel. */
+    template<typename SampleType>
+    static ChannelPeaks measureSamplePeaks(const SampleType *left, const SampleType *right, size_t numSamples,
+                                           Decode decode) noexcept;
+
+    /** Held linear true peak of decoded channel 0 (mid / left) or 1 (side / right). */
+    float getHeldPeak(const int channel) const noexcept { return heldPeak[static_cast<size_t>(channel)]; }
+
+    /** Forget the held values, keep the filter history. */
+    void resetHold() noexcept { heldPeak = {}; }
+
+    /** Clear the filter history and the held values. */
+    void reset() noexcept;
+
+    /** Largest gain of any polyphase branch for a worst-case input (sum of |taps|). */
+    static float getMaximumBranchGain() noexcept;
+
+private:
+    static constexpr size_t kHistory = kTapsPerPhase - 1;
+
+    template<typename SampleType>
+    void processChunk(const SampleType *left, const SampleType *right, size_t numSamples) noexcept;
+
+    /** Move the last kHistory decoded input samples into the history without filtering. */
+    template<typename SampleType>
+    void carryHistory(const SampleType *left, const SampleType *right, size_t numSamples) noexcept;
+
+    /** Decode numSamples frames after the history of each channel buffer. */
+    template<typename SampleType>
+    ChannelPeaks decodeAfterHistory(const SampleType *left, const SampleType *right, size_t numSamples) noexcept;
+
+    float historyPeak(size_t channel) const noexcept;
+
+    // Per channel: kHistory previous decoded samples followed by the current chunk
+    std::array<std::vector<float>, kNumChannels> decoded;
+    size_t chunkSize = 0;
+
+    std::array<float, kNumChannels> heldPeak{};
+    Decode currentDecode = Decode::MidSide;
+};
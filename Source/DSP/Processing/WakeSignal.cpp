@@ -0,0 +1,121 @@
+#include "WakeSignal.h"
+
+#if JUCE_LINUX || JUCE_ANDROID
+ #define GFRACTOR_WAKE_FUTEX 1
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #include <ctime>
+#elif JUCE_WINDOWS
+ #define GFRACTOR_WAKE_ADDRESS 1
+ #ifndef _WIN32_WINNT
+  #define _WIN32_WINNT 0x0602 // WaitOnAddress() needs Windows 8
+ #endif
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #define GFRACTOR_WAKE_DISPATCH 1
+ #include <dispatch/dispatch.h>
+#else
+ #define GFRACTOR_WAKE_SEMAPHORE 1
+ #include <semaphore.h>
+ #include <ctime>
+#endif
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+namespace {
+    /** Sleep while word holds token, for at most timeoutMs (negative: no limit); may return early. */
+    void sleepWhile(std::atomic<std::uint32_t> &word, const std::uint32_t token, void *semaphore,
+                    const int timeoutMs) noexcept {
+#if GFRACTOR_WAKE_FUTEX
+        juce::ignoreUnused(semaphore);
+        timespec timeout{timeoutMs / 1000, static_cast<long>(timeoutMs % 1000) * 1000000};
+        // The kernel rechecks the word under its own lock, so a post after the caller's check wakes it
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT_PRIVATE, token,
+                timeoutMs < 0 ? nullptr : &timeout, nullptr, 0);
+#elif GFRACTOR_WAKE_ADDRESS
+        juce::ignoreUnused(semaphore);
+        auto expected = token;
+        WaitOnAddress(&word, &expected, sizeof(expected),
+                      timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+#elif GFRACTOR_WAKE_DISPATCH
+        juce::ignoreUnused(word, token);
+        dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(semaphore),
+                                timeoutMs < 0 ? DISPATCH_TIME_FOREVER
+                                              : dispatch_time(DISPATCH_TIME_NOW, timeoutMs * static_cast<int64_t>(NSEC_PER_MSEC)));
+#elif GFRACTOR_WAKE_SEMAPHORE
+        juce::ignoreUnused(word, token);
+        auto *handle = static_cast<sem_t *>(semaphore);
+        if (timeoutMs < 0) {
+            sem_wait(handle);
+            return;
+        }
+        timespec deadline{};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeoutMs / 1000;
+        deadline.tv_nsec += static_cast<long>(timeoutMs % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            ++deadline.tv_sec;
+            deadline.tv_nsec -= 1000000000;
+        }
+        sem_timedwait(handle, &deadline);
+#endif
+    }
+}
+
+WakeSignal::WakeSignal() {
+#if GFRACTOR_WAKE_DISPATCH
+    semaphore = dispatch_semaphore_create(0);
+#elif GFRACTOR_WAKE_SEMAPHORE
+    auto *handle = new sem_t;
+    sem_init(handle, 0, 0);
+    semaphore = handle;
+#endif
+}
+
+WakeSignal::~WakeSignal() {
+#if GFRACTOR_WAKE_DISPATCH
+    dispatch_release(static_cast<dispatch_semaphore_t>(semaphore));
+#elif GFRACTOR_WAKE_SEMAPHORE
+    auto *handle = static_cast<sem_t *>(semaphore);
+    sem_destroy(handle);
+    delete handle;
+#endif
+}
+
+void WakeSignal::post() noexcept {
+    count.fetch_add(1, std::memory_order_release);
+
+    // Each of these only queues a wakeup: none of them waits for the waiter or takes its lock
+#if GFRACTOR_WAKE_FUTEX
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&count), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif GFRACTOR_WAKE_ADDRESS
+    WakeByAddressSingle(&count);
+#elif GFRACTOR_WAKE_DISPATCH
+    dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(semaphore));
+#elif GFRACTOR_WAKE_SEMAPHORE
+    sem_post(static_cast<sem_t *>(semaphore));
+#endif
+}
+
+bool WakeSignal::wait(const std::uint32_t token, const int timeoutMs) noexcept {
+    const auto start = juce::Time::getMillisecondCounter();
+
+    // Early returns (signals, a semaphore count left by an earlier post) just go round again
+    while (count.load(std::memory_order_acquire) == token) {
+        int remainingMs = -1;
+        if (timeoutMs >= 0) {
+            const auto elapsed = static_cast<int>(juce::Time::getMillisecondCounter() - start);
+            if (elapsed >= timeoutMs)
+                return false;
+            remainingMs = timeoutMs - elapsed;
+        }
+        sleepWhile(count, token, semaphore, remainingMs);
+    }
+
+    return true;
+}
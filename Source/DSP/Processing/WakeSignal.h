@@ -0,0 +1,44 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * WakeSignal
+ *
+ * Lets one thread sleep until another posts, where the poster must not block: post() is an
+ * atomic increment plus a non-blocking OS wake (a futex on Linux, WakeByAddressSingle() on
+ * Windows, a dispatch semaphore on Apple platforms, a POSIX semaphore elsewhere), so the
+ * audio thread can call it. A juce::WaitableEvent cannot be posted from there: its signal()
+ * locks the mutex the waiter sleeps under.
+ *
+ * The waiter takes a token with prepare() before checking its condition, then passes it to
+ * wait(), which returns at once if post() was called since. A post between the check and
+ * the sleep is never lost.
+ *
+ * Threading: post() from any thread; prepare() and wait() on one waiting thread.
+ */
+class WakeSignal {
+public:
+    WakeSignal();
+    ~WakeSignal();
+
+    /** Waiter: the token for wait(); take it before checking the condition waited for. */
+    std::uint32_t prepare() const noexcept { return count.load(std::memory_order_acquire); }
+
+    /** Any thread, realtime-safe: wake the waiter (or make its next wait() return at once). */
+    void post() noexcept;
+
+    /**
+     * Waiter: sleep until post() has been called since prepare() returned token, or timeoutMs
+     * passes (negative: no timeout). Returns false on the timeout.
+     */
+    bool wait(std::uint32_t token, int timeoutMs) noexcept;
+
+private:
+    std::atomic<std::uint32_t> count{0};
+    void *semaphore = nullptr; // Apple and POSIX fallback only: wait() sleeps on this
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSignal)
+};
@@ -27,7 +27,7 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
     hintManager.setCallback([this](const HintManager::HintContent &c) { hintBar.setHint(c); });
     hintManager.setPersistentHint("HOVER", "To see tooltips");
     wireHintBarPills();
-    // Register with processor so it can push audio data
+    // Register with processor so it attaches the analyzer to its capture buses
     audioProcessor.registerAudioDataSink(&spectrumAnalyzer);
     audioProcessor.setGhostDataSink(&spectrumAnalyzer);
     // Set initial sample rate
@@ -37,6 +37,8 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
     addChildComponent(meteringPanel);
     audioProcessor.registerAudioDataSink(&meteringPanel);
     meteringPanel.setSampleRate(audioProcessor.getSampleRate());
+    meteringPanel.setPeakLevelSource(&audioProcessor);
+    meteringPanel.onTruePeakReset = [this] { audioProcessor.resetTruePeaks(); };
 
     // Draggable divider between spectrum and metering panel (starts hidden)
     addChildComponent(panelDivider);
@@ -100,11 +102,29 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
         audioProcessor.setBandFilter(active, freq, q);
     };
 
+    // Wire band solo/mute callback (shift/alt-click on band hints -> band solo bank).
+    // The analyzer opens with nothing latched, so drop any solo left by a previous editor.
+    spectrumAnalyzer.onBandSolo = [this](const juce::uint32 soloMask, const juce::uint32 muteMask) {
+        audioProcessor.setBandSolo(soloMask, muteMask);
+    };
+    audioProcessor.setBandSolo(0, 0);
+
+    // Wire target curve load/clear -> match EQ. The processor keeps its target while the editor
+    // is closed, so a new editor leaves it alone until a curve is loaded or cleared.
+    spectrumAnalyzer.onTargetCurveChanged = [this](const TargetCurve::CurveData *curve) {
+        if (curve == nullptr)
+            audioProcessor.clearMatchEqTarget();
+        else
+            audioProcessor.setMatchEqTarget({curve->primaryDb, curve->fftSize, curve->sampleRate});
+    };
+
     // Create header bar with settings callback
     headerBar = std::make_unique<HeaderBar>(
         [this] {
             // Settings callback — toggle preference panel overlay
             if (preferencePanel == nullptr) {
+                if (processingPanel != nullptr)
+                    processingPanel->close();
                 preferencePanel = std::make_unique<PreferencePanel>(
                     spectrumAnalyzer,
                     audioProcessor.getAPVTS(),
@@ -204,6 +224,9 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
         }), true);
     };
 
+    // Processing panel (DSP button)
+    headerBar->onProcessing = [this] { toggleProcessingPanel(); };
+
     // Help menu callbacks
     headerBar->onAbout = [this] {
         juce::AlertWindow::showMessageBoxAsync(
@@ -236,9 +259,7 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
 
     // Wire meters pill callback
     footerBar.getMetersPill().onClick = [this] {
-        metersVisible = footerBar.getMetersPill().getToggleState();
-        meteringPanel.setVisible(metersVisible);
-        resized();
+        setMetersVisible(footerBar.getMetersPill().getToggleState());
     };
 
     // Performance display (debug builds only, starts visible, toggle with Ctrl+Shift+P)
@@ -259,6 +280,7 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
         if (savedVisible) {
             metersVisible = true;
             meteringPanel.setVisible(true);
+            audioProcessor.setTruePeakEnabled(true);
             footerBar.getMetersPill().setToggleState(true, juce::dontSendNotification);
         }
     }
@@ -364,11 +386,7 @@ gFractorAudioProcessorEditor::gFractorAudioProcessorEditor(gFractorAudioProcesso
             spectrumAnalyzer.setFftOrder(idx + 11);
             AnalyzerSettings::save(spectrumAnalyzer);
         };
-        actions.onMeters     = [this](const bool visible) {
-            metersVisible = visible;
-            meteringPanel.setVisible(visible);
-            resized();
-        };
+        actions.onMeters     = [this](const bool visible) { setMetersVisible(visible); };
         actions.onTarget      = [this]() {
             auto &pill = footerBar.getTargetPill();
             if (!pill.isEnabled()) return;
@@ -398,16 +416,19 @@ gFractorAudioProcessorEditor::~gFractorAudioProcessorEditor() {
     presetManager.getDisplayState  = nullptr;
     presetManager.applyDisplayState = nullptr;
 
-    // Disconnect audio thread from UI components FIRST — the ghost sink must
-    // be cleared before unregistering sinks so the audio thread can't call
-    // pushGhostData on a partially-unregistered SpectrumAnalyzer.
+    // Detach the UI components from the capture buses FIRST — the ghost sink is
+    // cleared before the sinks are unregistered, so the registry never holds a
+    // partially-unregistered SpectrumAnalyzer.
     audioProcessor.setGhostDataSink(nullptr);
     audioProcessor.unregisterAudioDataSink(&meteringPanel);
     audioProcessor.unregisterAudioDataSink(&spectrumAnalyzer);
+    audioProcessor.setTruePeakEnabled(false);
 
     // Clear callbacks that capture `this`
     spectrumAnalyzer.onFullscreen = nullptr;
     spectrumAnalyzer.onAuditFilter = nullptr;
+    spectrumAnalyzer.onTargetCurveChanged = nullptr;
+    meteringPanel.onTruePeakReset = nullptr;
 
     performanceDisplay.setProcessor(nullptr);
 
@@ -538,9 +559,17 @@ void gFractorAudioProcessorEditor::resized() {
                                    PreferencePanel::panelHeight);
     }
 
+    // Processing panel overlay (same place)
+    if (processingPanel != nullptr) {
+        processingPanel->setBounds(getWidth() - ProcessingPanel::panelWidth - Spacing::marginS,
+                                   Spacing::marginXL,
+                                   ProcessingPanel::panelWidth,
+                                   ProcessingPanel::panelHeight);
+    }
+
     // Performance display (top right corner, fixed size)
-    constexpr int perfWidth = 120;
-    constexpr int perfHeight = 34;
+    constexpr int perfWidth = 150;
+    constexpr int perfHeight = 94;
     constexpr int perfMargin = 2;
     performanceDisplay.setBounds(getWidth() - perfWidth - perfMargin,
                                  perfMargin,
@@ -555,6 +584,10 @@ bool gFractorAudioProcessorEditor::keyPressed(const juce::KeyPress &key,
             preferencePanel->cancel();
             return true;
         }
+        if (processingPanel != nullptr) {
+            processingPanel->close();
+            return true;
+        }
     }
 
     return uiController.keyPressed(key);
@@ -580,6 +613,29 @@ void gFractorAudioProcessorEditor::setSpectrumFullscreen(const bool fullscreen)
     resized();
 }
 
+void gFractorAudioProcessorEditor::toggleProcessingPanel() {
+    if (processingPanel != nullptr) {
+        processingPanel->close();
+        return;
+    }
+
+    if (preferencePanel != nullptr)
+        preferencePanel->cancel();
+
+    processingPanel = std::make_unique<ProcessingPanel>(audioProcessor);
+    processingPanel->onClose = [this] {
+        processingPanel.reset();
+        panelBackdrop.reset();
+    };
+    panelBackdrop = std::make_unique<PanelBackdrop>();
+    panelBackdrop->onMouseDown = [this] {
+        if (processingPanel != nullptr) processingPanel->close();
+    };
+    addAndMakeVisible(panelBackdrop.get());
+    addAndMakeVisible(processingPanel.get());
+    resized();
+}
+
 void gFractorAudioProcessorEditor::togglePerformanceDisplay() {
     performanceDisplayVisible = !performanceDisplayVisible;
     performanceDisplay.setVisible(performanceDisplayVisible);
@@ -587,6 +643,13 @@ void gFractorAudioProcessorEditor::togglePerformanceDisplay() {
         performanceDisplay.toFront(false);
 }
 
+void gFractorAudioProcessorEditor::setMetersVisible(const bool visible) {
+    metersVisible = visible;
+    meteringPanel.setVisible(visible);
+    audioProcessor.setTruePeakEnabled(visible);
+    resized();
+}
+
 void gFractorAudioProcessorEditor::applyTheme() {
     gFractorLnf.applyTheme();
     footerBar.applyTheme();
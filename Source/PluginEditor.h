@@ -9,6 +9,7 @@
 #include "UI/Controls/HintBar.h"
 #include "UI/Panels/StereoMeteringPanel.h"
 #include "UI/Panels/PreferencePanel.h"
+#include "UI/Panels/ProcessingPanel.h"
 #include "UI/LookAndFeel/gFractorLookAndFeel.h"
 #include "State/PresetManager.h"
 #include "UI/Theme/ColorPalette.h"
@@ -93,6 +94,7 @@ private:
     HintBar hintBar;
 
     std::unique_ptr<PreferencePanel> preferencePanel;
+    std::unique_ptr<ProcessingPanel> processingPanel;
     std::unique_ptr<PanelBackdrop> panelBackdrop;
     PanelDivider panelDivider;
 
@@ -104,6 +106,12 @@ private:
 
     void togglePerformanceDisplay();
 
+    /** Open the processing panel (closing the preference panel), or close it if open. */
+    void toggleProcessingPanel();
+
+    /** Show or hide the metering panel; true-peak metering runs only while it is shown. */
+    void setMetersVisible(bool visible);
+
     void setSpectrumFullscreen(bool fullscreen);
 
     //==============================================================================
@@ -2,6 +2,7 @@
 #include "PluginEditor.h"
 #include "PluginState.h"
 #include "State/ParameterLayout.h"
+#include <type_traits>
 
 //==============================================================================
 gFractorAudioProcessor::gFractorAudioProcessor()
@@ -19,8 +20,7 @@ gFractorAudioProcessor::gFractorAudioProcessor()
     :
 #endif
       apvts(*this, nullptr, "Parameters", ParameterLayout::createParameterLayout()) {
-    // Create parameter listener to automatically sync APVTS changes to DSP
-    parameterListener = std::make_unique<ParameterListener>(apvts, dspProcessor);
+    sinkRegistry.setFifoMetrics(perfMonitor);
 }
 
 gFractorAudioProcessor::~gFractorAudioProcessor() = default;
@@ -55,7 +55,11 @@ bool gFractorAudioProcessor::isMidiEffect() const {
 }
 
 double gFractorAudioProcessor::getTailLengthSeconds() const {
-    return 0.0;
+    // Latency plus ring-out: how long output continues after the input stops
+    const double sampleRate = getSampleRate();
+    const int tailSamples = isUsingDoublePrecision() ? dspProcessorDouble.getTailSamples()
+                                                     : dspProcessor.getTailSamples();
+    return sampleRate > 0.0 ? tailSamples / sampleRate : 0.0;
 }
 
 //==============================================================================
@@ -88,10 +92,28 @@ void gFractorAudioProcessor::prepareToPlay(const double sampleRate, const int sa
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumInputChannels());
 
-    dspProcessor.prepare(spec);
+    // Immersive main buses run the channel mode per speaker pair
+    const auto mainLayout = getChannelLayoutOfBus(true, 0);
+    const auto pairLayout = ChannelPairLayout::fromChannelSet(mainLayout);
+
+    // The host picks the precision before prepareToPlay; only that engine gets buffers
+    if (isUsingDoublePrecision()) {
+        dspProcessorDouble.setChannelLayout(pairLayout);
+        dspProcessorDouble.prepare(spec);
+        analysisBuffer.setSize(getTotalNumInputChannels(), samplesPerBlock);
+    } else {
+        dspProcessor.setChannelLayout(pairLayout);
+        dspProcessor.prepare(spec);
+        analysisBuffer.setSize(0, 0);
+    }
+
+    silenceDetector.prepare(sampleRate);
+    sidechainAligner.prepare(sampleRate, samplesPerBlock, getChannelCountOfBus(true, 0), getChannelCountOfBus(true, 1));
+    updateLatency();
 
     // Update all registered sinks with the new sample rate
     sinkRegistry.prepareSinks(sampleRate);
+    sinkRegistry.prepareAnalyzerSource(mainLayout, samplesPerBlock);
 }
 
 void gFractorAudioProcessor::releaseResources() {
@@ -100,7 +122,10 @@ void gFractorAudioProcessor::releaseResources() {
 
 void gFractorAudioProcessor::reset() {
     // Clear DSP state when playback stops/starts or sample rate changes
-    dspProcessor.reset();
+    if (isUsingDoublePrecision())
+        dspProcessorDouble.reset();
+    else
+        dspProcessor.reset();
 }
 
 bool gFractorAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const {
@@ -108,8 +133,12 @@ bool gFractorAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts)
     juce::ignoreUnused(layouts);
     return true;
 #else
-    // This plugin supports stereo only
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Stereo and the common immersive layouts (channel mode runs per speaker pair)
+    const auto &mainOutput = layouts.getMainOutputChannelSet();
+    if (mainOutput != juce::AudioChannelSet::stereo()
+        && mainOutput != juce::AudioChannelSet::create5point1()
+        && mainOutput != juce::AudioChannelSet::create7point1()
+        && mainOutput != juce::AudioChannelSet::create7point1point4())
         return false;
 
     // Input and output layouts must match
@@ -133,7 +162,34 @@ bool gFractorAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts)
 void gFractorAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                           juce::MidiBuffer &midiMessages) {
     juce::ignoreUnused(midiMessages);
+    processBlockWithPrecision(buffer);
+}
+
+void gFractorAudioProcessor::processBlock(juce::AudioBuffer<double> &buffer,
+                                          juce::MidiBuffer &midiMessages) {
+    juce::ignoreUnused(midiMessages);
+    processBlockWithPrecision(buffer);
+}
 
+juce::AudioBuffer<float> &gFractorAudioProcessor::getAnalysisInput(juce::AudioBuffer<double> &buffer) {
+    const int numChannels = juce::jmin(getTotalNumInputChannels(), analysisBuffer.getNumChannels());
+    const int numSamples = juce::jmin(buffer.getNumSamples(), analysisBuffer.getNumSamples());
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const double *input = buffer.getReadPointer(ch);
+        float *output = analysisBuffer.getWritePointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = static_cast<float>(input[i]);
+    }
+
+    // Refer to the converted region so the sinks see the block length, without reallocating
+    analysisView.setDataToReferTo(analysisBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+    return analysisView;
+}
+
+template<typename SampleType>
+void gFractorAudioProcessor::processBlockWithPrecision(juce::AudioBuffer<SampleType> &buffer) {
     // auval can pass zero-size buffers — early exit to avoid issues
     if (buffer.getNumSamples() == 0)
         return;
@@ -155,6 +211,10 @@ void gFractorAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     const bool hasSidechain = sidechainBus.getNumChannels() > 0;
     sidechainAvailable.store(hasSidechain);
 
+    // Measure the main/sidechain lag before reference mode overwrites the main input
+    if (hasSidechain)
+        sidechainAligner.capture(getBusBuffer(buffer, true, 0), sidechainBus);
+
     // In reference mode, replace main input with sidechain so the full
     // processing chain (analyzer, primary/secondary, audition filter) applies to it
     if (isRefMode && hasSidechain) {
@@ -167,19 +227,66 @@ void gFractorAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         }
     }
 
-    // Push audio data to sinks
-    const auto mainInput = getBusBuffer(buffer, true, 0);
-    sinkRegistry.pushAudioData(mainInput, hasSidechain, isRefMode);
-    sinkRegistry.pushGhostData(mainInput, sidechainBus, hasSidechain, isRefMode);
+    // Silent input: once the hold has passed, the sinks get one marker and stop receiving data.
+    // The DSP still runs on sub-threshold input; it is skipped only once the input has been
+    // digital silence for the latency and ring-out, when the chain would output silence too.
+    // processSilence() then leaves the zeros and restarts the chain when input returns.
+    const auto activity = silenceDetector.process(buffer);
+    if (activity == SilenceDetector::Activity::EnteredSleep)
+        sinkRegistry.pushSilence();
+
+    if (silenceDetector.hasFlushed()) {
+        const auto parameters = parameterSnapshot.read();
+        if constexpr (std::is_same_v<SampleType, double>)
+            dspProcessorDouble.processSilence(buffer, parameters);
+        else
+            dspProcessor.processSilence(buffer, parameters);
+
+        recordBlockTime(startTime, buffer.getNumSamples());
+        return;
+    }
+
+    if (activity == SilenceDetector::Activity::Active)
+        pushToSinks(buffer, hasSidechain, isRefMode);
+
+    // Process audio through DSP chain. Parameters are read once per block from the APVTS
+    // atomics; JUCE hands automation over as one value per parameter per block, so the
+    // timeline holds a single point at the block start.
+    parameterTimeline.clear();
+    parameterTimeline.add(0, parameterSnapshot.read());
+    if constexpr (std::is_same_v<SampleType, double>)
+        dspProcessorDouble.process(buffer, parameterTimeline);
+    else
+        dspProcessor.process(buffer, parameterTimeline);
 
-    // Process audio through DSP chain
-    // (Parameters are automatically updated via ParameterListener)
-    dspProcessor.process(buffer);
+    recordBlockTime(startTime, buffer.getNumSamples());
+}
+
+template<typename SampleType>
+void gFractorAudioProcessor::pushToSinks(juce::AudioBuffer<SampleType> &buffer, const bool hasSidechain,
+                                         const bool isRefMode) {
+    // Push audio data to sinks (float; a 64-bit block is converted for the analyzer only)
+    auto &analysisInput = getAnalysisInput(buffer);
+    const auto mainInput = getBusBuffer(analysisInput, true, 0);
+    const auto analysisSidechain = getBusBuffer(analysisInput, true, 1);
+
+    // The analyzer compares main and sidechain lined up: the leading one is delayed for the sinks
+    // only. Reference mode shows the sidechain on both sides, so there is nothing to line up.
+    const bool align = hasSidechain && !isRefMode;
+    if (align)
+        sidechainAligner.align(mainInput, analysisSidechain);
+
+    const auto &analyzedMain = align ? sidechainAligner.getAlignedMain() : mainInput;
+    const auto &analyzedSidechain = align ? sidechainAligner.getAlignedSidechain() : analysisSidechain;
+    sinkRegistry.pushAudioData(analyzedMain, hasSidechain, isRefMode);
+    sinkRegistry.pushGhostData(analyzedMain, analyzedSidechain, hasSidechain, isRefMode);
+}
 
+void gFractorAudioProcessor::recordBlockTime(const juce::int64 startTicks, const int numSamples) {
     // Update performance metrics
-    const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTime;
+    const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
     const auto elapsedMs = juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1000.0;
-    perfMonitor.recordBlock(elapsedMs, getSampleRate(), buffer.getNumSamples());
+    perfMonitor.recordBlock(elapsedMs, getSampleRate(), numSamples);
 }
 
 //==============================================================================
@@ -199,11 +306,59 @@ void gFractorAudioProcessor::getStateInformation(juce::MemoryBlock &destData) {
 
 void gFractorAudioProcessor::setStateInformation(const void *data, const int sizeInBytes) {
     // Deserialize plugin state with version migration support
-    if (PluginState::deserialize(apvts, displayState, data, sizeInBytes)) {
-        // Update DSP with loaded parameter values
-        if (parameterListener != nullptr)
-            parameterListener->updateAllParameters();
+    // Restored parameter values reach the DSP through the next block's snapshot.
+    PluginState::deserialize(apvts, displayState, data, sizeInBytes);
+
+    if (displayState.hasProperty("separatorFftOrder"))
+        setSeparatorFftOrder(displayState["separatorFftOrder"]);
+
+    if (displayState.hasProperty("spectralAuditionEdge"))
+        setSpectralAuditionEdge(displayState["spectralAuditionEdge"]);
+
+    if (displayState.hasProperty("auditionEngine"))
+        setAuditionEngine(auditionEngineFromInt(displayState["auditionEngine"]));
+
+    if (displayState.hasProperty("analyzerSource"))
+        setAnalyzerSource(analyzerSourceFromInt(displayState["analyzerSource"]));
+
+    if (displayState.hasProperty("silenceThresholdDb"))
+        setSilenceThresholdDb(displayState["silenceThresholdDb"]);
+
+    if (displayState.hasProperty("silenceHoldMs"))
+        setSilenceHoldMs(displayState["silenceHoldMs"]);
+
+    if (displayState.hasProperty("sidechainAlign"))
+        setSidechainAlignEnabled(displayState["sidechainAlign"]);
+
+    if (displayState.hasProperty("crossoverFrequencies")) {
+        std::vector<float> frequencies;
+        for (const auto &token: juce::StringArray::fromTokens(displayState["crossoverFrequencies"].toString(), false))
+            frequencies.push_back(token.getFloatValue());
+        setCrossoverFrequencies(frequencies);
     }
+
+    for (int band = 0; band < MultibandCrossover::kMaxBands; ++band) {
+        const auto key = "crossoverBand" + juce::String(band);
+        if (!displayState.hasProperty(key))
+            continue;
+
+        // "midGainDb sideGainDb midEnabled sideEnabled"
+        const auto fields = juce::StringArray::fromTokens(displayState[key].toString(), false);
+        if (fields.size() != 4)
+            continue;
+
+        setCrossoverBand(band, {fields[0].getFloatValue(), fields[1].getFloatValue(),
+                                fields[2].getIntValue() != 0, fields[3].getIntValue() != 0});
+    }
+
+    if (displayState.hasProperty("crossoverEnabled"))
+        setCrossoverEnabled(displayState["crossoverEnabled"]);
+
+    if (displayState.hasProperty("matchEqAmount"))
+        setMatchEqAmount(displayState["matchEqAmount"]);
+
+    if (displayState.hasProperty("matchEqEnabled"))
+        setMatchEqEnabled(displayState["matchEqEnabled"]);
 }
 
 //==============================================================================
@@ -216,11 +371,65 @@ void gFractorAudioProcessor::unregisterAudioDataSink(IAudioDataSink *sink) {
 }
 
 void gFractorAudioProcessor::setAuditFilter(const bool active, const float frequencyHz, const float q) {
-    dspProcessor.setAuditFilter(active, frequencyHz, q);
+    forEachProcessor([=](auto &dsp) { dsp.setAuditFilter(active, frequencyHz, q); });
 }
 
 void gFractorAudioProcessor::setBandFilter(const bool active, const float frequencyHz, const float q) {
-    dspProcessor.setBandFilter(active, frequencyHz, q);
+    forEachProcessor([=](auto &dsp) { dsp.setBandFilter(active, frequencyHz, q); });
+}
+
+void gFractorAudioProcessor::setBandSolo(const juce::uint32 soloMask, const juce::uint32 muteMask) {
+    forEachProcessor([=](auto &dsp) {
+        dsp.setBandSolo(soloMask);
+        dsp.setBandMute(muteMask);
+    });
+}
+
+void gFractorAudioProcessor::setCrossoverEnabled(const bool enabled) {
+    forEachProcessor([enabled](auto &dsp) { dsp.setCrossoverEnabled(enabled); });
+    displayState.setProperty("crossoverEnabled", enabled, nullptr);
+    updateLatency();
+}
+
+void gFractorAudioProcessor::setCrossoverFrequencies(const std::vector<float> &frequencies) {
+    forEachProcessor([&frequencies](auto &dsp) { dsp.setCrossoverFrequencies(frequencies); });
+
+    juce::StringArray tokens;
+    for (const float frequency: dspProcessor.getCrossoverFrequencies())
+        tokens.add(juce::String(frequency));
+    displayState.setProperty("crossoverFrequencies", tokens.joinIntoString(" "), nullptr);
+}
+
+void gFractorAudioProcessor::setCrossoverBand(const int band, const MultibandCrossover::BandSettings &settings) {
+    if (band < 0 || band >= MultibandCrossover::kMaxBands)
+        return;
+
+    forEachProcessor([band, &settings](auto &dsp) { dsp.setCrossoverBand(band, settings); });
+
+    const auto applied = dspProcessor.getCrossoverBand(band);
+    displayState.setProperty("crossoverBand" + juce::String(band),
+                             juce::String(applied.midGainDb) + " " + juce::String(applied.sideGainDb) + " "
+                             + juce::String(applied.midEnabled ? 1 : 0) + " " + juce::String(applied.sideEnabled ? 1 : 0),
+                             nullptr);
+}
+
+void gFractorAudioProcessor::setMatchEqEnabled(const bool enabled) {
+    forEachProcessor([enabled](auto &dsp) { dsp.setMatchEqEnabled(enabled); });
+    displayState.setProperty("matchEqEnabled", enabled, nullptr);
+    updateLatency();
+}
+
+void gFractorAudioProcessor::setMatchEqAmount(const float amount) {
+    forEachProcessor([amount](auto &dsp) { dsp.setMatchEqAmount(amount); });
+    displayState.setProperty("matchEqAmount", dspProcessor.getMatchEqAmount(), nullptr);
+}
+
+void gFractorAudioProcessor::setMatchEqTarget(const MatchEqualizer::Target &target) {
+    forEachProcessor([&target](auto &dsp) { dsp.setMatchEqTarget(target); });
+}
+
+void gFractorAudioProcessor::clearMatchEqTarget() {
+    forEachProcessor([](auto &dsp) { dsp.clearMatchEqTarget(); });
 }
 
 //==============================================================================
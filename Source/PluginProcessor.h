@@ -3,12 +3,14 @@
 #include <atomic>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "DSP/Core/gFractorDSP.h"
-#include "State/ParameterListener.h"
+#include "State/ParameterSnapshot.h"
 #include "DSP/Interfaces/IAudioDataSink.h"
 #include "DSP/Interfaces/IGhostDataSink.h"
 #include "DSP/Interfaces/IPeakLevelSource.h"
 #include "DSP/Monitoring/SinkRegistry.h"
 #include "DSP/Monitoring/PerformanceMonitor.h"
+#include "DSP/Processing/SidechainAligner.h"
+#include "DSP/Processing/SilenceDetector.h"
 
 /**
  * Main AudioProcessor class for the gFractor plugin
@@ -38,6 +40,11 @@ public:
     // Audio processing
     void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
 
+    void processBlock(juce::AudioBuffer<double> &, juce::MidiBuffer &) override;
+
+    // 64-bit hosts get a dedicated double engine; the analyzer still receives float
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
     //==============================================================================
     // Editor management
     juce::AudioProcessorEditor *createEditor() override;
@@ -104,6 +111,27 @@ public:
     // Band selection filter (driven by spectrum analyzer band hints click)
     void setBandFilter(bool active, float frequencyHz, float q);
 
+    //==============================================================================
+    // Band solo/mute over all analyzer bands (driven by spectrum analyzer band hints shift/alt-click)
+    void setBandSolo(juce::uint32 soloMask, juce::uint32 muteMask);
+
+    /** Engine for the three above: IIR filters, or brickwall STFT regions (reports
+     *  SpectralAudition's latency to the host while selected). */
+    void setAuditionEngine(const AuditionEngine engine) {
+        forEachProcessor([engine](auto &dsp) { dsp.setAuditionEngine(engine); });
+        displayState.setProperty("auditionEngine", auditionEngineToInt(engine), nullptr);
+        updateLatency();
+    }
+
+    /** Raised-cosine edge width of the spectral audition regions in octaves (0 = brickwall). */
+    void setSpectralAuditionEdge(const float octaves) {
+        forEachProcessor([octaves](auto &dsp) { dsp.setSpectralAuditionEdge(octaves); });
+        displayState.setProperty("spectralAuditionEdge", dspProcessor.getSpectralAuditionEdge(), nullptr);
+    }
+
+    AuditionEngine getAuditionEngine() const { return dspProcessor.getAuditionEngine(); }
+    float getSpectralAuditionEdge() const { return dspProcessor.getSpectralAuditionEdge(); }
+
     //==============================================================================
     // Reference mode: when enabled, analyzer shows sidechain input instead of main input
     void setReferenceMode(const bool enabled) { referenceMode.store(enabled); }
@@ -112,18 +140,99 @@ public:
     // Sidechain availability (updated every processBlock)
     bool isSidechainAvailable() const { return sidechainAvailable.load(); }
 
+    // Sidechain alignment: GCC-PHAT lag measurement delaying the leading analyzer feed
+    void setSidechainAlignEnabled(const bool enabled) {
+        sidechainAligner.setActive(enabled);
+        displayState.setProperty("sidechainAlign", enabled, nullptr);
+    }
+
+    bool isSidechainAlignEnabled() const { return sidechainAligner.isActive(); }
+
+    // Measured lag of the sidechain behind the main input in samples (negative: it leads)
+    int getSidechainDelaySamples() const { return sidechainAligner.getDelaySamples(); }
+
+    //==============================================================================
+    // Analyzer input on multichannel buses: one speaker pair or a stereo fold-down
+    void setAnalyzerSource(const AnalyzerSource source) {
+        sinkRegistry.setAnalyzerSource(source);
+        displayState.setProperty("analyzerSource", analyzerSourceToInt(source), nullptr);
+    }
+
+    AnalyzerSource getAnalyzerSource() const { return sinkRegistry.getAnalyzerSource(); }
+
+    //==============================================================================
+    // Silence sleep: below the threshold for the hold time, analysis and processing pause
+    void setSilenceThresholdDb(const float thresholdDb) {
+        silenceDetector.setThresholdDb(thresholdDb);
+        displayState.setProperty("silenceThresholdDb", silenceDetector.getThresholdDb(), nullptr);
+    }
+
+    void setSilenceHoldMs(const float holdMs) {
+        silenceDetector.setHoldMs(holdMs);
+        displayState.setProperty("silenceHoldMs", silenceDetector.getHoldMs(), nullptr);
+    }
+
+    float getSilenceThresholdDb() const { return silenceDetector.getThresholdDb(); }
+    float getSilenceHoldMs() const { return silenceDetector.getHoldMs(); }
+
+    // Whether the input is currently asleep (any thread)
+    bool isInputSilent() const { return silenceDetector.isSleeping(); }
+
+    // Channels on the main input bus (more than 2 for 5.1 / 7.1 / 7.1.4)
+    int getMainBusNumChannels() const { return getChannelCountOfBus(true, 0); }
+
     //==============================================================================
     // IPeakLevelSource implementation
-    float getPeakPrimaryDb() const override { return dspProcessor.getPeakPrimaryDb(); }
-    float getPeakSecondaryDb() const override { return dspProcessor.getPeakSecondaryDb(); }
+    float getPeakPrimaryDb() const override { return activePeakSource().getPeakPrimaryDb(); }
+    float getPeakSecondaryDb() const override { return activePeakSource().getPeakSecondaryDb(); }
+    float getTruePeakPrimaryDb() const override { return activePeakSource().getTruePeakPrimaryDb(); }
+    float getTruePeakSecondaryDb() const override { return activePeakSource().getTruePeakSecondaryDb(); }
+
+    // BS.1770 true-peak metering (4x oversampled, held until reset)
+    void setTruePeakEnabled(const bool enabled) {
+        forEachProcessor([enabled](auto &dsp) { dsp.setTruePeakEnabled(enabled); });
+    }
 
-    /** Set output mode: 0 = M/S, 1 = L/R, 2 = Tonal/Noise.
-     *  T/N mode introduces kFftSize samples of latency via SpectralSeparator. */
+    void resetTruePeaks() { forEachProcessor([](auto &dsp) { dsp.resetTruePeaks(); }); }
+
+    /** Set output mode: 0 = M/S, 1 = L/R, 2 = Tonal/Transient.
+     *  Tonal/Transient reports the separator's FFT size as latency to the host. */
     void setOutputMode(const ChannelMode mode) {
-        dspProcessor.setOutputMode(mode);
+        forEachProcessor([mode](auto &dsp) { dsp.setOutputMode(mode); });
         displayState.setProperty("channelMode", channelModeToInt(mode), nullptr);
+        updateLatency();
+    }
+
+    /** Tonal/Transient separator FFT size as 2^order (SpectralSeparator::kMinFftOrder..kMaxFftOrder). */
+    void setSeparatorFftOrder(const int order) {
+        forEachProcessor([order](auto &dsp) { dsp.setSeparatorFftOrder(order); });
+        displayState.setProperty("separatorFftOrder", dspProcessor.getSeparatorFftOrder(), nullptr);
+        updateLatency();
     }
 
+    int getSeparatorFftOrder() const { return dspProcessor.getSeparatorFftOrder(); }
+
+    //==============================================================================
+    // Linear-phase M/S crossover (adds MultibandCrossover latency while on)
+    void setCrossoverEnabled(bool enabled);
+    void setCrossoverFrequencies(const std::vector<float> &frequencies);
+    void setCrossoverBand(int band, const MultibandCrossover::BandSettings &settings);
+
+    bool isCrossoverEnabled() const { return dspProcessor.isCrossoverEnabled(); }
+    const std::vector<float> &getCrossoverFrequencies() const { return dspProcessor.getCrossoverFrequencies(); }
+    MultibandCrossover::BandSettings getCrossoverBand(const int band) const { return dspProcessor.getCrossoverBand(band); }
+
+    //==============================================================================
+    // Match EQ towards the analyzer's loaded target curve (adds MatchEqualizer latency while on).
+    // The target lives with the analyzer and is not saved; enable and amount are.
+    void setMatchEqEnabled(bool enabled);
+    void setMatchEqAmount(float amount);
+    void setMatchEqTarget(const MatchEqualizer::Target &target);
+    void clearMatchEqTarget();
+
+    bool isMatchEqEnabled() const { return dspProcessor.isMatchEqEnabled(); }
+    float getMatchEqAmount() const { return dspProcessor.getMatchEqAmount(); }
+    bool hasMatchEqTarget() const { return dspProcessor.hasMatchEqTarget(); }
 
     //==============================================================================
     // Performance profiling
@@ -131,24 +240,76 @@ public:
     void resetPerformanceMetrics() { perfMonitor.reset(); }
 
 private:
+    // Report the DSP latency for the current output mode to the host. Processing sleeps only
+    // after the latency plus the ring-out of digital silence, when the output is silent too.
+    void updateLatency() {
+        const bool isDouble = isUsingDoublePrecision();
+        setLatencySamples(isDouble ? dspProcessorDouble.getLatencySamples() : dspProcessor.getLatencySamples());
+        silenceDetector.setFlushSamples(isDouble ? dspProcessorDouble.getTailSamples()
+                                                 : dspProcessor.getTailSamples());
+    }
+
+    void recordBlockTime(juce::int64 startTicks, int numSamples);
+
+    template<typename SampleType>
+    void processBlockWithPrecision(juce::AudioBuffer<SampleType> &buffer);
+
+    /** Hand the block's main (and sidechain) input to the sinks, lined up when aligning. */
+    template<typename SampleType>
+    void pushToSinks(juce::AudioBuffer<SampleType> &buffer, bool hasSidechain, bool isRefMode);
+
+    /** The input bus channels as float for the sinks: the block itself, or a converted copy. */
+    juce::AudioBuffer<float> &getAnalysisInput(juce::AudioBuffer<float> &buffer) { return buffer; }
+    juce::AudioBuffer<float> &getAnalysisInput(juce::AudioBuffer<double> &buffer);
+
+    // Meters come from the engine the host is running
+    const IPeakLevelSource &activePeakSource() const {
+        if (isUsingDoublePrecision())
+            return dspProcessorDouble;
+        return dspProcessor;
+    }
+
+    template<typename Fn>
+    void forEachProcessor(Fn &&fn) {
+        fn(dspProcessor);
+        fn(dspProcessorDouble);
+    }
+
     //==============================================================================
     // Parameter state management
     juce::AudioProcessorValueTreeState apvts;
 
+    // Lock-free per-block read of the APVTS values (must follow apvts)
+    ParameterSnapshot parameterSnapshot{apvts};
+
+    // Parameter changes for the current block (audio thread only)
+    ParameterTimeline parameterTimeline;
+
     // Per-project display settings (analyzer colors, ranges, theme, etc.)
     juce::ValueTree displayState{"DisplaySettings"};
 
     //==============================================================================
-    // DSP Processor
-    gFractorDSP dspProcessor;
+    // DSP Processors. Only the one matching the host's processing precision is prepared;
+    // setters go to both so a precision switch keeps the current settings.
+    gFractorDSP<float> dspProcessor;
+    gFractorDSP<double> dspProcessorDouble;
 
-    // Parameter listener (automates sync APVTS to DSP)
-    std::unique_ptr<ParameterListener> parameterListener;
+    // Float copy of the input buses for the sinks in 64-bit mode (sized in prepareToPlay)
+    juce::AudioBuffer<float> analysisBuffer;
+    juce::AudioBuffer<float> analysisView; // refers to analysisBuffer at the block length
 
     //==============================================================================
     // Sink registry (handles audio data sinks)
     SinkRegistry sinkRegistry;
 
+    //==============================================================================
+    // Silence detection (whole input, after the reference-mode swap)
+    SilenceDetector silenceDetector;
+
+    //==============================================================================
+    // Main/sidechain lag measurement and analyzer feed alignment
+    SidechainAligner sidechainAligner;
+
     //==============================================================================
     // Performance monitoring
     PerformanceMonitor perfMonitor;
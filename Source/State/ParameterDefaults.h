@@ -41,7 +41,7 @@ namespace ParameterDefaults {
         inline const juce::String name = "Side";
     }
 
-    // Transient length (fast envelope time constant, stored in ms)
+    // Transient length (Tonal/Transient separator: shortest transient to isolate, stored in ms)
     namespace TransientLength {
         inline constexpr float minValue = 0.1f;
         inline constexpr float maxValue = 10.0f;
@@ -61,7 +61,7 @@ namespace ParameterLayout {
             ParameterDefaults::OutputSide::defaultValue
         ));
 
-        // Transient length — fast envelope time constant (1–50 ms, default 2 ms)
+        // Transient length — sets the separator's frequency median span (0.1–10 ms, default 1 ms)
         layout.add(std::make_unique<juce::AudioParameterFloat>(
             juce::ParameterID{ParameterIDs::transientLength, ParameterIDs::parameterVersion},
             ParameterDefaults::TransientLength::name,
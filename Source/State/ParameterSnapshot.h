@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "ParameterIDs.h"
+#include "../DSP/Core/DSPParameters.h"
+
+/**
+ * ParameterSnapshot
+ *
+ * Lock-free bridge from the APVTS to the DSP processor.
+ *
+ * Hosts may deliver parameter changes on any thread. Instead of pushing each change into
+ * gFractorDSP from that thread (which raced with the audio thread on smoother targets and
+ * mixer state), processBlock() pulls: read() loads every parameter's raw atomic once and
+ * returns a plain DSPParameters copy, which gFractorDSP applies on the audio thread.
+ * The APVTS atomics are the only shared state; nothing runs on the message thread per
+ * change, and state restores are picked up on the next block without extra work.
+ *
+ * Usage:
+ * @code
+ * class MyProcessor : public AudioProcessor
+ * {
+ *     void processBlock(AudioBuffer<float> &buffer, MidiBuffer &) override
+ *     {
+ *         parameterTimeline.clear();
+ *         parameterTimeline.add(0, parameterSnapshot.read());
+ *         dspProcessor.process(buffer, parameterTimeline);
+ *     }
+ *
+ *     AudioProcessorValueTreeState apvts;
+ *     ParameterSnapshot parameterSnapshot{apvts}; // declared after apvts
+ *     ParameterTimeline parameterTimeline;
+ *     gFractorDSP<float> dspProcessor;
+ * };
+ * @endcode
+ */
+class ParameterSnapshot {
+public:
+    /**
+     * Caches the raw value pointers (message thread, once). The APVTS must outlive the snapshot.
+     * @param apvts Parameter tree built from ParameterLayout
+     */
+    explicit ParameterSnapshot(const juce::AudioProcessorValueTreeState &apvts)
+        : gain(apvts.getRawParameterValue(ParameterIDs::gain)),
+          dryWet(apvts.getRawParameterValue(ParameterIDs::dryWet)),
+          bypass(apvts.getRawParameterValue(ParameterIDs::bypass)),
+          primaryEnable(apvts.getRawParameterValue(ParameterIDs::outputPrimaryEnable)),
+          secondaryEnable(apvts.getRawParameterValue(ParameterIDs::outputSecondaryEnable)),
+          transientLength(apvts.getRawParameterValue(ParameterIDs::transientLength)) {
+        jassert(gain != nullptr && dryWet != nullptr && bypass != nullptr
+            && primaryEnable != nullptr && secondaryEnable != nullptr && transientLength != nullptr);
+    }
+
+    /** Current parameter values in DSP units (audio thread; lock-free, no allocation). */
+    DSPParameters read() const noexcept {
+        DSPParameters parameters;
+        parameters.gainDb = load(gain, parameters.gainDb);
+        parameters.dryWet = load(dryWet, parameters.dryWet * 100.0f) / 100.0f;
+        parameters.bypassed = load(bypass, 0.0f) > 0.5f;
+        parameters.primaryEnabled = load(primaryEnable, 1.0f) > 0.5f;
+        parameters.secondaryEnabled = load(secondaryEnable, 1.0f) > 0.5f;
+        parameters.transientLengthMs = load(transientLength, parameters.transientLengthMs);
+        return parameters;
+    }
+
+private:
+    static float load(const std::atomic<float> *value, const float fallback) noexcept {
+        return value != nullptr ? value->load(std::memory_order_relaxed) : fallback;
+    }
+
+    const std::atomic<float> *gain;
+    const std::atomic<float> *dryWet;
+    const std::atomic<float> *bypass;
+    const std::atomic<float> *primaryEnable;
+    const std::atomic<float> *secondaryEnable;
+    const std::atomic<float> *transientLength;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSnapshot)
+};
@@ -45,6 +45,13 @@ FooterBar::FooterBar(gFractorAudioProcessor &processor,
     };
     addAndMakeVisible(modePill);
 
+    // Analyzer source dropdown — only offered on 5.1 / 7.1 / 7.1.4 buses
+    sourcePill.setSelectedIndex(analyzerSourceToInt(processorRef.getAnalyzerSource()));
+    sourcePill.onChange = [this](const int index) {
+        processorRef.setAnalyzerSource(analyzerSourceFromInt(index));
+    };
+    addChildComponent(sourcePill);
+
     // Primary pill — APVTS-bound
     primaryPill.attachToParameter(processorRef.getAPVTS(), "outputPrimaryEnable");
     primaryPill.setLeftIcon(dotSvg, false, Layout::PillButton::dotIconSize);
@@ -127,6 +134,13 @@ FooterBar::FooterBar(gFractorAudioProcessor &processor,
     };
     addAndMakeVisible(targetPill);
 
+    // Match pill — match EQ towards the loaded target curve (processor state, saved with the project)
+    matchPill.setToggleState(processorRef.isMatchEqEnabled(), juce::dontSendNotification);
+    matchPill.onClick = [this] {
+        processorRef.setMatchEqEnabled(matchPill.getToggleState());
+    };
+    addAndMakeVisible(matchPill);
+
     applyTheme();
 
 }
@@ -145,6 +159,7 @@ void FooterBar::applyTheme() {
     referencePill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
     ghostPill.setActiveColour(juce::Colour(ColorPalette::refPrimaryBlue));
     modePill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
+    sourcePill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
     primaryPill.setActiveColour(juce::Colour(ColorPalette::primaryGreen));
     secondaryPill.setActiveColour(juce::Colour(ColorPalette::secondaryAmber));
     freezePill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
@@ -152,6 +167,7 @@ void FooterBar::applyTheme() {
     saveTargetPill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
     loadTargetPill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
     targetPill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
+    matchPill.setActiveColour(juce::Colour(ColorPalette::blueAccent));
     metersPill.setActiveColour(juce::Colour(ColorPalette::primaryGreen));
     repaint();
 }
@@ -176,6 +192,14 @@ void FooterBar::resized() {
     fb.items.add(Item().withWidth(gs).withHeight(ph));
     fb.items.add(Item(secondaryPill).withWidth(bw).withHeight(ph));
     fb.items.add(Item().withWidth(gs).withHeight(ph));
+
+    // ── [Source ▾] — multichannel buses only ─────────────────────────────────
+    sourcePill.setVisible(processorRef.getMainBusNumChannels() > 2);
+    if (sourcePill.isVisible()) {
+        fb.items.add(Item(sourcePill).withWidth(bw).withHeight(ph));
+        fb.items.add(Item().withWidth(gs).withHeight(ph));
+    }
+
     fb.items.add(Item(refDivider).withWidth(gl).withHeight(ph));
     fb.items.add(Item().withWidth(gs).withHeight(ph));
 
@@ -200,6 +224,8 @@ void FooterBar::resized() {
     fb.items.add(Item(loadTargetPill).withWidth(bw).withHeight(ph));
     fb.items.add(Item().withWidth(gs).withHeight(ph));
     fb.items.add(Item(targetPill).withWidth(bww).withHeight(ph));
+    fb.items.add(Item().withWidth(gs).withHeight(ph));
+    fb.items.add(Item(matchPill).withWidth(bw).withHeight(ph));
 
     // Spacer — pushes Meters + Settings to the right
     fb.items.add(Item().withFlex(1.0f));
@@ -220,11 +246,12 @@ void FooterBar::setHintManager(HintManager &hm) {
     Component *pills[] = {
         &referencePill, &ghostPill, &primaryPill,
         &secondaryPill, &freezePill, &infinitePill,
-        &saveTargetPill, &loadTargetPill, &targetPill, &metersPill
+        &saveTargetPill, &loadTargetPill, &targetPill, &matchPill, &metersPill
     };
     for (auto *c: pills)
         c->addMouseListener(this, false);
     modePill.addMouseListener(this, false);
+    sourcePill.addMouseListener(this, false);
 }
 
 void FooterBar::mouseEnter(const juce::MouseEvent &e) {
@@ -242,6 +269,9 @@ void FooterBar::mouseEnter(const juce::MouseEvent &e) {
     } else if (c == &modePill) {
         title = "CLICK | KEY Tab";
         hint = "M/S  |  L/R  |  Transient";
+    } else if (c == &sourcePill) {
+        title = "CLICK";
+        hint = "Analyzer input: fold-down or speaker pair";
     } else if (c == &primaryPill) {
         title = "CLICK | KEY 1";
         hint = "Show / hide Ch1 spectrum";
@@ -263,6 +293,9 @@ void FooterBar::mouseEnter(const juce::MouseEvent &e) {
     } else if (c == &targetPill) {
         title = "CLICK | KEY T";
         hint = "Show / hide target curve";
+    } else if (c == &matchPill) {
+        title = "CLICK";
+        hint = "Match EQ towards the loaded target curve";
     } else if (c == &metersPill) {
         title = "CLICK";
         hint = "Stereo metering panel";
@@ -49,6 +49,7 @@ public:
     ToggleButton &getGhostPill() { return ghostPill; }
     ToggleButton &getInfinitePill() { return infinitePill; }
     ToggleButton &getTargetPill() { return targetPill; }
+    ToggleButton &getMatchPill() { return matchPill; }
     DropdownPill &getModePill() { return modePill; }
 
     /** Left margin from SpectrumAnalyzer — used for button alignment. */
@@ -60,6 +61,7 @@ private:
 
     // Left group — pill buttons
     DropdownPill modePill{ButtonCaptions::channelModeOptions, juce::Colour(ColorPalette::blueAccent)};
+    DropdownPill sourcePill{ButtonCaptions::analyzerSourceOptions, juce::Colour(ColorPalette::blueAccent)};
     ToggleButton primaryPill{ButtonCaptions::primary, juce::Colour(ColorPalette::primaryGreen)};
     ToggleButton secondaryPill{ButtonCaptions::secondary, juce::Colour(ColorPalette::secondaryAmber)};
     VerticalDivider refDivider;
@@ -72,6 +74,7 @@ private:
     ToggleButton targetPill{ButtonCaptions::target, juce::Colour(ColorPalette::blueAccent)};
     ToggleButton loadTargetPill{ButtonCaptions::loadTarget, juce::Colour(ColorPalette::blueAccent)};
     ToggleButton saveTargetPill{ButtonCaptions::saveTarget, juce::Colour(ColorPalette::blueAccent)};
+    ToggleButton matchPill{ButtonCaptions::match, juce::Colour(ColorPalette::blueAccent)};
     ToggleButton metersPill{ButtonCaptions::meters, juce::Colour(ColorPalette::primaryGreen)};
 
     // Mouse listener overrides — receive forwarded events from pill children
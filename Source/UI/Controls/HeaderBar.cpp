@@ -15,6 +15,12 @@ HeaderBar::HeaderBar(std::function<void()> settingsCallback) {
 
     addAndMakeVisible(settingsDivider);
 
+    // Processing button - non-toggle, opens the processing panel
+    processingPill.setClickingTogglesState(false);
+    processingPill.setToggleState(false, juce::dontSendNotification);
+    processingPill.onClick = [this] { if (onProcessing) onProcessing(); };
+    addAndMakeVisible(processingPill);
+
     // Settings button - non-toggle
     settingsPill.setIcon(Icons::settings);
     settingsPill.setClickingTogglesState(false);
@@ -40,6 +46,7 @@ void HeaderBar::paint(juce::Graphics &g) {
 void HeaderBar::setHintManager(HintManager &hm) {
     hints = &hm;
     presetPill.addMouseListener(this, false);
+    processingPill.addMouseListener(this, false);
     settingsPill.addMouseListener(this, false);
     helpPill.addMouseListener(this, false);
 }
@@ -64,6 +71,8 @@ void HeaderBar::mouseEnter(const juce::MouseEvent &e) {
 
     if (e.eventComponent == &presetPill)
         hintHandle = hints->setHint("CLICK", "Preset menu");
+    else if (e.eventComponent == &processingPill)
+        hintHandle = hints->setHint("CLICK", "Processing settings");
     else if (e.eventComponent == &settingsPill)
         hintHandle = hints->setHint("CLICK", "Analyzer settings");
     else if (e.eventComponent == &helpPill)
@@ -182,6 +191,8 @@ void HeaderBar::resized() {
     fb.items.add(Item(logo).withFlex(1.0f).withHeight(bs));
     fb.items.add(Item(presetPill).withWidth(presetW).withHeight(bs));
     fb.items.add(Item(settingsDivider).withWidth(static_cast<float>(Spacing::gapL)).withHeight(bs));
+    fb.items.add(Item(processingPill).withWidth(Layout::PillButton::buttonWidth).withHeight(bs));
+    fb.items.add(Item().withWidth(Spacing::gapM).withHeight(bs));
     fb.items.add(Item(settingsPill).withWidth(bs).withHeight(bs));
     fb.items.add(Item().withWidth(Spacing::gapM).withHeight(bs));
     fb.items.add(Item(helpPill).withWidth(bs).withHeight(bs));
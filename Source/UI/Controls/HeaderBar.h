@@ -14,7 +14,7 @@
  * 30px tall header strip containing:
  * - Logo ("g" in teal + "Fractor" in white bold italic)
  * - Preset selector pill (name + dirty indicator, click for popup menu)
- * - Right: Settings and Help buttons
+ * - Right: DSP, Settings and Help buttons
  *
  * The Help button shows a popup menu with About, Check for Updates, and Manual items.
  */
@@ -43,6 +43,9 @@ public:
     /** Called when the user selects "Save Preset..." — PluginEditor shows the naming dialog. */
     std::function<void()> onSavePreset;
 
+    /** Called by the DSP button — PluginEditor toggles the processing panel. */
+    std::function<void()> onProcessing;
+
 private:
     void mouseEnter(const juce::MouseEvent &e) override;
 
@@ -59,6 +62,7 @@ private:
     Logo logo;
     PillButton presetPill { "Init", juce::Colour(ColorPalette::textDimmed) };
     VerticalDivider settingsDivider;
+    PillButton processingPill { ButtonCaptions::processing, juce::Colour(ColorPalette::textDimmed) };
     PillButton settingsPill { ButtonCaptions::settings, juce::Colour(ColorPalette::textDimmed) };
     PillButton helpPill { ButtonCaptions::help, juce::Colour(ColorPalette::textDimmed) };
 
@@ -17,6 +17,8 @@
  * - Maximum processing time (ms)
  * - Average CPU load (%)
  * - Sample count (total blocks processed)
+ * - Per audio-to-UI FIFO (the L/R, M/S and mono main buses, ghost): peak fill, overruns and
+ *   samples lost to the writer
  *
  * Usage:
  * @code
@@ -82,6 +84,15 @@ public:
         g.drawText(juce::String::formatted("CPU: %.1f%%", cpuLoad),
                    bounds.withHeight(lineHeight).withY(y),
                    juce::Justification::centredLeft);
+        y += lineHeight;
+
+        // FIFOs: any overrun means a display showed gapped data
+        static constexpr const char *mainNames[] = {"L/R", "M/S", "Mono"};
+        for (size_t bus = 0; bus < metrics.mainFifos.size(); ++bus) {
+            drawFifo(g, mainNames[bus], metrics.mainFifos[bus], bounds.withHeight(lineHeight).withY(y));
+            y += lineHeight;
+        }
+        drawFifo(g, "Ghost", metrics.ghostFifo, bounds.withHeight(lineHeight).withY(y));
     }
 
     void mouseDown(const juce::MouseEvent &) override {
@@ -93,6 +104,22 @@ public:
     }
 
 private:
+    static void drawFifo(juce::Graphics &g, const char *name, const PerformanceMonitor::FifoMetrics &fifo,
+                         const juce::Rectangle<int> line) {
+        const int capacity = fifo.capacity.load(std::memory_order_relaxed);
+        const int fillPercent = capacity > 0
+                                    ? fifo.highWaterMark.load(std::memory_order_relaxed) * 100 / capacity
+                                    : 0;
+        const int overruns = fifo.overruns.load(std::memory_order_relaxed);
+        const auto dropped = fifo.droppedSamples.load(std::memory_order_relaxed);
+
+        g.setColour(overruns > 0 ? juce::Colours::red : juce::Colours::lightgreen);
+        // "M/S: 37%  ovr 2 (1024)": peak fill, overruns (samples lost)
+        g.drawText(juce::String::formatted("%s: %d%%  ovr %d (%llu)", name, fillPercent, overruns,
+                                           static_cast<unsigned long long>(dropped)),
+                   line, juce::Justification::centredLeft);
+    }
+
     void timerCallback() override {
         // Trigger repaint to update display
         repaint();
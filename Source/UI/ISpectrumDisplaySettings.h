@@ -61,6 +61,11 @@ struct IFftSettings {
     virtual void setSlope(float db) = 0;
 
     virtual float getSlope() const = 0;
+
+    /** Decimate 88.2 kHz and faster input towards 48 kHz when the visible range allows. */
+    virtual void setHighRateDecimation(bool enabled) = 0;
+
+    virtual bool getHighRateDecimation() const = 0;
 };
 
 struct ISpectrumDisplaySettings : IRangeSettings, IColorSettings, IFftSettings {
@@ -0,0 +1,333 @@
+#include "ProcessingPanel.h"
+
+#include <cmath>
+
+#include "../../PluginProcessor.h"
+#include "../Theme/Typography.h"
+#include "../Theme/UILabels.h"
+
+//==============================================================================
+ProcessingPanel::ProcessingPanel(gFractorAudioProcessor &processor)
+    : processorRef(processor) {
+    constexpr auto textBoxWidth = Layout::ProcessingPanel::textBoxWidth;
+    setOpaque(true);
+
+    // --- Sidechain alignment toggle ---
+    addAndMakeVisible(alignToggle);
+    alignToggle.setToggleState(processorRef.isSidechainAlignEnabled(), juce::dontSendNotification);
+    alignToggle.onClick = [this] {
+        processorRef.setSidechainAlignEnabled(alignToggle.getToggleState());
+    };
+
+    addAndMakeVisible(alignLabel);
+    alignLabel.setText("SC Align", juce::dontSendNotification);
+    alignLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Audition engine combo box (ids are auditionEngineToInt() + 1) ---
+    addAndMakeVisible(auditionCombo);
+    auditionCombo.addItem("Filter", 1);
+    auditionCombo.addItem("Spectral", 2);
+    auditionCombo.setSelectedId(auditionEngineToInt(processorRef.getAuditionEngine()) + 1,
+                                juce::dontSendNotification);
+    auditionCombo.onChange = [this] {
+        const auto engine = auditionEngineFromInt(auditionCombo.getSelectedId() - 1);
+        processorRef.setAuditionEngine(engine);
+        auditionEdgeSlider.setEnabled(engine == AuditionEngine::Spectral);
+    };
+
+    addAndMakeVisible(auditionLabel);
+    auditionLabel.setText("Audition", juce::dontSendNotification);
+    auditionLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Spectral audition edge slider (only used by the spectral engine) ---
+    addAndMakeVisible(auditionEdgeSlider);
+    auditionEdgeSlider.setRange(0.0, SpectralAudition::kMaxEdgeOctaves, 0.01);
+    auditionEdgeSlider.setValue(processorRef.getSpectralAuditionEdge(), juce::dontSendNotification);
+    auditionEdgeSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, 24);
+    auditionEdgeSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    auditionEdgeSlider.setTextValueSuffix(" oct");
+    auditionEdgeSlider.setEnabled(processorRef.getAuditionEngine() == AuditionEngine::Spectral);
+    auditionEdgeSlider.onValueChange = [this] {
+        processorRef.setSpectralAuditionEdge(static_cast<float>(auditionEdgeSlider.getValue()));
+    };
+
+    addAndMakeVisible(auditionEdgeLabel);
+    auditionEdgeLabel.setText("Edge", juce::dontSendNotification);
+    auditionEdgeLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Separator FFT size combo box (ids are order - kMinFftOrder + 1) ---
+    addAndMakeVisible(separatorFftCombo);
+    for (int order = SpectralSeparator::kMinFftOrder; order <= SpectralSeparator::kMaxFftOrder; ++order)
+        separatorFftCombo.addItem(juce::String(1 << order), order - SpectralSeparator::kMinFftOrder + 1);
+    separatorFftCombo.setSelectedId(processorRef.getSeparatorFftOrder() - SpectralSeparator::kMinFftOrder + 1,
+                                    juce::dontSendNotification);
+    separatorFftCombo.onChange = [this] {
+        processorRef.setSeparatorFftOrder(separatorFftCombo.getSelectedId() - 1 + SpectralSeparator::kMinFftOrder);
+    };
+
+    addAndMakeVisible(separatorFftLabel);
+    separatorFftLabel.setText("TRN FFT", juce::dontSendNotification);
+    separatorFftLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Silence sleep sliders ---
+    addAndMakeVisible(silenceThresholdSlider);
+    silenceThresholdSlider.setRange(SilenceDetector::kMinThresholdDb, SilenceDetector::kMaxThresholdDb, 1.0);
+    silenceThresholdSlider.setValue(processorRef.getSilenceThresholdDb(), juce::dontSendNotification);
+    silenceThresholdSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, 24);
+    silenceThresholdSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    silenceThresholdSlider.setTextValueSuffix(" dB");
+    silenceThresholdSlider.onValueChange = [this] {
+        processorRef.setSilenceThresholdDb(static_cast<float>(silenceThresholdSlider.getValue()));
+    };
+
+    addAndMakeVisible(silenceHoldSlider);
+    silenceHoldSlider.setRange(SilenceDetector::kMinHoldMs, SilenceDetector::kMaxHoldMs, 10.0);
+    silenceHoldSlider.setSkewFactorFromMidPoint(1000.0);
+    silenceHoldSlider.setValue(processorRef.getSilenceHoldMs(), juce::dontSendNotification);
+    silenceHoldSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, 24);
+    silenceHoldSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    silenceHoldSlider.setTextValueSuffix(" ms");
+    silenceHoldSlider.onValueChange = [this] {
+        processorRef.setSilenceHoldMs(static_cast<float>(silenceHoldSlider.getValue()));
+    };
+
+    addAndMakeVisible(silenceThresholdLabel);
+    silenceThresholdLabel.setText("Sleep dB", juce::dontSendNotification);
+    silenceThresholdLabel.setJustificationType(juce::Justification::centredRight);
+
+    addAndMakeVisible(silenceHoldLabel);
+    silenceHoldLabel.setText("Sleep Hold", juce::dontSendNotification);
+    silenceHoldLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Crossover toggle ---
+    addAndMakeVisible(crossoverToggle);
+    crossoverToggle.setToggleState(processorRef.isCrossoverEnabled(), juce::dontSendNotification);
+    crossoverToggle.onClick = [this] {
+        processorRef.setCrossoverEnabled(crossoverToggle.getToggleState());
+    };
+
+    addAndMakeVisible(crossoverLabel);
+    crossoverLabel.setText("Crossover", juce::dontSendNotification);
+    crossoverLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Band count combo box (ids are the band count) ---
+    addAndMakeVisible(bandCountCombo);
+    for (int bands = 2; bands <= MultibandCrossover::kMaxBands; ++bands)
+        bandCountCombo.addItem(juce::String(bands), bands);
+    bandCountCombo.setSelectedId(static_cast<int>(processorRef.getCrossoverFrequencies().size()) + 1,
+                                 juce::dontSendNotification);
+    bandCountCombo.onChange = [this] { setBandCount(bandCountCombo.getSelectedId()); };
+
+    addAndMakeVisible(bandCountLabel);
+    bandCountLabel.setText("Bands", juce::dontSendNotification);
+    bandCountLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Band selector (ids are band + 1) ---
+    addAndMakeVisible(bandCombo);
+    bandCombo.onChange = [this] { showSelectedBand(); };
+
+    addAndMakeVisible(bandLabel);
+    bandLabel.setText("Band", juce::dontSendNotification);
+    bandLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Split frequency above the selected band ---
+    addAndMakeVisible(splitSlider);
+    splitSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, 24);
+    splitSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    splitSlider.setTextValueSuffix(" Hz");
+    splitSlider.onValueChange = [this] {
+        auto frequencies = processorRef.getCrossoverFrequencies();
+        const auto band = static_cast<size_t>(getSelectedBand());
+        if (band < frequencies.size()) {
+            frequencies[band] = static_cast<float>(splitSlider.getValue());
+            processorRef.setCrossoverFrequencies(frequencies);
+        }
+    };
+
+    addAndMakeVisible(splitLabel);
+    splitLabel.setText("Split", juce::dontSendNotification);
+    splitLabel.setJustificationType(juce::Justification::centredRight);
+
+    // --- Mid / side enables and gains of the selected band ---
+    for (auto *slider : { &midGainSlider, &sideGainSlider }) {
+        addAndMakeVisible(*slider);
+        slider->setRange(MultibandCrossover::kMinGainDb, MultibandCrossover::kMaxGainDb, 0.1);
+        slider->setDoubleClickReturnValue(true, 0.0);
+        slider->setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, 24);
+        slider->setSliderStyle(juce::Slider::LinearHorizontal);
+        slider->setTextValueSuffix(" dB");
+        slider->onValueChange = [this] { applySelectedBand(); };
+    }
+
+    for (auto *toggle : { &midToggle, &sideToggle }) {
+        addAndMakeVisible(*toggle);
+        toggle->onClick = [this] { applySelectedBand(); };
+    }
+
+    addAndMakeVisible(midLabel);
+    midLabel.setText("Mid", juce::dontSendNotification);
+    midLabel.setJustificationType(juce::Justification::centredRight);
+
+    addAndMakeVisible(sideLabel);
+    sideLabel.setText("Side", juce::dontSendNotification);
+    sideLabel.setJustificationType(juce::Justification::centredRight);
+
+    updateBandCombo();
+
+    applyThemeColours();
+}
+
+//==============================================================================
+void ProcessingPanel::applyThemeColours() {
+    const auto textColour = juce::Colour(ColorPalette::textBright);
+    const auto panelFont  = Typography::makeFont(Typography::mainFontSize);
+
+    for (auto *label : { &alignLabel, &auditionLabel, &auditionEdgeLabel, &separatorFftLabel,
+                         &silenceThresholdLabel, &silenceHoldLabel, &crossoverLabel, &bandCountLabel,
+                         &bandLabel, &splitLabel, &midLabel, &sideLabel }) {
+        label->setFont(panelFont);
+        label->setMinimumHorizontalScale(1.0f);
+        label->setColour(juce::Label::textColourId, textColour);
+    }
+
+    const auto panelColour = juce::Colour(ColorPalette::panel);
+    for (auto *combo : { &auditionCombo, &separatorFftCombo, &bandCountCombo, &bandCombo }) {
+        combo->setColour(juce::ComboBox::textColourId,       textColour);
+        combo->setColour(juce::ComboBox::backgroundColourId, panelColour);
+        combo->setColour(juce::ComboBox::arrowColourId,      textColour);
+        combo->setColour(juce::ComboBox::outlineColourId,    juce::Colours::transparentBlack);
+    }
+
+    for (auto *slider : { &auditionEdgeSlider, &silenceThresholdSlider, &silenceHoldSlider,
+                          &splitSlider, &midGainSlider, &sideGainSlider }) {
+        slider->setColour(juce::Slider::textBoxTextColourId,       textColour);
+        slider->setColour(juce::Slider::textBoxBackgroundColourId, panelColour);
+        slider->setColour(juce::Slider::textBoxOutlineColourId,    juce::Colours::transparentBlack);
+    }
+
+    for (auto *toggle : { &alignToggle, &crossoverToggle })
+        toggle->setActiveColour(juce::Colour(ColorPalette::blueAccent));
+    midToggle.setActiveColour(juce::Colour(ColorPalette::primaryGreen));
+    sideToggle.setActiveColour(juce::Colour(ColorPalette::secondaryAmber));
+}
+
+//==============================================================================
+void ProcessingPanel::paint(juce::Graphics &g) {
+    g.fillAll(juce::Colour(ColorPalette::panel));
+
+    // Section header
+    g.setColour(juce::Colour(ColorPalette::panelHeading));
+    g.setFont(Typography::makeBoldFont(Typography::mainFontSize));
+    g.drawText(UILabels::Panels::processing,
+               getLocalBounds().removeFromTop(Layout::ProcessingPanel::headerHeight),
+               juce::Justification::centred);
+}
+
+void ProcessingPanel::resized() {
+    auto bounds = getLocalBounds().reduced(Spacing::paddingM);
+
+    bounds.removeFromTop(Layout::ProcessingPanel::headerHeight); // header
+    bounds.removeFromRight(Spacing::gapM); // right spacing
+
+    constexpr int labelW = Layout::ProcessingPanel::labelColumnWidth;
+    auto layoutRow = [&](juce::Label &label, Component &control, const int controlW = 0) {
+        auto row = bounds.removeFromTop(Layout::ProcessingPanel::rowHeight);
+        label.setBounds(row.removeFromLeft(labelW));
+        row.removeFromLeft(Spacing::gapS);
+        control.setBounds(controlW > 0 ? row.removeFromLeft(controlW) : row);
+        bounds.removeFromTop(Spacing::gapS); // spacing
+    };
+
+    layoutRow(alignLabel, alignToggle, Layout::PillButton::buttonWidth);
+    layoutRow(auditionLabel, auditionCombo);
+    layoutRow(auditionEdgeLabel, auditionEdgeSlider);
+    layoutRow(separatorFftLabel, separatorFftCombo);
+    layoutRow(silenceThresholdLabel, silenceThresholdSlider);
+    layoutRow(silenceHoldLabel, silenceHoldSlider);
+    layoutRow(crossoverLabel, crossoverToggle, Layout::PillButton::buttonWidth);
+    layoutRow(bandCountLabel, bandCountCombo);
+    layoutRow(bandLabel, bandCombo);
+    layoutRow(splitLabel, splitSlider);
+
+    // Band enable + gain rows
+    auto layoutBandRow = [&](juce::Label &label, ToggleButton &toggle, juce::Slider &gain) {
+        auto row = bounds.removeFromTop(Layout::ProcessingPanel::rowHeight);
+        label.setBounds(row.removeFromLeft(labelW));
+        row.removeFromLeft(Spacing::gapS);
+        toggle.setBounds(row.removeFromLeft(Layout::PillButton::buttonWidth));
+        row.removeFromLeft(Spacing::gapS);
+        gain.setBounds(row);
+        bounds.removeFromTop(Spacing::gapS); // spacing
+    };
+
+    layoutBandRow(midLabel, midToggle, midGainSlider);
+    layoutBandRow(sideLabel, sideToggle, sideGainSlider);
+}
+
+void ProcessingPanel::close() {
+    if (onClose) onClose();
+}
+
+//==============================================================================
+// Crossover bands
+
+void ProcessingPanel::setBandCount(const int numBands) {
+    auto frequencies = processorRef.getCrossoverFrequencies();
+    const auto numSplits = static_cast<size_t>(numBands - 1);
+
+    while (frequencies.size() > numSplits)
+        frequencies.pop_back();
+
+    // New bands split the top band geometrically
+    while (frequencies.size() < numSplits) {
+        const float below = frequencies.empty() ? MultibandCrossover::kMinFrequency : frequencies.back();
+        frequencies.push_back(std::sqrt(below * MultibandCrossover::kMaxFrequency));
+    }
+
+    processorRef.setCrossoverFrequencies(frequencies);
+    updateBandCombo();
+}
+
+void ProcessingPanel::updateBandCombo() {
+    const int numBands = static_cast<int>(processorRef.getCrossoverFrequencies().size()) + 1;
+    const int selected = juce::jlimit(1, numBands, bandCombo.getSelectedId());
+
+    bandCombo.clear(juce::dontSendNotification);
+    for (int band = 0; band < numBands; ++band)
+        bandCombo.addItem(juce::String(band + 1), band + 1);
+    bandCombo.setSelectedId(selected, juce::dontSendNotification);
+
+    showSelectedBand();
+}
+
+void ProcessingPanel::showSelectedBand() {
+    const auto &frequencies = processorRef.getCrossoverFrequencies();
+    const int band = getSelectedBand();
+    const auto numSplits = static_cast<int>(frequencies.size());
+
+    // The split stays between its neighbours, so moving it never reorders the bands
+    const auto split = static_cast<size_t>(band);
+    const double low = band > 0 ? frequencies[split - 1] : MultibandCrossover::kMinFrequency;
+    const double high = band + 1 < numSplits ? frequencies[split + 1] : MultibandCrossover::kMaxFrequency;
+    const bool movable = band < numSplits && high > low;
+
+    splitSlider.setEnabled(movable);
+    if (movable) {
+        splitSlider.setRange(low, high, 1.0);
+        splitSlider.setSkewFactorFromMidPoint(std::sqrt(low * high));
+        splitSlider.setValue(frequencies[split], juce::dontSendNotification);
+    }
+
+    const auto settings = processorRef.getCrossoverBand(band);
+    midToggle.setToggleState(settings.midEnabled, juce::dontSendNotification);
+    sideToggle.setToggleState(settings.sideEnabled, juce::dontSendNotification);
+    midGainSlider.setValue(settings.midGainDb, juce::dontSendNotification);
+    sideGainSlider.setValue(settings.sideGainDb, juce::dontSendNotification);
+}
+
+void ProcessingPanel::applySelectedBand() {
+    processorRef.setCrossoverBand(getSelectedBand(),
+                                  {static_cast<float>(midGainSlider.getValue()),
+                                   static_cast<float>(sideGainSlider.getValue()),
+                                   midToggle.getToggleState(), sideToggle.getToggleState()});
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <functional>
+#include "../Theme/ButtonCaptions.h"
+#include "../Theme/ColorPalette.h"
+#include "../Theme/LayoutConstants.h"
+#include "../Theme/Spacing.h"
+#include "Controls/Buttons/ToggleButton.h"
+
+class gFractorAudioProcessor;
+
+/**
+ * ProcessingPanel
+ *
+ * Overlay panel for the processor's audio settings:
+ * - Sidechain alignment
+ * - Audition engine (band hints and right-click audition) and the spectral engine's edge width
+ * - Tonal/Transient separator FFT size
+ * - Silence sleep threshold and hold time
+ * - M/S crossover: on/off, band count, and per band its upper split frequency and mid/side
+ *   enables and gains (one band at a time, picked in the Band combo)
+ *
+ * Unlike the PreferencePanel these are processor state, saved with the project, so every
+ * change applies at once and there is nothing to save or revert. Closed by a backdrop
+ * click, Esc or the header's DSP button.
+ */
+class ProcessingPanel : public juce::Component {
+public:
+    explicit ProcessingPanel(gFractorAudioProcessor &processor);
+
+    void paint(juce::Graphics &g) override;
+
+    void resized() override;
+
+    static constexpr int numRows = 12;
+    static constexpr int panelWidth = Layout::ProcessingPanel::panelWidth;
+    static constexpr int panelHeight = Layout::ProcessingPanel::headerHeight + 2 * Spacing::paddingM
+                                       + numRows * (Layout::ProcessingPanel::rowHeight + Spacing::gapS);
+
+    /** Called when the panel should close (set by PluginEditor) */
+    std::function<void()> onClose;
+
+    void close();
+
+private:
+    gFractorAudioProcessor &processorRef;
+
+    ToggleButton alignToggle{ButtonCaptions::on, juce::Colour(ColorPalette::blueAccent)};
+    juce::Label alignLabel;
+
+    juce::ComboBox auditionCombo;
+    juce::Label auditionLabel;
+
+    juce::Slider auditionEdgeSlider;
+    juce::Label auditionEdgeLabel;
+
+    juce::ComboBox separatorFftCombo;
+    juce::Label separatorFftLabel;
+
+    juce::Slider silenceThresholdSlider, silenceHoldSlider;
+    juce::Label silenceThresholdLabel, silenceHoldLabel;
+
+    ToggleButton crossoverToggle{ButtonCaptions::on, juce::Colour(ColorPalette::blueAccent)};
+    juce::Label crossoverLabel;
+
+    juce::ComboBox bandCountCombo, bandCombo;
+    juce::Label bandCountLabel, bandLabel;
+
+    juce::Slider splitSlider;
+    juce::Label splitLabel;
+
+    ToggleButton midToggle{ButtonCaptions::on, juce::Colour(ColorPalette::primaryGreen)};
+    ToggleButton sideToggle{ButtonCaptions::on, juce::Colour(ColorPalette::secondaryAmber)};
+    juce::Slider midGainSlider, sideGainSlider;
+    juce::Label midLabel, sideLabel;
+
+    /** Keep the lowest numBands - 1 split frequencies, adding new ones above the top split. */
+    void setBandCount(int numBands);
+
+    /** Refill the Band combo for the current band count, keeping the selection where possible. */
+    void updateBandCombo();
+
+    /** Load the selected band's split frequency and settings into the controls. */
+    void showSelectedBand();
+
+    /** Apply the mid/side controls to the selected band. */
+    void applySelectedBand();
+
+    int getSelectedBand() const { return bandCombo.getSelectedId() - 1; }
+
+    void applyThemeColours();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessingPanel)
+};
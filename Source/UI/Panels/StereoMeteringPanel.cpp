@@ -29,18 +29,35 @@ void StereoMeteringPanel::setHintManager(HintManager& hm) {
     hints = &hm;
 }
 
+void StereoMeteringPanel::setPeakLevelSource(const IPeakLevelSource *source) {
+    peakSource = source;
+    updateTruePeaks();
+    requestRepaint();
+}
+
 void StereoMeteringPanel::mouseEnter(const juce::MouseEvent& /*e*/) {
     if (hints)
-        hintHandle = hints->setHint("DRAG", "Divider to resize  |  Goniometer  |  Correlation  |  Width");
+        hintHandle = hints->setHint("DRAG", "Divider to resize  |  Goniometer  |  Correlation  |  Width"
+                                            "  |  Click true peak to reset");
 }
 
 void StereoMeteringPanel::mouseExit(const juce::MouseEvent& /*e*/) {
     hintHandle = {};
 }
 
+void StereoMeteringPanel::mouseDown(const juce::MouseEvent& e) {
+    if (!truePeakArea.contains(e.getPosition())) return;
+
+    if (onTruePeakReset)
+        onTruePeakReset();
+    updateTruePeaks();
+    requestRepaint();
+}
+
 //==============================================================================
 void StereoMeteringPanel::processDrainedData(const int numNewSamples) {
     if (numNewSamples == 0) return;
+    silentFrames = 0;
     updateGoniometerImage();
 
     // Smoothed correlation
@@ -48,6 +65,21 @@ void StereoMeteringPanel::processDrainedData(const int numNewSamples) {
     correlationDisplay = correlationDisplay * 0.85f + raw * 0.15f;
 
     computeWidthPerOctave();
+    updateTruePeaks();
+}
+
+bool StereoMeteringPanel::decayTowardsSilence(int) {
+    // Nothing new to plot: let the trace fade out and the correlation settle where silence reads (0)
+    fadeGoniometerImage();
+    correlationDisplay *= 0.85f;
+    updateTruePeaks();
+
+    return ++silentFrames < kSilentFadeFrames;
+}
+
+void StereoMeteringPanel::updateTruePeaks() {
+    truePeakPrimaryDb = peakSource != nullptr ? peakSource->getTruePeakPrimaryDb() : -100.0f;
+    truePeakSecondaryDb = peakSource != nullptr ? peakSource->getTruePeakSecondaryDb() : -100.0f;
 }
 
 //==============================================================================
@@ -61,12 +93,7 @@ void StereoMeteringPanel::updateGoniometerImage() const {
         gonioImageBgArgb = gonioBg.getARGB();
     }
 
-    // Fade existing image towards current theme background
-    {
-        juce::Graphics gc(gonioImage);
-        gc.setColour(gonioBg.withAlpha(0.15f));
-        gc.fillAll();
-    }
+    fadeGoniometerImage();
 
     const int imgW = gonioImage.getWidth();
     const int imgH = gonioImage.getHeight();
@@ -77,19 +104,16 @@ void StereoMeteringPanel::updateGoniometerImage() const {
     const juce::Image::BitmapData bd(gonioImage, juce::Image::BitmapData::readWrite);
     const juce::Colour dotColour(ColorPalette::primaryGreen);
 
-    const auto &rolling_L = getRollingL();
-    const auto &rolling_R = getRollingR();
+    const float *rollingMid = getRollingL();
+    const float *rollingSide = getRollingR();
     const int rollingSize = getRollingSize();
 
     // Sample every 4th rolling buffer sample to reduce visual density
     for (int i = 0; i < rollingSize; i += 4) {
-        const float l = rolling_L[static_cast<size_t>(i)];
-        const float r = rolling_R[static_cast<size_t>(i)];
-
         // Primary/secondary rotation: primary = (L+R)*0.5 maps to vertical (up = positive)
         //                            secondary = (L-R)*0.5 maps to horizontal
-        const float dotX = (l - r) * 0.5f * scale + cx;
-        const float dotY = cy - (l + r) * 0.5f * scale;
+        const float dotX = rollingSide[static_cast<size_t>(i)] * scale + cx;
+        const float dotY = cy - rollingMid[static_cast<size_t>(i)] * scale;
 
         const int px = juce::roundToInt(dotX);
         const int py = juce::roundToInt(dotY);
@@ -114,39 +138,45 @@ void StereoMeteringPanel::updateGoniometerImage() const {
     }
 }
 
+void StereoMeteringPanel::fadeGoniometerImage() const {
+    if (!gonioImage.isValid()) return;
+
+    // Fade existing image towards current theme background
+    juce::Graphics gc(gonioImage);
+    gc.setColour(juce::Colour(ColorPalette::background).withAlpha(0.15f));
+    gc.fillAll();
+}
+
 float StereoMeteringPanel::computeCorrelation() const {
-    const auto &rolling_L = getRollingL();
-    const auto &rolling_R = getRollingR();
+    const float *rollingMid = getRollingL();
+    const float *rollingSide = getRollingR();
     const int rollingSize = getRollingSize();
 
-    double sumLR = 0.0, sumL2 = 0.0, sumR2 = 0.0;
+    // From mid/side: L = M + S, R = M - S, so L*R = M^2 - S^2 and L^2, R^2 = M^2 + S^2 +/- 2MS
+    double sumM2 = 0.0, sumS2 = 0.0, sumMS = 0.0;
     for (int i = 0; i < rollingSize; ++i) {
-        const double l = rolling_L[static_cast<size_t>(i)];
-        const double r = rolling_R[static_cast<size_t>(i)];
-        sumLR += l * r;
-        sumL2 += l * l;
-        sumR2 += r * r;
+        const double m = rollingMid[static_cast<size_t>(i)];
+        const double s = rollingSide[static_cast<size_t>(i)];
+        sumM2 += m * m;
+        sumS2 += s * s;
+        sumMS += m * s;
     }
-    const double denom = std::sqrt(sumL2 * sumR2);
+    const double sumLR = sumM2 - sumS2;
+    const double sumL2 = sumM2 + sumS2 + 2.0 * sumMS;
+    const double sumR2 = sumM2 + sumS2 - 2.0 * sumMS;
+    const double denom = std::sqrt(juce::jmax(0.0, sumL2 * sumR2));
     if (denom < 1.0e-10) return 0.0f;
     return juce::jlimit(-1.0f, 1.0f, static_cast<float>(sumLR / denom));
 }
 
 void StereoMeteringPanel::computeWidthPerOctave() {
-    const auto &rolling_L = getRollingL();
-    const auto &rolling_R = getRollingR();
     const int wp = getRollingWritePos();
     const double sampleRate = getSampleRate();
 
-    // Copy ordered rolling buffer into FFT work buffers, apply Hann window
-    for (size_t i = 0; i < static_cast<size_t>(kFftSize); ++i) {
-        const size_t idx = (static_cast<size_t>(wp) + i) % static_cast<size_t>(kFftSize);
-        const float win = hannWindow[i];
-        const float l = rolling_L[idx];
-        const float r = rolling_R[idx];
-        fftWorkMid[i] = (l + r) * 0.5f * win;
-        fftWorkSide[i] = (l - r) * 0.5f * win;
-    }
+    // Window the rolling mid/side buffers (contiguous oldest first from wp: they are mirrored)
+    // into the FFT work buffers
+    juce::FloatVectorOperations::multiply(fftWorkMid.data(), getRollingL() + wp, hannWindow.data(), kFftSize);
+    juce::FloatVectorOperations::multiply(fftWorkSide.data(), getRollingR() + wp, hannWindow.data(), kFftSize);
     // Zero imaginary parts
     std::fill(fftWorkMid.begin() + kFftSize, fftWorkMid.end(), 0.0f);
     std::fill(fftWorkSide.begin() + kFftSize, fftWorkSide.end(), 0.0f);
@@ -186,16 +216,18 @@ void StereoMeteringPanel::computeWidthPerOctave() {
 void StereoMeteringPanel::resized() {
     constexpr int corrH = Layout::StereoMetering::correlationHeight;
     constexpr int widthH = Layout::StereoMetering::widthHeight;
+    constexpr int truePeakH = Layout::StereoMetering::truePeakHeight;
 
     const int w = getWidth();
     const int h = getHeight();
 
     // Goniometer square: as large as space allows, min 60px
-    const int gonioSide = juce::jlimit(60, w, h - corrH - widthH - 2);
+    const int gonioSide = juce::jlimit(60, w, h - corrH - widthH - truePeakH - 3);
 
     gonioArea = getLocalBounds().removeFromTop(gonioSide);
     corrArea = getLocalBounds().withTrimmedTop(gonioSide).removeFromTop(corrH);
-    widthArea = getLocalBounds().withTrimmedTop(gonioSide + corrH);
+    truePeakArea = getLocalBounds().removeFromBottom(truePeakH);
+    widthArea = getLocalBounds().withTrimmedTop(gonioSide + corrH).withTrimmedBottom(truePeakH + 1);
 
     // Goniometer image: square, centred below the title label
     constexpr int gonioTitleH = Layout::StereoMetering::gonioTitleHeight;
@@ -383,6 +415,32 @@ void StereoMeteringPanel::paintWidthPerOctave(juce::Graphics &g) const {
     }
 }
 
+void StereoMeteringPanel::paintTruePeak(juce::Graphics &g) const {
+    constexpr int labelH = Layout::StereoMetering::labelHeight;
+    constexpr int pad = Layout::StereoMetering::labelPadding;
+
+    auto area = truePeakArea;
+
+    g.setColour(juce::Colour(ColorPalette::textMuted));
+    g.setFont(Typography::makeFont(Typography::mainFontSize));
+    g.drawText(UILabels::Metering::truePeak, area.removeFromTop(labelH), juce::Justification::centred);
+
+    const auto readout = [](const float db) {
+        return db <= -100.0f ? juce::String(UILabels::Metering::noPeak) : juce::String(db, 1);
+    };
+
+    // Primary left, secondary right; over 0 dBTP reads in red
+    const auto valueRow = area.reduced(pad, 0);
+    const auto primaryArea = valueRow.withWidth(valueRow.getWidth() / 2);
+    const auto secondaryArea = valueRow.withTrimmedLeft(primaryArea.getWidth());
+    const juce::Colour over(0xffcc4444);
+
+    g.setColour(truePeakPrimaryDb > 0.0f ? over : juce::Colour(ColorPalette::primaryGreen));
+    g.drawText(readout(truePeakPrimaryDb), primaryArea, juce::Justification::centred);
+    g.setColour(truePeakSecondaryDb > 0.0f ? over : juce::Colour(ColorPalette::secondaryAmber));
+    g.drawText(readout(truePeakSecondaryDb), secondaryArea, juce::Justification::centred);
+}
+
 //==============================================================================
 void StereoMeteringPanel::paint(juce::Graphics &g) {
     g.fillAll(juce::Colour(ColorPalette::background));
@@ -400,4 +458,10 @@ void StereoMeteringPanel::paint(juce::Graphics &g) {
     g.fillRect(0, corrArea.getBottom(), getWidth(), 1);
 
     paintWidthPerOctave(g);
+
+    // Divider between width chart and true peak
+    g.setColour(juce::Colour(ColorPalette::border));
+    g.fillRect(0, truePeakArea.getY() - 1, getWidth(), 1);
+
+    paintTruePeak(g);
 }
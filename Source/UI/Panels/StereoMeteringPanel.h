@@ -4,23 +4,27 @@
 #include <juce_dsp/juce_dsp.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <array>
+#include <functional>
 #include <vector>
 
 #include "../Visualizers/AudioVisualizerBase.h"
 #include "../Theme/LayoutConstants.h"
 #include "../HintManager.h"
 #include "../../DSP/Interfaces/IAudioDataSink.h"
+#include "../../DSP/Interfaces/IPeakLevelSource.h"
 
 /**
  * StereoMeteringPanel
  *
- * Right-side collapsible panel (~180px wide) providing three primary/secondary analysis instruments:
+ * Right-side collapsible panel (~180px wide) providing four primary/secondary analysis instruments:
  *  1. Goniometer  — Lissajous with phosphor persistence (Primary=up, Secondary=sideways)
  *  2. Correlation — L/R phase correlation bar (-1 to +1)
  *  3. Width/Oct   — Primary/Secondary energy ratio in 10 octave bands
+ *  4. True Peak   — held BS.1770 true peak of the output channels (click to reset)
  *
- * Audio data is pushed from the audio thread via pushStereoData() and consumed
- * by a 60 Hz timer on the UI thread. The FIFO is lock-free (juce::AbstractFifo).
+ * Audio data is written by the audio thread to the processor's mid/side CaptureBus and
+ * read in place by a 60 Hz timer on the UI thread (lock-free, one cursor per sink). The true
+ * peaks are read from the peak source on the same timer.
  */
 class StereoMeteringPanel : public AudioVisualizerBase,
                             public IAudioDataSink {
@@ -31,8 +35,11 @@ public:
 
     //==============================================================================
     // IAudioDataSink implementation (forwards to AudioVisualizerBase)
-    void pushStereoData(const juce::AudioBuffer<float> &buffer) override {
-        AudioVisualizerBase::pushStereoData(buffer);
+    /** All three displays work in mid/side: the rolling "L/R" buffers hold mid and side. */
+    SinkFormat getSinkFormat() const override { return SinkFormat::MidSide; }
+
+    void setCaptureBus(const CaptureBus *bus) override {
+        AudioVisualizerBase::setCaptureBus(bus);
     }
 
     void setSampleRate(const double sr) override {
@@ -47,15 +54,25 @@ public:
     /** Register HintManager — call once from PluginEditor after construction. */
     void setHintManager(HintManager& hm);
 
+    /** Source of the held true peaks (nullptr: none). */
+    void setPeakLevelSource(const IPeakLevelSource *source);
+
+    /** Called when the true-peak readout is clicked: clear the held values. */
+    std::function<void()> onTruePeakReset;
+
 protected:
     //==============================================================================
     // AudioVisualizerBase overrides
     void processDrainedData(int numNewSamples) override;
 
+    bool decayTowardsSilence(int numElapsedSamples) override;
+
 private:
     // Processing helpers (UI thread only)
     void updateGoniometerImage() const;
 
+    void fadeGoniometerImage() const;
+
     float computeCorrelation() const;
 
     void computeWidthPerOctave();
@@ -67,6 +84,11 @@ private:
 
     void paintWidthPerOctave(juce::Graphics &g) const;
 
+    void paintTruePeak(juce::Graphics &g) const;
+
+    /** Re-read the held true peaks from the peak source. */
+    void updateTruePeaks();
+
     //==============================================================================
     // FFT for width-per-octave (UI thread only)
     static constexpr int kFftOrder = Layout::StereoMetering::fftOrder;
@@ -85,18 +107,29 @@ private:
     // Correlation
     float correlationDisplay = 0.0f;
 
+    // Frames faded since the input went silent (0.85^40 leaves nothing visible)
+    static constexpr int kSilentFadeFrames = 40;
+    int silentFrames = 0;
+
     //==============================================================================
     // Width per octave
     static constexpr int kNumBands = Layout::StereoMetering::numBands;
     std::array<float, kNumBands> bandWidths{};
 
+    //==============================================================================
+    // True peak (held dBTP, -100 while nothing has been metered)
+    const IPeakLevelSource *peakSource = nullptr;
+    float truePeakPrimaryDb = -100.0f;
+    float truePeakSecondaryDb = -100.0f;
+
     //==============================================================================
     // Layout areas (set in resized)
-    juce::Rectangle<int> gonioArea, corrArea, widthArea;
+    juce::Rectangle<int> gonioArea, corrArea, widthArea, truePeakArea;
 
     //==============================================================================
     void mouseEnter(const juce::MouseEvent& e) override;
     void mouseExit(const juce::MouseEvent& e) override;
+    void mouseDown(const juce::MouseEvent& e) override;
 
     HintManager* hints = nullptr;
     HintManager::HintHandle hintHandle;
@@ -14,8 +14,8 @@ public:
     ~TransientMeteringPanel() override;
 
     // IAudioDataSink implementation
-    void pushStereoData(const juce::AudioBuffer<float> &buffer) override {
-        AudioVisualizerBase::pushStereoData(buffer);
+    void setCaptureBus(const CaptureBus *bus) override {
+        AudioVisualizerBase::setCaptureBus(bus);
     }
 
     void setSampleRate(const double sr) override {
@@ -10,6 +10,8 @@
 namespace ButtonCaptions {
     inline constexpr auto freeze = "FREEZE";
     inline constexpr auto settings = "SETTINGS";
+    inline constexpr auto processing = "DSP";
+    inline constexpr auto on = "ON";
     inline constexpr auto help = "Help";
     inline constexpr auto reference = "REF";
     inline constexpr auto ghost = "GHOST";
@@ -20,10 +22,14 @@ namespace ButtonCaptions {
     inline constexpr auto target = "TARGET";
     inline constexpr auto saveTarget = "SAVE";
     inline constexpr auto loadTarget = "LOAD";
+    inline constexpr auto match = "MATCH";
     inline constexpr auto primaryLeft = "LEFT";
     inline constexpr auto secondaryRight = "RIGHT";
     inline constexpr auto primaryTrans = "TRANS";
     inline constexpr auto secondaryTonal = "TONAL";
 
     inline const juce::StringArray channelModeOptions{"M/S", "L/R", "TRN"};
+
+    // Analyzer input on multichannel buses, in AnalyzerSource order
+    inline const juce::StringArray analyzerSourceOptions{"FOLD", "L/R", "SUR", "REAR", "TOP F", "TOP R", "C/LFE"};
 } // namespace ButtonCaptions
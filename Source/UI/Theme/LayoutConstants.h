@@ -35,6 +35,17 @@ namespace Layout {
         inline constexpr int panelHeight = 398;
     }
 
+    //==========================================================================
+    // ProcessingPanel
+    //==========================================================================
+    namespace ProcessingPanel {
+        inline constexpr int textBoxWidth = 90;
+        inline constexpr int labelColumnWidth = 80;
+        inline constexpr int rowHeight = 30;
+        inline constexpr int headerHeight = 30;
+        inline constexpr int panelWidth = 350;
+    }
+
     //==========================================================================
     // SpectrumAnalyzer
     //==========================================================================
@@ -80,6 +91,7 @@ namespace Layout {
         // Correlation/gonio display
         inline constexpr int correlationHeight = 62;
         inline constexpr int widthHeight = 94;
+        inline constexpr int truePeakHeight = 44;
         inline constexpr int gonioTitleHeight = 20;
 
         // Labels
@@ -25,6 +25,8 @@ namespace UILabels {
         inline constexpr auto goniometer = "Goniometer";
         inline constexpr auto correlation = "Correlation";
         inline constexpr auto widthPerOctave = "Width / Octave";
+        inline constexpr auto truePeak = "True Peak";
+        inline constexpr auto noPeak = "-inf";
         inline constexpr auto minusOne = "-1";
         inline constexpr auto zero = "0";
         inline constexpr auto plusOne = "+1";
@@ -32,6 +34,7 @@ namespace UILabels {
 
     namespace Panels {
         inline constexpr auto settings = "Settings";
+        inline constexpr auto processing = "Processing";
         inline constexpr auto help = "Help";
     }
 
@@ -3,18 +3,13 @@
 //==============================================================================
 AudioVisualizerBase::AudioVisualizerBase(const int fifoCapacity, const int rollingBufferSize)
     : ringBuffer(fifoCapacity, rollingBufferSize) {
-    startTimerHz(60);
+    startTimerHz(kFrameRateHz);
 }
 
 AudioVisualizerBase::~AudioVisualizerBase() {
     stopTimer();
 }
 
-//==============================================================================
-void AudioVisualizerBase::pushStereoData(const juce::AudioBuffer<float> &buffer) {
-    ringBuffer.push(buffer);
-}
-
 //==============================================================================
 void AudioVisualizerBase::setSampleRate(const double newSampleRate) {
     // Store atomically — the actual update (onSampleRateChanged) is deferred
@@ -32,19 +27,41 @@ void AudioVisualizerBase::resetFifo(const int newActiveCapacity) {
     ringBuffer.resetFifo(newActiveCapacity);
 }
 
+bool AudioVisualizerBase::setDecimationStages(const int stages) {
+    if (stages == ringBuffer.getDecimationStages())
+        return false;
+
+    ringBuffer.setDecimationStages(stages);
+    sampleRate = hostSampleRate / static_cast<double>(1 << ringBuffer.getDecimationStages());
+    requestRepaint();
+    return true;
+}
+
 //==============================================================================
 void AudioVisualizerBase::timerCallback() {
     // Apply pending sample rate change on the message thread (safe for all shared state)
     const double newRate = pendingSampleRate.exchange(0.0, std::memory_order_acquire);
     if (newRate > 0.0) {
-        sampleRate = newRate;
+        hostSampleRate = newRate;
+        sampleRate = hostSampleRate / static_cast<double>(1 << ringBuffer.getDecimationStages());
         onSampleRateChanged();
     }
 
     const int numNew = ringBuffer.drain();
-    processDrainedData(numNew);
+    bool decaying = false;
+
+    // Silent input: once the FIFO is empty, only let the display fall to its floor
+    if (numNew == 0 && ringBuffer.isSourceSilent()) {
+        if (!restingAtFloor) {
+            decaying = decayTowardsSilence(juce::roundToInt(sampleRate / kFrameRateHz));
+            restingAtFloor = !decaying;
+        }
+    } else {
+        restingAtFloor = false;
+        processDrainedData(numNew);
+    }
 
-    if (numNew > 0 || newRate > 0.0 || repaintRequested) {
+    if (numNew > 0 || decaying || newRate > 0.0 || repaintRequested) {
         repaintRequested = false;
         repaint();
     }
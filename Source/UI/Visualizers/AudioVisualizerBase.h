@@ -10,9 +10,13 @@
  * Abstract base class for audio visualization components.
  *
  * Provides the lock-free audio-to-UI pipeline common to all audio visualizers:
- *  - AudioRingBuffer for realtime-safe stereo data transfer (audio thread -> UI)
+ *  - AudioRingBuffer reading the processor's CaptureBus (audio thread -> UI, no per-sink copy
+ *    on the audio thread)
  *  - 60 Hz timer lifecycle (start in ctor, stop in dtor)
- *  - Sample rate storage
+ *  - Sample rate storage, and optional decimation of the feed (getSampleRate() is the
+ *    analysis rate, getHostSampleRate() the rate the audio thread pushes at)
+ *  - Sleep while the input is silent: once the bus is marked silent no analysis runs, the
+ *    display only decays to its floor and then stops repainting
  *
  * Subclasses override processDrainedData() to perform their specific analysis
  * (FFT, correlation, goniometer, etc.) each frame after the FIFO has been
@@ -25,8 +29,8 @@ public:
 
     ~AudioVisualizerBase() override;
 
-    /** Called from the audio thread — lock-free, no allocation. */
-    virtual void pushStereoData(const juce::AudioBuffer<float> &buffer);
+    /** Message thread. Read the audio from bus (nullptr: detach), starting at its current end. */
+    void setCaptureBus(const CaptureBus *bus) { ringBuffer.attach(bus); }
 
     virtual void setSampleRate(double newSampleRate);
 
@@ -43,6 +47,15 @@ protected:
      *  @param numNewSamples number of samples just written into the rolling buffer */
     virtual void processDrainedData(int numNewSamples) = 0;
 
+    /** Called each frame instead of processDrainedData() while the input is silent and
+     *  nothing is left in the FIFO. Move the display towards its floor without analysing
+     *  anything; return false once it rests there (frames stop until signal returns).
+     *  @param numElapsedSamples audio time covered by one frame */
+    virtual bool decayTowardsSilence(int numElapsedSamples) {
+        juce::ignoreUnused(numElapsedSamples);
+        return false;
+    }
+
     /** Called after setSampleRate — subclass can recompute FFT bin mappings, etc. */
     virtual void onSampleRateChanged() {
     }
@@ -54,12 +67,20 @@ protected:
      *  their destructor so the timer cannot fire while members are being destroyed. */
     void stopVisualizerTimer() { stopTimer(); }
 
-    // Rolling buffer accessors (read-only for subclasses)
-    const std::vector<float> &getRollingL() const { return ringBuffer.getL(); }
-    const std::vector<float> &getRollingR() const { return ringBuffer.getR(); }
+    // Rolling buffer accessors (read-only for subclasses). Mirrored: the rolling buffer oldest
+    // first is the contiguous getRollingL() + getRollingWritePos() (see AudioRingBuffer)
+    const float *getRollingL() const { return ringBuffer.getL(); }
+    const float *getRollingR() const { return ringBuffer.getR(); }
     int getRollingWritePos() const { return ringBuffer.getWritePos(); }
     int getRollingSize() const { return ringBuffer.getRollingSize(); }
     double getSampleRate() const { return sampleRate; }
+    double getHostSampleRate() const { return hostSampleRate; }
+
+    /** Decimate the feed by 2^stages (HalfbandDecimator) before it reaches the rolling buffer.
+     *  Clears the FIFO and rolling buffer and updates getSampleRate(); returns false if the
+     *  stage count was already in effect. Does not call onSampleRateChanged(). */
+    bool setDecimationStages(int stages);
+    int getDecimationStages() const { return ringBuffer.getDecimationStages(); }
 
     /** Resize the rolling buffer (e.g. when FFT order changes).
      *  Resets writePos to 0 and clears the buffer. */
@@ -69,13 +90,19 @@ protected:
     void resetFifo(int newActiveCapacity);
 
 private:
+    static constexpr int kFrameRateHz = 60;
+
     void timerCallback() final;
 
     AudioRingBuffer ringBuffer;
-    double sampleRate = 44100.0;
+    double hostSampleRate = 44100.0;
+    double sampleRate = 44100.0; // hostSampleRate over the decimation
 
     /** Pending sample rate from audio thread — picked up by timerCallback on the message thread. */
     std::atomic<double> pendingSampleRate{0.0};
 
     bool repaintRequested = false;
+
+    /** The silent display has reached its floor (UI thread only). */
+    bool restingAtFloor = false;
 };
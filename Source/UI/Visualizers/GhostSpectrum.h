@@ -1,41 +1,25 @@
 #pragma once
 
-#include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <functional>
 #include <vector>
 
-#include "../../DSP/Processing/AudioRingBuffer.h"
-
 /**
- * Ghost spectrum — secondary FFT pipeline for visual comparison.
+ * Ghost spectrum — display side of the secondary curves for visual comparison.
  *
- * Manages its own AudioRingBuffer, smoothed dB arrays, and rendered paths.
- * Calls back to the parent's FFT processor and path builder to avoid
- * duplicating DSP setup.
+ * Holds the latest ghost curves (measured by SpectrumAnalysisWorker alongside the main ones)
+ * and their rendered paths. Calls back to the parent's path builder so both spectra map bins
+ * to pixels the same way.
  */
 class GhostSpectrum {
 public:
-    using ProcessFFTFn = std::function<void(const std::vector<float> &srcL,
-                                            const std::vector<float> &srcR,
-                                            int srcWritePos,
-                                            std::vector<float> &outPrimaryDb,
-                                            std::vector<float> &outSecondaryDb)>;
-
     using BuildPathFn = std::function<void(juce::Path &path, const std::vector<float> &dbData,
                                            float width, float height, bool closePath)>;
 
-    explicit GhostSpectrum(int maxFifoCapacity);
-
-    void pushData(const juce::AudioBuffer<float> &buffer);
-
     void resetBuffers(int fftSize, float minDb);
 
-    void resetFifo(int capacity);
-
-    /** Process drained ghost samples hop-by-hop, calling processFFT for each hop.
-     *  Returns true if any FFT was computed (paths need rebuilding). */
-    bool processDrained(int fftSize, int hopSize, const ProcessFFTFn &processFFT);
+    /** Adopt the curves of the latest analysis frame (same bin count). */
+    void setCurves(const std::vector<float> &primaryDb, const std::vector<float> &secondaryDb);
 
     void buildPaths(float width, float height, const BuildPathFn &buildPath);
 
@@ -50,14 +34,7 @@ public:
     const juce::Path &getPrimaryPath() const { return primaryPath; }
     const juce::Path &getSecondaryPath() const { return secondaryPath; }
 
-    /** Drain FIFO without processing (used when frozen). */
-    void drainSilently();
-
 private:
-    AudioRingBuffer ringBuffer;
-
-    int hopCounter = 0;
-
     std::vector<float> smoothedPrimaryDb;
     std::vector<float> smoothedSecondaryDb;
 
@@ -1,6 +1,7 @@
 #include "SpectrumAnalyzer.h"
 #include <cmath>
 #include <juce_dsp/juce_dsp.h>
+#include "../../DSP/Processing/HalfbandDecimator.h"
 #include "../Theme/ColorPalette.h"
 #include "../Theme/LayoutConstants.h"
 #include "../Theme/Typography.h"
@@ -9,11 +10,8 @@
 
 //==============================================================================
 SpectrumAnalyzer::SpectrumAnalyzer()
-    : AudioVisualizerBase(maxFifoCapacity, 1 << defaultFftOrder) {
+    : AudioVisualizerBase(0, 0) { // the worker drains the buses; the base only ticks the display
     applyTheme();
-    fftProcessor.setChannelMode(channelMode);
-    fftProcessor.setSlope(slopeDb);
-    fftProcessor.setTemporalDecay(curveDecay);
     SpectrumAnalyzer::setFftOrder(defaultFftOrder);
     setOpaque(true);
 
@@ -45,17 +43,10 @@ void SpectrumAnalyzer::setFftOrder(const int order) {
 
     fftOrder = order;
     fftSize = 1 << order;
-    fifoCapacity = fftSize * 2;
     numBins = fftSize / 2 + 1;
-    hopSize = juce::jmax(1, fftSize / overlapFactor);
 
-    // Delegate FFT setup to FFTProcessor
-    fftProcessor.setFftOrder(order, range.minDb);
-    fftProcessor.setSampleRate(getSampleRate());
-
-    // Reset rolling buffers and counters (base class rolling buffer)
-    resizeRollingBuffer(fftSize);
-    hopCounter = 0;
+    // The worker resizes its FFT and rolling buffers and restarts its curves from the floor
+    updateAnalysisSettings();
 
     // Resize and clear magnitude arrays
     smoothedPrimaryDb.assign(static_cast<size_t>(numBins), range.minDb);
@@ -64,10 +55,6 @@ void SpectrumAnalyzer::setFftOrder(const int order) {
     ghostSpectrum.resetBuffers(fftSize, range.minDb);
     peakHold.reset(numBins, range.minDb);
 
-    // Reset FIFOs to new active capacity (underlying buffers stay at max — no realloc)
-    resetFifo(fifoCapacity);
-    ghostSpectrum.resetFifo(fifoCapacity);
-
     if (spectrumArea.getWidth() > 0) {
         precomputePathPoints();
         rebuildGridImage();
@@ -77,19 +64,54 @@ void SpectrumAnalyzer::setFftOrder(const int order) {
 
 SpectrumAnalyzer::~SpectrumAnalyzer() {
     // Stop the timer BEFORE member destruction — otherwise the 60Hz callback
-    // can fire while ghostSpectrum, fftProcessor etc. are
+    // can fire while ghostSpectrum, the analysis worker etc. are
     // already destroyed, causing SIGABRT / use-after-free.
     stopVisualizerTimer();
 }
 
 //==============================================================================
-void SpectrumAnalyzer::pushGhostData(const juce::AudioBuffer<float> &buffer) {
-    ghostSpectrum.pushData(buffer);
+void SpectrumAnalyzer::setGhostCaptureBus(const CaptureBus *bus) {
+    analysis.setGhostCaptureBus(bus);
+}
+
+void SpectrumAnalyzer::updateAnalysisSettings() {
+    SpectrumAnalysisWorker::Settings settings;
+    settings.fftOrder = fftOrder;
+    settings.overlapFactor = overlapFactor;
+    settings.decimationStages = getDecimationStages();
+    settings.sampleRate = getSampleRate();
+    settings.minDb = range.minDb;
+    settings.curveDecay = curveDecay;
+    settings.slopeDb = slopeDb;
+    settings.smoothing = smoothingMode;
+    settings.channelMode = channelMode;
+    analysisGeneration = analysis.setSettings(settings);
 }
 
 //==============================================================================
 void SpectrumAnalyzer::onSampleRateChanged() {
-    fftProcessor.setSampleRate(getSampleRate());
+    updateAnalysisDecimation();
+    updateAnalysisSettings();
+    if (spectrumArea.getWidth() > 0)
+        precomputePathPoints();
+}
+
+void SpectrumAnalyzer::setHighRateDecimation(const bool enabled) {
+    highRateDecimation = enabled;
+    updateAnalysisDecimation();
+}
+
+void SpectrumAnalyzer::updateAnalysisDecimation() {
+    const int stages = highRateDecimation
+                           ? HalfbandDecimator::stagesFor(getHostSampleRate(), range.maxFreq)
+                           : 0;
+    if (!setDecimationStages(stages))
+        return;
+
+    // Every bin now maps to a different frequency: curves measured at the old rate are stale
+    // (the worker restarts its own when it sees the new stage count)
+    updateAnalysisSettings();
+    clearAllCurves();
     if (spectrumArea.getWidth() > 0)
         precomputePathPoints();
 }
@@ -298,6 +320,19 @@ void SpectrumAnalyzer::mouseDown(const juce::MouseEvent &event) {
             event.position.x - spectrumArea.getX(), spectrumArea.getWidth());
 
         const int bandIdx = findBandAtFrequency(clickFreq);
+
+        // Shift-click toggles a band's solo, alt-click its mute; both stay latched.
+        if (bandIdx >= 0 && (event.mods.isShiftDown() || event.mods.isAltDown())) {
+            auto &mask = event.mods.isShiftDown() ? soloedBands : mutedBands;
+            mask ^= 1u << bandIdx;
+            rebuildGridImage();
+            repaint();
+
+            if (onBandSolo)
+                onBandSolo(soloedBands, mutedBands);
+            return;
+        }
+
         if (bandIdx >= 0) {
             const auto info = getBandInfo(bandIdx);
             selectedBand = bandIdx;
@@ -411,7 +446,8 @@ void SpectrumAnalyzer::mouseMove(const juce::MouseEvent &event) {
             hoverRegion = newRegion;
             switch (newRegion) {
                 case HoverRegion::BandHints:
-                    hintHandle = hints->setHint("CLICK | DRAG", "Audition band  |  Move between bands");
+                    hintHandle = hints->setHint("CLICK | DRAG | SHIFT | ALT",
+                                                "Audition band  |  Move between bands  |  Solo band  |  Mute band");
                     break;
                 case HoverRegion::Spectrum:
                     hintHandle = hints->setHint("R CLICK | DRAG", "Audition freq  |  Change Q");
@@ -437,57 +473,27 @@ void SpectrumAnalyzer::mouseExit(const juce::MouseEvent &) {
 }
 
 //==============================================================================
-void SpectrumAnalyzer::processDrainedData(const int numNewSamples) {
-    if (frozen) {
-        ghostSpectrum.drainSilently();
-        return;
-    }
-
-    if (numNewSamples == 0)
+void SpectrumAnalyzer::processDrainedData(int /*numNewSamples*/) {
+    // The buses feed the worker: all that is left here is to render its latest frame
+    if (frozen)
         return;
 
-    const auto &rolling_L = getRollingL();
-    const auto &rolling_R = getRollingR();
-    const int currentWritePos = getRollingWritePos();
-
-    // Walk through the newly drained samples hop-by-hop.
-    // The rolling buffer already contains all data; we advance a virtual write
-    // position to trigger FFTs at the correct circular-buffer offsets.
-    bool fftDataReady = false;
-    // Double-modulo ensures the result is positive even when numNewSamples > fftSize
-    // (e.g. a 4096-sample DAW buffer with a 2048-point FFT). A single "+ fftSize"
-    // guard is insufficient in that case.
-    int virtualWritePos = ((currentWritePos - numNewSamples) % fftSize + fftSize) % fftSize;
-
-    for (int i = 0; i < numNewSamples; ++i) {
-        virtualWritePos = (virtualWritePos + 1) % fftSize;
-        ++hopCounter;
-
-        if (hopCounter >= hopSize) {
-            fftProcessor.processBlock(rolling_L, rolling_R, virtualWritePos,
-                                      smoothedPrimaryDb, smoothedSecondaryDb);
-            fftDataReady = true;
-            hopCounter = 0;
+    const auto *frame = analysis.takeLatestFrame();
+    if (frame == nullptr || frame->generation != analysisGeneration) {
+        // Silence reached the floor: let the sub-bass glow fade out
+        if (analysisAtFloor && lowFreqGlow > 0.001f) {
+            updateLowFreqGlow();
+            requestRepaint();
         }
+        return;
     }
 
-    // Process ghost FIFO (opposite signal for comparison).
-    // THREAD-SAFETY: ghostSpectrum reuses fftProcessor's work buffers (fftDataPrimary/Secondary)
-    // and FFT engine. This is safe because:
-    //   1. Both paths run exclusively on the UI timer thread.
-    //   2. Main hops (above) always finish before this call.
-    //   3. captureInstant defaults to false, so instantPrimaryDb/SecondaryDb are not overwritten.
-    // If ghost processing is ever moved off the UI thread, this invariant must be revisited.
-    const bool ghostFftReady = ghostSpectrum.processDrained(fftSize, hopSize,
-                                                            [this](const std::vector<float> &srcL,
-                                                                   const std::vector<float> &srcR, const int wp,
-                                                                   std::vector<float> &outPrimary,
-                                                                   std::vector<float> &outSecondary) {
-                                                                // captureInstant = false (default): does not
-                                                                // stomp instantPrimaryDb/SecondaryDb used by the tooltip.
-                                                                fftProcessor.processBlock(
-                                                                    srcL, srcR, wp, outPrimary, outSecondary);
-                                                            });
+    smoothedPrimaryDb = frame->primaryDb;
+    smoothedSecondaryDb = frame->secondaryDb;
+    if (frame->hasGhost)
+        ghostSpectrum.setCurves(frame->ghostPrimaryDb, frame->ghostSecondaryDb);
+    analysisAtFloor = !frame->aboveFloor;
+    requestRepaint();
 
     const float w = spectrumArea.getWidth();
     const float h = spectrumArea.getHeight();
@@ -495,30 +501,10 @@ void SpectrumAnalyzer::processDrainedData(const int numNewSamples) {
     if (canRebuildPeakHold)
         peakHoldThrottleCounter = 0;
 
-    if (fftDataReady && w > 0 && h > 0) {
+    if (w > 0 && h > 0) {
         buildPath(primaryPath, smoothedPrimaryDb, w, h);
         buildPath(secondaryPath, smoothedSecondaryDb, w, h);
 
-        // Sub-bass glow: measure peak energy below 25 Hz
-        {
-            constexpr float kThresholdDb  = -20.0f; // glow starts here
-            constexpr float kMaxDb        = -1.0f;  // glow is full here
-            constexpr float kAttack       = 0.6f;
-            constexpr float kRelease      = 0.05f;
-
-            const float binWidth = (getSampleRate() > 0.0) ? static_cast<float>(getSampleRate()) / static_cast<float>(fftSize) : 1.0f;
-            const int   maxBin   = juce::jlimit(1, static_cast<int>(smoothedPrimaryDb.size()) - 1,
-                                                static_cast<int>(std::ceil(20.0f / binWidth)));
-            float peakDb = kThresholdDb;
-            for (int b = 0; b <= maxBin; ++b)
-                peakDb = std::max(peakDb, smoothedPrimaryDb[static_cast<size_t>(b)]);
-
-            const float target = juce::jlimit(0.0f, 1.0f,
-                                              (peakDb - kThresholdDb) / (kMaxDb - kThresholdDb));
-            const float coeff  = target > lowFreqGlow ? kAttack : kRelease;
-            lowFreqGlow += coeff * (target - lowFreqGlow);
-        }
-
         if (peakHold.isEnabled()) {
             const bool peaksChanged = peakHold.accumulate(smoothedPrimaryDb, smoothedSecondaryDb, numBins);
             pendingPeakHoldMainRebuild = pendingPeakHoldMainRebuild || peaksChanged;
@@ -531,8 +517,9 @@ void SpectrumAnalyzer::processDrainedData(const int numNewSamples) {
             }
         }
     }
+    updateLowFreqGlow();
 
-    if (ghostFftReady && w > 0 && h > 0) {
+    if (frame->hasGhost && w > 0 && h > 0) {
         auto pathBuilder = [this](juce::Path &p, const std::vector<float> &db,
                                   const float pw, const float ph, const bool close) {
             buildPath(p, db, pw, ph, close);
@@ -562,11 +549,30 @@ void SpectrumAnalyzer::processDrainedData(const int numNewSamples) {
     }
 }
 
+void SpectrumAnalyzer::updateLowFreqGlow() {
+    // Sub-bass glow: measure peak energy below 25 Hz
+    constexpr float kThresholdDb  = -20.0f; // glow starts here
+    constexpr float kMaxDb        = -1.0f;  // glow is full here
+    constexpr float kAttack       = 0.6f;
+    constexpr float kRelease      = 0.05f;
+
+    const float binWidth = (getSampleRate() > 0.0) ? static_cast<float>(getSampleRate()) / static_cast<float>(fftSize) : 1.0f;
+    const int   maxBin   = juce::jlimit(1, static_cast<int>(smoothedPrimaryDb.size()) - 1,
+                                        static_cast<int>(std::ceil(20.0f / binWidth)));
+    float peakDb = kThresholdDb;
+    for (int b = 0; b <= maxBin; ++b)
+        peakDb = std::max(peakDb, smoothedPrimaryDb[static_cast<size_t>(b)]);
+
+    const float target = juce::jlimit(0.0f, 1.0f,
+                                      (peakDb - kThresholdDb) / (kMaxDb - kThresholdDb));
+    const float coeff  = target > lowFreqGlow ? kAttack : kRelease;
+    lowFreqGlow += coeff * (target - lowFreqGlow);
+}
 
 //==============================================================================
 void SpectrumAnalyzer::setSmoothing(const SmoothingMode mode) {
     smoothingMode = mode;
-    fftProcessor.setSmoothing(mode);
+    updateAnalysisSettings();
     repaint();
 }
 
@@ -709,12 +715,16 @@ void SpectrumAnalyzer::loadTargetCurve(std::function<void(bool)> onLoaded) {
                                  targetCurve.buildPaths(range, spectrumArea.getWidth(), spectrumArea.getHeight());
                                  repaint();
                              }
+                             if (onTargetCurveChanged && (ok || !targetCurve.isLoaded()))
+                                 onTargetCurveChanged(ok ? &targetCurve.getData() : nullptr);
                              if (callback) callback(ok);
                          });
 }
 
 void SpectrumAnalyzer::clearTargetCurve() {
     targetCurve.clear();
+    if (onTargetCurveChanged)
+        onTargetCurveChanged(nullptr);
     repaint();
 }
 
@@ -722,7 +732,8 @@ void SpectrumAnalyzer::clearAllCurves() {
     const auto nb = static_cast<size_t>(numBins);
     smoothedPrimaryDb.assign(nb, range.minDb);
     smoothedSecondaryDb.assign(nb, range.minDb);
-    fftProcessor.setMinDb(range.minDb);
+    analysisGeneration = analysis.clear();
+    analysisAtFloor = false;
     ghostSpectrum.resetBuffers(fftSize, range.minDb);
     primaryPath.clear();
     secondaryPath.clear();
@@ -809,6 +820,14 @@ void SpectrumAnalyzer::rebuildGridImage() {
 
             const float xLo = sx + range.frequencyToX(lo, sw);
             const float xHi = sx + range.frequencyToX(hi, sw);
+            const bool soloed = ((soloedBands >> i) & 1u) != 0;
+            const bool muted = ((mutedBands >> i) & 1u) != 0;
+
+            // Latched solo: tint the whole band cell
+            if (soloed) {
+                g.setColour(juce::Colour(ColorPalette::blueAccent).withAlpha(0.25f));
+                g.fillRect(xLo, barY, xHi - xLo, barH);
+            }
 
             // Highlight selected band with accent color (drawn on top)
             if (i == static_cast<size_t>(selectedBand)) {
@@ -822,8 +841,8 @@ void SpectrumAnalyzer::rebuildGridImage() {
                 }
             }
 
-            // Band label
-            g.setColour(textColour);
+            // Band label (dimmed when muted)
+            g.setColour(muted ? textColour.withMultipliedAlpha(0.35f) : textColour);
             g.drawText(kBands[i].name,
                        static_cast<int>(xLo), static_cast<int>(barY),
                        static_cast<int>(xHi - xLo), static_cast<int>(barH),
@@ -891,7 +910,7 @@ void SpectrumAnalyzer::rebuildGridImage() {
 void SpectrumAnalyzer::setDbRange(const float newMinDb, const float newMaxDb) {
     range.minDb = newMinDb;
     range.maxDb = juce::jmax(newMinDb + 1.0f, newMaxDb);
-    fftProcessor.setMinDb(range.minDb);
+    updateAnalysisSettings();
     rebuildGridImage();
     repaint();
 }
@@ -900,6 +919,7 @@ void SpectrumAnalyzer::setFreqRange(const float newMinFreq, const float newMaxFr
     range.minFreq = juce::jmax(1.0f, newMinFreq);
     range.maxFreq = juce::jmax(range.minFreq + 1.0f, newMaxFreq);
     range.logRange = std::log2(range.maxFreq / range.minFreq);
+    updateAnalysisDecimation();
     if (spectrumArea.getWidth() > 0)
         precomputePathPoints();
     rebuildGridImage();
@@ -12,7 +12,7 @@
 #include "PeakHold.h"
 #include "TargetCurve.h"
 #include "SpectrumTooltip.h"
-#include "BandConstants.h"
+#include "../../Utility/BandConstants.h"
 #include "../ISpectrumControls.h"
 #include "../ISpectrumDisplaySettings.h"
 #include "../Theme/ColorPalette.h"
@@ -21,14 +21,18 @@
 #include "../../Utility/ChannelMode.h"
 #include "../../Utility/DisplayRange.h"
 #include "../../DSP/Interfaces/IAudioDataSink.h"
-#include "../../DSP/Processing/FFTProcessor.h"
+#include "../../DSP/Processing/SpectrumAnalysisWorker.h"
 #include "../../DSP/Interfaces/IGhostDataSink.h"
 
 /**
  * Primary/Secondary Spectrum Analyzer Component
  *
  * Displays real-time frequency spectrum with separate primary and secondary channels.
- * Uses lock-free FIFO for realtime-safe audio data transfer from the audio thread.
+ * Reads the processor's lock-free CaptureBus for realtime-safe audio data transfer.
+ *
+ * The analysis (drain, decimation, FFT, smoothing) runs on a SpectrumAnalysisWorker; the
+ * capture buses go to the worker, not to the AudioVisualizerBase ring, and each display tick
+ * only takes the worker's latest frame and builds paths, peak hold and glow from it.
  *
  * Features:
  * - Configurable FFT order (11-14): 2048-16384 points
@@ -50,9 +54,9 @@ public:
     ~SpectrumAnalyzer() override;
 
     //==============================================================================
-    // IAudioDataSink implementation (forwards to AudioVisualizerBase)
-    void pushStereoData(const juce::AudioBuffer<float> &buffer) override {
-        AudioVisualizerBase::pushStereoData(buffer);
+    // IAudioDataSink implementation (the bus feeds the analysis worker)
+    void setCaptureBus(const CaptureBus *bus) override {
+        analysis.setCaptureBus(bus);
     }
 
     void setSampleRate(const double sr) override {
@@ -60,7 +64,7 @@ public:
     }
 
     // IGhostDataSink implementation
-    void pushGhostData(const juce::AudioBuffer<float> &buffer) override;
+    void setGhostCaptureBus(const CaptureBus *bus) override;
 
     //==============================================================================
     void paint(juce::Graphics &g) override;
@@ -85,6 +89,13 @@ public:
     /** Callback for band selection filter (set by PluginEditor) */
     std::function<void(bool active, float freqHz, float q)> onBandFilter;
 
+    /** Callback for band solo/mute (shift-click solos, alt-click mutes; set by PluginEditor).
+     *  Masks use bit i for kBands[i]. */
+    std::function<void(juce::uint32 soloMask, juce::uint32 muteMask)> onBandSolo;
+
+    /** Callback fired when a target curve is loaded (its data) or cleared (nullptr); set by PluginEditor. */
+    std::function<void(const TargetCurve::CurveData *curve)> onTargetCurveChanged;
+
     /** Callback fired when the fullscreen toggle button is clicked (set by PluginEditor) */
     std::function<void(bool fullscreen)> onFullscreen;
 
@@ -94,8 +105,11 @@ public:
     //==============================================================================
     // ISpectrumControls implementation
 
-    /** Freeze the display — drains FIFOs silently but stops updating paths. */
-    void setFrozen(const bool freeze) override { frozen = freeze; }
+    /** Freeze the display — the worker skips the input and publishes nothing. */
+    void setFrozen(const bool freeze) override {
+        frozen = freeze;
+        analysis.setFrozen(freeze);
+    }
     bool isFrozen() const override { return frozen; }
 
     /** Infinite peak hold — accumulates the per-bin maximum over time. */
@@ -166,8 +180,7 @@ public:
 
     void setOverlapFactor(const int factor) override {
         overlapFactor = juce::jlimit(minOverlapFactor, maxOverlapFactor, factor);
-        hopSize = juce::jmax(1, fftSize / overlapFactor);
-        hopCounter = 0;
+        updateAnalysisSettings();
     }
 
     int getOverlapFactor() const override { return overlapFactor; }
@@ -178,7 +191,7 @@ public:
 
     void setCurveDecay(const float decay) override {
         curveDecay = juce::jlimit(0.0f, 1.0f, decay);
-        fftProcessor.setTemporalDecay(curveDecay);
+        updateAnalysisSettings();
     }
 
     float getCurveDecay() const override { return curveDecay; }
@@ -209,7 +222,7 @@ public:
 
     void setChannelMode(const ChannelMode mode) {
         channelMode = mode;
-        fftProcessor.setChannelMode(mode);
+        updateAnalysisSettings();
         clearAllCurves();
     }
 
@@ -219,7 +232,7 @@ public:
      *  Positive tilts the display up toward high frequencies, negative toward lows. */
     void setSlope(const float db) override {
         slopeDb = juce::jlimit(-9.0f, 9.0f, db);
-        fftProcessor.setSlope(slopeDb);
+        updateAnalysisSettings();
         repaint();
     }
 
@@ -238,6 +251,12 @@ public:
 
     float getSlope() const override { return slopeDb; }
 
+    /** At 88.2 kHz and above, analyse a halfband-decimated feed (towards 48 kHz) whenever the
+     *  visible range fits its passband: the same FFT order then resolves the low end 2-4x finer. */
+    void setHighRateDecimation(bool enabled) override;
+
+    bool getHighRateDecimation() const override { return highRateDecimation; }
+
     // ISpectrumDisplaySettings getters
     float getMinDb() const override { return range.minDb; }
     float getMaxDb() const override { return range.maxDb; }
@@ -259,6 +278,17 @@ protected:
     void onSampleRateChanged() override;
 
 private:
+    /** Hand the current FFT, range and decode settings to the worker. */
+    void updateAnalysisSettings();
+
+    /** Sub-bass glow follows the peak below 20 Hz of the current curve. */
+    void updateLowFreqGlow();
+
+    /** Pick the decimation for the host rate and maxFreq; rebins everything when it changes. */
+    void updateAnalysisDecimation();
+
+    bool highRateDecimation = Defaults::highRateDecimation;
+
     //==============================================================================
     // Fullscreen toggle button (top-right corner)
     ToggleButton fullscreenButton{"FS", juce::Colour(ColorPalette::blueAccent), Typography::mainFontSize};
@@ -274,16 +304,14 @@ private:
     // Runtime-configurable dimensions (updated by setFftOrder)
     int fftOrder = defaultFftOrder;
     int fftSize = 1 << defaultFftOrder;
-    int fifoCapacity = fftSize * 2;
     int numBins = fftSize / 2 + 1;
     int overlapFactor = Defaults::overlapFactor;
-    int hopSize = (1 << defaultFftOrder) / Defaults::overlapFactor;
 
     //==============================================================================
-    // FFT processing — delegated to FFTProcessor (SRP: DSP separate from rendering)
-    FFTProcessor fftProcessor;
-
-    int hopCounter = 0;
+    // Analysis — on the worker thread; the curves of the latest frame are copied here
+    SpectrumAnalysisWorker analysis{maxFifoCapacity};
+    juce::uint32 analysisGeneration = 0; // frames older than the current settings are dropped
+    bool analysisAtFloor = false;        // the last frame was silence at the floor
 
     std::vector<float> smoothedPrimaryDb;
     std::vector<float> smoothedSecondaryDb;
@@ -343,6 +371,8 @@ private:
     int selectedBand = -1; // -1 means none selected, 0-6 are the 7 frequency bands
     float selectedBandLo = 0.0f; // Low frequency of selected band
     float selectedBandHi = 0.0f; // High frequency of selected band
+    juce::uint32 soloedBands = 0; // Bit i set = kBands[i] soloed (persists until toggled off)
+    juce::uint32 mutedBands = 0;  // Bit i set = kBands[i] muted
 
     bool isInBandHintsArea(const juce::Point<float> &position) const {
         constexpr float barY = Layout::SpectrumAnalyzer::barY;
@@ -415,7 +445,7 @@ public:
 
     //==============================================================================
     // Ghost spectrum — shows the "other" signal for visual comparison
-    GhostSpectrum ghostSpectrum{maxFifoCapacity};
+    GhostSpectrum ghostSpectrum;
 
 
     ChannelMode channelMode = ChannelMode::MidSide;
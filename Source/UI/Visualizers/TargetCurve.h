@@ -27,6 +27,9 @@ public:
     [[nodiscard]]
     bool isLoaded() const { return loaded; }
 
+    /** The loaded curve (empty when nothing is loaded). */
+    const CurveData &getData() const { return data; }
+
     /** Build display paths from the stored curve data. */
     void buildPaths(const DisplayRange &range, float width, float height);
 
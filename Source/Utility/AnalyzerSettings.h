@@ -28,6 +28,7 @@ struct AnalyzerSettings {
             props->setValue("overlapFactor", settings.getOverlapFactor());
             props->setValue("curveDecay", settings.getCurveDecay());
             props->setValue("slopeDb", settings.getSlope());
+            props->setValue("highRateDecimation", settings.getHighRateDecimation());
             props->saveIfNeeded();
         }
     }
@@ -67,6 +68,8 @@ struct AnalyzerSettings {
                 settings.setCurveDecay(static_cast<float>(props->getDoubleValue("curveDecay", D::curveDecay)));
             if (props->containsKey("slopeDb"))
                 settings.setSlope(static_cast<float>(props->getDoubleValue("slopeDb", 0.0)));
+            if (props->containsKey("highRateDecimation"))
+                settings.setHighRateDecimation(props->getBoolValue("highRateDecimation", D::highRateDecimation));
         }
     }
 
@@ -89,6 +92,7 @@ struct AnalyzerSettings {
         tree.setProperty("overlapFactor", settings.getOverlapFactor(),                                                    nullptr);
         tree.setProperty("curveDecay",    settings.getCurveDecay(),                                  nullptr);
         tree.setProperty("slopeDb",       settings.getSlope(),                                       nullptr);
+        tree.setProperty("highRateDecimation", settings.getHighRateDecimation(),                   nullptr);
         tree.setProperty("uiTheme",       static_cast<int>(theme),                                                        nullptr);
     }
 
@@ -121,6 +125,8 @@ struct AnalyzerSettings {
             settings.setCurveDecay(static_cast<float>(static_cast<double>(tree["curveDecay"])));
         if (tree.hasProperty("slopeDb"))
             settings.setSlope(static_cast<float>(static_cast<double>(tree["slopeDb"])));
+        if (tree.hasProperty("highRateDecimation"))
+            settings.setHighRateDecimation(static_cast<bool>(tree["highRateDecimation"]));
         if (tree.hasProperty("uiTheme"))
             theme = static_cast<ColorPalette::Theme>(static_cast<int>(tree["uiTheme"]));
     }
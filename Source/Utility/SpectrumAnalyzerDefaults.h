@@ -13,6 +13,7 @@ struct Defaults {
     static constexpr int overlapFactor = 4;
     static constexpr auto smoothing = SmoothingMode::None;
     static constexpr float curveDecay = 0.95f;
+    static constexpr bool highRateDecimation = true;
     static juce::Colour primaryColour() { return juce::Colour(ColorPalette::primaryGreen); }
     static juce::Colour secondaryColour() { return juce::Colour(ColorPalette::secondaryAmber); }
     static juce::Colour refPrimaryColour() { return juce::Colour(ColorPalette::refPrimaryBlue); }
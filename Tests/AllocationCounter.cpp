@@ -0,0 +1,48 @@
+/*
+  Global operator new/delete replacements used by AllocationCounter.h
+
+  Only plain and array new are counted — the aligned and nothrow overloads
+  are left to the standard library.
+*/
+
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local bool countingEnabled = false;
+    thread_local size_t allocationCount = 0;
+
+    void *allocate(const std::size_t size) {
+        if (countingEnabled)
+            ++allocationCount;
+
+        if (void *p = std::malloc(size == 0 ? 1 : size))
+            return p;
+
+        throw std::bad_alloc();
+    }
+}
+
+void *operator new(const std::size_t size) { return allocate(size); }
+void *operator new[](const std::size_t size) { return allocate(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace AllocationCounter {
+    ScopedCount::ScopedCount()
+        : startCount(allocationCount), wasCounting(countingEnabled) {
+        countingEnabled = true;
+    }
+
+    ScopedCount::~ScopedCount() {
+        countingEnabled = wasCounting;
+    }
+
+    size_t ScopedCount::getCount() const {
+        return allocationCount - startCount;
+    }
+}
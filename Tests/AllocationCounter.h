@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counts global operator new calls made by the current thread while a ScopedCount is alive.
+ *
+ * The replacement operator new/delete live in AllocationCounter.cpp and forward to malloc/free,
+ * so linking this into the test executable changes nothing except the bookkeeping.
+ */
+namespace AllocationCounter {
+    class ScopedCount {
+    public:
+        ScopedCount();
+        ~ScopedCount();
+
+        /** Allocations made on this thread since construction. */
+        size_t getCount() const;
+
+        ScopedCount(const ScopedCount &) = delete;
+        ScopedCount &operator=(const ScopedCount &) = delete;
+
+    private:
+        size_t startCount;
+        bool wasCounting;
+    };
+}
@@ -1,15 +1,24 @@
 /*
   Core unit tests for gFractor plugin
 
-  Tests for AudioRingBuffer, ChannelDecoder, PeakHold, PluginState,
+  Tests for AudioRingBuffer, MirroredRing, CaptureBus, SinkRegistry, ChannelDecoder, PeakHold, PluginState,
   and parameter stability. Added after refactoring to verify core
   building blocks still work correctly.
 */
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
 
 #include "DSP/Processing/AudioRingBuffer.h"
+#include "DSP/Processing/CaptureBus.h"
+#include "DSP/Processing/MirroredRing.h"
+#include "DSP/Processing/WakeSignal.h"
+#include "DSP/Monitoring/PerformanceMonitor.h"
+#include "DSP/Monitoring/SinkRegistry.h"
 #include "DSP/Core/gFractorDSP.h"
 #include "DSP/Interfaces/IAudioDataSink.h"
 #include "Utility/ChannelMode.h"
@@ -43,8 +52,8 @@ public:
             expect(drained == 64);
 
             // Verify rolling buffer contents
-            const auto &L = ring.getL();
-            const auto &R = ring.getR();
+            const float *L = ring.getL();
+            const float *R = ring.getR();
             for (int i = 0; i < 64; ++i) {
                 expectWithinAbsoluteError(L[static_cast<size_t>(i)],
                                           static_cast<float>(i) * 0.01f, 1e-6f);
@@ -73,13 +82,18 @@ public:
 
             // The rolling buffer should contain the last 32 samples wrapped:
             // positions 0..15 hold samples 33..48, positions 16..31 hold samples 17..32
-            const auto &L = ring.getL();
+            const float *L = ring.getL();
             for (int i = 0; i < 16; ++i)
                 expectWithinAbsoluteError(L[static_cast<size_t>(i)],
                                           static_cast<float>(32 + i + 1), 1e-6f);
             for (int i = 16; i < 32; ++i)
                 expectWithinAbsoluteError(L[static_cast<size_t>(i)],
                                           static_cast<float>(i + 1), 1e-6f);
+
+            // Mirrored: from writePos on, the whole buffer reads oldest first (samples 17..48)
+            const float *window = L + ring.getWritePos();
+            for (int i = 0; i < rollingSize; ++i)
+                expectWithinAbsoluteError(window[i], static_cast<float>(17 + i), 1e-6f);
         }
 
         beginTest("Empty drain");
@@ -103,7 +117,7 @@ public:
             // Drain silently — rolling buffer should remain zeroed
             ring.drainSilently();
 
-            const auto &L = ring.getL();
+            const float *L = ring.getL();
             for (size_t i = 0; i < 128; ++i)
                 expectWithinAbsoluteError(L[i], 0.0f, 1e-6f);
 
@@ -148,17 +162,587 @@ public:
             ring.resizeRolling(64);
             expect(ring.getRollingSize() == 64);
             expect(ring.getWritePos() == 0);
-            expect(static_cast<int>(ring.getL().size()) == 64);
 
-            const auto &L = ring.getL();
-            for (size_t i = 0; i < 64; ++i)
+            const float *L = ring.getL();
+            for (size_t i = 0; i < 128; ++i)
                 expectWithinAbsoluteError(L[i], 0.0f, 1e-6f);
         }
+
+        beginTest("Decimated push");
+        {
+            AudioRingBuffer ring(4096, 2048);
+            ring.setDecimationStages(2);
+            expectEquals(ring.getDecimationStages(), 2);
+
+            // A DC block longer than the decimation chunk: a quarter as many samples, settling at the input level
+            juce::AudioBuffer<float> buf(2, 2000);
+            for (int i = 0; i < 2000; ++i) {
+                buf.setSample(0, i, 0.5f);
+                buf.setSample(1, i, -0.25f);
+            }
+            ring.push(buf);
+            expectEquals(ring.drain(), 500);
+            expectWithinAbsoluteError(ring.getL()[499], 0.5f, 1e-3f);
+            expectWithinAbsoluteError(ring.getR()[499], -0.25f, 1e-3f);
+
+            // Changing the decimation drops what was captured at the old rate
+            ring.push(buf);
+            ring.setDecimationStages(0);
+            expectEquals(ring.getWritePos(), 0);
+            expectEquals(ring.drain(), 0);
+            ring.push(buf);
+            expectEquals(ring.drain(), 2000);
+        }
     }
 };
 
 static AudioRingBufferTests audioRingBufferTests;
 
+//==============================================================================
+// MirroredRing Tests
+//==============================================================================
+
+class MirroredRingTests : public juce::UnitTest {
+public:
+    MirroredRingTests() : UnitTest("MirroredRing Tests", "Core") {
+    }
+
+    void runTest() override {
+        // A page multiple maps the mirror where the OS can; 1000 samples always copies
+        for (const int size: {4096, 1000}) {
+            beginTest("Wrapping write and mirror, " + juce::String(size) + " samples");
+
+            MirroredRing ring(size);
+            expectEquals(ring.getSize(), size);
+
+            const float *data = ring.getData();
+            bool zeroed = true;
+            for (int i = 0; i < size * 2; ++i)
+                zeroed = zeroed && data[i] == 0.0f;
+            expect(zeroed);
+
+            // A full-size write starting near the end wraps to the front
+            std::vector<float> ramp(static_cast<size_t>(size));
+            for (int i = 0; i < size; ++i)
+                ramp[static_cast<size_t>(i)] = static_cast<float>(i + 1);
+
+            const int start = size - 10;
+            ring.write(start, ramp.data(), size);
+
+            bool contiguous = true, mirrored = true;
+            for (int i = 0; i < size; ++i) {
+                contiguous = contiguous && data[start + i] == ramp[static_cast<size_t>(i)];
+                mirrored = mirrored && data[i + size] == data[i];
+            }
+            expect(contiguous);
+            expect(mirrored);
+            expectEquals(data[0], 11.0f);
+
+            ring.clear();
+            expectEquals(data[start], 0.0f);
+            expectEquals(data[size], 0.0f);
+
+            ring.setSize(size / 2);
+            expectEquals(ring.getSize(), size / 2);
+        }
+    }
+};
+
+static MirroredRingTests mirroredRingTests;
+
+//==============================================================================
+// CaptureBus Tests
+//==============================================================================
+class CaptureBusTests : public juce::UnitTest {
+public:
+    CaptureBusTests() : UnitTest("CaptureBus Tests", "Core") {
+    }
+
+    void runTest() override {
+        beginTest("One write, every reader sees it");
+        {
+            CaptureBus bus(256);
+            expectEquals(bus.getCapacity(), 256);
+
+            CaptureBus::Reader first(&bus), second(&bus);
+            std::vector<float> left(100), right(100);
+            for (int i = 0; i < 100; ++i) {
+                left[static_cast<size_t>(i)] = static_cast<float>(i);
+                right[static_cast<size_t>(i)] = static_cast<float>(-i);
+            }
+            bus.write(left.data(), right.data(), 100);
+
+            for (auto *reader: {&first, &second}) {
+                std::vector<float> seenL, seenR;
+                const int count = reader->read(1000, [&](const float *l, const float *r, const int n) {
+                    seenL.insert(seenL.end(), l, l + n);
+                    seenR.insert(seenR.end(), r, r + n);
+                });
+                expectEquals(count, 100);
+                expect(seenL == left && seenR == right);
+                expectEquals(reader->read(1000, [](const float *, const float *, int) {}), 0);
+            }
+
+            // A reader attached later starts at the end
+            CaptureBus::Reader late(&bus);
+            expectEquals(late.getNumReady(), 0);
+        }
+
+        beginTest("Wrap into two spans");
+        {
+            CaptureBus bus(64);
+            CaptureBus::Reader reader(&bus);
+            std::vector<float> block(40);
+
+            float next = 0.0f;
+            for (int round = 0; round < 5; ++round) {
+                for (auto &sample: block)
+                    sample = next++;
+                bus.write(block.data(), block.data(), 40);
+
+                int spans = 0;
+                std::vector<float> seen;
+                reader.read(1000, [&](const float *l, const float *, const int n) {
+                    ++spans;
+                    seen.insert(seen.end(), l, l + n);
+                });
+                expect(seen == block);
+                expect(spans <= 2);
+            }
+        }
+
+        beginTest("A late reader skips to the newest frames");
+        {
+            CaptureBus bus(64);
+            CaptureBus::Reader reader(&bus);
+            std::vector<float> block(200);
+            for (int i = 0; i < 200; ++i)
+                block[static_cast<size_t>(i)] = static_cast<float>(i);
+
+            // Oversized: only the last capacity frames are kept, the reader only trusts 3/4 of them
+            bus.write(block.data(), block.data(), 200);
+            expect(bus.getWritePosition() == 200);
+
+            float firstSeen = -1.0f;
+            int count = reader.read(1000, [&](const float *l, const float *, int) {
+                if (firstSeen < 0.0f)
+                    firstSeen = l[0];
+            });
+            expectEquals(count, 48);
+            expectEquals(firstSeen, 152.0f);
+            expect(reader.getNumDropped() == 152);
+
+            // maxFrames caps the backlog the same way
+            bus.write(block.data(), block.data(), 30);
+            count = reader.read(10, [](const float *, const float *, int) {});
+            expectEquals(count, 10);
+            expect(reader.getNumDropped() == 172);
+        }
+
+        beginTest("Frames overwritten during a read are dropped, never torn");
+        {
+            CaptureBus bus(4096);
+            CaptureBus::Reader reader(&bus);
+            std::vector<float> block(3000);
+            for (int i = 0; i < 3000; ++i)
+                block[static_cast<size_t>(i)] = static_cast<float>(i);
+            bus.write(block.data(), block.data(), 3000);
+
+            // The writer laps the reader while it consumes its first chunk: the rest of the backlog
+            // was overwritten with -1, so it must not be handed on
+            const std::vector<float> marker(4096, -1.0f);
+            std::vector<float> seen;
+            bool lapped = false;
+            const int count = reader.read(4096, [&](const float *l, const float *, const int n) {
+                seen.insert(seen.end(), l, l + n);
+                if (!std::exchange(lapped, true))
+                    bus.write(marker.data(), marker.data(), 4096);
+            });
+
+            expectEquals(count, CaptureBus::kReadChunk);
+            expectEquals(static_cast<int>(seen.size()), CaptureBus::kReadChunk);
+            for (int i = 0; i < count; ++i)
+                expectEquals(seen[static_cast<size_t>(i)], static_cast<float>(i));
+            expect(reader.getNumDropped() == static_cast<std::uint64_t>(3000 - CaptureBus::kReadChunk));
+        }
+
+        beginTest("Silence marker");
+        {
+            CaptureBus bus(64);
+            float sample = 0.5f;
+            expect(!bus.isSilent());
+            bus.markSilent();
+            expect(bus.isSilent());
+            bus.write(&sample, &sample, 1);
+            expect(!bus.isSilent());
+        }
+
+        beginTest("Overrun telemetry");
+        {
+            PerformanceMonitor monitor;
+            auto &metrics = monitor.getMainFifoMetrics(0);
+            CaptureBus bus(64);
+            bus.setMetrics(&metrics);
+            expectEquals(metrics.capacity.load(), 64);
+
+            std::vector<float> data(200, 0.0f);
+            auto discard = [](const float *, const float *, int) {};
+
+            CaptureBus::Reader a(&bus), b(&bus);
+            bus.write(data.data(), data.data(), 30);
+            a.read(64, discard);
+            expectEquals(metrics.highWaterMark.load(), 30);
+            expectEquals(metrics.overruns.load(), 0);
+
+            // A reader taking only the newest frames skips the rest, but nothing was lost
+            bus.write(data.data(), data.data(), 30);
+            a.read(10, discard);
+            expectEquals(metrics.overruns.load(), 0);
+            expect(metrics.droppedSamples.load() == 0);
+
+            // Stalled readers: the writer overwrote all but the last 64 frames of what each missed
+            // (b also missed the earlier 60 frames)
+            bus.write(data.data(), data.data(), 200);
+            a.read(64, discard);
+            b.read(64, discard);
+            expectEquals(metrics.overruns.load(), 2);
+            expect(metrics.droppedSamples.load() == (200 - 64) + (260 - 64));
+            expectEquals(metrics.highWaterMark.load(), 64);
+
+            monitor.reset();
+            expectEquals(metrics.overruns.load(), 0);
+            expect(metrics.droppedSamples.load() == 0);
+            expectEquals(metrics.highWaterMark.load(), 0);
+            expectEquals(metrics.capacity.load(), 64);
+        }
+
+        beginTest("Waiting reader wakes on data, silence or request");
+        {
+            CaptureBus bus(1024);
+            CaptureBus::Reader reader(&bus);
+            std::vector<float> block(64, 0.25f);
+            constexpr int kLongMs = 5000;
+
+            // Already there: no wait
+            bus.write(block.data(), block.data(), 64);
+            expect(reader.waitForData(64, kLongMs));
+
+            // Writes below the threshold leave it waiting; the write that reaches it wakes it
+            reader.skipToEnd();
+            std::thread writer([&] {
+                for (int i = 0; i < 4; ++i) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                    bus.write(block.data(), block.data(), 64);
+                }
+            });
+            auto start = std::chrono::steady_clock::now();
+            expect(reader.waitForData(256, -1));
+            writer.join();
+            expectEquals(reader.getNumReady(), 256);
+            expect(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(kLongMs));
+
+            // A silence mark or an explicit wake ends the wait without data
+            reader.skipToEnd();
+            for (const bool viaSilence: {true, false}) {
+                std::thread waker([&] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    if (viaSilence)
+                        bus.markSilent();
+                    else
+                        bus.wakeReader();
+                });
+                start = std::chrono::steady_clock::now();
+                expect(!reader.waitForData(64, kLongMs));
+                waker.join();
+                expect(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(kLongMs));
+            }
+
+            // A wake requested before the wait ends the next wait at once
+            bus.wakeReader();
+            start = std::chrono::steady_clock::now();
+            expect(!reader.waitForData(64, kLongMs));
+            expect(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(kLongMs));
+
+            // Silence from before the wait does not end it, silence after a new write does
+            expect(bus.isSilent());
+            std::thread resilencer([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                bus.write(block.data(), block.data(), 16);
+                bus.markSilent();
+            });
+            start = std::chrono::steady_clock::now();
+            expect(!reader.waitForData(64, kLongMs));
+            resilencer.join();
+            expectEquals(reader.getNumReady(), 16);
+            expect(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(kLongMs));
+
+            // Nothing at all: the timeout
+            expect(!reader.waitForData(64, 10));
+        }
+
+        beginTest("Wake signal never loses a post");
+        {
+            WakeSignal signal;
+
+            // Posted between prepare() and wait(): no sleep
+            auto token = signal.prepare();
+            signal.post();
+            expect(signal.wait(token, 5000));
+
+            // Nothing posted: the timeout
+            expect(!signal.wait(signal.prepare(), 10));
+
+            // Posted from another thread while the waiter sleeps, many times over
+            for (int i = 0; i < 200; ++i) {
+                token = signal.prepare();
+                std::thread poster([&] { signal.post(); });
+                expect(signal.wait(token, -1));
+                poster.join();
+            }
+        }
+    }
+};
+
+static CaptureBusTests captureBusTests;
+
+//==============================================================================
+// SinkRegistry Tests
+//==============================================================================
+class SinkRegistryTests : public juce::UnitTest {
+public:
+    SinkRegistryTests() : UnitTest("SinkRegistry Tests", "Core") {
+    }
+
+    void runTest() override {
+        juce::AudioBuffer<float> block(2, 64);
+        for (int i = 0; i < 64; ++i) {
+            block.setSample(0, i, static_cast<float>(i) * 0.01f);
+            block.setSample(1, i, static_cast<float>(i) * -0.01f);
+        }
+
+        beginTest("Capture bus fan-out");
+        {
+            SinkRegistry registry;
+            Sink sinkA, sinkB;
+            GhostSink ghost;
+
+            registry.registerAudioDataSink(&sinkA);
+            registry.registerAudioDataSink(&sinkB);
+            expect(sinkA.reader.getBus() == &registry.getCaptureBus());
+            registry.prepareSinks(48000.0);
+            expectEquals(sinkA.sampleRateUpdates.load(), 1);
+
+            // Written once, read by both in place
+            registry.pushAudioData(block, false, false);
+            expect(registry.getCaptureBus().getWritePosition() == 64);
+            expectEquals(sinkA.pull(), 64);
+            expectEquals(sinkB.pull(), 64);
+            expectWithinAbsoluteError(sinkB.lastLeft, 0.63f, 1e-6f);
+            expectWithinAbsoluteError(sinkB.lastRight, -0.63f, 1e-6f);
+
+            registry.unregisterAudioDataSink(&sinkA);
+            expect(sinkA.reader.getBus() == nullptr);
+            registry.pushAudioData(block, false, false);
+            expectEquals(sinkA.pull(), 0);
+            expectEquals(sinkB.pull(), 64);
+
+            registry.pushSilence();
+            expect(registry.getCaptureBus().isSilent());
+
+            // The ghost bus carries the sidechain, or the main input in reference mode
+            juce::AudioBuffer<float> sidechain(2, 64);
+            sidechain.clear();
+            registry.setGhostDataSink(&ghost);
+            expect(registry.getGhostDataSink() == &ghost);
+            expect(ghost.reader.getBus() == &registry.getGhostCaptureBus());
+            registry.pushGhostData(block, sidechain, true, false);
+            expectEquals(ghost.pull(), 64);
+            expectEquals(ghost.lastLeft, 0.0f);
+            registry.pushGhostData(block, sidechain, true, true);
+            expectEquals(ghost.pull(), 64);
+            expectWithinAbsoluteError(ghost.lastLeft, 0.63f, 1e-6f);
+            registry.pushGhostData(block, sidechain, false, false);
+            expectEquals(ghost.pull(), 0);
+
+            registry.setGhostDataSink(nullptr);
+            expect(registry.getGhostDataSink() == nullptr);
+            expect(ghost.reader.getBus() == nullptr);
+        }
+
+        beginTest("Subscription formats");
+        {
+            SinkRegistry registry;
+            Sink midSideA, midSideB, mono;
+            midSideA.format = midSideB.format = SinkFormat::MidSide;
+            mono.format = SinkFormat::Mono;
+
+            registry.registerAudioDataSink(&midSideA);
+            registry.registerAudioDataSink(&midSideB);
+            registry.registerAudioDataSink(&mono);
+            expect(midSideA.reader.getBus() == &registry.getCaptureBus(SinkFormat::MidSide));
+            expect(midSideB.reader.getBus() == midSideA.reader.getBus());
+            expect(mono.reader.getBus() == &registry.getCaptureBus(SinkFormat::Mono));
+
+            // Last frame: L = 0.63, R = -0.63, so mid 0 and side 0.63; no L/R subscriber, no L/R write
+            registry.pushAudioData(block, false, false);
+            expect(registry.getCaptureBus(SinkFormat::MidSide).getWritePosition() == 64);
+            expect(registry.getCaptureBus().getWritePosition() == 0);
+            expectEquals(midSideA.pull(), 64);
+            expectEquals(midSideB.pull(), 64);
+            expectWithinAbsoluteError(midSideB.lastLeft, 0.0f, 1e-6f);
+            expectWithinAbsoluteError(midSideB.lastRight, 0.63f, 1e-6f);
+            expectEquals(mono.pull(), 64);
+            expectWithinAbsoluteError(mono.lastLeft, 0.0f, 1e-6f);
+
+            // Longer than the unprepared scratch: produced in chunks, nothing lost
+            juce::AudioBuffer<float> longBlock(2, 1500);
+            for (int i = 0; i < 1500; ++i) {
+                longBlock.setSample(0, i, 1.0f);
+                longBlock.setSample(1, i, static_cast<float>(i) / 1500.0f);
+            }
+            registry.pushAudioData(longBlock, false, false);
+            expectEquals(midSideA.pull(), 1500);
+            expectWithinAbsoluteError(midSideA.lastLeft, (1.0f + 1499.0f / 1500.0f) * 0.5f, 1e-6f);
+            expectWithinAbsoluteError(midSideA.lastRight, (1.0f - 1499.0f / 1500.0f) * 0.5f, 1e-6f);
+            expectEquals(mono.pull(), 1500);
+
+            // A format nobody reads any more is no longer produced
+            registry.unregisterAudioDataSink(&midSideA);
+            registry.unregisterAudioDataSink(&midSideB);
+            registry.pushAudioData(block, false, false);
+            expect(registry.getCaptureBus(SinkFormat::MidSide).getWritePosition() == 64 + 1500);
+            expectEquals(mono.pull(), 64);
+        }
+
+        beginTest("Telemetry per bus");
+        {
+            PerformanceMonitor monitor;
+            SinkRegistry registry;
+            registry.setFifoMetrics(monitor);
+
+            Sink leftRight, midSide;
+            midSide.format = SinkFormat::MidSide;
+            registry.registerAudioDataSink(&leftRight);
+            registry.registerAudioDataSink(&midSide);
+
+            registry.pushAudioData(block, false, false);
+            leftRight.pull();
+            registry.pushAudioData(block, false, false);
+            midSide.pull();
+
+            const auto &lr = monitor.getMainFifoMetrics(static_cast<int>(SinkFormat::LeftRight));
+            const auto &ms = monitor.getMainFifoMetrics(static_cast<int>(SinkFormat::MidSide));
+            const auto &mono = monitor.getMainFifoMetrics(static_cast<int>(SinkFormat::Mono));
+            expectEquals(lr.highWaterMark.load(), block.getNumSamples());
+            expectEquals(ms.highWaterMark.load(), 2 * block.getNumSamples());
+            expectEquals(mono.highWaterMark.load(), 0);
+            expectEquals(lr.capacity.load(), SinkRegistry::kCaptureBusCapacity);
+            expectEquals(monitor.getGhostFifoMetrics().capacity.load(), SinkRegistry::kCaptureBusCapacity);
+
+            registry.unregisterAudioDataSink(&midSide);
+            registry.unregisterAudioDataSink(&leftRight);
+        }
+
+        beginTest("Register/unregister under contention");
+        {
+            SinkRegistry registry;
+            Sink resident;
+            registry.registerAudioDataSink(&resident);
+
+            // Sinks stay allocated to the end, so a call after unregister is counted, not a crash
+            std::vector<std::unique_ptr<Sink>> sinks;
+            std::vector<std::unique_ptr<GhostSink>> ghosts;
+            constexpr int kRounds = 2000;
+            sinks.reserve(kRounds);
+            ghosts.reserve(kRounds);
+
+            // The audio thread writes; prepareSinks() stands in for a host preparing off the message thread
+            std::atomic<bool> stop{false};
+            std::atomic<int> blocks{0};
+            std::thread audioThread([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    registry.pushAudioData(block, true, false);
+                    registry.pushGhostData(block, block, true, false);
+                    registry.pushSilence();
+                    registry.prepareSinks(48000.0);
+                    blocks.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            for (int round = 0; round < kRounds; ++round) {
+                auto &sink = sinks.emplace_back(std::make_unique<Sink>());
+                auto &ghost = ghosts.emplace_back(std::make_unique<GhostSink>());
+                registry.registerAudioDataSink(sink.get());
+                registry.setGhostDataSink(ghost.get());
+                sink->pull();
+                ghost->pull();
+                std::this_thread::yield();
+
+                registry.setGhostDataSink(nullptr);
+                registry.unregisterAudioDataSink(sink.get());
+                sink->retired.store(true, std::memory_order_relaxed);
+            }
+
+            // Let the audio thread run a few more blocks past the last unregister
+            const int blocksAtEnd = blocks.load();
+            while (blocks.load() < blocksAtEnd + 100)
+                std::this_thread::yield();
+            stop.store(true);
+            audioThread.join();
+
+            int lateCalls = 0;
+            for (const auto &sink: sinks)
+                lateCalls += sink->lateCalls.load();
+
+            expectEquals(lateCalls, 0, "Nothing reaches a sink after its unregister returned");
+            expect(resident.sampleRateUpdates.load() >= blocksAtEnd, "The resident sink saw every prepare");
+            expect(resident.pull() > 0);
+        }
+    }
+
+private:
+    struct Sink : IAudioDataSink {
+        SinkFormat getSinkFormat() const override { return format; }
+
+        void setCaptureBus(const CaptureBus *bus) override { reader.attach(bus); }
+
+        void setSampleRate(double) override {
+            sampleRateUpdates.fetch_add(1, std::memory_order_relaxed);
+            if (retired.load(std::memory_order_relaxed))
+                lateCalls.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /** What a visualizer's timer does: copy the new frames out. */
+        int pull() {
+            return reader.read(SinkRegistry::kCaptureBusCapacity, [this](const float *l, const float *r, const int n) {
+                lastLeft = l[n - 1];
+                lastRight = r[n - 1];
+            });
+        }
+
+        SinkFormat format = SinkFormat::LeftRight;
+        CaptureBus::Reader reader;
+        float lastLeft = 0.0f, lastRight = 0.0f;
+        std::atomic<int> sampleRateUpdates{0}, lateCalls{0};
+        std::atomic<bool> retired{false};
+    };
+
+    struct GhostSink : IGhostDataSink {
+        void setGhostCaptureBus(const CaptureBus *bus) override { reader.attach(bus); }
+
+        int pull() {
+            return reader.read(SinkRegistry::kCaptureBusCapacity, [this](const float *l, const float *, const int n) {
+                lastLeft = l[n - 1];
+            });
+        }
+
+        CaptureBus::Reader reader;
+        float lastLeft = 0.0f;
+    };
+};
+
+static SinkRegistryTests sinkRegistryTests;
+
 //==============================================================================
 // ChannelDecoder Tests
 //==============================================================================
@@ -758,7 +1342,7 @@ public:
             }
 
             expectEquals(sink.sampleRateUpdates, 3);
-            expectEquals(sink.pushCalls, 3);
+            expectEquals(sink.pull(), 512 + 256 + 1024);
             expectWithinAbsoluteError(sink.lastSampleRate, 48000.0, 0.001);
 
             proc.unregisterAudioDataSinkForTest(&sink);
@@ -783,8 +1367,8 @@ public:
             juce::MidiBuffer midi;
             proc.processBlock(block, midi);
 
-            expectEquals(sinkA.pushCalls, 1);
-            expectEquals(sinkB.pushCalls, 1);
+            expectEquals(sinkA.pull(), 64);
+            expectEquals(sinkB.pull(), 64);
             expectEquals(sinkA.sampleRateUpdates, 1);
             expectEquals(sinkB.sampleRateUpdates, 1);
 
@@ -794,22 +1378,25 @@ public:
             fillMainInput(block, 0.5f);
             proc.processBlock(block, midi);
 
-            expectEquals(sinkA.pushCalls, 1);
-            expectEquals(sinkB.pushCalls, 2);
+            expectEquals(sinkA.pull(), 0);
+            expectEquals(sinkB.pull(), 64);
             expect(allFinite(block));
         }
     }
 
 private:
     struct CountingSink : IAudioDataSink {
-        void pushStereoData(const juce::AudioBuffer<float> &) override { ++pushCalls; }
+        void setCaptureBus(const CaptureBus *bus) override { reader.attach(bus); }
 
         void setSampleRate(const double sr) override {
             ++sampleRateUpdates;
             lastSampleRate = sr;
         }
 
-        int pushCalls = 0;
+        /** Frames written since the last pull. */
+        int pull() { return reader.read(SinkRegistry::kCaptureBusCapacity, [](const float *, const float *, int) {}); }
+
+        CaptureBus::Reader reader;
         int sampleRateUpdates = 0;
         double lastSampleRate = 0.0;
     };
@@ -832,10 +1419,7 @@ private:
             spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
             spec.numChannels = static_cast<juce::uint32>(getTotalNumInputChannels());
             dsp.prepare(spec);
-
-            const juce::SpinLock::ScopedLockType lock(sinkLock);
-            for (auto *sink: sinks)
-                sink->setSampleRate(sampleRate);
+            sinks.prepareSinks(sampleRate);
         }
 
         void releaseResources() override {
@@ -856,12 +1440,7 @@ private:
                 }
             }
 
-            {
-                const juce::SpinLock::ScopedLockType lock(sinkLock);
-                for (auto *sink: sinks)
-                    sink->pushStereoData(buffer);
-            }
-
+            sinks.pushAudioData(buffer, hasSidechain, referenceMode.load(std::memory_order_relaxed));
             dsp.process(buffer);
         }
 
@@ -888,15 +1467,11 @@ private:
         }
 
         void registerAudioDataSinkForTest(IAudioDataSink *sink) {
-            if (sink == nullptr)
-                return;
-            const juce::SpinLock::ScopedLockType lock(sinkLock);
-            sinks.push_back(sink);
+            sinks.registerAudioDataSink(sink);
         }
 
         void unregisterAudioDataSinkForTest(IAudioDataSink *sink) {
-            const juce::SpinLock::ScopedLockType lock(sinkLock);
-            sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+            sinks.unregisterAudioDataSink(sink);
         }
 
         void setReferenceModeForTest(const bool enabled) {
@@ -908,9 +1483,8 @@ private:
         }
 
     private:
-        gFractorDSP dsp;
-        juce::SpinLock sinkLock;
-        std::vector<IAudioDataSink *> sinks;
+        gFractorDSP<float> dsp;
+        SinkRegistry sinks;
         std::atomic<bool> referenceMode{false};
         std::atomic<bool> sidechainAvailable{false};
     };
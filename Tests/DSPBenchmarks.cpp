@@ -0,0 +1,541 @@
+/*
+  DSP micro-benchmarks for gFractor plugin
+
+  Built as a separate executable (gFractorBenchmarks) and not registered with
+  CTest — timings are informational and depend on the host machine.
+  Run the executable directly from a Release build:
+
+      ./Tests/gFractorBenchmarks
+*/
+
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "DSP/Core/gFractorDSP.h"
+#include "DSP/Processing/BandSoloBank.h"
+#include "DSP/Processing/MidSidePeakKernel.h"
+#include "DSP/Processing/MultibandCrossover.h"
+#include "DSP/Processing/SpectralAudition.h"
+#include "DSP/Processing/StereoBiquadCascade.h"
+#include "DSP/Processing/TruePeakMeter.h"
+#include "Utility/ChannelMode.h"
+
+namespace {
+    constexpr std::array kBenchmarkBlockSizes = {32, 64, 128, 256, 512, 1024, 2048, 4096};
+
+    // Total samples processed per measurement, independent of block size
+    constexpr int kSamplesPerMeasurement = 1 << 24;
+
+    void fillNoise(std::vector<float> &data, juce::Random &random) {
+        for (auto &s: data)
+            s = random.nextFloat() * 2.0f - 1.0f;
+    }
+
+    /** Runs fn() repeatedly until kSamplesPerMeasurement samples have been processed; returns samples/ns. */
+    template<typename Fn>
+    double measureSamplesPerNs(const int blockSize, Fn &&fn) {
+        const int iterations = juce::jmax(1, kSamplesPerMeasurement / blockSize);
+
+        // Warm caches and branch predictors before timing
+        for (int i = 0; i < 64; ++i)
+            fn();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < iterations; ++i)
+            fn();
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        const double ns = juce::Time::highResolutionTicksToSeconds(elapsed) * 1.0e9;
+        return ns > 0.0 ? static_cast<double>(iterations) * blockSize / ns : 0.0;
+    }
+}
+
+//==============================================================================
+// Mid/side peak meter kernel
+//==============================================================================
+class PeakMeterBenchmark : public juce::UnitTest {
+public:
+    PeakMeterBenchmark() : UnitTest("Peak Meter Kernel", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("Mid/side abs-max, samples/ns");
+
+        juce::Random random(42);
+        std::vector<float> left(static_cast<size_t>(kBenchmarkBlockSizes.back()));
+        std::vector<float> right(left.size());
+        fillNoise(left, random);
+        fillNoise(right, random);
+
+        constexpr std::array kIsas = {
+            MidSidePeakKernel::Isa::Scalar,
+            MidSidePeakKernel::Isa::SSE2,
+            MidSidePeakKernel::Isa::AVX2,
+            MidSidePeakKernel::Isa::NEON,
+        };
+
+        logMessage("Active kernel: " + juce::String(MidSidePeakKernel::getIsaName(MidSidePeakKernel::getActiveIsa())));
+
+        volatile float sink = 0.0f;
+
+        for (const auto isa: kIsas) {
+            if (!MidSidePeakKernel::isSupported(isa))
+                continue;
+
+            juce::String line = juce::String(MidSidePeakKernel::getIsaName(isa)).paddedRight(' ', 8);
+
+            for (const int blockSize: kBenchmarkBlockSizes) {
+                const double rate = measureSamplesPerNs(blockSize, [&] {
+                    const auto peaks = MidSidePeakKernel::process(isa, left.data(), right.data(),
+                                                                  static_cast<size_t>(blockSize));
+                    sink = sink + peaks.mid + peaks.side;
+                });
+                line << " " << blockSize << ":" << juce::String(rate, 2);
+            }
+
+            logMessage(line);
+        }
+
+        expect(std::isfinite(sink));
+    }
+};
+
+static PeakMeterBenchmark peakMeterBenchmark;
+
+//==============================================================================
+// BS.1770 4x true-peak meter vs the sample-peak kernel
+//==============================================================================
+class TruePeakBenchmark : public juce::UnitTest {
+public:
+    TruePeakBenchmark() : UnitTest("True Peak Meter", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("Mid/side peaks, stereo samples/ns");
+
+        juce::Random random(42);
+        std::vector<float> left(static_cast<size_t>(kBenchmarkBlockSizes.back()));
+        std::vector<float> right(left.size());
+        fillNoise(left, random);
+        fillNoise(right, random);
+
+        volatile float sink = 0.0f;
+
+        juce::String sampleLine = juce::String("Sample").paddedRight(' ', 14);
+        juce::String risingLine = juce::String("TP rising").paddedRight(' ', 14);
+        juce::String heldLine = juce::String("Sample+TP held").paddedRight(' ', 14);
+
+        for (const int blockSize: kBenchmarkBlockSizes) {
+            const auto n = static_cast<size_t>(blockSize);
+
+            const double sampleRate = measureSamplesPerNs(blockSize, [&] {
+                const auto peaks = MidSidePeakKernel::process(left.data(), right.data(), n);
+                sink = sink + peaks.mid + peaks.side;
+            });
+
+            // Worst case: the hold is cleared every block, so every chunk runs the polyphase filter
+            TruePeakMeter meter;
+            meter.prepare(blockSize);
+            const double risingRate = measureSamplesPerNs(blockSize, [&] {
+                meter.resetHold();
+                meter.process(left.data(), right.data(), n, TruePeakMeter::Decode::MidSide);
+                sink = sink + meter.getHeldPeak(0);
+            });
+
+            // Steady state: programme 12 dB under the held peak only pays for the decode pass
+            meter.resetHold();
+            meter.process(left.data(), right.data(), n, TruePeakMeter::Decode::MidSide);
+            std::vector<float> quietL(left), quietR(right);
+            for (size_t i = 0; i < quietL.size(); ++i) {
+                quietL[i] *= 0.25f;
+                quietR[i] *= 0.25f;
+            }
+            // Sample peaks plus the true-peak meter gated on them, as gFractorDSP runs it in M/S
+            const double heldRate = measureSamplesPerNs(blockSize, [&] {
+                const auto peaks = MidSidePeakKernel::process(quietL.data(), quietR.data(), n);
+                meter.process(quietL.data(), quietR.data(), n, TruePeakMeter::Decode::MidSide, {peaks.mid, peaks.side});
+                sink = sink + peaks.mid + meter.getHeldPeak(0);
+            });
+
+            sampleLine << " " << blockSize << ":" << juce::String(sampleRate, 2);
+            risingLine << " " << blockSize << ":" << juce::String(risingRate, 2);
+            heldLine << " " << blockSize << ":" << juce::String(heldRate, 2);
+        }
+
+        logMessage(sampleLine);
+        logMessage(risingLine);
+        logMessage(heldLine);
+        expect(std::isfinite(sink));
+    }
+};
+
+static TruePeakBenchmark truePeakBenchmark;
+
+//==============================================================================
+// 4th-order stereo bandpass: four scalar biquads vs the SIMD wavefront cascade
+//==============================================================================
+class BiquadCascadeBenchmark : public juce::UnitTest {
+public:
+    BiquadCascadeBenchmark() : UnitTest("Biquad Cascade", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("Stereo 4th-order bandpass, samples/ns");
+
+        juce::Random random(42);
+        std::vector<float> sourceL(static_cast<size_t>(kBenchmarkBlockSizes.back()));
+        std::vector<float> sourceR(sourceL.size());
+        fillNoise(sourceL, random);
+        fillNoise(sourceR, random);
+        std::vector<float> left(sourceL.size()), right(sourceR.size());
+
+        const auto coefficients = BiquadCoefficients::bandPass(48000.0, 1000.0f, 2.0f);
+        volatile float sink = 0.0f;
+
+        const auto refill = [&](const int blockSize) {
+            std::copy_n(sourceL.begin(), blockSize, left.begin());
+            std::copy_n(sourceR.begin(), blockSize, right.begin());
+        };
+
+        juce::String scalarLine = juce::String("Scalar").paddedRight(' ', 8);
+        juce::String simdLine = juce::String("SIMD").paddedRight(' ', 8);
+
+        for (const int blockSize: kBenchmarkBlockSizes) {
+            BiquadState l1, l2, r1, r2;
+            const double scalarRate = measureSamplesPerNs(blockSize, [&] {
+                refill(blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    left[static_cast<size_t>(i)] = l2.process(l1.process(left[static_cast<size_t>(i)], coefficients), coefficients);
+                    right[static_cast<size_t>(i)] = r2.process(r1.process(right[static_cast<size_t>(i)], coefficients), coefficients);
+                }
+                sink = sink + left[0];
+            });
+
+            StereoBiquadCascade<float> cascade;
+            auto c = coefficients;
+            const double simdRate = measureSamplesPerNs(blockSize, [&] {
+                refill(blockSize);
+                cascade.process(left.data(), right.data(), static_cast<size_t>(blockSize), c);
+                sink = sink + left[0];
+            });
+
+            scalarLine << " " << blockSize << ":" << juce::String(scalarRate, 3);
+            simdLine << " " << blockSize << ":" << juce::String(simdRate, 3);
+        }
+
+        logMessage(scalarLine);
+        logMessage(simdLine);
+        expect(std::isfinite(sink));
+    }
+};
+
+static BiquadCascadeBenchmark biquadCascadeBenchmark;
+
+//==============================================================================
+// Band solo: one cascade per soloed band vs the 8-lane bank
+//==============================================================================
+class BandSoloBenchmark : public juce::UnitTest {
+public:
+    BandSoloBenchmark() : UnitTest("Band Solo", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("Soloed bands summed, stereo samples/ns by band count");
+
+        constexpr int blockSize = 512;
+        constexpr double sampleRate = 48000.0;
+
+        juce::Random random(42);
+        std::vector<float> sourceL(static_cast<size_t>(blockSize)), sourceR(sourceL.size());
+        fillNoise(sourceL, random);
+        fillNoise(sourceR, random);
+        std::vector<float> left(sourceL.size()), right(sourceR.size());
+        std::vector<float> bandL(sourceL.size()), bandR(sourceR.size());
+        volatile float sink = 0.0f;
+
+        juce::String cascadeLine = juce::String("Cascades").paddedRight(' ', 10);
+        juce::String bankLine = juce::String("Bank").paddedRight(' ', 10);
+
+        for (int numBands = 1; numBands <= kNumBands; ++numBands) {
+            // Naive: a full 4th-order cascade per soloed band, outputs summed
+            std::vector<StereoBiquadCascade<float>> cascades(static_cast<size_t>(numBands));
+            std::vector<BiquadCoefficients> coefficients;
+            for (size_t band = 0; band < cascades.size(); ++band) {
+                const auto info = getBandInfo(band);
+                coefficients.push_back(BiquadCoefficients::bandPass(sampleRate, info.centerFreq, info.q));
+            }
+
+            const double cascadeRate = measureSamplesPerNs(blockSize, [&] {
+                std::fill(left.begin(), left.end(), 0.0f);
+                std::fill(right.begin(), right.end(), 0.0f);
+                for (size_t band = 0; band < cascades.size(); ++band) {
+                    std::copy(sourceL.begin(), sourceL.end(), bandL.begin());
+                    std::copy(sourceR.begin(), sourceR.end(), bandR.begin());
+                    cascades[band].process(bandL.data(), bandR.data(), bandL.size(), coefficients[band]);
+                    for (size_t i = 0; i < left.size(); ++i) {
+                        left[i] += bandL[i];
+                        right[i] += bandR[i];
+                    }
+                }
+                sink = sink + left[0];
+            });
+
+            BandSoloBank bank;
+            bank.setSoloMask((1u << numBands) - 1u);
+            bank.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 2});
+            bank.beginBlock();
+
+            const double bankRate = measureSamplesPerNs(blockSize, [&] {
+                std::copy(sourceL.begin(), sourceL.end(), left.begin());
+                std::copy(sourceR.begin(), sourceR.end(), right.begin());
+                bank.processStereo(left.data(), right.data(), left.size());
+                bank.endBlock();
+                sink = sink + left[0];
+            });
+
+            cascadeLine << " " << numBands << ":" << juce::String(cascadeRate, 3);
+            bankLine << " " << numBands << ":" << juce::String(bankRate, 3);
+        }
+
+        logMessage(cascadeLine);
+        logMessage(bankLine);
+        expect(std::isfinite(sink));
+    }
+};
+
+static BandSoloBenchmark bandSoloBenchmark;
+
+//==============================================================================
+// Staged vs fused gFractorDSP pipeline
+//==============================================================================
+class PipelineBenchmark : public juce::UnitTest {
+public:
+    PipelineBenchmark() : UnitTest("DSP Pipeline", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("Staged vs fused, samples/ns");
+
+        struct Scenario {
+            const char *name;
+            ChannelMode mode;
+            float dryWet;
+            bool filters;
+        };
+
+        constexpr std::array kScenarios = {
+            Scenario{"M/S wet", ChannelMode::MidSide, 1.0f, false},
+            Scenario{"M/S mix+filters", ChannelMode::MidSide, 0.5f, true},
+            Scenario{"T/T mix+filters", ChannelMode::TonalTransient, 0.5f, true},
+        };
+
+        constexpr std::array kPipelineBlockSizes = {64, 256, 1024};
+        constexpr std::array kModes = {gFractorDSP<float>::ExecutionMode::Staged, gFractorDSP<float>::ExecutionMode::Fused};
+
+        juce::Random random(42);
+        volatile float sink = 0.0f;
+
+        for (const auto &scenario: kScenarios) {
+            for (const auto executionMode: kModes) {
+                juce::String line = juce::String(scenario.name).paddedRight(' ', 16)
+                                    + (executionMode == gFractorDSP<float>::ExecutionMode::Fused ? "fused " : "staged");
+
+                for (const int blockSize: kPipelineBlockSizes) {
+                    gFractorDSP<float> dsp;
+                    dsp.setExecutionMode(executionMode);
+                    dsp.setOutputMode(scenario.mode);
+                    dsp.prepare({48000.0, static_cast<juce::uint32>(blockSize), 2});
+                    dsp.setDryWet(scenario.dryWet);
+                    dsp.setAuditFilter(scenario.filters, 2000.0f, 2.0f);
+                    dsp.setBandFilter(scenario.filters, 800.0f, 1.0f);
+                    dsp.reset();
+
+                    juce::AudioBuffer<float> source(2, blockSize);
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < blockSize; ++i)
+                            source.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+                    juce::AudioBuffer<float> buffer(2, blockSize);
+
+                    // Refill every block so repeated filtering never decays into denormals;
+                    // the copy costs the same in both pipelines.
+                    const double rate = measureSamplesPerNs(blockSize, [&] {
+                        for (int ch = 0; ch < 2; ++ch)
+                            buffer.copyFrom(ch, 0, source, ch, 0, blockSize);
+                        dsp.process(buffer);
+                        sink = sink + buffer.getSample(0, 0);
+                    });
+                    line << " " << blockSize << ":" << juce::String(rate, 3);
+                }
+
+                logMessage(line);
+            }
+        }
+
+        expect(std::isfinite(sink));
+    }
+};
+
+static PipelineBenchmark pipelineBenchmark;
+
+//==============================================================================
+// Linear-phase crossover: gains folded into one kernel per channel vs a convolver per band
+//==============================================================================
+class CrossoverBenchmark : public juce::UnitTest {
+public:
+    CrossoverBenchmark() : UnitTest("Multiband Crossover", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("M/S crossover, stereo samples/ns by band count");
+
+        constexpr int blockSize = 512;
+        constexpr juce::dsp::ProcessSpec spec{48000.0, static_cast<juce::uint32>(blockSize), 2};
+
+        juce::Random random(42);
+        std::vector<float> sourceL(static_cast<size_t>(blockSize)), sourceR(sourceL.size());
+        fillNoise(sourceL, random);
+        fillNoise(sourceR, random);
+        std::vector<float> left(sourceL.size()), right(sourceR.size());
+        volatile float sink = 0.0f;
+
+        juce::String perBandLine = juce::String("Per band").paddedRight(' ', 10);
+        juce::String foldedLine = juce::String("Folded").paddedRight(' ', 10);
+
+        for (int numBands = 2; numBands <= MultibandCrossover::kMaxBands; ++numBands) {
+            // Edges spread log-uniformly over 60 Hz .. 12 kHz, every band at its own gain
+            std::vector<float> frequencies;
+            for (int e = 0; e < numBands - 1; ++e)
+                frequencies.push_back(60.0f * std::pow(200.0f, static_cast<float>(e) / juce::jmax(1, numBands - 2)));
+
+            MultibandCrossover crossover;
+            crossover.setFrequencies(frequencies);
+            crossover.prepare(spec, 1);
+            for (int band = 0; band < numBands; ++band)
+                crossover.setBand(band, {static_cast<float>(band) - 3.0f, -static_cast<float>(band), true, true});
+
+            const double foldedRate = measureSamplesPerNs(blockSize, [&] {
+                std::copy(sourceL.begin(), sourceL.end(), left.begin());
+                std::copy(sourceR.begin(), sourceR.end(), right.begin());
+                float *lefts[] = {left.data()};
+                float *rights[] = {right.data()};
+                crossover.process(lefts, rights, 1, left.size());
+                sink = sink + left[0];
+            });
+
+            // Naive: mid and side through one full-length convolver per band (the partitioning,
+            // FFT size and kernel length match the crossover's; only the band count differs)
+            const juce::dsp::FFT fft(MultibandCrossover::kPartitionOrder + 1);
+            const size_t partitionSize = size_t{1} << MultibandCrossover::kPartitionOrder;
+            const size_t numPartitions = 16;
+
+            std::vector<float> impulse(numPartitions * partitionSize - 1), scratch;
+            fillNoise(impulse, random);
+            PartitionedConvolver::Kernel kernel;
+            PartitionedConvolver::prepareKernel(fft, numPartitions, kernel);
+            PartitionedConvolver::transformKernel(fft, impulse.data(), impulse.size(), kernel, scratch);
+
+            std::vector<PartitionedConvolver> convolvers(static_cast<size_t>(2 * numBands));
+            for (auto &convolver: convolvers)
+                convolver.prepare(fft, numPartitions);
+
+            std::vector<float> output(partitionSize);
+            const double perBandRate = measureSamplesPerNs(blockSize, [&] {
+                for (size_t start = 0; start < left.size(); start += partitionSize)
+                    for (size_t c = 0; c < convolvers.size(); ++c)
+                        convolvers[c].process((c % 2 == 0 ? sourceL : sourceR).data() + start, output.data(), kernel);
+                sink = sink + output[0];
+            });
+
+            perBandLine << " " << numBands << ":" << juce::String(perBandRate, 3);
+            foldedLine << " " << numBands << ":" << juce::String(foldedRate, 3);
+        }
+
+        logMessage(perBandLine);
+        logMessage(foldedLine);
+        expect(std::isfinite(sink));
+    }
+};
+
+static CrossoverBenchmark crossoverBenchmark;
+
+//==============================================================================
+// Spectral audition: one shared mask, so the cost does not grow with the soloed bands
+class SpectralAuditionBenchmark : public juce::UnitTest {
+public:
+    SpectralAuditionBenchmark() : UnitTest("Spectral Audition", "Benchmarks") {
+    }
+
+    void runTest() override {
+        beginTest("Soloed bands, stereo samples/ns by band count");
+
+        constexpr int blockSize = 512;
+        constexpr juce::dsp::ProcessSpec spec{48000.0, static_cast<juce::uint32>(blockSize), 2};
+
+        juce::Random random(42);
+        std::vector<float> sourceL(static_cast<size_t>(blockSize)), sourceR(sourceL.size());
+        fillNoise(sourceL, random);
+        fillNoise(sourceR, random);
+        std::vector<float> left(sourceL.size()), right(sourceR.size());
+        volatile float sink = 0.0f;
+
+        juce::String bankLine = juce::String("Bank").paddedRight(' ', 10);
+        juce::String spectralLine = juce::String("Spectral").paddedRight(' ', 10);
+
+        for (int numBands = 1; numBands <= kNumBands; ++numBands) {
+            // Every other band, so no two merge into one region
+            juce::uint32 soloMask = 0;
+            for (int band = 0; band < numBands; ++band)
+                soloMask |= 1u << ((2 * band) % kNumBands);
+
+            BandSoloBank bank;
+            bank.setSoloMask(soloMask);
+            bank.prepare(spec);
+            bank.beginBlock();
+
+            const double bankRate = measureSamplesPerNs(blockSize, [&] {
+                std::copy(sourceL.begin(), sourceL.end(), left.begin());
+                std::copy(sourceR.begin(), sourceR.end(), right.begin());
+                bank.processStereo(left.data(), right.data(), left.size());
+                bank.endBlock();
+                sink = sink + left[0];
+            });
+
+            SpectralAudition audition;
+            audition.prepare(spec);
+            audition.setBandSolo(soloMask);
+
+            const double spectralRate = measureSamplesPerNs(blockSize, [&] {
+                std::copy(sourceL.begin(), sourceL.end(), left.begin());
+                std::copy(sourceR.begin(), sourceR.end(), right.begin());
+                float *channels[] = {left.data(), right.data()};
+                audition.process(juce::dsp::AudioBlock<float>(channels, 2, left.size()));
+                sink = sink + left[0];
+            });
+
+            bankLine << " " << numBands << ":" << juce::String(bankRate, 3);
+            spectralLine << " " << numBands << ":" << juce::String(spectralRate, 3);
+        }
+
+        logMessage(bankLine);
+        logMessage(spectralLine);
+        expect(std::isfinite(sink));
+    }
+};
+
+static SpectralAuditionBenchmark spectralAuditionBenchmark;
+
+//==============================================================================
+int main(int, char **) {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("Benchmarks");
+
+    return 0;
+}
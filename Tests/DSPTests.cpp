@@ -12,7 +12,26 @@
 #include <juce_dsp/juce_dsp.h>
 #include <juce_core/juce_core.h>
 #include "DSP/Core/gFractorDSP.h"
+#include "DSP/Processing/BandpassFilter.h"
+#include "DSP/Processing/BandSoloBank.h"
+#include "DSP/Processing/ChannelModeCrossfade.h"
+#include "DSP/Processing/ChannelModeKernels.h"
+#include "DSP/Processing/GccPhatEstimator.h"
+#include "DSP/Processing/HalfbandDecimator.h"
+#include "DSP/Processing/MatchEqDesigner.h"
+#include "DSP/Processing/MatchEqualizer.h"
+#include "DSP/Processing/MidSidePeakKernel.h"
+#include "DSP/Processing/MultibandCrossover.h"
+#include "DSP/Processing/NonUniformConvolver.h"
+#include "DSP/Processing/PartitionedConvolver.h"
+#include "DSP/Processing/SidechainAligner.h"
+#include "DSP/Processing/SilenceDetector.h"
+#include "DSP/Processing/SpectralAudition.h"
+#include "DSP/Processing/SpectralSeparator.h"
+#include "DSP/Processing/StereoBiquadCascade.h"
+#include "DSP/Processing/TruePeakMeter.h"
 #include "Utility/ChannelMode.h"
+#include "AllocationCounter.h"
 
 /**
  * DSP Tests using JUCE's built-in testing framework
@@ -31,8 +50,13 @@ public:
         testMultiChannelProcessing();
         testMidSideFiltering();
         testLRModeSwitching();
+        testChannelPairLayout();
+        testImmersiveChannelMode();
+        testOutputModeCrossfade();
         testAuditFilter();
         testPeakMetering();
+        testPeakKernelParity();
+        testTruePeakMetering();
         testMonoInput();
         testProcessBeforePrepare();
         testZeroSampleRate();
@@ -45,6 +69,24 @@ public:
         testSampleRateChange();
         testClippingBehavior();
         testBandFilter();
+        testFusedMatchesStaged();
+        testDoublePrecision();
+        testIdentityElision();
+        testChannelModeKernels();
+        testSpectralSeparator();
+        testBandpassCoefficientEngine();
+        testFilterSweepAllocations();
+        testStereoBiquadCascade();
+        testBandSoloBank();
+        testParameterTimeline();
+        testSilenceDetector();
+        testPartitionedConvolver();
+        testMultibandCrossover();
+        testNonUniformConvolver();
+        testMatchEqualizer();
+        testSpectralAudition();
+        testSidechainAligner();
+        testHalfbandDecimator();
     }
 
 private:
@@ -52,7 +94,7 @@ private:
     void testPrepareAndReset() {
         beginTest("Prepare and Reset");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
 
         // Setup processing spec
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
@@ -76,7 +118,7 @@ private:
     void testGainProcessing() {
         beginTest("Gain Processing");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -136,7 +178,7 @@ private:
     void testBypassFunctionality() {
         beginTest("Bypass Functionality");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -176,7 +218,7 @@ private:
     void testParameterSmoothing() {
         beginTest("Parameter Smoothing");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -214,7 +256,7 @@ private:
     void testSilenceProcessing() {
         beginTest("Silence Processing");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -242,7 +284,7 @@ private:
     void testMultiChannelProcessing() {
         beginTest("Multi-Channel Processing");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -281,7 +323,7 @@ private:
     void testMidSideFiltering() {
         beginTest("Mid/Side Filtering");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -350,7 +392,7 @@ private:
     void testLRModeSwitching() {
         beginTest("L/R Mode Switching");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -416,11 +458,364 @@ private:
         }
     }
 
+    //==============================================================================
+    void testChannelPairLayout() {
+        beginTest("Channel Pair Layout");
+
+        using Set = juce::AudioChannelSet;
+
+        // 5.1: front and surround pairs, then C and LFE as singles
+        {
+            const auto set = Set::create5point1();
+            const auto layout = ChannelPairLayout::fromChannelSet(set);
+
+            expectEquals(static_cast<int>(layout.units.size()), 4);
+            expectEquals(layout.getNumChannels(), 6);
+            expectEquals(layout.units[0].left, set.getChannelIndexForType(Set::left));
+            expectEquals(layout.units[0].right, set.getChannelIndexForType(Set::right));
+            expectEquals(layout.units[1].left, set.getChannelIndexForType(Set::leftSurround));
+            expectEquals(layout.units[1].right, set.getChannelIndexForType(Set::rightSurround));
+            expect(!layout.units[2].isPair());
+            expect(!layout.units[3].isPair());
+        }
+
+        // 7.1.4: five pairs plus C and LFE, every channel used once
+        {
+            const auto set = Set::create7point1point4();
+            const auto layout = ChannelPairLayout::fromChannelSet(set);
+
+            expectEquals(static_cast<int>(layout.units.size()), 7);
+            expectEquals(layout.getNumChannels(), 12);
+
+            std::vector<int> seen(12, 0);
+            int numPairs = 0;
+            for (const auto &unit: layout.units) {
+                ++seen[static_cast<size_t>(unit.left)];
+                if (unit.isPair()) {
+                    ++seen[static_cast<size_t>(unit.right)];
+                    ++numPairs;
+                }
+            }
+            expectEquals(numPairs, 5);
+            for (const int count: seen)
+                expectEquals(count, 1);
+        }
+
+        // Discrete channels pair by index with a trailing single
+        {
+            const auto layout = ChannelPairLayout::fromChannelSet(Set::discreteChannels(5));
+            expectEquals(static_cast<int>(layout.units.size()), 3);
+            expectEquals(layout.units[1].left, 2);
+            expectEquals(layout.units[1].right, 3);
+            expect(!layout.units[2].isPair());
+        }
+
+        // Analyzer sources
+        {
+            const auto set71 = Set::create7point1();
+            const auto surround = ChannelPairLayout::findSource(set71, AnalyzerSource::Surround);
+            expectEquals(surround[0], set71.getChannelIndexForType(Set::leftSurroundSide));
+            expectEquals(surround[1], set71.getChannelIndexForType(Set::rightSurroundSide));
+
+            const auto set714 = Set::create7point1point4();
+            const auto topFront = ChannelPairLayout::findSource(set714, AnalyzerSource::TopFront);
+            expectEquals(topFront[0], set714.getChannelIndexForType(Set::topFrontLeft));
+            expectEquals(topFront[1], set714.getChannelIndexForType(Set::topFrontRight));
+
+            expectEquals(ChannelPairLayout::findSource(Set::create5point1(), AnalyzerSource::Rear)[0], -1);
+            expect(analyzerSourceFromInt(99) == AnalyzerSource::FoldDown);
+        }
+
+        // Fold-down: front at unity, centre and surrounds at -3 dB, LFE dropped
+        {
+            const auto set = Set::create5point1();
+            const auto weights = ChannelPairLayout::getFoldDownWeights(set);
+            const float minus3dB = 1.0f / std::sqrt(2.0f);
+
+            const auto weightOf = [&](const Set::ChannelType type) {
+                return weights[static_cast<size_t>(set.getChannelIndexForType(type))];
+            };
+
+            expectEquals(weightOf(Set::left)[0], 1.0f);
+            expectEquals(weightOf(Set::left)[1], 0.0f);
+            expectEquals(weightOf(Set::right)[1], 1.0f);
+            expectWithinAbsoluteError(weightOf(Set::centre)[0], minus3dB, 1.0e-6f);
+            expectWithinAbsoluteError(weightOf(Set::centre)[1], minus3dB, 1.0e-6f);
+            expectEquals(weightOf(Set::LFE)[0], 0.0f);
+            expectEquals(weightOf(Set::LFE)[1], 0.0f);
+            expectWithinAbsoluteError(weightOf(Set::leftSurround)[0], minus3dB, 1.0e-6f);
+            expectEquals(weightOf(Set::leftSurround)[1], 0.0f);
+        }
+    }
+
+    //==============================================================================
+    void testImmersiveChannelMode() {
+        beginTest("Immersive Channel Mode");
+
+        using Set = juce::AudioChannelSet;
+        constexpr int blockSize = 512;
+
+        const auto fill = [](juce::AudioBuffer<float> &buffer) {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample(ch, i, 0.05f * static_cast<float>(ch + 1));
+        };
+
+        // 7.1.4 in M/S with only the mid on: every pair collapses to its own mid, singles keep their signal
+        {
+            const auto set = Set::create7point1point4();
+            const auto layout = ChannelPairLayout::fromChannelSet(set);
+
+            gFractorDSP<float> dsp;
+            dsp.setChannelLayout(layout);
+            dsp.prepare({44100.0, blockSize, 12});
+            expectEquals(static_cast<int>(dsp.getNumChannelUnits()), 7);
+
+            dsp.setOutputMode(ChannelMode::MidSide);
+            dsp.setPrimaryEnabled(true);
+            dsp.setSecondaryEnabled(false);
+
+            juce::AudioBuffer<float> buffer(12, blockSize);
+            fill(buffer);
+            dsp.process(buffer);
+
+            for (const auto &unit: layout.units) {
+                const float left = 0.05f * static_cast<float>(unit.left + 1);
+
+                if (unit.isPair()) {
+                    const float mid = (left + 0.05f * static_cast<float>(unit.right + 1)) * 0.5f;
+                    expectWithinAbsoluteError(buffer.getSample(unit.left, 256), mid, 1.0e-5f);
+                    expectWithinAbsoluteError(buffer.getSample(unit.right, 256), mid, 1.0e-5f);
+                } else {
+                    expectWithinAbsoluteError(buffer.getSample(unit.left, 256), left, 1.0e-5f);
+                }
+            }
+        }
+
+        // Stereo main bus plus sidechain: the sidechain channels skip the channel-mode stage
+        {
+            gFractorDSP<float> dsp;
+            dsp.setChannelLayout(ChannelPairLayout::fromChannelSet(Set::stereo()));
+            dsp.prepare({44100.0, blockSize, 4});
+            expectEquals(static_cast<int>(dsp.getNumChannelUnits()), 1);
+
+            dsp.setOutputMode(ChannelMode::LR);
+            dsp.setPrimaryEnabled(false);
+            dsp.setSecondaryEnabled(true);
+
+            juce::AudioBuffer<float> buffer(4, blockSize);
+            fill(buffer);
+            dsp.process(buffer);
+
+            expectWithinAbsoluteError(buffer.getSample(0, 256), 0.0f, 1.0e-6f);
+            expectWithinAbsoluteError(buffer.getSample(1, 256), 0.10f, 1.0e-5f);
+            expectWithinAbsoluteError(buffer.getSample(2, 256), 0.15f, 1.0e-5f);
+            expectWithinAbsoluteError(buffer.getSample(3, 256), 0.20f, 1.0e-5f);
+        }
+
+        // A layout wider than the spec falls back to the front pair
+        {
+            gFractorDSP<float> dsp;
+            dsp.setChannelLayout(ChannelPairLayout::fromChannelSet(Set::create7point1point4()));
+            dsp.prepare({44100.0, blockSize, 2});
+            expectEquals(static_cast<int>(dsp.getNumChannelUnits()), 1);
+        }
+
+        // 5.1 in Tonal/Transient with both outputs on: every channel, singles included, comes
+        // back as its own input delayed by the separator latency
+        {
+            const auto set = Set::create5point1();
+
+            gFractorDSP<float> dsp;
+            dsp.setChannelLayout(ChannelPairLayout::fromChannelSet(set));
+            dsp.prepare({44100.0, blockSize, 6});
+            dsp.setOutputMode(ChannelMode::TonalTransient);
+            dsp.setPrimaryEnabled(true);
+            dsp.setSecondaryEnabled(true);
+
+            const int latency = dsp.getLatencySamples();
+            const int numBlocks = (3 * latency) / blockSize + 1;
+            const auto input = [](const int ch, const int n) {
+                return 0.3f * std::sin(0.01f * static_cast<float>((ch + 1) * n));
+            };
+
+            juce::AudioBuffer<float> buffer(6, blockSize);
+            float maxError = 0.0f;
+
+            for (int b = 0; b < numBlocks; ++b) {
+                for (int ch = 0; ch < 6; ++ch)
+                    for (int i = 0; i < blockSize; ++i)
+                        buffer.setSample(ch, i, input(ch, b * blockSize + i));
+
+                dsp.process(buffer);
+
+                for (int ch = 0; ch < 6; ++ch) {
+                    for (int i = 0; i < blockSize; ++i) {
+                        const int n = b * blockSize + i;
+                        if (n >= 2 * latency)
+                            maxError = juce::jmax(maxError, std::abs(buffer.getSample(ch, i) - input(ch, n - latency)));
+                    }
+                }
+            }
+
+            expectLessThan(maxError, 1.0e-4f);
+        }
+    }
+
+    //==============================================================================
+    void testOutputModeCrossfade() {
+        beginTest("Output Mode Crossfade");
+
+        constexpr juce::dsp::ProcessSpec spec{48000.0, 128, 2};
+        constexpr int blockSize = 128;
+        const auto fadeLength = juce::roundToInt(spec.sampleRate * ChannelModeCrossfade<float>::kCrossfadeSeconds);
+
+        for (const auto executionMode: {gFractorDSP<float>::ExecutionMode::Staged, gFractorDSP<float>::ExecutionMode::Fused}) {
+            gFractorDSP<float> dsp;
+            dsp.setExecutionMode(executionMode);
+            dsp.prepare(spec);
+            dsp.setPrimaryEnabled(true);
+            dsp.setSecondaryEnabled(false);
+            dsp.setOutputMode(ChannelMode::MidSide);
+
+            // Constant L = 0.8, R = 0.2: M/S primary gives 0.5 / 0.5, L/R primary gives 0.8 / 0
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            const auto fill = [&] {
+                for (int i = 0; i < blockSize; ++i) {
+                    buffer.setSample(0, i, 0.8f);
+                    buffer.setSample(1, i, 0.2f);
+                }
+            };
+
+            fill();
+            dsp.process(buffer);
+            expectWithinAbsoluteError(buffer.getSample(0, blockSize - 1), 0.5f, 1.0e-6f);
+
+            const auto numFrames = static_cast<size_t>(fadeLength + 3 * blockSize);
+            std::vector<float> left, right;
+            left.reserve(numFrames);
+            right.reserve(numFrames);
+            size_t numAllocations = 0;
+            {
+                AllocationCounter::ScopedCount allocations;
+                dsp.setOutputMode(ChannelMode::LR);
+
+                for (int rendered = 0; rendered < fadeLength + 2 * blockSize; rendered += blockSize) {
+                    fill();
+                    dsp.process(buffer);
+                    for (int i = 0; i < blockSize; ++i) {
+                        left.push_back(buffer.getSample(0, i));
+                        right.push_back(buffer.getSample(1, i));
+                    }
+                }
+
+                numAllocations = allocations.getCount();
+            }
+
+            expectEquals(static_cast<int>(numAllocations), 0, "Mode switches must not allocate");
+
+            // Equal-power blend: starts at the old output, ends exactly on the new one
+            expectWithinAbsoluteError(left.front(), 0.5f, 0.01f);
+            expectWithinAbsoluteError(right.front(), 0.5f, 0.01f);
+            expectEquals(left[static_cast<size_t>(fadeLength - 1)], 0.8f);
+            expectEquals(right[static_cast<size_t>(fadeLength - 1)], 0.0f);
+            expectEquals(left.back(), 0.8f);
+
+            // Midway both kernels contribute sin/cos(45 deg)
+            const auto mid = static_cast<size_t>(fadeLength / 2 - 1);
+            expectWithinAbsoluteError(left[mid], (0.8f + 0.5f) * std::sqrt(0.5f), 1.0e-3f);
+            expectWithinAbsoluteError(right[mid], 0.5f * std::sqrt(0.5f), 1.0e-3f);
+
+            // No step larger than a small fraction of the signal anywhere in the switch
+            float maxStep = 0.0f;
+            for (size_t i = 1; i < left.size(); ++i)
+                maxStep = juce::jmax(maxStep, std::abs(left[i] - left[i - 1]), std::abs(right[i] - right[i - 1]));
+            expectLessThan(maxStep, 0.01f, "Mode switch should not step the output");
+        }
+
+        // A switch while a fade runs waits for it, then fades again; reset() switches at once
+        {
+            gFractorDSP<float> dsp;
+            dsp.prepare(spec);
+            dsp.setPrimaryEnabled(true);
+            dsp.setSecondaryEnabled(false);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            const auto render = [&] {
+                for (int i = 0; i < blockSize; ++i) {
+                    buffer.setSample(0, i, 0.8f);
+                    buffer.setSample(1, i, 0.2f);
+                }
+                dsp.process(buffer);
+            };
+
+            render();
+            dsp.setOutputMode(ChannelMode::LR);
+            render();
+            dsp.setOutputMode(ChannelMode::MidSide);
+
+            float previous = buffer.getSample(0, blockSize - 1);
+            float maxStep = 0.0f;
+            for (int rendered = 0; rendered < 3 * fadeLength; rendered += blockSize) {
+                render();
+                for (int i = 0; i < blockSize; ++i) {
+                    maxStep = juce::jmax(maxStep, std::abs(buffer.getSample(0, i) - previous));
+                    previous = buffer.getSample(0, i);
+                }
+            }
+            expectLessThan(maxStep, 0.01f);
+            expectEquals(buffer.getSample(0, blockSize - 1), 0.5f);
+
+            dsp.setOutputMode(ChannelMode::LR);
+            dsp.reset();
+            render();
+            expectEquals(buffer.getSample(0, 0), 0.8f);
+        }
+
+        // Into and out of Tonal/Transient (both outputs on: the input, delayed) the output keeps
+        // its level: entering waits for the primed separator instead of fading into its silence
+        for (const auto executionMode: {gFractorDSP<float>::ExecutionMode::Staged, gFractorDSP<float>::ExecutionMode::Fused}) {
+            gFractorDSP<float> dsp;
+            dsp.setExecutionMode(executionMode);
+            dsp.prepare(spec);
+            dsp.setOutputMode(ChannelMode::MidSide);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            int frame = 0;
+            const auto render = [&] {
+                for (int i = 0; i < blockSize; ++i, ++frame) {
+                    const auto phase = static_cast<float>(frame) * 0.13f;
+                    buffer.setSample(0, i, 0.5f * std::sin(phase));
+                    buffer.setSample(1, i, 0.3f * std::sin(phase + 0.7f));
+                }
+                dsp.process(buffer);
+                return buffer.getRMSLevel(0, 0, blockSize);
+            };
+
+            for (int b = 0; b < 8; ++b)
+                render();
+
+            const int settle = 8 * (1 << SpectralSeparator::kMaxFftOrder);
+            const float inputRms = 0.5f * std::sqrt(0.5f);
+            float minRms = inputRms;
+
+            dsp.setOutputMode(ChannelMode::TonalTransient);
+            for (int rendered = 0; rendered < settle; rendered += blockSize)
+                minRms = juce::jmin(minRms, render());
+
+            dsp.setOutputMode(ChannelMode::MidSide);
+            for (int rendered = 0; rendered < 4 * fadeLength; rendered += blockSize)
+                minRms = juce::jmin(minRms, render());
+
+            expectGreaterThan(minRms, 0.5f * inputRms, "Tonal/Transient switches must not drop out");
+        }
+    }
+
     //==============================================================================
     void testAuditFilter() {
         beginTest("Audit Filter");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -503,7 +898,7 @@ private:
     void testPeakMetering() {
         beginTest("Peak Metering");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -599,11 +994,172 @@ private:
         }
     }
 
+    //==============================================================================
+    void testPeakKernelParity() {
+        beginTest("Peak Kernel Parity");
+
+        juce::Random random(1234);
+        constexpr std::array isas = {
+            MidSidePeakKernel::Isa::SSE2,
+            MidSidePeakKernel::Isa::AVX2,
+            MidSidePeakKernel::Isa::NEON,
+        };
+
+        // Odd sizes exercise the vector remainder and scalar tail paths
+        for (const int numSamples: {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 511, 512, 4096}) {
+            std::vector<float> left(static_cast<size_t>(numSamples));
+            std::vector<float> right(left.size());
+            for (size_t i = 0; i < left.size(); ++i) {
+                left[i] = random.nextFloat() * 2.0f - 1.0f;
+                right[i] = random.nextFloat() * 2.0f - 1.0f;
+            }
+            if (numSamples > 5)
+                left[5] = std::nanf("");
+
+            const auto reference = MidSidePeakKernel::process(MidSidePeakKernel::Isa::Scalar,
+                                                              left.data(), right.data(),
+                                                              left.size());
+
+            for (const auto isa: isas) {
+                if (!MidSidePeakKernel::isSupported(isa))
+                    continue;
+
+                const auto peaks = MidSidePeakKernel::process(isa, left.data(), right.data(), left.size());
+                expectEquals(peaks.mid, reference.mid);
+                expectEquals(peaks.side, reference.side);
+            }
+        }
+
+        // Known values: L = 0.8, R = 0.2 -> mid 0.5, side 0.3
+        {
+            std::vector<float> left(100, 0.8f);
+            std::vector<float> right(100, 0.2f);
+            const auto peaks = MidSidePeakKernel::process(left.data(), right.data(), left.size());
+            expectWithinAbsoluteError(peaks.mid, 0.5f, 1.0e-6f);
+            expectWithinAbsoluteError(peaks.side, 0.3f, 1.0e-6f);
+        }
+    }
+
+    //==============================================================================
+    void testTruePeakMetering() {
+        beginTest("True Peak Metering");
+
+        constexpr int blockSize = 512;
+        constexpr double sampleRate = 48000.0;
+
+        // fs/4 sine at 45 degrees: every sample sits at 0.707 (-3 dB), the waveform peaks at 1.0
+        const auto quarterRateSine = [](const int n) {
+            return std::sin(juce::MathConstants<float>::halfPi * static_cast<float>(n)
+                            + juce::MathConstants<float>::pi * 0.25f);
+        };
+
+        gFractorDSP<float> dsp;
+        dsp.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 2});
+        dsp.setGain(0.0f);
+        dsp.setOutputMode(ChannelMode::MidSide);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        const auto fill = [&](const float leftScale, const float rightScale) {
+            for (int i = 0; i < blockSize; ++i) {
+                buffer.setSample(0, i, leftScale * quarterRateSine(i));
+                buffer.setSample(1, i, rightScale * quarterRateSine(i));
+            }
+        };
+
+        // Off by default: nothing is metered
+        {
+            fill(1.0f, 1.0f);
+            dsp.process(buffer);
+            expect(!dsp.isTruePeakEnabled());
+            expectEquals(dsp.getTruePeakPrimaryDb(), -100.0f);
+            expectEquals(dsp.getTruePeakSecondaryDb(), -100.0f);
+        }
+
+        // M/S: mid carries the sine, side is silent; the true peak reads ~3 dB over the sample peak
+        {
+            dsp.setTruePeakEnabled(true);
+            dsp.resetPeaks();
+            fill(1.0f, 1.0f);
+            dsp.process(buffer);
+
+            expectWithinAbsoluteError(dsp.getPeakPrimaryDb(), -3.01f, 0.05f);
+            expectWithinAbsoluteError(dsp.getTruePeakPrimaryDb(), 0.0f, 0.5f);
+            expectLessThan(dsp.getTruePeakSecondaryDb(), -60.0f);
+        }
+
+        // The value is held: a quieter block does not lower it
+        {
+            fill(0.1f, 0.1f);
+            dsp.process(buffer);
+            expectGreaterThan(dsp.getTruePeakPrimaryDb(), -0.5f);
+        }
+
+        // resetTruePeaks() clears the hold; the next block re-measures
+        {
+            dsp.resetTruePeaks();
+            expectEquals(dsp.getTruePeakPrimaryDb(), -100.0f);
+            dsp.process(buffer);
+            expectWithinAbsoluteError(dsp.getTruePeakPrimaryDb(), -20.0f, 0.5f);
+        }
+
+        // L/R mode meters left and right directly
+        {
+            dsp.setOutputMode(ChannelMode::LR);
+            fill(1.0f, 0.0f);
+            dsp.process(buffer);
+            expectWithinAbsoluteError(dsp.getTruePeakPrimaryDb(), 0.0f, 0.5f);
+            expectLessThan(dsp.getTruePeakSecondaryDb(), -60.0f);
+        }
+
+        // Disabling the mode drops the readings back to the floor
+        {
+            dsp.setTruePeakEnabled(false);
+            dsp.process(buffer);
+            expectEquals(dsp.getTruePeakPrimaryDb(), -100.0f);
+        }
+
+        // Skipping the polyphase filter on quiet chunks must not change the held value:
+        // compare against the same signal with the hold cleared before every block (never skips).
+        {
+            juce::Random random(77);
+            constexpr int numSamples = 20000;
+            std::vector<float> left(numSamples), right(numSamples);
+            for (int i = 0; i < numSamples; ++i) {
+                // Loud bursts between long quiet stretches, so most chunks can be skipped
+                const float level = (i / 1500) % 4 == 0 ? 1.0f : 0.05f;
+                left[static_cast<size_t>(i)] = level * (random.nextFloat() * 2.0f - 1.0f);
+                right[static_cast<size_t>(i)] = level * (random.nextFloat() * 2.0f - 1.0f);
+            }
+
+            for (const auto decode: {TruePeakMeter::Decode::MidSide, TruePeakMeter::Decode::LeftRight}) {
+                TruePeakMeter gated, exhaustive;
+                gated.prepare(100);
+                exhaustive.prepare(100);
+
+                float exhaustivePeak[2] = {0.0f, 0.0f};
+                for (int start = 0; start < numSamples; start += 37) {
+                    const auto n = static_cast<size_t>(juce::jmin(37, numSamples - start));
+                    gated.process(left.data() + start, right.data() + start, n, decode);
+
+                    exhaustive.resetHold();
+                    exhaustive.process(left.data() + start, right.data() + start, n, decode);
+                    for (int ch = 0; ch < 2; ++ch)
+                        exhaustivePeak[ch] = juce::jmax(exhaustivePeak[ch], exhaustive.getHeldPeak(ch));
+                }
+
+                for (int ch = 0; ch < 2; ++ch) {
+                    expectEquals(gated.getHeldPeak(ch), exhaustivePeak[ch]);
+                    expectGreaterThan(gated.getHeldPeak(ch), 0.5f);
+                }
+            }
+        }
+    }
+
     //==============================================================================
     void testMonoInput() {
         beginTest("Mono Input");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
 
         // Mono spec
         constexpr juce::dsp::ProcessSpec monoSpec{44100.0, 512, 1};
@@ -636,7 +1192,7 @@ private:
     void testProcessBeforePrepare() {
         beginTest("Process Before Prepare");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         // DO NOT call prepare()
 
         juce::AudioBuffer<float> buffer(2, 512);
@@ -665,7 +1221,7 @@ private:
         // Actual behavior depends on JUCE's DSP module handling
         try {
             constexpr juce::dsp::ProcessSpec zeroSpec{0.0, 512, 2};
-            gFractorDSP dsp;
+            gFractorDSP<float> dsp;
             dsp.prepare(zeroSpec);
             juce::AudioBuffer<float> buffer(2, 512);
             fillBufferWithValue(buffer, 0.5f);
@@ -681,7 +1237,7 @@ private:
     void testTinyBuffers() {
         beginTest("Tiny Buffers");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         dsp.setGain(6.0f);
         dsp.setBypassed(false);
 
@@ -734,7 +1290,7 @@ private:
     void testNaNInfInput() {
         beginTest("NaN/Inf Input");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
         dsp.setGain(0.0f);
@@ -799,7 +1355,7 @@ private:
     void testRapidParameterChanges() {
         beginTest("Rapid Parameter Changes");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -852,7 +1408,7 @@ private:
     void testDcOffset() {
         beginTest("DC Offset");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
         dsp.setGain(0.0f);
@@ -907,7 +1463,7 @@ private:
     void testLargeBuffers() {
         beginTest("Large Buffers");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 8192, 2};
         dsp.prepare(spec);
         dsp.setGain(6.0f);
@@ -929,7 +1485,7 @@ private:
     void testHighSampleRate() {
         beginTest("High Sample Rate");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
 
         // 192 kHz
         constexpr juce::dsp::ProcessSpec spec{192000.0, 512, 2};
@@ -953,7 +1509,7 @@ private:
     void testSampleRateChange() {
         beginTest("Sample Rate Change");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
 
         auto runAtSampleRate = [&dsp](const double sampleRate, const int blockSize) {
             const juce::dsp::ProcessSpec spec{
@@ -1009,7 +1565,7 @@ private:
     void testClippingBehavior() {
         beginTest("Clipping Behavior");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -1046,7 +1602,7 @@ private:
     void testBandFilter() {
         beginTest("Band Filter");
 
-        gFractorDSP dsp;
+        gFractorDSP<float> dsp;
         constexpr juce::dsp::ProcessSpec spec{44100.0, 512, 2};
         dsp.prepare(spec);
 
@@ -1249,7 +1805,7 @@ private:
         {
             // Test at 48kHz
             {
-                gFractorDSP dsp48;
+                gFractorDSP<float> dsp48;
                 constexpr juce::dsp::ProcessSpec spec48{48000.0, 512, 2};
                 dsp48.prepare(spec48);
                 dsp48.setBandFilter(true, 1000.0f, 2.0f);
@@ -1266,7 +1822,7 @@ private:
 
             // Test at 96kHz
             {
-                gFractorDSP dsp96;
+                gFractorDSP<float> dsp96;
                 constexpr juce::dsp::ProcessSpec spec96{96000.0, 512, 2};
                 dsp96.prepare(spec96);
                 dsp96.setBandFilter(true, 1000.0f, 2.0f);
@@ -1286,6 +1842,1825 @@ private:
         dsp.setBandFilter(false, 1000.0f, 1.0f);
     }
 
+    //==============================================================================
+    void testFusedMatchesStaged() {
+        beginTest("Fused Pipeline Matches Staged");
+
+        constexpr juce::dsp::ProcessSpec spec{44100.0, 256, 2};
+
+        for (const auto mode: {ChannelMode::MidSide, ChannelMode::LR, ChannelMode::TonalTransient}) {
+            for (const float wet: {1.0f, 0.5f}) {
+                gFractorDSP<float> staged, fused;
+                staged.setExecutionMode(gFractorDSP<float>::ExecutionMode::Staged);
+                fused.setExecutionMode(gFractorDSP<float>::ExecutionMode::Fused);
+
+                for (auto *dsp: {&staged, &fused}) {
+                    dsp->setOutputMode(mode);
+                    dsp->prepare(spec);
+                    dsp->setAuditFilter(true, 2000.0f, 2.0f);
+                    dsp->setBandFilter(true, 800.0f, 1.0f);
+                    dsp->setSecondaryEnabled(false);
+                    dsp->setDryWet(wet);
+                    dsp->setGain(-6.0f); // ramps over the first blocks
+                }
+
+                juce::Random random(77);
+                float maxError = 0.0f;
+
+                for (int blockIndex = 0; blockIndex < 20; ++blockIndex) {
+                    // Vary the block size so ramps end mid-block
+                    const int numSamples = blockIndex % 3 == 0 ? 256 : 97;
+                    juce::AudioBuffer<float> a(2, numSamples);
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < numSamples; ++i)
+                            a.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+                    juce::AudioBuffer<float> b(a);
+
+                    // Toggle a stage and a channel mid-stream to exercise variant changes
+                    if (blockIndex == 5)
+                        for (auto *dsp: {&staged, &fused})
+                            dsp->setBandSolo(0b0001010u);
+
+                    if (blockIndex == 14)
+                        for (auto *dsp: {&staged, &fused}) {
+                            dsp->setBandSolo(0);
+                            dsp->setBandMute(1u << 3);
+                        }
+
+                    if (blockIndex == 10) {
+                        for (auto *dsp: {&staged, &fused}) {
+                            dsp->setAuditFilter(false, 2000.0f, 2.0f);
+                            dsp->setSecondaryEnabled(true);
+                        }
+                    }
+
+                    staged.process(a);
+                    fused.process(b);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < numSamples; ++i)
+                            maxError = juce::jmax(maxError, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+                }
+
+                expectLessThan(maxError, 1.0e-5f,
+                               "Fused output should match staged (mode " + juce::String(channelModeToInt(mode))
+                               + ", wet " + juce::String(wet) + ")");
+            }
+        }
+    }
+
+    //==============================================================================
+    void testDoublePrecision() {
+        beginTest("Double Precision Matches Float");
+
+        constexpr juce::dsp::ProcessSpec spec{44100.0, 256, 2};
+
+        for (const bool fusedPath: {false, true}) {
+            for (const auto mode: {ChannelMode::MidSide, ChannelMode::LR, ChannelMode::TonalTransient}) {
+                gFractorDSP<float> single;
+                gFractorDSP<double> precise;
+                single.setExecutionMode(fusedPath ? gFractorDSP<float>::ExecutionMode::Fused
+                                                  : gFractorDSP<float>::ExecutionMode::Staged);
+                precise.setExecutionMode(fusedPath ? gFractorDSP<double>::ExecutionMode::Fused
+                                                   : gFractorDSP<double>::ExecutionMode::Staged);
+
+                const auto configure = [&](auto &dsp) {
+                    dsp.setOutputMode(mode);
+                    dsp.prepare(spec);
+                    dsp.setAuditFilter(true, 2000.0f, 2.0f);
+                    dsp.setBandSolo(0b0000110u);
+                    dsp.setSecondaryEnabled(false);
+                    dsp.setDryWet(0.5f);
+                    dsp.setGain(-6.0f);
+                };
+                configure(single);
+                configure(precise);
+
+                juce::Random random(31);
+                double maxError = 0.0;
+
+                for (int blockIndex = 0; blockIndex < 16; ++blockIndex) {
+                    const int numSamples = blockIndex % 2 == 0 ? 256 : 113;
+                    juce::AudioBuffer<float> a(2, numSamples);
+                    juce::AudioBuffer<double> b(2, numSamples);
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < numSamples; ++i) {
+                            const float x = random.nextFloat() * 2.0f - 1.0f;
+                            a.setSample(ch, i, x);
+                            b.setSample(ch, i, x);
+                        }
+
+                    single.process(a);
+                    precise.process(b);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < numSamples; ++i)
+                            maxError = juce::jmax(maxError, std::abs(static_cast<double>(a.getSample(ch, i))
+                                                                     - b.getSample(ch, i)));
+                }
+
+                const juce::String label = " (mode " + juce::String(channelModeToInt(mode))
+                                           + (fusedPath ? ", fused)" : ", staged)");
+                expectLessThan(maxError, 1.0e-4, "Double output should track float" + label);
+                expectWithinAbsoluteError(precise.getPeakPrimaryDb(), single.getPeakPrimaryDb(), 0.01f,
+                                          "Double meters should track float" + label);
+            }
+        }
+
+        // An offset float cannot hold survives a unity L/R pass in the 64-bit path
+        gFractorDSP<double> dsp;
+        dsp.setOutputMode(ChannelMode::LR);
+        dsp.prepare(spec);
+
+        juce::AudioBuffer<double> buffer(2, 256);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 256; ++i)
+                buffer.setSample(ch, i, 0.5 + 1.0e-12);
+
+        dsp.process(buffer);
+        expectWithinAbsoluteError(buffer.getSample(0, 255) - 0.5, 1.0e-12, 1.0e-15,
+                                  "Unity path should keep double resolution");
+    }
+
+    //==============================================================================
+    void testIdentityElision() {
+        beginTest("Identity Stages Leave The Block Bit-Identical");
+
+        constexpr juce::dsp::ProcessSpec spec{44100.0, 256, 2};
+
+        struct Setting {
+            const char *name;
+            ChannelMode mode;
+            float gainDb;
+            float wet;
+        };
+
+        // 0 dB / fully wet, a gain that a fully dry mix cancels, and a mix that a 0 dB gain cancels
+        constexpr std::array kSettings = {
+            Setting{"defaults", ChannelMode::MidSide, 0.0f, 1.0f},
+            Setting{"L/R defaults", ChannelMode::LR, 0.0f, 1.0f},
+            Setting{"fully dry", ChannelMode::MidSide, -12.0f, 0.0f},
+            Setting{"0 dB half wet", ChannelMode::LR, 0.0f, 0.5f},
+        };
+
+        for (const auto executionMode: {gFractorDSP<float>::ExecutionMode::Staged,
+                                        gFractorDSP<float>::ExecutionMode::Fused}) {
+            for (const auto &setting: kSettings) {
+                gFractorDSP<float> dsp;
+                dsp.setExecutionMode(executionMode);
+                dsp.setOutputMode(setting.mode);
+                dsp.setDryWet(setting.wet);
+                dsp.prepare(spec);
+                dsp.setGain(setting.gainDb); // fully dry: ramps while contributing nothing
+
+                juce::Random random(5);
+                bool identical = true;
+
+                for (int blockIndex = 0; blockIndex < 12; ++blockIndex) {
+                    // Also longer than the prepared block size
+                    const int numSamples = blockIndex == 3 ? 600 : 256;
+                    juce::AudioBuffer<float> buffer(2, numSamples);
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < numSamples; ++i)
+                            buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+                    juce::AudioBuffer<float> input(buffer);
+
+                    dsp.process(buffer);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        identical = identical
+                                    && std::memcmp(buffer.getReadPointer(ch), input.getReadPointer(ch),
+                                                   sizeof(float) * static_cast<size_t>(numSamples)) == 0;
+                }
+
+                expect(identical, juce::String("Output should be bit-identical (") + setting.name
+                                  + (executionMode == gFractorDSP<float>::ExecutionMode::Fused
+                                         ? ", fused)"
+                                         : ", staged)"));
+            }
+        }
+
+        // A gain change after a fully dry stretch starts from where its ramp has got to
+        gFractorDSP<float> dsp;
+        dsp.setDryWet(0.0f);
+        dsp.prepare(spec);
+        dsp.setGain(-12.0f);
+
+        juce::AudioBuffer<float> buffer(2, 256);
+        for (int blockIndex = 0; blockIndex < 20; ++blockIndex) {
+            buffer.clear();
+            dsp.process(buffer);
+        }
+
+        dsp.setDryWet(1.0f);
+        for (int blockIndex = 0; blockIndex < 20; ++blockIndex) {
+            for (int ch = 0; ch < 2; ++ch)
+                juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), 1.0f, 256);
+            dsp.process(buffer);
+        }
+
+        expectWithinAbsoluteError(buffer.getSample(0, 255), juce::Decibels::decibelsToGain(-12.0f), 1.0e-5f,
+                                  "Gain should have settled while the mix was fully dry");
+    }
+
+    //==============================================================================
+    void testChannelModeKernels() {
+        beginTest("Channel Mode Kernels");
+
+        using namespace ChannelModeKernels;
+        constexpr size_t numSamples = 67;
+
+        juce::Random random(99);
+        std::vector<float> inputL(numSamples), inputR(numSamples);
+        for (size_t i = 0; i < numSamples; ++i) {
+            inputL[i] = random.nextFloat() * 2.0f - 1.0f;
+            inputR[i] = random.nextFloat() * 2.0f - 1.0f;
+        }
+
+        ChannelModeState state;
+        state.primaryGain.reset(44100.0, 0.010);
+        state.secondaryGain.reset(44100.0, 0.010);
+
+        // Both channels on: M/S and L/R are exact identities
+        static_assert(Kernel<makeIndex(kMidSide, true, true)>::isIdentity);
+        static_assert(Kernel<makeIndex(kLR, true, true)>::isIdentity);
+        static_assert(!Kernel<makeIndex(kTonalTransient, true, true)>::isIdentity);
+
+        for (const auto mode: {ChannelMode::MidSide, ChannelMode::LR}) {
+            auto left = inputL;
+            auto right = inputR;
+            process(select(mode, true, true, state), left.data(), right.data(), numSamples, state);
+            expect(left == inputL && right == inputR, "Both-on M/S and L/R must not touch the buffer");
+        }
+
+        // Single-channel selections
+        for (const bool primOn: {false, true}) {
+            for (const bool secOn: {false, true}) {
+                auto msL = inputL, msR = inputR;
+                process(select(ChannelMode::MidSide, primOn, secOn, state), msL.data(), msR.data(), numSamples, state);
+
+                auto lrL = inputL, lrR = inputR;
+                process(select(ChannelMode::LR, primOn, secOn, state), lrL.data(), lrR.data(), numSamples, state);
+
+                for (size_t i = 0; i < numSamples; ++i) {
+                    const float mid = primOn ? (inputL[i] + inputR[i]) * 0.5f : 0.0f;
+                    const float side = secOn ? (inputL[i] - inputR[i]) * 0.5f : 0.0f;
+                    expectWithinAbsoluteError(msL[i], mid + side, 1.0e-6f);
+                    expectWithinAbsoluteError(msR[i], mid - side, 1.0e-6f);
+
+                    expectEquals(lrL[i], primOn ? inputL[i] : 0.0f);
+                    expectEquals(lrR[i], secOn ? inputR[i] : 0.0f);
+                }
+            }
+        }
+
+        // Tonal/Transient: settled kernels must match the general ramping kernel
+        {
+            constexpr size_t spectralSamples = 3000;
+            std::vector<float> longL(spectralSamples), longR(spectralSamples);
+            for (size_t i = 0; i < spectralSamples; ++i) {
+                longL[i] = random.nextFloat() * 2.0f - 1.0f;
+                longR[i] = random.nextFloat() * 2.0f - 1.0f;
+            }
+
+            static_assert(Kernel<makeIndex(kTonalTransient, true, false)>::isSpectral);
+            static_assert(!Kernel<makeIndex(kLR, true, false)>::isSpectral);
+
+            for (const bool primOn: {false, true}) {
+                for (const bool secOn: {false, true}) {
+                    SpectralSeparator settledSeparator, rampingSeparator;
+                    for (auto *separator: {&settledSeparator, &rampingSeparator}) {
+                        separator->setFftOrder(SpectralSeparator::kMinFftOrder);
+                        separator->prepare({44100.0, 512, 2});
+                    }
+
+                    ChannelModeState settled;
+                    settled.primaryGain.setCurrentAndTargetValue(primOn ? 1.0f : 0.0f);
+                    settled.secondaryGain.setCurrentAndTargetValue(secOn ? 1.0f : 0.0f);
+                    ChannelModeState ramping = settled;
+                    settled.separator = &settledSeparator;
+                    ramping.separator = &rampingSeparator;
+
+                    const unsigned index = select(ChannelMode::TonalTransient, primOn, secOn, settled);
+                    expectEquals(index, makeIndex(kTonalTransient, primOn, secOn));
+
+                    auto settledL = longL, settledR = longR;
+                    process(index, settledL.data(), settledR.data(), spectralSamples, settled);
+
+                    auto rampL = longL, rampR = longR;
+                    process(makeIndex(kTonalTransientRamp, false, false), rampL.data(), rampR.data(),
+                            spectralSamples, ramping);
+
+                    expect(settledL == rampL && settledR == rampR,
+                           "Settled Tonal/Transient kernels must match the ramping kernel");
+                }
+            }
+
+            // Without a separator the Tonal/Transient kernels pass the block through
+            auto left = inputL, right = inputR;
+            process(makeIndex(kTonalTransient, true, false), left.data(), right.data(), numSamples, state);
+            expect(left == inputL && right == inputR);
+        }
+
+        // A gain change routes Tonal/Transient through the ramping kernel until it settles
+        {
+            ChannelModeState ramping;
+            ramping.primaryGain.reset(44100.0, 0.010);
+            ramping.secondaryGain.reset(44100.0, 0.010);
+            ramping.primaryGain.setCurrentAndTargetValue(1.0f);
+            ramping.secondaryGain.setCurrentAndTargetValue(1.0f);
+
+            expectEquals(select(ChannelMode::TonalTransient, true, false, ramping),
+                         makeIndex(kTonalTransientRamp, false, false));
+        }
+    }
+
+    //==============================================================================
+    void testSpectralSeparator() {
+        beginTest("Spectral Separator");
+
+        constexpr double sampleRate = 44100.0;
+        constexpr juce::dsp::ProcessSpec spec{sampleRate, 512, 2};
+        constexpr int numSamples = 30000;
+        constexpr int clickAt = 20000;
+
+        // Steady 440 Hz tone with one click on top
+        std::vector<float> inputL(numSamples), inputR(numSamples);
+        for (int i = 0; i < numSamples; ++i) {
+            const float tone = 0.5f * std::sin(juce::MathConstants<float>::twoPi * 440.0f
+                                               * static_cast<float>(i) / static_cast<float>(sampleRate));
+            inputL[static_cast<size_t>(i)] = tone + (i == clickAt ? 1.0f : 0.0f);
+            inputR[static_cast<size_t>(i)] = 0.8f * tone + (i == clickAt ? 1.0f : 0.0f);
+        }
+
+        // Run the whole input through a fresh separator in odd-sized blocks
+        const auto separate = [&](const int order, const float percussiveOn, const float harmonicOn) {
+            SpectralSeparator separator;
+            separator.setFftOrder(order);
+            separator.prepare(spec);
+            expectEquals(separator.getLatencySamples(), 1 << order);
+
+            juce::SmoothedValue<float> percussiveGain(percussiveOn), harmonicGain(harmonicOn);
+            std::pair<std::vector<float>, std::vector<float>> out{inputL, inputR};
+
+            for (int start = 0; start < numSamples; start += 333) {
+                const auto len = static_cast<size_t>(juce::jmin(333, numSamples - start));
+                separator.process(out.first.data() + start, out.second.data() + start, len,
+                                  percussiveGain, harmonicGain);
+            }
+            return out;
+        };
+
+        for (const int order: {SpectralSeparator::kMinFftOrder, SpectralSeparator::kDefaultFftOrder}) {
+            const int latency = 1 << order;
+
+            // Both parts on: the delayed input, once the start-up fade (one hop) has passed
+            const auto both = separate(order, 1.0f, 1.0f);
+            float maxError = 0.0f;
+            for (int i = latency + latency / SpectralSeparator::kOverlap; i < numSamples; ++i) {
+                maxError = juce::jmax(maxError, std::abs(both.first[static_cast<size_t>(i)]
+                                                         - inputL[static_cast<size_t>(i - latency)]));
+                maxError = juce::jmax(maxError, std::abs(both.second[static_cast<size_t>(i)]
+                                                         - inputR[static_cast<size_t>(i - latency)]));
+            }
+            expectLessThan(maxError, 1.0e-4f, "Percussive + harmonic must rebuild the delayed input");
+
+            for (int i = 0; i < latency; ++i)
+                expectEquals(both.first[static_cast<size_t>(i)], 0.0f);
+        }
+
+        // The click goes to the percussive part, the steady tone to the harmonic part
+        {
+            constexpr int order = SpectralSeparator::kDefaultFftOrder;
+            constexpr int latency = 1 << order;
+            const auto percussive = separate(order, 1.0f, 0.0f);
+            const auto harmonic = separate(order, 0.0f, 1.0f);
+
+            const auto rms = [](const std::vector<float> &x, const int from, const int to) {
+                double sum = 0.0;
+                for (int i = from; i < to; ++i)
+                    sum += static_cast<double>(x[static_cast<size_t>(i)]) * x[static_cast<size_t>(i)];
+                return static_cast<float>(std::sqrt(sum / (to - from)));
+            };
+
+            // Steady stretch well after start-up and before the click
+            const float toneRms = rms(inputL, 12000, 12000 + 4096);
+            expectLessThan(rms(percussive.first, 12000 + latency, 12000 + latency + 4096), 0.1f * toneRms);
+            expectGreaterThan(rms(harmonic.first, 12000 + latency, 12000 + latency + 4096), 0.9f * toneRms);
+
+            float clickPeak = 0.0f;
+            for (int i = clickAt + latency - 8; i <= clickAt + latency + 8; ++i)
+                clickPeak = juce::jmax(clickPeak, std::abs(percussive.first[static_cast<size_t>(i)]));
+            expectGreaterThan(clickPeak, 0.5f, "The click should land in the percussive part");
+        }
+
+        // Transient length sets the frequency median span
+        {
+            SpectralSeparator separator;
+            separator.prepare(spec);
+
+            separator.setTransientLength(10.0f);
+            const int narrow = separator.getFrequencyMedianBins();
+            separator.setTransientLength(0.5f);
+            const int wide = separator.getFrequencyMedianBins();
+
+            expectGreaterThan(wide, narrow);
+            expectEquals(wide % 2, 1);
+            expectEquals(narrow % 2, 1);
+            expectLessOrEqual(wide, SpectralSeparator::kMaxFrequencyMedianBins);
+        }
+
+        // Non-finite input is passed through but never reaches the spectral state
+        {
+            SpectralSeparator separator;
+            separator.setFftOrder(SpectralSeparator::kMinFftOrder);
+            separator.prepare(spec);
+            juce::SmoothedValue<float> percussiveGain(1.0f), harmonicGain(0.0f);
+
+            std::vector<float> l(4096, 0.25f), r(4096, 0.25f);
+            l[100] = std::numeric_limits<float>::quiet_NaN();
+            r[200] = std::numeric_limits<float>::infinity();
+            separator.process(l.data(), r.data(), l.size(), percussiveGain, harmonicGain);
+
+            std::vector<float> l2(4096, 0.25f), r2(4096, 0.25f);
+            separator.process(l2.data(), r2.data(), l2.size(), percussiveGain, harmonicGain);
+
+            bool finite = true;
+            for (size_t i = 0; i < l2.size(); ++i)
+                finite = finite && std::isfinite(l2[i]) && std::isfinite(r2[i]);
+            expect(finite, "Percussive output must recover once non-finite input has passed");
+        }
+
+        // gFractorDSP reports the separator latency only in Tonal/Transient
+        {
+            gFractorDSP<float> dsp;
+            dsp.prepare(spec);
+            expectEquals(dsp.getLatencySamples(), 0);
+
+            dsp.setOutputMode(ChannelMode::TonalTransient);
+            expectEquals(dsp.getLatencySamples(), 1 << SpectralSeparator::kDefaultFftOrder);
+
+            dsp.setSeparatorFftOrder(SpectralSeparator::kMinFftOrder);
+            expectEquals(dsp.getLatencySamples(), 1 << SpectralSeparator::kMinFftOrder);
+
+            dsp.setSeparatorFftOrder(99);
+            expectEquals(dsp.getSeparatorFftOrder(), SpectralSeparator::kMaxFftOrder);
+
+            dsp.setOutputMode(ChannelMode::LR);
+            expectEquals(dsp.getLatencySamples(), 0);
+        }
+    }
+
+    //==============================================================================
+    void testBandpassCoefficientEngine() {
+        beginTest("Bandpass Coefficient Engine");
+
+        // In-place design matches JUCE's allocating makeBandPass()
+        for (const double sampleRate: {44100.0, 48000.0, 96000.0}) {
+            for (const float frequency: {40.0f, 1000.0f, 12000.0f}) {
+                for (const float q: {0.5f, 1.0f, 4.0f}) {
+                    const auto designed = BiquadCoefficients::bandPass(sampleRate, frequency, q);
+                    const auto reference = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, frequency, q);
+                    const auto *raw = reference->getRawCoefficients();
+
+                    expectWithinAbsoluteError(designed.b0, raw[0], 1.0e-4f);
+                    expectWithinAbsoluteError(designed.b1, raw[1], 1.0e-4f);
+                    expectWithinAbsoluteError(designed.b2, raw[2], 1.0e-4f);
+                    expectWithinAbsoluteError(designed.a1, raw[3], 1.0e-4f);
+                    expectWithinAbsoluteError(designed.a2, raw[4], 1.0e-4f);
+                }
+            }
+        }
+
+        // A retune glides, then lands exactly on the new design
+        {
+            constexpr juce::dsp::ProcessSpec spec{48000.0, 480, 2};
+            BandpassFilter<float> filter;
+            filter.prepare(spec);
+            filter.setParams(true, 500.0f, 1.0f);
+
+            juce::AudioBuffer<float> buffer(2, 480);
+            juce::dsp::AudioBlock<float> block(buffer);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+
+            filter.process(context);
+            const auto start = BiquadCoefficients::bandPass(spec.sampleRate, 500.0f, 1.0f);
+            expectEquals(filter.getCurrentCoefficients().a1, start.a1, "Activation applies coefficients at once");
+
+            filter.setParams(true, 5000.0f, 2.0f);
+            const auto end = BiquadCoefficients::bandPass(spec.sampleRate, 5000.0f, 2.0f);
+
+            filter.process(context);
+            expect(std::abs(filter.getCurrentCoefficients().a1 - end.a1) > 1.0e-3f,
+                   "Coefficients should still be gliding after 10 ms");
+
+            for (int i = 0; i < 4; ++i)
+                filter.process(context);
+
+            const auto &settled = filter.getCurrentCoefficients();
+            expectEquals(settled.b0, end.b0);
+            expectEquals(settled.a1, end.a1);
+            expectEquals(settled.a2, end.a2);
+        }
+    }
+
+    //==============================================================================
+    void testFilterSweepAllocations() {
+        beginTest("Filter Sweep Allocations");
+
+        constexpr juce::dsp::ProcessSpec spec{48000.0, 512, 2};
+        constexpr int numBlocks = static_cast<int>(10.0 * spec.sampleRate / spec.maximumBlockSize);
+
+        for (const auto executionMode: {gFractorDSP<float>::ExecutionMode::Staged, gFractorDSP<float>::ExecutionMode::Fused}) {
+            gFractorDSP<float> dsp;
+            dsp.setExecutionMode(executionMode);
+            dsp.prepare(spec);
+            dsp.setAuditFilter(true, 20.0f, 1.0f);
+            dsp.setBandFilter(true, 20000.0f, 2.0f);
+
+            juce::AudioBuffer<float> buffer(2, 512);
+            juce::Random random(5);
+            bool allFinite = true;
+            size_t numAllocations = 0;
+
+            {
+                AllocationCounter::ScopedCount allocations;
+
+                // 10 s log sweep 20 Hz -> 20 kHz (audit) and back down (band), retuned every block
+                for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+                    const float t = static_cast<float>(blockIndex) / static_cast<float>(numBlocks - 1);
+                    dsp.setAuditFilter(true, 20.0f * std::pow(1000.0f, t), 1.0f + t);
+                    dsp.setBandFilter(true, 20000.0f * std::pow(0.001f, t), 2.0f - t);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < 512; ++i)
+                            buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+                    dsp.process(buffer);
+                    allFinite = allFinite && std::isfinite(buffer.getSample(0, 511))
+                                && std::isfinite(buffer.getSample(1, 511));
+                }
+
+                numAllocations = allocations.getCount();
+            }
+
+            expectEquals(static_cast<int>(numAllocations), 0,
+                         "Filter sweep must not allocate on the audio thread");
+            expect(allFinite, "Sweep output should stay finite");
+        }
+    }
+
+    //==============================================================================
+    void testStereoBiquadCascade() {
+        beginTest("Stereo Biquad Cascade");
+
+        const auto from = BiquadCoefficients::bandPass(48000.0, 300.0f, 0.7f);
+        const auto to = BiquadCoefficients::bandPass(48000.0, 3000.0f, 2.0f);
+        const auto rampStep = BiquadCoefficients::rampStep(from, to, 16);
+
+        juce::Random random(31);
+
+        // Wavefront SIMD path must match four scalar TDF-II biquads, across block boundaries
+        for (const bool ramped: {false, true}) {
+            for (const int numSamples: {1, 2, 3, 16, 17, 64}) {
+                StereoBiquadCascade<float> cascade;
+                BiquadState refL1, refL2, refR1, refR2, refMono1, refMono2;
+                StereoBiquadCascade<float> monoCascade;
+
+                auto coefficients = from;
+                auto refCoefficients = from;
+                auto monoCoefficients = from;
+                float maxError = 0.0f;
+
+                for (int blockIndex = 0; blockIndex < 3; ++blockIndex) {
+                    std::vector<float> left(static_cast<size_t>(numSamples)), right(left.size());
+                    for (size_t i = 0; i < left.size(); ++i) {
+                        left[i] = random.nextFloat() * 2.0f - 1.0f;
+                        right[i] = random.nextFloat() * 2.0f - 1.0f;
+                    }
+                    auto expectedL = left, expectedR = right, mono = left;
+
+                    for (size_t i = 0; i < left.size(); ++i) {
+                        if (ramped)
+                            refCoefficients += rampStep;
+                        expectedL[i] = refL2.process(refL1.process(expectedL[i], refCoefficients), refCoefficients);
+                        expectedR[i] = refR2.process(refR1.process(expectedR[i], refCoefficients), refCoefficients);
+                    }
+
+                    const auto *step = ramped ? &rampStep : nullptr;
+                    cascade.process(left.data(), right.data(), left.size(), coefficients, step);
+                    monoCascade.process(mono.data(), nullptr, mono.size(), monoCoefficients, step);
+
+                    for (size_t i = 0; i < left.size(); ++i) {
+                        maxError = juce::jmax(maxError, std::abs(left[i] - expectedL[i]));
+                        maxError = juce::jmax(maxError, std::abs(right[i] - expectedR[i]));
+                        maxError = juce::jmax(maxError, std::abs(mono[i] - expectedL[i]));
+                    }
+                }
+
+                expectLessThan(maxError, 1.0e-6f,
+                               "Cascade should match scalar reference (" + juce::String(numSamples)
+                               + (ramped ? " samples, ramped)" : " samples)"));
+                expectWithinAbsoluteError(coefficients.a1, refCoefficients.a1, 1.0e-7f,
+                                          "Ramped coefficients should end where the scalar ramp does");
+            }
+        }
+    }
+
+    void testBandSoloBank() {
+        beginTest("Band Solo Bank");
+
+        constexpr double sampleRate = 48000.0;
+        constexpr juce::dsp::ProcessSpec spec{sampleRate, 512, 2};
+
+        // Per-band scalar reference: two cascaded BPFs at the band's centre and Q
+        std::array<BiquadCoefficients, kNumBands> bandCoefficients;
+        for (size_t band = 0; band < bandCoefficients.size(); ++band) {
+            const auto info = getBandInfo(band);
+            bandCoefficients[band] = BiquadCoefficients::bandPass(sampleRate, info.centerFreq, info.q);
+        }
+
+        juce::Random random(19);
+
+        const auto makeNoise = [&random](const int numSamples) {
+            juce::AudioBuffer<float> buffer(2, numSamples);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+            return buffer;
+        };
+
+        // Settled solo and mute masks must match the weighted sum of independent band filters
+        for (const auto &[solo, mute]: {std::pair<juce::uint32, juce::uint32>{1u << 3, 0},
+                                        {0b1010101u, 0},
+                                        {BandSoloBank::kAllBands, 1u << 6},
+                                        {0, 0b0000110u}}) {
+            BandSoloBank bank;
+            bank.setSoloMask(solo);
+            bank.setMuteMask(mute);
+            bank.prepare(spec); // no crossfade: starts on the masks
+
+            const auto weights = BandSoloBank::computeWeights(solo, mute);
+            std::array<std::array<BiquadState, 2>, kNumBands> stage1{}, stage2{};
+            float maxError = 0.0f;
+
+            for (const int numSamples: {97, 256, 5}) {
+                auto buffer = makeNoise(numSamples);
+                juce::AudioBuffer<float> expected(buffer);
+
+                for (int ch = 0; ch < 2; ++ch) {
+                    for (int i = 0; i < numSamples; ++i) {
+                        const float x = expected.getSample(ch, i);
+                        float y = x * weights[BandSoloBank::kDryLane];
+                        for (size_t band = 0; band < static_cast<size_t>(kNumBands); ++band) {
+                            const auto &c = bandCoefficients[band];
+                            const float filtered = stage2[band][ch].process(stage1[band][ch].process(x, c), c);
+                            y += filtered * weights[band];
+                        }
+                        expected.setSample(ch, i, y);
+                    }
+                }
+
+                juce::dsp::AudioBlock<float> block(buffer);
+                juce::dsp::ProcessContextReplacing<float> context(block);
+                bank.process(context);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                        maxError = juce::jmax(maxError, std::abs(buffer.getSample(ch, i) - expected.getSample(ch, i)));
+            }
+
+            expectLessThan(maxError, 1.0e-5f,
+                           "Bank should match per-band reference (solo " + juce::String(static_cast<int>(solo))
+                           + ", mute " + juce::String(static_cast<int>(mute)) + ")");
+        }
+
+        // Switching on and off crossfades from and back to the untouched input, then sleeps
+        {
+            BandSoloBank bank;
+            bank.prepare(spec);
+            expect(!bank.beginBlock(), "Bank should be bypassed with no solo or mute");
+
+            const int crossfade = juce::roundToInt(sampleRate * BandSoloBank::kCrossfadeSeconds);
+
+            bank.setSoloMask(1u << 3);
+            auto buffer = makeNoise(crossfade * 2);
+            const juce::AudioBuffer<float> input(buffer);
+            juce::dsp::AudioBlock<float> block(buffer);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            bank.process(context);
+
+            expectWithinAbsoluteError(buffer.getSample(0, 0), input.getSample(0, 0), 0.01f,
+                                      "First sample after solo should still be almost dry");
+
+            bank.setSoloMask(0);
+            bank.process(context);
+            expect(!bank.beginBlock(), "Bank should go back to sleep once the crossfade has finished");
+
+            auto untouched = makeNoise(64);
+            const juce::AudioBuffer<float> reference(untouched);
+            juce::dsp::AudioBlock<float> untouchedBlock(untouched);
+            juce::dsp::ProcessContextReplacing<float> untouchedContext(untouchedBlock);
+            bank.process(untouchedContext);
+
+            bool identical = true;
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 64; ++i)
+                    identical = identical && untouched.getSample(ch, i) == reference.getSample(ch, i);
+            expect(identical, "Sleeping bank should leave the signal untouched");
+        }
+    }
+
+    void testParameterTimeline() {
+        beginTest("Parameter Timeline");
+
+        constexpr juce::dsp::ProcessSpec spec{48000.0, 512, 2};
+
+        DSPParameters initial;
+        DSPParameters automated = initial;
+        automated.gainDb = -12.0f;
+        automated.dryWet = 0.5f;
+        automated.secondaryEnabled = false;
+        DSPParameters bypassed = automated;
+        bypassed.bypassed = true;
+
+        // Same offset replaces, full timeline keeps the newest values on its last point
+        {
+            ParameterTimeline timeline;
+            timeline.add(0, initial);
+            timeline.add(0, automated);
+            expectEquals(static_cast<int>(timeline.size()), 1);
+            expect(timeline.begin()->parameters == automated);
+
+            timeline.clear();
+            for (int i = 0; i < static_cast<int>(ParameterTimeline::kMaxPoints) + 4; ++i) {
+                auto p = initial;
+                p.gainDb = static_cast<float>(-i);
+                timeline.add(i, p);
+            }
+            expectEquals(static_cast<int>(timeline.size()), static_cast<int>(ParameterTimeline::kMaxPoints));
+            expectEquals((timeline.end() - 1)->parameters.gainDb,
+                         -static_cast<float>(ParameterTimeline::kMaxPoints + 3));
+        }
+
+        // Splitting must match processing the pieces separately with the setters in between
+        for (const auto executionMode: {gFractorDSP<float>::ExecutionMode::Staged, gFractorDSP<float>::ExecutionMode::Fused}) {
+            gFractorDSP<float> split, manual;
+            for (auto *dsp: {&split, &manual}) {
+                dsp->setExecutionMode(executionMode);
+                dsp->prepare(spec);
+            }
+
+            juce::Random random(5);
+            float maxError = 0.0f;
+            bool bypassUntouched = true;
+
+            for (int blockIndex = 0; blockIndex < 4; ++blockIndex) {
+                constexpr int numSamples = 300;
+                juce::AudioBuffer<float> a(2, numSamples);
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                        a.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+                juce::AudioBuffer<float> b(a);
+                const juce::AudioBuffer<float> input(a);
+
+                ParameterTimeline timeline;
+                timeline.add(0, initial);
+                timeline.add(37, automated);
+                timeline.add(250, bypassed);
+                split.process(a, timeline);
+
+                int start = 0;
+                for (const auto &point: timeline) {
+                    if (point.sampleOffset > start) {
+                        juce::AudioBuffer<float> piece(b.getArrayOfWritePointers(), 2, start, point.sampleOffset - start);
+                        manual.process(piece);
+                        start = point.sampleOffset;
+                    }
+                    manual.setParameters(point.parameters);
+                }
+                juce::AudioBuffer<float> tail(b.getArrayOfWritePointers(), 2, start, numSamples - start);
+                manual.process(tail);
+
+                for (int ch = 0; ch < 2; ++ch) {
+                    for (int i = 0; i < numSamples; ++i) {
+                        maxError = juce::jmax(maxError, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+                        if (i >= 250)
+                            bypassUntouched = bypassUntouched && a.getSample(ch, i) == input.getSample(ch, i);
+                    }
+                }
+            }
+
+            expectLessThan(maxError, 1.0e-6f, "Split block should match separately processed pieces");
+            expect(bypassUntouched, "Samples after a bypass point should pass untouched");
+        }
+    }
+
+    //==============================================================================
+    void testSilenceDetector() {
+        beginTest("Silence Detector");
+
+        using Activity = SilenceDetector::Activity;
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 480; // 10 ms
+
+        SilenceDetector detector;
+        detector.setThresholdDb(-90.0f);
+        detector.setHoldMs(100.0f);
+        detector.prepare(sampleRate);
+
+        juce::AudioBuffer<float> silent(2, blockSize);
+        silent.clear();
+        juce::AudioBuffer<float> quiet(2, blockSize);
+        fillBufferWithValue(quiet, juce::Decibels::decibelsToGain(-100.0f)); // under the threshold
+        juce::AudioBuffer<float> signal(2, blockSize);
+        signal.clear();
+        signal.setSample(1, blockSize - 1, 0.001f); // one sample on the second channel
+
+        // Asleep after exactly the hold (10 blocks of 10 ms), reported once
+        for (int block = 0; block < 9; ++block)
+            expect(detector.process(block % 2 == 0 ? silent : quiet) == Activity::Active,
+                   "Should stay awake during the hold");
+        expect(detector.process(silent) == Activity::EnteredSleep, "Hold elapsed: should fall asleep");
+        expect(detector.isSleeping());
+        expect(detector.process(quiet) == Activity::Sleeping, "Sub-threshold input should keep it asleep");
+
+        // Any channel reaching the threshold wakes it within the block and restarts the hold
+        expect(detector.process(signal) == Activity::Active, "Signal should wake it at once");
+        expect(!detector.isSleeping());
+        for (int block = 0; block < 9; ++block)
+            detector.process(silent);
+        expect(detector.process(silent) == Activity::EnteredSleep, "A full hold should be needed again");
+
+        // Flushed only after the flush samples (processing latency) of digital silence while asleep;
+        // sub-threshold input keeps it asleep but never flushed
+        detector.reset();
+        detector.setFlushSamples(blockSize * 20);
+        int blocksToFlush = 0;
+        for (; !detector.hasFlushed() && blocksToFlush < 100; ++blocksToFlush)
+            detector.process(silent);
+        expectEquals(blocksToFlush, 20, "Flush samples of digital silence should allow processing to stop");
+        juce::AudioBuffer<float> faint(2, blockSize);
+        fillBufferWithValue(faint, juce::Decibels::decibelsToGain(-95.0f));
+        detector.process(faint);
+        expect(detector.isSleeping() && !detector.hasFlushed(), "Sub-threshold input is still audio");
+        detector.setFlushSamples(0);
+        detector.process(silent);
+        expect(detector.hasFlushed());
+
+        // Disabled: always active; double blocks classify the same way
+        detector.setEnabled(false);
+        expect(detector.process(silent) == Activity::Active);
+        expect(!detector.isSleeping(), "Disabling should wake it");
+
+        SilenceDetector precise;
+        precise.setHoldMs(SilenceDetector::kMinHoldMs);
+        precise.prepare(sampleRate);
+        juce::AudioBuffer<double> doubleSilent(2, blockSize);
+        doubleSilent.clear();
+        Activity last = Activity::Active;
+        for (int block = 0; block < 5 && last == Activity::Active; ++block)
+            last = precise.process(doubleSilent);
+        expect(last == Activity::EnteredSleep, "Double blocks should sleep after the hold");
+
+        // Settings are clamped
+        precise.setThresholdDb(0.0f);
+        expectEquals(precise.getThresholdDb(), SilenceDetector::kMaxThresholdDb);
+        precise.setHoldMs(0.0f);
+        expectEquals(precise.getHoldMs(), SilenceDetector::kMinHoldMs);
+
+        // The processor's sleep path: processSilence() once flushed gives the same output as
+        // running the chain throughout, with gain, dry/wet, a mute and latency (the crossover),
+        // and input under the threshold still comes out processed
+        {
+            const juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(blockSize), 2};
+            gFractorDSP<float> awake, gated;
+            for (auto *dsp: {&awake, &gated}) {
+                dsp->setOutputMode(ChannelMode::LR);
+                dsp->setCrossoverEnabled(true);
+                dsp->prepare(spec);
+            }
+
+            DSPParameters parameters;
+            parameters.gainDb = 6.0f;
+            parameters.dryWet = 0.8f;
+            parameters.secondaryEnabled = false;
+            ParameterTimeline timeline;
+            timeline.add(0, parameters);
+
+            SilenceDetector gate;
+            gate.setThresholdDb(SilenceDetector::kMaxThresholdDb);
+            gate.setHoldMs(SilenceDetector::kMinHoldMs);
+            gate.setFlushSamples(gated.getTailSamples());
+            gate.prepare(sampleRate);
+
+            juce::Random random(23);
+            float maxError = 0.0f;
+            int asleepBlocks = 0, sleepingBlocks = 0;
+
+            // Signal, 0.5 s at -80 dBFS (under the threshold), 1 s of digital silence, signal again
+            for (int block = 0; block < 190; ++block) {
+                const float level = block < 20 || block >= 170 ? 1.0f
+                                    : block < 70              ? juce::Decibels::decibelsToGain(-80.0f)
+                                                              : 0.0f;
+                juce::AudioBuffer<float> a(2, blockSize);
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < blockSize; ++i)
+                        a.setSample(ch, i, level * (random.nextFloat() - 0.5f));
+                juce::AudioBuffer<float> b(a);
+
+                awake.process(a, timeline);
+                if (gate.process(b) != Activity::Active)
+                    ++asleepBlocks;
+                if (gate.hasFlushed()) {
+                    gated.processSilence(b, parameters);
+                    ++sleepingBlocks;
+                } else {
+                    gated.process(b, timeline);
+                }
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < blockSize; ++i)
+                        maxError = juce::jmax(maxError, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+            }
+
+            expectGreaterThan(asleepBlocks, sleepingBlocks, "The quiet input should sleep without stopping processing");
+            expectGreaterThan(sleepingBlocks, 0, "The gate should have slept through the silence");
+            expectLessThan(maxError, 1.0e-6f, "Sleeping should not change the processed output");
+        }
+    }
+
+    //==============================================================================
+    void testPartitionedConvolver() {
+        beginTest("Partitioned Convolver");
+
+        constexpr int order = 6; // 32-sample partitions
+        constexpr size_t partitionSize = 32;
+        constexpr size_t numPartitions = 8;
+        juce::dsp::FFT fft(order);
+        juce::Random random(42);
+
+        std::vector<float> kernelA(200), kernelB(150), input(partitionSize * 40);
+        for (auto &tap: kernelA)
+            tap = random.nextFloat() - 0.5f;
+        for (auto &tap: kernelB)
+            tap = random.nextFloat() - 0.5f;
+        for (auto &sample: input)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        const auto direct = [&](const std::vector<float> &kernel, const size_t n) {
+            double sum = 0.0;
+            for (size_t k = 0; k < kernel.size() && k <= n; ++k)
+                sum += static_cast<double>(kernel[k]) * input[n - k];
+            return static_cast<float>(sum);
+        };
+
+        std::vector<float> scratch;
+        PartitionedConvolver::Kernel a, b;
+        PartitionedConvolver::prepareKernel(fft, numPartitions, a);
+        PartitionedConvolver::prepareKernel(fft, numPartitions, b);
+        PartitionedConvolver::transformKernel(fft, kernelA.data(), kernelA.size(), a, scratch);
+        PartitionedConvolver::transformKernel(fft, kernelB.data(), kernelB.size(), b, scratch);
+        expectEquals(static_cast<int>(a.endPartition), 7);
+
+        PartitionedConvolver convolver;
+        convolver.prepare(fft, numPartitions);
+
+        // Kernel A for 20 partitions, then a faded switch to B and B alone after it
+        constexpr size_t switchAt = 20;
+        float maxError = 0.0f;
+        std::vector<float> output(partitionSize);
+
+        for (size_t p = 0; p < input.size() / partitionSize; ++p) {
+            const bool fading = p == switchAt;
+            convolver.process(input.data() + p * partitionSize, output.data(), p < switchAt ? a : b,
+                              fading ? &a : nullptr);
+
+            if (fading)
+                continue;
+
+            for (size_t i = 0; i < partitionSize; ++i) {
+                const size_t n = p * partitionSize + i;
+                maxError = juce::jmax(maxError, std::abs(output[i] - direct(p < switchAt ? kernelA : kernelB, n)));
+            }
+        }
+        expectLessThan(maxError, 1.0e-4f, "Partitioned output must match direct convolution");
+
+        // A weighted sum of kernels convolves as the weighted sum of their outputs
+        PartitionedConvolver::Kernel sum;
+        PartitionedConvolver::prepareKernel(fft, numPartitions, sum);
+        PartitionedConvolver::addKernel(sum, a, 0.5f);
+        PartitionedConvolver::addKernel(sum, b, -2.0f);
+        PartitionedConvolver::addKernel(sum, b, 0.0f);
+
+        convolver.reset();
+        maxError = 0.0f;
+        for (size_t p = 0; p < input.size() / partitionSize; ++p) {
+            convolver.process(input.data() + p * partitionSize, output.data(), sum);
+            for (size_t i = 0; i < partitionSize; ++i) {
+                const size_t n = p * partitionSize + i;
+                maxError = juce::jmax(maxError, std::abs(output[i] - (0.5f * direct(kernelA, n)
+                                                                      - 2.0f * direct(kernelB, n))));
+            }
+        }
+        expectLessThan(maxError, 1.0e-4f);
+
+        // Leading silence is skipped, not convolved
+        std::vector<float> delayed(100, 0.0f);
+        delayed.back() = 1.0f;
+        PartitionedConvolver::transformKernel(fft, delayed.data(), delayed.size(), a, scratch);
+        expectEquals(static_cast<int>(a.firstPartition), 3);
+        expectEquals(static_cast<int>(a.endPartition), 4);
+    }
+
+    //==============================================================================
+    void testMultibandCrossover() {
+        beginTest("Multiband Crossover");
+
+        constexpr double sampleRate = 48000.0;
+        constexpr juce::dsp::ProcessSpec spec{sampleRate, 512, 2};
+        constexpr int numSamples = 24000;
+        const int latency = MultibandCrossover::getLatencySamples(sampleRate);
+        expectEquals(latency, 256 + 2047);
+
+        const auto tone = [&](const float frequency, const int i) {
+            return std::sin(juce::MathConstants<float>::twoPi * frequency * static_cast<float>(i)
+                            / static_cast<float>(sampleRate));
+        };
+
+        // Run a stereo signal through a prepared crossover in odd-sized blocks
+        const auto run = [&](MultibandCrossover &crossover, std::vector<float> left, std::vector<float> right) {
+            for (int start = 0; start < numSamples; start += 317) {
+                const auto len = static_cast<size_t>(juce::jmin(317, numSamples - start));
+                float *lefts[] = {left.data() + start};
+                float *rights[] = {right.data() + start};
+                crossover.process(lefts, rights, 1, len);
+            }
+            return std::make_pair(std::move(left), std::move(right));
+        };
+
+        const auto rms = [](const std::vector<float> &x, const int from, const int to) {
+            double sum = 0.0;
+            for (int i = from; i < to; ++i)
+                sum += static_cast<double>(x[static_cast<size_t>(i)]) * x[static_cast<size_t>(i)];
+            return static_cast<float>(std::sqrt(sum / (to - from)));
+        };
+
+        std::vector<float> inputL(numSamples), inputR(numSamples);
+        juce::Random random(7);
+        for (int i = 0; i < numSamples; ++i) {
+            inputL[static_cast<size_t>(i)] = random.nextFloat() - 0.5f;
+            inputR[static_cast<size_t>(i)] = 0.3f * inputL[static_cast<size_t>(i)] + 0.5f * (random.nextFloat() - 0.5f);
+        }
+
+        // Unity bands: the input delayed by the latency, silence before it
+        {
+            MultibandCrossover crossover;
+            crossover.prepare(spec, 1);
+            expectEquals(crossover.getLatencySamples(), latency);
+            expectEquals(crossover.getNumBands(), kNumBands);
+
+            const auto out = run(crossover, inputL, inputR);
+            float maxError = 0.0f;
+            for (int i = latency; i < numSamples; ++i) {
+                maxError = juce::jmax(maxError, std::abs(out.first[static_cast<size_t>(i)]
+                                                         - inputL[static_cast<size_t>(i - latency)]));
+                maxError = juce::jmax(maxError, std::abs(out.second[static_cast<size_t>(i)]
+                                                         - inputR[static_cast<size_t>(i - latency)]));
+            }
+            expectLessThan(maxError, 1.0e-4f, "Unity bands must sum to the delayed input");
+            expectLessThan(std::abs(out.first[static_cast<size_t>(latency - 1)]), 1.0e-5f,
+                           "Nothing should come out before the latency");
+        }
+
+        // Only the Mid band (600 Hz - 2 kHz) on: 1 kHz passes, 100 Hz and 8 kHz are stopped
+        {
+            MultibandCrossover crossover;
+            crossover.prepare(spec, 1);
+            for (int band = 0; band < kNumBands; ++band)
+                crossover.setBand(band, {0.0f, 0.0f, band == 3, band == 3});
+
+            for (const auto &[frequency, passes]: {std::pair{1000.0f, true}, {100.0f, false}, {8000.0f, false}}) {
+                std::vector<float> l(numSamples), r(numSamples);
+                for (int i = 0; i < numSamples; ++i)
+                    l[static_cast<size_t>(i)] = r[static_cast<size_t>(i)] = 0.5f * tone(frequency, i);
+
+                const auto out = run(crossover, l, r);
+                const float gain = rms(out.first, numSamples - 8192, numSamples) / rms(l, 0, 8192);
+                if (passes)
+                    expectWithinAbsoluteError(gain, 1.0f, 0.02f);
+                else
+                    expectLessThan(gain, 0.001f, juce::String(frequency) + " Hz should be stopped");
+            }
+        }
+
+        // Mid and side are independent: side muted in the Mid band, mid raised by 6 dB there
+        {
+            MultibandCrossover crossover;
+            crossover.prepare(spec, 1);
+            crossover.setBand(3, {6.0f, 0.0f, true, false});
+
+            std::vector<float> l(numSamples), r(numSamples);
+            for (int i = 0; i < numSamples; ++i) {
+                const float mid = 0.25f * tone(1000.0f, i);
+                const float side = 0.25f * tone(1250.0f, i);
+                l[static_cast<size_t>(i)] = mid + side;
+                r[static_cast<size_t>(i)] = mid - side;
+            }
+
+            auto out = run(crossover, l, r);
+            std::vector<float> mid(numSamples), side(numSamples);
+            for (size_t i = 0; i < mid.size(); ++i) {
+                mid[i] = 0.5f * (out.first[i] + out.second[i]);
+                side[i] = 0.5f * (out.first[i] - out.second[i]);
+            }
+
+            const float inputRms = 0.25f / std::sqrt(2.0f);
+            expectWithinAbsoluteError(rms(mid, numSamples - 8192, numSamples) / inputRms,
+                                      juce::Decibels::decibelsToGain(6.0f), 0.03f);
+            expectLessThan(rms(side, numSamples - 8192, numSamples) / inputRms, 0.001f);
+        }
+
+        // A gain change while running is crossfaded: no step bigger than the signal's own slope
+        {
+            MultibandCrossover crossover;
+            crossover.prepare(spec, 1);
+
+            std::vector<float> l(numSamples), r(numSamples);
+            for (int i = 0; i < numSamples; ++i)
+                l[static_cast<size_t>(i)] = r[static_cast<size_t>(i)] = 0.5f * tone(200.0f, i);
+
+            constexpr int changeAt = 12000;
+            for (int start = 0; start < numSamples; start += 480) {
+                if (start == changeAt)
+                    for (int band = 0; band < kNumBands; ++band)
+                        crossover.setBand(band, {0.0f, 0.0f, false, false});
+
+                float *lefts[] = {l.data() + start};
+                float *rights[] = {r.data() + start};
+                crossover.process(lefts, rights, 1, 480);
+            }
+
+            float maxStep = 0.0f;
+            for (int i = latency + 1; i < numSamples; ++i)
+                maxStep = juce::jmax(maxStep, std::abs(l[static_cast<size_t>(i)] - l[static_cast<size_t>(i - 1)]));
+
+            const float toneSlope = 0.5f * juce::MathConstants<float>::twoPi * 200.0f / static_cast<float>(sampleRate);
+            expectLessThan(maxStep, 1.05f * toneSlope, "Kernel switches must not click");
+            expectLessThan(rms(l, numSamples - 2048, numSamples), 1.0e-4f, "All bands off should be silent");
+        }
+
+        // Frequencies are sorted, deduplicated, clamped and capped; a single stays mid-only
+        {
+            MultibandCrossover crossover;
+            crossover.setFrequencies({5000.0f, 100.0f, 100.0f, 5.0f, 30000.0f, 1.0e3f, 2.0e3f, 3.0e3f, 4.0e3f, 6.0e3f});
+            const auto &frequencies = crossover.getFrequencies();
+            expectEquals(static_cast<int>(frequencies.size()), MultibandCrossover::kMaxBands - 1);
+            expectEquals(frequencies.front(), MultibandCrossover::kMinFrequency);
+            expect(std::is_sorted(frequencies.begin(), frequencies.end()));
+
+            crossover.setFrequencies({});
+            expectEquals(static_cast<int>(crossover.getFrequencies().size()), MultibandCrossover::kMaxBands - 1,
+                         "An empty list should leave the frequencies alone");
+
+            crossover.setFrequencies({1000.0f});
+            crossover.prepare(spec, 1);
+            crossover.setBand(0, {0.0f, 0.0f, false, true});
+
+            std::vector<double> mono(numSamples);
+            for (int i = 0; i < numSamples; ++i)
+                mono[static_cast<size_t>(i)] = 0.5 * tone(100.0f, i) + 0.5 * tone(5000.0f, i);
+
+            for (int start = 0; start < numSamples; start += 500) {
+                double *lefts[] = {mono.data() + start};
+                double *rights[] = {nullptr};
+                crossover.process(lefts, rights, 1, 500);
+            }
+
+            // The 100 Hz part was in the muted low band; 5 kHz is left at 0.5 / sqrt(2)
+            double sum = 0.0;
+            for (int i = numSamples - 8192; i < numSamples; ++i)
+                sum += mono[static_cast<size_t>(i)] * mono[static_cast<size_t>(i)];
+            expectWithinAbsoluteError(std::sqrt(sum / 8192.0), 0.5 / std::sqrt(2.0), 0.01);
+        }
+
+        // gFractorDSP adds the crossover latency while it is on
+        {
+            gFractorDSP<float> dsp;
+            dsp.prepare(spec);
+            expectEquals(dsp.getLatencySamples(), 0);
+            dsp.setCrossoverEnabled(true);
+            expectEquals(dsp.getLatencySamples(), latency);
+            dsp.setOutputMode(ChannelMode::TonalTransient);
+            expectEquals(dsp.getLatencySamples(), latency + (1 << dsp.getSeparatorFftOrder()));
+            dsp.setOutputMode(ChannelMode::MidSide);
+
+            juce::AudioBuffer<float> buffer(2, 512);
+            std::vector<float> outL;
+            for (int block = 0; block < 10; ++block) {
+                for (int i = 0; i < 512; ++i) {
+                    buffer.setSample(0, i, inputL[static_cast<size_t>(block * 512 + i)]);
+                    buffer.setSample(1, i, inputR[static_cast<size_t>(block * 512 + i)]);
+                }
+                dsp.process(buffer);
+                outL.insert(outL.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + 512);
+            }
+
+            float maxError = 0.0f;
+            for (size_t i = static_cast<size_t>(latency); i < outL.size(); ++i)
+                maxError = juce::jmax(maxError, std::abs(outL[i] - inputL[i - static_cast<size_t>(latency)]));
+            expectLessThan(maxError, 1.0e-4f, "Crossover at unity should only delay the DSP output");
+        }
+    }
+
+    void testNonUniformConvolver() {
+        beginTest("Non-Uniform Convolver");
+
+        const NonUniformConvolver::Ffts ffts;
+        constexpr size_t latency = NonUniformConvolver::getHeadSize();
+        expectEquals(NonUniformConvolver::getLatencySamples(), 64);
+        expectEquals(static_cast<int>(NonUniformConvolver::getTailOffset()), 960);
+
+        juce::Random random(7);
+        std::vector<float> kernelA(3000), kernelB(100), input(12000);
+        for (auto &tap: kernelA)
+            tap = (random.nextFloat() - 0.5f) * 0.1f;
+        for (auto &tap: kernelB)
+            tap = random.nextFloat() - 0.5f;
+        for (auto &sample: input)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        // Direct convolution, delayed by the head partition
+        const auto direct = [&](const std::vector<float> &kernel, const size_t n) {
+            if (n < latency)
+                return 0.0f;
+            const size_t m = n - latency;
+            double sum = 0.0;
+            for (size_t k = 0; k < kernel.size() && k <= m; ++k)
+                sum += static_cast<double>(kernel[k]) * input[m - k];
+            return static_cast<float>(sum);
+        };
+
+        std::vector<float> scratch;
+        NonUniformConvolver::Kernel a, b;
+        NonUniformConvolver::prepareKernel(ffts, kernelA.size(), a);
+        NonUniformConvolver::prepareKernel(ffts, kernelA.size(), b);
+        NonUniformConvolver::transformKernel(ffts, kernelA.data(), kernelA.size(), a, scratch);
+        NonUniformConvolver::transformKernel(ffts, kernelB.data(), kernelB.size(), b, scratch);
+        expect(b.stages[1].isSilent(), "A kernel shorter than the tail offset should leave the tail silent");
+
+        NonUniformConvolver convolver;
+        convolver.prepare(ffts, kernelA.size());
+        convolver.setKernel(&a);
+        expect(!convolver.isSwitching(), "The first kernel has nothing to switch from");
+
+        // Odd host blocks; switch to B half way and check both sides of the switch
+        std::vector<float> output = input;
+        size_t switchAt = 0;
+        size_t start = 0;
+
+        for (size_t block = 0; start < output.size(); ++block) {
+            const size_t len = juce::jmin<size_t>(block % 2 == 0 ? 37 : 700, output.size() - start);
+            if (start >= 6000 && switchAt == 0) {
+                convolver.setKernel(&b);
+                expect(convolver.isSwitching());
+                switchAt = start;
+            }
+
+            convolver.process(output.data() + start, len);
+            start += len;
+        }
+
+        float errorA = 0.0f, errorB = 0.0f;
+        for (size_t n = 0; n < switchAt; ++n)
+            errorA = juce::jmax(errorA, std::abs(output[n] - direct(kernelA, n)));
+        for (size_t n = switchAt + 2 * NonUniformConvolver::getTailSize(); n < output.size(); ++n)
+            errorB = juce::jmax(errorB, std::abs(output[n] - direct(kernelB, n)));
+        expectLessThan(errorA, 1.0e-4f, "Head + tail output must match direct convolution");
+        expectLessThan(errorB, 1.0e-4f, "After a switch the new kernel applies to the full history");
+        expect(!convolver.isSwitching());
+
+        // Doubles convert at the edges; a nullptr kernel silences
+        {
+            NonUniformConvolver mono;
+            mono.prepare(ffts, kernelA.size());
+            mono.setKernel(&a);
+
+            std::vector<double> samples(input.begin(), input.begin() + 4096);
+            mono.process(samples.data(), samples.size());
+
+            double maxError = 0.0;
+            for (size_t n = 0; n < samples.size(); ++n)
+                maxError = juce::jmax(maxError, std::abs(samples[n] - static_cast<double>(direct(kernelA, n))));
+            expectLessThan(maxError, 1.0e-4);
+
+            mono.setKernel(nullptr);
+            std::vector<float> silent(input.begin(), input.begin() + 4096);
+            mono.process(silent.data(), silent.size());
+            float peak = 0.0f;
+            for (size_t n = 2 * NonUniformConvolver::getTailSize(); n < silent.size(); ++n)
+                peak = juce::jmax(peak, std::abs(silent[n]));
+            expectLessThan(peak, 1.0e-6f);
+        }
+    }
+
+    void testMatchEqualizer() {
+        beginTest("Match EQ");
+
+        constexpr double sampleRate = 48000.0;
+        juce::Random random(11);
+
+        // A -3 dB/octave tilt around 1 kHz, in the analyzer's saved-curve format
+        const auto tiltTarget = [](const float dbPerOctave) {
+            MatchEqDesigner::Target target;
+            target.fftSize = 4096;
+            target.sampleRate = sampleRate;
+            target.db.resize(2049);
+            for (size_t k = 0; k < target.db.size(); ++k) {
+                const double frequency = juce::jmax(10.0, static_cast<double>(k) * sampleRate / 4096.0);
+                target.db[k] = dbPerOctave * static_cast<float>(std::log2(frequency / 1000.0));
+            }
+            return target;
+        };
+
+        const auto responseDb = [](const std::vector<float> &impulse, const double frequency, const size_t offset) {
+            std::complex<double> sum;
+            for (size_t n = offset; n < impulse.size(); ++n)
+                sum += static_cast<double>(impulse[n])
+                        * std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * frequency
+                                          * static_cast<double>(n - offset) / sampleRate);
+            return 20.0 * std::log10(std::abs(sum) + 1.0e-12);
+        };
+
+        std::vector<float> noise(static_cast<size_t>(3.0 * sampleRate));
+        for (auto &sample: noise)
+            sample = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+
+        // Designer: white noise measured, correction follows the target's shape
+        {
+            MatchEqDesigner designer;
+            designer.prepare(sampleRate);
+
+            std::vector<float> correction;
+            designer.pushSamples(noise.data(), static_cast<size_t>(sampleRate));
+            expect(!designer.designCorrection(tiltTarget(-3.0f), 1.0f, correction),
+                   "No design before kMinAnalysisSeconds have been measured");
+
+            designer.pushSamples(noise.data() + static_cast<size_t>(sampleRate), noise.size() - static_cast<size_t>(sampleRate));
+            expectGreaterOrEqual(designer.getAnalysedSeconds(), MatchEqDesigner::kMinAnalysisSeconds);
+            expect(designer.designCorrection(tiltTarget(-3.0f), 1.0f, correction));
+            expectEquals(static_cast<int>(correction.size()), static_cast<int>(MatchEqDesigner::getNumBins()));
+
+            const auto at = [&](const std::vector<float> &curve, const double frequency) {
+                return curve[static_cast<size_t>(std::lround(frequency * 8192.0 / sampleRate))];
+            };
+            expectWithinAbsoluteError(at(correction, 250.0) - at(correction, 4000.0), 12.0f, 1.5f);
+            expectWithinAbsoluteError(at(correction, 5.0), 0.0f, 1.0e-3f, "Below the matched range fades to 0 dB");
+
+            std::vector<float> half;
+            designer.designCorrection(tiltTarget(-3.0f), 0.5f, half);
+            expectWithinAbsoluteError(at(half, 250.0) - at(half, 4000.0), 6.0f, 1.0f);
+
+            std::vector<float> steep;
+            designer.designCorrection(tiltTarget(-12.0f), 1.0f, steep);
+            float largest = 0.0f;
+            for (const float db: steep)
+                largest = juce::jmax(largest, std::abs(db));
+            expectLessOrEqual(largest, MatchEqDesigner::kMaxCorrectionDb);
+
+            // Minimum phase: the magnitude of the correction with its energy at the front
+            std::vector<float> impulse;
+            designer.designFilter(correction, impulse);
+            expectEquals(static_cast<int>(impulse.size()), static_cast<int>(MatchEqDesigner::kFilterLength));
+            expectWithinAbsoluteError(responseDb(impulse, 250.0, 0) - responseDb(impulse, 4000.0, 0),
+                                      static_cast<double>(at(correction, 250.0) - at(correction, 4000.0)), 0.5);
+
+            double front = 0.0, total = 0.0;
+            for (size_t n = 0; n < impulse.size(); ++n) {
+                const double energy = static_cast<double>(impulse[n]) * impulse[n];
+                total += energy;
+                if (n < 512)
+                    front += energy;
+            }
+            expectGreaterThan(front / total, 0.95);
+
+            std::vector<float> flat(MatchEqDesigner::getNumBins(), 0.0f);
+            designer.designFilter(flat, impulse);
+            expectWithinAbsoluteError(impulse[0], 1.0f, 1.0e-3f);
+            expectLessThan(std::abs(impulse[1]) + std::abs(impulse[100]), 1.0e-3f);
+        }
+
+        // End to end: the worker measures, designs and hands the filter to the audio thread
+        {
+            MatchEqualizer eq;
+            constexpr juce::dsp::ProcessSpec spec{sampleRate, 512, 2};
+            eq.prepare(spec, 2);
+            eq.setTarget(tiltTarget(-3.0f));
+            eq.setActive(true);
+            expect(eq.hasTarget());
+
+            std::vector<float> left(512), right(512);
+            const auto feed = [&](const size_t from, const size_t to) {
+                for (size_t start = from; start + 512 <= to; start += 512) {
+                    std::copy_n(noise.data() + start, 512, left.data());
+                    std::copy_n(noise.data() + start, 512, right.data());
+                    float *channels[] = {left.data(), right.data()};
+                    eq.process(channels, 2, 512);
+                }
+            };
+
+            // Faster than realtime: give the worker time to drain the FIFO between halves
+            feed(0, noise.size() / 2);
+            juce::Thread::sleep(MatchEqualizer::kDesignIntervalMs + 200);
+            feed(noise.size() / 2, noise.size());
+
+            const auto waitForDesigns = [&](const juce::uint32 count) {
+                for (int waited = 0; eq.getNumDesigns() < count && waited < 10000; waited += 20)
+                    juce::Thread::sleep(20);
+                return eq.getNumDesigns() >= count;
+            };
+
+            // Adopt the published kernel, let both stages finish switching, then take an impulse response
+            const auto impulseResponse = [&] {
+                std::vector<float> silence(4096, 0.0f), other(4096, 0.0f);
+                float *channels[] = {silence.data(), other.data()};
+                eq.process(channels, 2, 4096);
+                eq.reset();
+
+                std::vector<float> response(MatchEqDesigner::kFilterLength + 2048, 0.0f), quiet(response.size(), 0.0f);
+                response[0] = 1.0f;
+                float *io[] = {response.data(), quiet.data()};
+                eq.process(io, 2, response.size());
+                return response;
+            };
+
+            expect(waitForDesigns(1), "The worker should publish a correction");
+            const auto corrected = impulseResponse();
+            expectWithinAbsoluteError(responseDb(corrected, 250.0, 64) - responseDb(corrected, 4000.0, 64), 12.0, 2.0);
+
+            const auto designs = eq.getNumDesigns();
+            eq.clearTarget();
+            expect(!eq.hasTarget());
+            expect(waitForDesigns(designs + 1), "Clearing the target should publish the unit impulse");
+
+            const auto identity = impulseResponse();
+            expectWithinAbsoluteError(identity[64], 1.0f, 1.0e-4f);
+            expectLessThan(std::abs(identity[63]) + std::abs(identity[65]) + std::abs(identity[1000]), 1.0e-4f);
+            eq.setActive(false);
+        }
+
+        // gFractorDSP adds the convolver's latency while the match EQ is on
+        {
+            gFractorDSP<float> dsp;
+            dsp.prepare({sampleRate, 512, 2});
+            expectEquals(dsp.getLatencySamples(), 0);
+            dsp.setMatchEqEnabled(true);
+            expectEquals(dsp.getLatencySamples(), MatchEqualizer::getLatencySamples());
+            expect(dsp.isMatchEqEnabled());
+
+            juce::AudioBuffer<float> buffer(2, 512);
+            std::vector<float> outL;
+            for (int block = 0; block < 4; ++block) {
+                for (int i = 0; i < 512; ++i) {
+                    buffer.setSample(0, i, noise[static_cast<size_t>(block * 512 + i)]);
+                    buffer.setSample(1, i, noise[static_cast<size_t>(block * 512 + i)]);
+                }
+                dsp.process(buffer);
+                outL.insert(outL.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + 512);
+            }
+
+            float maxError = 0.0f;
+            for (size_t i = 64; i < outL.size(); ++i)
+                maxError = juce::jmax(maxError, std::abs(outL[i] - noise[i - 64]));
+            expectLessThan(maxError, 1.0e-4f, "Without a target the match EQ should only delay");
+            dsp.setMatchEqEnabled(false);
+        }
+    }
+
+    void testSpectralAudition() {
+        beginTest("Spectral audition");
+
+        constexpr double sampleRate = 48000.0;
+        constexpr int latency = SpectralAudition::getLatencySamples();
+        constexpr size_t blockSize = 480; // not a divisor of the hop
+        constexpr double binHz = sampleRate / static_cast<double>(latency);
+        juce::Random random(17);
+
+        // Run a mono signal through in blocks, returning the output
+        const auto run = [&](SpectralAudition &audition, const std::vector<float> &input) {
+            std::vector<float> output(input);
+            for (size_t start = 0; start < output.size(); start += blockSize) {
+                float *channels[] = {output.data() + start};
+                const auto len = juce::jmin(blockSize, output.size() - start);
+                audition.process(juce::dsp::AudioBlock<float>(channels, 1, len));
+            }
+            return output;
+        };
+
+        const auto tone = [&](const double frequency, const size_t length) {
+            std::vector<float> signal(length);
+            for (size_t n = 0; n < length; ++n)
+                signal[n] = static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * frequency
+                                                        * static_cast<double>(n) / sampleRate));
+            return signal;
+        };
+
+        const auto rmsDb = [](const std::vector<float> &signal, const size_t from) {
+            double sum = 0.0;
+            for (size_t n = from; n < signal.size(); ++n)
+                sum += static_cast<double>(signal[n]) * signal[n];
+            return 10.0 * std::log10(sum / static_cast<double>(signal.size() - from) + 1.0e-30);
+        };
+
+        std::vector<float> noise(static_cast<size_t>(latency) * 8);
+        for (auto &sample: noise)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        // Every control off: the input delayed by exactly the latency, no transforms
+        {
+            SpectralAudition audition;
+            audition.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 1});
+            const auto output = run(audition, noise);
+            expect(!audition.isMasking());
+
+            float maxError = 0.0f;
+            for (size_t n = 0; n < output.size(); ++n) {
+                const float expected = n >= static_cast<size_t>(latency) ? noise[n - static_cast<size_t>(latency)] : 0.0f;
+                maxError = juce::jmax(maxError, std::abs(output[n] - expected));
+            }
+            expectEquals(maxError, 0.0f);
+        }
+
+        // A 1 kHz audition region passes its centre and removes a tone a third of an octave away
+        {
+            SpectralAudition audition;
+            audition.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 1});
+            audition.setAuditFilter(true, 1000.0f, 4.0f);
+
+            const size_t length = static_cast<size_t>(latency) * 6;
+            const auto inBand = run(audition, tone(1000.0, length));
+            expect(audition.isMasking());
+            expectWithinAbsoluteError(rmsDb(inBand, 2 * static_cast<size_t>(latency)), -3.0103, 0.5);
+
+            audition.reset();
+            const auto outOfBand = run(audition, tone(1300.0, length));
+            expectLessThan(rmsDb(outOfBand, 2 * static_cast<size_t>(latency)), -3.0103 - 50.0);
+        }
+
+        // Mask: the audition and band regions multiply; solo passes the union less the muted bands
+        {
+            SpectralAudition audition;
+            audition.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 1});
+            audition.setEdgeOctaves(0.0f);
+            const auto gainAt = [&](const double frequency) {
+                return audition.getMaskGain(static_cast<size_t>(std::lround(frequency / binHz)));
+            };
+            const auto refresh = [&] {
+                std::vector<float> hop(static_cast<size_t>(latency) / SpectralAudition::kOverlap, 0.0f);
+                run(audition, hop);
+            };
+
+            audition.setBandSolo(0b0001011); // Sub, Low, Mid
+            audition.setBandMute(0b0000010); // less Low
+            refresh();
+            expectEquals(gainAt(50.0), 1.0f);
+            expectEquals(gainAt(150.0), 0.0f);
+            expectEquals(gainAt(450.0), 0.0f);
+            expectEquals(gainAt(1000.0), 1.0f);
+            expectEquals(gainAt(4000.0), 0.0f);
+
+            audition.setBandSolo(0);
+            audition.setBandMute(0b0011000); // Mid and Hi-Mid
+            audition.setBandFilter(true, 1000.0f, 0.5f);
+            refresh();
+            expectEquals(gainAt(500.0), 1.0f);
+            expectEquals(gainAt(1000.0), 0.0f);
+            expectEquals(gainAt(4000.0), 0.0f);
+            expectEquals(gainAt(8000.0), 0.0f, "Outside the band region");
+
+            // Contiguous solo bands merge, so their shared edge does not dip
+            audition.setBandFilter(false, 1000.0f, 0.5f);
+            audition.setBandMute(0);
+            audition.setBandSolo(0b0011000);
+            audition.setEdgeOctaves(SpectralAudition::kDefaultEdgeOctaves);
+            refresh();
+            expectEquals(gainAt(2000.0), 1.0f);
+            expectLessThan(gainAt(500.0), 1.0e-3f);
+        }
+
+        // Switching off: the last masked frames overlap-add out, then the delayed input again
+        {
+            SpectralAudition audition;
+            audition.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 1});
+            audition.setAuditFilter(true, 1000.0f, 2.0f);
+            std::vector<float> first(noise.begin(), noise.begin() + static_cast<std::ptrdiff_t>(noise.size() / 2));
+            run(audition, first);
+
+            audition.setAuditFilter(false, 1000.0f, 2.0f);
+            std::vector<float> second(noise.begin() + static_cast<std::ptrdiff_t>(noise.size() / 2), noise.end());
+            const auto output = run(audition, second);
+            expect(!audition.isMasking());
+
+            // Masking ends within a hop; a frame later everything is the plain delayed input
+            const size_t settled = 2 * static_cast<size_t>(latency);
+            float maxError = 0.0f;
+            for (size_t n = settled; n < output.size(); ++n)
+                maxError = juce::jmax(maxError, std::abs(output[n] - second[n - static_cast<size_t>(latency)]));
+            expectLessThan(maxError, 1.0e-5f);
+        }
+
+        // gFractorDSP: the selected engine's latency is reported and both engines share the controls
+        {
+            gFractorDSP<float> dsp;
+            dsp.prepare({sampleRate, 512, 2});
+            dsp.setAuditionEngine(AuditionEngine::Spectral);
+            expectEquals(dsp.getLatencySamples(), latency);
+            dsp.setAuditFilter(true, 1000.0f, 4.0f);
+
+            const auto source = tone(1300.0, static_cast<size_t>(latency) * 6);
+            juce::AudioBuffer<float> buffer(2, 512);
+            std::vector<float> output;
+            for (size_t start = 0; start + 512 <= source.size(); start += 512) {
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.copyFrom(ch, 0, source.data() + start, 512);
+                dsp.process(buffer);
+                output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + 512);
+            }
+            expectLessThan(rmsDb(output, 2 * static_cast<size_t>(latency)), -50.0);
+
+            dsp.setAuditionEngine(AuditionEngine::Filter);
+            expectEquals(dsp.getLatencySamples(), 0);
+            expect(auditionEngineFromInt(auditionEngineToInt(AuditionEngine::Spectral)) == AuditionEngine::Spectral);
+        }
+    }
+
+    void testSidechainAligner() {
+        beginTest("Sidechain alignment");
+
+        juce::Random random(23);
+        std::vector<float> noise(48000 * 3);
+        for (auto &sample: noise)
+            sample = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+
+        // The signal shifted by lag samples (positive: later), zero before it starts
+        const auto shifted = [&](const int lag) {
+            std::vector<float> signal(noise.size(), 0.0f);
+            for (size_t n = 0; n < signal.size(); ++n) {
+                const auto source = static_cast<std::ptrdiff_t>(n) - lag;
+                if (source >= 0 && source < static_cast<std::ptrdiff_t>(noise.size()))
+                    signal[n] = noise[static_cast<size_t>(source)];
+            }
+            return signal;
+        };
+
+        // Estimator: a filtered, delayed copy with uncorrelated noise on top still peaks at its lag
+        {
+            GccPhatEstimator estimator;
+            estimator.prepare(12000.0, 1, 1500);
+
+            auto second = shifted(23);
+            float state = 0.0f;
+            for (auto &sample: second) {
+                state += 0.3f * (sample - state);
+                sample = state + (random.nextFloat() * 2.0f - 1.0f) * 0.05f;
+            }
+
+            GccPhatEstimator::Estimate estimate;
+            estimator.pushSamples(noise.data(), second.data(), 6000);
+            expect(!estimator.estimate(estimate), "No estimate before kMinAnalysisSeconds have been measured");
+
+            estimator.pushSamples(noise.data() + 6000, second.data() + 6000, 30000);
+            expect(estimator.estimate(estimate));
+            expectEquals(estimate.lagSamples, 23);
+            expectGreaterThan(estimate.confidence, SidechainAligner::kMinConfidence);
+
+            // Leading is a negative lag
+            estimator.reset();
+            const auto leading = shifted(-40);
+            estimator.pushSamples(noise.data(), leading.data(), 36000);
+            expect(estimator.estimate(estimate));
+            expectEquals(estimate.lagSamples, -40);
+        }
+
+        // End to end at 48 kHz: decimated measurement, lags off the decimated grid, delayed feeds
+        for (const int lag: {37, -5}) {
+            SidechainAligner aligner;
+            aligner.prepare(48000.0, 512, 2, 2);
+            expectEquals(aligner.getDecimationFactor(), 4);
+            aligner.setActive(true);
+
+            const auto sidechainSignal = shifted(lag);
+            juce::AudioBuffer<float> main(2, 512), sidechain(2, 512);
+            const auto load = [&](const size_t start) {
+                for (int ch = 0; ch < 2; ++ch) {
+                    main.copyFrom(ch, 0, noise.data() + start, 512);
+                    sidechain.copyFrom(ch, 0, sidechainSignal.data() + start, 512);
+                }
+            };
+
+            // Faster than realtime: the FIFO holds it all
+            for (size_t start = 0; start + 512 <= noise.size(); start += 512) {
+                load(start);
+                aligner.capture(main, sidechain);
+            }
+
+            for (int waited = 0; aligner.getDelaySamples() != lag && waited < 10000; waited += 20)
+                juce::Thread::sleep(20);
+            expectEquals(aligner.getDelaySamples(), lag);
+            expectGreaterThan(aligner.getConfidence(), 0.5f);
+
+            // The leading feed is delayed so both show the same samples (the first block fills the line)
+            float maxError = 0.0f;
+            for (size_t start = 0; start + 512 <= 8 * 512; start += 512) {
+                load(start);
+                aligner.align(main, sidechain);
+                if (start == 0)
+                    continue;
+
+                const auto &alignedMain = aligner.getAlignedMain();
+                const auto &alignedSidechain = aligner.getAlignedSidechain();
+                for (int i = 0; i < 512; ++i)
+                    maxError = juce::jmax(maxError, std::abs(alignedMain.getSample(1, i) - alignedSidechain.getSample(1, i)));
+            }
+            expectEquals(maxError, 0.0f);
+
+            aligner.setActive(false);
+            expectEquals(aligner.getDelaySamples(), 0);
+            aligner.align(main, sidechain);
+            expect(aligner.getAlignedMain().getReadPointer(0) == main.getReadPointer(0), "Inactive feeds pass through");
+        }
+    }
+
+    void testHalfbandDecimator() {
+        beginTest("Halfband decimator");
+
+        // Stages for a 20 kHz display: standard rates stay put, high rates land at 44.1/48 kHz
+        expectEquals(HalfbandDecimator::stagesFor(44100.0, 20000.0), 0);
+        expectEquals(HalfbandDecimator::stagesFor(48000.0, 20000.0), 0);
+        expectEquals(HalfbandDecimator::stagesFor(88200.0, 20000.0), 0);
+        expectEquals(HalfbandDecimator::stagesFor(88200.0, 18000.0), 1);
+        expectEquals(HalfbandDecimator::stagesFor(96000.0, 20000.0), 1);
+        expectEquals(HalfbandDecimator::stagesFor(192000.0, 20000.0), 2);
+        expectEquals(HalfbandDecimator::stagesFor(384000.0, 20000.0), 3);
+        expectEquals(HalfbandDecimator::stagesFor(768000.0, 20000.0), HalfbandDecimator::kMaxStages);
+
+        // Output level of a sine (relative to its input) after the filters have settled
+        const auto responseDb = [](const int stages, const double sampleRate, const double frequency) {
+            HalfbandDecimator decimator;
+            decimator.setNumStages(stages);
+
+            constexpr int blockSize = 480;
+            std::vector<float> left(blockSize), right(blockSize), outLeft(blockSize), outRight(blockSize);
+            double energy = 0.0;
+            int counted = 0;
+            for (int block = 0; block < 100; ++block) {
+                for (int i = 0; i < blockSize; ++i) {
+                    const double t = static_cast<double>(block * blockSize + i) / sampleRate;
+                    left[static_cast<size_t>(i)] = static_cast<float>(
+                        0.5 * std::sin(2.0 * juce::MathConstants<double>::pi * frequency * t));
+                    right[static_cast<size_t>(i)] = -left[static_cast<size_t>(i)];
+                }
+                const int count = decimator.process(left.data(), right.data(), blockSize,
+                                                    outLeft.data(), outRight.data());
+                if (block < 10)
+                    continue;
+                for (int i = 0; i < count; ++i)
+                    energy += static_cast<double>(outLeft[static_cast<size_t>(i)])
+                              * static_cast<double>(outLeft[static_cast<size_t>(i)]);
+                counted += count;
+            }
+            return 10.0 * std::log10(energy / static_cast<double>(counted) / 0.125 + 1.0e-30);
+        };
+
+        // Flat passband up to kPassbandFraction of the output rate
+        for (const double frequency: {100.0, 1000.0, 10000.0, 19000.0, 20000.0})
+            expectWithinAbsoluteError(responseDb(1, 96000.0, frequency), 0.0, 0.01,
+                                      "Passband at " + juce::String(frequency) + " Hz");
+        for (const double frequency: {1000.0, 20000.0})
+            expectWithinAbsoluteError(responseDb(2, 192000.0, frequency), 0.0, 0.01,
+                                      "Two stages at " + juce::String(frequency) + " Hz");
+        expectWithinAbsoluteError(responseDb(3, 384000.0, 1000.0), 0.0, 0.01, "Three stages");
+
+        // Everything that would fold into the passband is rejected
+        for (const double frequency: {28000.0, 30000.0, 40000.0, 47000.0}) {
+            const double level = responseDb(1, 96000.0, frequency);
+            expect(level < -HalfbandDecimator::kStopbandDb + 3.0,
+                   "Alias of " + juce::String(frequency) + " Hz at " + juce::String(level, 1) + " dB");
+        }
+        for (const double frequency: {30000.0, 60000.0, 90000.0}) {
+            const double level = responseDb(2, 192000.0, frequency);
+            expect(level < -HalfbandDecimator::kStopbandDb + 3.0,
+                   "Two-stage alias of " + juce::String(frequency) + " Hz at " + juce::String(level, 1) + " dB");
+        }
+
+        // Zero stages produce nothing; the count is clamped
+        HalfbandDecimator idle;
+        float in[4] = {1.0f, 1.0f, 1.0f, 1.0f}, out[4] = {};
+        expectEquals(idle.process(in, in, 4, out, out + 2), 0);
+        idle.setNumStages(HalfbandDecimator::kMaxStages + 2);
+        expectEquals(idle.getNumStages(), HalfbandDecimator::kMaxStages);
+    }
+
     //==============================================================================
     // Helper methods
 
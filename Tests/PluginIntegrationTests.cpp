@@ -67,6 +67,39 @@ public:
             bufferIsFinite(block);
         }
 
+        beginTest("Parameter changes reach the DSP on the next block");
+        {
+            gFractorAudioProcessor processor;
+            processor.setOutputMode(ChannelMode::MidSide);
+            processor.prepareToPlay(48000.0, 64);
+            auto &apvts = processor.getAPVTS();
+            juce::MidiBuffer midi;
+
+            // Pure mid input: with the primary (mid) output disabled, M/S mode leaves silence
+            const auto makeMidBlock = [] {
+                juce::AudioBuffer<float> block(2, 64);
+                for (int sample = 0; sample < block.getNumSamples(); ++sample) {
+                    block.setSample(0, sample, 0.5f);
+                    block.setSample(1, sample, 0.5f);
+                }
+                return block;
+            };
+
+            if (auto *primary = apvts.getParameter(ParameterIDs::outputPrimaryEnable))
+                primary->setValueNotifyingHost(0.0f);
+
+            auto block = makeMidBlock();
+            processor.processBlock(block, midi);
+            expectWithinAbsoluteError(block.getMagnitude(0, block.getNumSamples()), 0.0f, 1.0e-6f);
+
+            if (auto *bypass = apvts.getParameter(ParameterIDs::bypass))
+                bypass->setValueNotifyingHost(1.0f);
+
+            block = makeMidBlock();
+            processor.processBlock(block, midi);
+            expectWithinAbsoluteError(block.getSample(0, block.getNumSamples() - 1), 0.5f, 1.0e-6f);
+        }
+
         beginTest("Display state round-trip: channel mode survives save/load");
         {
             gFractorAudioProcessor source;
@@ -152,6 +185,17 @@ public:
                 juce::AudioChannelSet::stereo(),
                 juce::AudioChannelSet::mono(),
                 juce::AudioChannelSet::disabled())));
+
+            for (const auto &immersive: {juce::AudioChannelSet::create5point1(),
+                                         juce::AudioChannelSet::create7point1(),
+                                         juce::AudioChannelSet::create7point1point4()}) {
+                expect(processor.isBusesLayoutSupported(makeLayout(
+                    immersive, immersive, juce::AudioChannelSet::disabled())));
+                expect(processor.isBusesLayoutSupported(makeLayout(
+                    immersive, immersive, juce::AudioChannelSet::stereo())));
+                expect(!processor.isBusesLayoutSupported(makeLayout(
+                    immersive, juce::AudioChannelSet::stereo(), juce::AudioChannelSet::disabled())));
+            }
         }
 
         beginTest("Plugin load/unload via factory");
@@ -431,14 +475,16 @@ public:
         beginTest("Sink registration/unregistration is stable");
         {
             struct CountingSink : IAudioDataSink {
-                void pushStereoData(const juce::AudioBuffer<float> &) override { ++pushCalls; }
+                void setCaptureBus(const CaptureBus *bus) override { reader.attach(bus); }
 
                 void setSampleRate(const double sr) override {
                     ++sampleRateCalls;
                     lastSampleRate = sr;
                 }
 
-                int pushCalls = 0;
+                int pull() { return reader.read(1 << 16, [](const float *, const float *, int) {}); }
+
+                CaptureBus::Reader reader;
                 int sampleRateCalls = 0;
                 double lastSampleRate = 0.0;
             };
@@ -457,16 +503,16 @@ public:
             juce::MidiBuffer midi;
 
             processor.processBlock(block, midi);
-            expectEquals(sinkA.pushCalls, 1);
-            expectEquals(sinkB.pushCalls, 1);
+            expectEquals(sinkA.pull(), 64);
+            expectEquals(sinkB.pull(), 64);
             expectEquals(sinkA.sampleRateCalls, 1);
             expectEquals(sinkB.sampleRateCalls, 1);
 
             processor.unregisterAudioDataSink(&sinkA);
 
             processor.processBlock(block, midi);
-            expectEquals(sinkA.pushCalls, 1);
-            expectEquals(sinkB.pushCalls, 2);
+            expectEquals(sinkA.pull(), 0);
+            expectEquals(sinkB.pull(), 64);
             expectWithinAbsoluteError(sinkB.lastSampleRate, 44100.0, 0.001);
         }
 
@@ -4,19 +4,24 @@
   Tests for:
   - DisplayRange coordinate transformations
   - FFTProcessor functionality
+  - SpectrumAnalysisWorker frame hand-off
   - Defaults verification
   - Correlation calculation
 */
 
 #include <juce_dsp/juce_dsp.h>
 #include <juce_core/juce_core.h>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <thread>
 #include <vector>
 
 #include "Utility/DisplayRange.h"
 #include "Utility/AnalyzerSettings.h"
 #include "Utility/SpectrumAnalyzerDefaults.h"
 #include "DSP/Processing/FFTProcessor.h"
+#include "DSP/Processing/SpectrumAnalysisWorker.h"
 #include "UI/Visualizers/SpectrumAnalyzer.h"
 #include "UI/Theme/ColorPalette.h"
 #include "UI/Theme/Typography.h"
@@ -39,6 +44,7 @@ public:
         testFFTProcessorBinAccuracy();
         testFFTProcessorSlopeTilt();
         testFFTProcessorTemporalDecay();
+        testSpectrumAnalysisWorkerFrames();
         testAnalyzerSettingsCorruption();
         testCorrelationCalculation();
         testSpectrumAnalyzerBandLookup();
@@ -338,6 +344,90 @@ private:
         expect(true);
     }
 
+    //==============================================================================
+    void testSpectrumAnalysisWorkerFrames() {
+        beginTest("SpectrumAnalysisWorker frames");
+
+        CaptureBus bus(1 << 15);
+        SpectrumAnalysisWorker worker(1 << 15);
+        worker.setCaptureBus(&bus);
+
+        SpectrumAnalysisWorker::Settings settings;
+        settings.fftOrder = 11;
+        settings.overlapFactor = 2;
+        settings.sampleRate = 48000.0;
+        settings.curveDecay = 0.0f; // every frame shows its own window
+        settings.channelMode = ChannelMode::LR;
+        auto generation = worker.setSettings(settings);
+
+        // 1.5 kHz on the left only, written the way the audio thread does
+        std::vector<float> left(256), right(256, 0.0f);
+        double phase = 0.0;
+        const auto writeBlock = [&] {
+            for (auto &sample: left) {
+                sample = static_cast<float>(0.5 * std::sin(phase));
+                phase += juce::MathConstants<double>::twoPi * 1500.0 / 48000.0;
+            }
+            bus.write(left.data(), right.data(), 256);
+        };
+
+        // Frames analysed with older settings may still be in flight: skip them
+        const auto nextFrame = [&](const bool feed) -> const SpectrumAnalysisWorker::Frame * {
+            for (int i = 0; i < 2000; ++i) {
+                if (feed)
+                    writeBlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                if (const auto *frame = worker.takeLatestFrame(); frame != nullptr && frame->generation == generation)
+                    return frame;
+            }
+            return nullptr;
+        };
+        const auto peakBin = [](const std::vector<float> &db) {
+            return static_cast<int>(std::max_element(db.begin(), db.end()) - db.begin());
+        };
+
+        const auto *frame = nextFrame(true);
+        expect(frame != nullptr);
+        if (frame == nullptr)
+            return;
+        expectEquals(static_cast<int>(frame->primaryDb.size()), 1025);
+        expectEquals(peakBin(frame->primaryDb), 64); // 1500 / (48000 / 2048)
+        expectLessOrEqual(*std::max_element(frame->secondaryDb.begin(), frame->secondaryDb.end()),
+                          settings.minDb + 0.01f);
+        expect(frame->aboveFloor && !frame->hasGhost);
+
+        // A new FFT order: only frames at the new size carry the new generation
+        settings.fftOrder = 12;
+        generation = worker.setSettings(settings);
+        frame = nextFrame(true);
+        expect(frame != nullptr);
+        if (frame == nullptr)
+            return;
+        expectEquals(static_cast<int>(frame->primaryDb.size()), 2049);
+        expectEquals(peakBin(frame->primaryDb), 128);
+
+        // Silence: the worker decays to the floor by itself, then stops publishing
+        bus.markSilent();
+        do {
+            frame = nextFrame(false);
+        } while (frame != nullptr && frame->aboveFloor);
+        expect(frame != nullptr);
+        if (frame == nullptr)
+            return;
+        expectEquals(*std::max_element(frame->primaryDb.begin(), frame->primaryDb.end()), settings.minDb);
+
+        // Frozen: the input is skipped, nothing is published
+        worker.setFrozen(true);
+        for (int i = 0; i < 50; ++i) {
+            writeBlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        expect(worker.takeLatestFrame() == nullptr);
+
+        worker.setFrozen(false);
+        expect(nextFrame(true) != nullptr);
+    }
+
     //==============================================================================
     void testCorrelationCalculation() {
         beginTest("Correlation Calculation");